@@ -7,18 +7,23 @@
 //
 
 #include <ctype.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "ai.h"
+#include "book.h"
 #include "cli.h"
 #include "game.h"
 #include "gomoku.h"
+#include "snapshot.h"
 
 #include "coords.h"
 #include "metadata.h"
 #include "protocol.h"
+#include "swap2_openings.h"
 #include "time_budget.h"
 
 // The engine's gomoku.h already defines DEFAULT_BOARD_SIZE = 19 for the TUI;
@@ -26,28 +31,27 @@
 // document that the Standard tournament category is fixed at 15x15.
 #define BRAIN_BOARD_SIZE       15
 
-// Default search depth. We use 5 (not 7) deliberately:
-//
-// The engine's find_best_ai_move pipeline (see doc/ai-engine.md §1) handles
-// every meaningful tactical situation BEFORE minimax via Steps 1-6: own
-// winning move, blocking opponent's win, compound threats, VCT search,
-// blocking open threes, playing forcing fours. Depth only matters for
-// Step 7 (minimax), which runs in QUIET positions where neither side has
-// a forcing line. In quiet positions, the static evaluator is the
-// dominant signal, and depth 5 vs 7 changes the move chosen rarely.
-//
-// An adaptive "depth 5 normally, depth 7 when the position is hot" rule
-// would need a position-classifier that the existing pipeline doesn't
-// already provide cheaply (steps 1-6 already short-circuit on hot
-// positions, so by the time we reach the depth choice we're in quiet
-// territory by definition). Implementing such a classifier well would
-// add real complexity for marginal strength gain. Depth 5 with the
-// improved heuristic from PR #86 (broken-three / broken-four / overline
-// fixes) is a strong baseline that fits comfortably inside the 30s
-// per-turn tournament budget on a 15x15 board.
-#define BRAIN_DEFAULT_DEPTH    5
+// Depth ceiling for iterative deepening. The brain used to pin depth 5
+// on the grounds that an adaptive rule would need a position classifier;
+// the engine's predictive time manager IS that classifier now. Each
+// completed iteration's time yields an effective branching factor, and a
+// new depth only starts when its predicted cost fits the remaining
+// move_timeout — so the brain reaches 7-8 in the opening when iterations
+// are cheap and backs off on its own as the board fills and iterations
+// swell, instead of leaving 20+ of a 30 s turn unused. The ceiling just
+// bounds the TT entry depths; the clock does the real limiting.
+#define BRAIN_MAX_DEPTH        8
 #define BRAIN_SEARCH_RADIUS    3
 
+// Pondering: while the opponent thinks we are otherwise idle, so a
+// background thread pre-searches their most plausible replies. Searched
+// positions land in the game's transposition table keyed by position
+// hash, so on a prediction hit the real search after TURN starts from a
+// near-complete tree instead of cold. The extra depth is affordable
+// because the opponent's clock is running, not ours.
+#define BRAIN_PONDER_PREDICTIONS 3
+#define BRAIN_PONDER_DEPTH_BONUS 2
+
 // Brain-side identification of the two engine players. self_color is whichever
 // side the manager assigns to us — determined the first time the manager asks
 // us to play (BEGIN means self-first; the first TURN means opponent-first).
@@ -58,6 +62,9 @@ typedef struct {
   int self_color;          // AI_CELL_CROSSES or AI_CELL_NAUGHTS, or 0 if unknown.
   int started;             // 1 once START succeeded.
   int board_collecting;    // 1 between BOARD and DONE.
+  pthread_t ponder_thread;
+  int ponder_active;       // 1 while the ponder thread may be running.
+  volatile int ponder_stop; // Abort channel the search polls (game->smp_stop).
 } brain_t;
 
 // ---------------------------------------------------------------------------
@@ -92,7 +99,7 @@ static cli_config_t make_brain_config(int board_size) {
   cli_config_t cfg;
   memset(&cfg, 0, sizeof(cfg));
   cfg.board_size = board_size;
-  cfg.max_depth = BRAIN_DEFAULT_DEPTH;
+  cfg.max_depth = BRAIN_MAX_DEPTH;
   cfg.move_timeout = 0;          // Per-move budget is set on each search.
   cfg.show_help = 0;
   cfg.invalid_args = 0;
@@ -102,6 +109,7 @@ static cli_config_t make_brain_config(int board_size) {
   cfg.headless = 1;              // Suppress stdout chatter from the engine.
   cfg.stateless_mode = 0;        // Reuse the TT across turns (see plan §6).
   cfg.search_radius = BRAIN_SEARCH_RADIUS;
+  cfg.leaf_radius = 2;
   cfg.json_file[0] = '\0';
   cfg.replay_file[0] = '\0';
   cfg.replay_wait = 0;
@@ -144,6 +152,92 @@ static int apply_stone(brain_t *b, int row, int col, int player) {
   return make_move(b->game, row, col, player, 0.0, 0, 0, 0);
 }
 
+// ---------------------------------------------------------------------------
+// Pondering on opponent time
+// ---------------------------------------------------------------------------
+
+// The dispatch loop blocks on stdin while the opponent thinks, so the
+// thread below is the only one touching the game state until it is
+// joined. It speculatively plays each predicted opponent reply, searches
+// our answer (warming the TT for the real search), and unmakes the
+// stone — the board is exactly as it found it when the thread exits.
+// Any command that touches the game joins the thread first; INFO only
+// updates the budget struct and deliberately does not interrupt.
+static void *ponder_main(void *arg) {
+  brain_t *b = (brain_t *)arg;
+  game_state_t *game = b->game;
+  int opponent = other_color(b->self_color);
+
+  // Rank the opponent's candidate replies by the move generator's
+  // priority — the same ordering the real search would explore first.
+  move_t moves[361];
+  int count = generate_moves_optimized(game, game->board, moves, opponent,
+                                       game->max_depth);
+  int predictions =
+      (count < BRAIN_PONDER_PREDICTIONS) ? count : BRAIN_PONDER_PREDICTIONS;
+  for (int k = 0; k < predictions; k++) {
+    int best = k;
+    for (int i = k + 1; i < count; i++) {
+      if (moves[i].priority > moves[best].priority) best = i;
+    }
+    move_t tmp = moves[k];
+    moves[k] = moves[best];
+    moves[best] = tmp;
+  }
+
+  int saved_depth = game->max_depth;
+  double saved_timeout = game->move_timeout;
+  game->max_depth = saved_depth + BRAIN_PONDER_DEPTH_BONUS;
+  game->move_timeout = 0; // The opponent's clock is running, not ours.
+  game->smp_stop = &b->ponder_stop;
+
+  for (int k = 0; k < predictions && !b->ponder_stop; k++) {
+    int x = moves[k].x, y = moves[k].y;
+    if (!make_move(game, x, y, opponent, 0.0, 0, 0, 0)) {
+      continue;
+    }
+    if (game->game_state == GAME_RUNNING) {
+      game->current_player = b->self_color;
+      game->search_timed_out = 0;
+      int bx = -1, by = -1;
+      find_best_ai_move(game, &bx, &by, NULL);
+    }
+    game->move_history_count--;
+    search_unmake_move(game, game->board, x, y, opponent);
+    game->game_state = GAME_RUNNING;
+    game->current_player = b->self_color;
+  }
+
+  game->smp_stop = NULL;
+  game->search_timed_out = 0;
+  game->max_depth = saved_depth;
+  game->move_timeout = saved_timeout;
+  return NULL;
+}
+
+static void ponder_start(brain_t *b) {
+  if (!b->game || !b->self_color || b->ponder_active ||
+      b->game->game_state != GAME_RUNNING) {
+    return;
+  }
+  b->ponder_stop = 0;
+  if (pthread_create(&b->ponder_thread, NULL, ponder_main, b) == 0) {
+    b->ponder_active = 1;
+  }
+}
+
+// Raise the abort flag and wait for the thread to put the board back.
+// The search polls the flag every few thousand nodes, so this returns in
+// well under a millisecond of the next command arriving.
+static void ponder_join(brain_t *b) {
+  if (!b->ponder_active) {
+    return;
+  }
+  b->ponder_stop = 1;
+  pthread_join(b->ponder_thread, NULL);
+  b->ponder_active = 0;
+}
+
 // ---------------------------------------------------------------------------
 // AI move generation
 // ---------------------------------------------------------------------------
@@ -165,7 +259,8 @@ static int compute_and_emit_move(brain_t *b) {
   // search runs from. Force it to self_color so we always search for our move.
   b->game->current_player = b->self_color;
 
-  double budget_s = time_budget_compute_seconds(&b->budget);
+  double budget_s =
+      time_budget_compute_seconds(&b->budget, b->game->stones_on_board);
   b->game->move_timeout = budget_s;
   b->game->search_start_time = get_current_time();
   b->game->search_timed_out = 0;
@@ -202,6 +297,9 @@ static int compute_and_emit_move(brain_t *b) {
 
   double elapsed = get_current_time() - b->game->search_start_time;
   time_budget_record_elapsed(&b->budget, elapsed);
+
+  // Our answer is on the wire; the opponent's clock is now running.
+  ponder_start(b);
   return 1;
 }
 
@@ -254,6 +352,7 @@ static void handle_begin(brain_t *b) {
   char buf[16];
   snprintf(buf, sizeof(buf), "%d,%d", gx, gy);
   out_line(buf);
+  ponder_start(b);
 }
 
 static void handle_turn(brain_t *b, const parsed_command_t *cmd) {
@@ -261,9 +360,14 @@ static void handle_turn(brain_t *b, const parsed_command_t *cmd) {
     out_error("brain not started");
     return;
   }
-  // First TURN with no prior moves implies opponent moved first → we are NAUGHTS.
+  // First TURN with our colour still open: stone parity decides it. Stones
+  // alternate starting with black, so an incoming stone on an even count is
+  // black (classic opponent-first game — we are white) and on an odd count
+  // white (e.g. the opponent answered our SWAP2 three-stone proposal by
+  // playing the white 4th stone, which makes us black).
   if (!b->self_color) {
-    b->self_color = AI_CELL_NAUGHTS;
+    b->self_color = (b->game->stones_on_board % 2 == 0) ? AI_CELL_NAUGHTS
+                                                        : AI_CELL_CROSSES;
   }
 
   int row = -1, col = -1;
@@ -305,6 +409,9 @@ static void handle_takeback(brain_t *b, const parsed_command_t *cmd) {
   }
   invalidate_winner_cache(b->game);
   b->game->current_hash = compute_zobrist_hash(b->game);
+  bitboard_sync(&b->game->bitboard, b->game->board, b->game->board_size,
+                b->game->search_radius);
+  line_eval_rebuild(&b->game->line_eval, b->game->board, b->game->board_size);
   out_ok();
 }
 
@@ -329,23 +436,24 @@ static void handle_board(brain_t *b) {
     out_error("brain not started");
     return;
   }
-  // Replay every cell. Until DONE arrives, each subsequent line is a
+  // Collect every cell. Until DONE arrives, each subsequent line is a
   // "X,Y,field" triple. Reset the board first so the BOARD state is
-  // authoritative; the engine TT is preserved (plan §6).
+  // authoritative; the engine TT is preserved (plan §6). Derived state
+  // (bitboard, line totals, hash, winner cache) is rebuilt ONCE by the
+  // bulk loader after DONE instead of per stone.
   for (int r = 0; r < b->board_size; r++) {
     for (int c = 0; c < b->board_size; c++) {
       b->game->board[r][c] = AI_CELL_EMPTY;
     }
   }
   b->game->move_history_count = 0;
-  b->game->stones_on_board = 0;
-  invalidate_winner_cache(b->game);
-  b->game->current_hash = compute_zobrist_hash(b->game);
   b->game->current_player = AI_CELL_CROSSES;
 
-  if (!b->self_color) {
-    b->self_color = AI_CELL_CROSSES;  // fallback; refined below if BOARD has only opponent stones
-  }
+  move_history_t stones[BRAIN_BOARD_SIZE * BRAIN_BOARD_SIZE];
+  int fields[BRAIN_BOARD_SIZE * BRAIN_BOARD_SIZE];
+  uint8_t seen[BRAIN_BOARD_SIZE * BRAIN_BOARD_SIZE];
+  int stone_count = 0;
+  memset(seen, 0, sizeof(seen));
 
   b->board_collecting = 1;
 
@@ -365,19 +473,163 @@ static void handle_board(brain_t *b) {
     if (!gomocup_coord_in_bounds(gx, gy, b->board_size)) continue;
     int row = -1, col = -1;
     gomocup_to_engine(gx, gy, &row, &col);
-    int stone = (field == 1) ? b->self_color : other_color(b->self_color);
-    if (b->game->board[row][col] != AI_CELL_EMPTY) continue;
-    make_move(b->game, row, col, stone, 0.0, 0, 0, 0);
+    if (seen[row * b->board_size + col]) continue;
+    seen[row * b->board_size + col] = 1;
+    memset(&stones[stone_count], 0, sizeof(stones[stone_count]));
+    stones[stone_count].x = row;
+    stones[stone_count].y = col;
+    fields[stone_count] = field;
+    stone_count++;
+  }
+
+  // Resolve our colour before mapping field bits to engine cells. After
+  // DONE it is our turn, so stone parity pins it: an even count means the
+  // next (our) stone is black, odd means white. This matters after SWAP2 —
+  // when the opponent swaps to black following our three-stone proposal,
+  // the manager hands us the position via BOARD and we must come out white.
+  if (!b->self_color) {
+    b->self_color =
+        (stone_count % 2 == 0) ? AI_CELL_CROSSES : AI_CELL_NAUGHTS;
+  }
+  for (int i = 0; i < stone_count; i++) {
+    stones[i].player =
+        (fields[i] == 1) ? b->self_color : other_color(b->self_color);
   }
+  bulk_load_moves(b->game, stones, stone_count, NULL);
   // After DONE, it is always our turn (the manager sends BOARD when it wants
   // a move from us).
   compute_and_emit_move(b);
 }
 
+static void handle_swap2board(brain_t *b) {
+  if (!b->started) {
+    out_error("brain not started");
+    return;
+  }
+  // The SWAP2 position is authoritative, like BOARD: start from a clean
+  // board and rebuild derived state once via the bulk loader.
+  for (int r = 0; r < b->board_size; r++) {
+    for (int c = 0; c < b->board_size; c++) {
+      b->game->board[r][c] = AI_CELL_EMPTY;
+    }
+  }
+  b->game->move_history_count = 0;
+  b->game->current_player = AI_CELL_CROSSES;
+
+  // Collect "X,Y" rows until DONE. A SWAP2 decision position carries 0,
+  // 3 or 5 stones; colours follow placement order (stones 1, 3, 5 black).
+  int gx[5], gy[5];
+  int n = 0;
+  b->board_collecting = 1;
+  char line[256];
+  while (fgets(line, sizeof(line), stdin)) {
+    char *p = line;
+    while (*p && isspace((unsigned char)*p)) p++;
+    if (strncasecmp(p, "DONE", 4) == 0) {
+      b->board_collecting = 0;
+      break;
+    }
+    int x = -1, y = -1;
+    if (!protocol_parse_swap2_row(line, &x, &y)) {
+      continue;  // tolerate noise
+    }
+    if (!gomocup_coord_in_bounds(x, y, b->board_size)) continue;
+    if (n < 5) {
+      gx[n] = x;
+      gy[n] = y;
+      n++;
+    }
+  }
+
+  move_history_t stones[5];
+  memset(stones, 0, sizeof(stones));
+
+  if (n == 0) {
+    // We are the opener: propose a balanced triple straight from the
+    // precomputed table. Pick pseudo-randomly so repeated matches against
+    // the same opponent do not always start from one shape.
+    static int seeded = 0;
+    if (!seeded) {
+      srand((unsigned)time(NULL));
+      seeded = 1;
+    }
+    const swap2_opening_t *op = &swap2_openings[rand() % SWAP2_OPENING_COUNT];
+    for (int i = 0; i < 3; i++) {
+      int row = -1, col = -1;
+      gomocup_to_engine(op->stones[i][0], op->stones[i][1], &row, &col);
+      stones[i].x = row;
+      stones[i].y = col;
+      stones[i].player = (i % 2 == 0) ? AI_CELL_CROSSES : AI_CELL_NAUGHTS;
+    }
+    bulk_load_moves(b->game, stones, 3, NULL);
+
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%d,%d %d,%d %d,%d", op->stones[0][0],
+             op->stones[0][1], op->stones[1][0], op->stones[1][1],
+             op->stones[2][0], op->stones[2][1]);
+    out_line(buf);
+    // Our colour stays open until the opponent chooses: TURN means they
+    // played white's 4th stone (we are black, resolved by stone parity in
+    // handle_turn), BOARD means they swapped to black (resolved there),
+    // and a 5-stone SWAP2BOARD means they balanced and passed the choice
+    // back to us.
+    return;
+  }
+
+  if (n != 3 && n != 5) {
+    out_error("malformed swap2 position");
+    return;
+  }
+
+  for (int i = 0; i < n; i++) {
+    int row = -1, col = -1;
+    gomocup_to_engine(gx[i], gy[i], &row, &col);
+    stones[i].x = row;
+    stones[i].y = col;
+    stones[i].player = (i % 2 == 0) ? AI_CELL_CROSSES : AI_CELL_NAUGHTS;
+  }
+  bulk_load_moves(b->game, stones, n, NULL);
+
+  // Colour choice. White moves next in both decision positions, so we take
+  // black only when its standing edge beats the precomputed tempo threshold;
+  // otherwise we keep white and play the next stone with the normal budgeted
+  // search. The maintained line totals make this an O(1) read — the deep
+  // evaluation behind the threshold already happened offline. The protocol's
+  // third option after 3 stones (place two balancing stones and hand the
+  // choice back) is deliberately unused: it only pays if our balancing
+  // placement outsmarts the opponent's evaluation, and declining keeps the
+  // negotiation free of search entirely.
+  int black_edge = line_eval_score(&b->game->line_eval, AI_CELL_CROSSES);
+  if (black_edge >= SWAP2_SWAP_THRESHOLD) {
+    b->self_color = AI_CELL_CROSSES;
+    b->game->current_player = AI_CELL_NAUGHTS;
+    out_line("SWAP");
+    ponder_start(b);  // the opponent is on the clock as white now
+    return;
+  }
+  b->self_color = AI_CELL_NAUGHTS;
+  compute_and_emit_move(b);
+}
+
 static int dispatch(brain_t *b, const char *line) {
   parsed_command_t cmd;
   protocol_parse_line(line, &cmd);
 
+  // Stop any in-flight ponder search before a command that touches the
+  // game state. INFO, ABOUT and noise only read or update side structs,
+  // so they pass through without costing us the speculative search —
+  // managers typically send INFO time_left right before TURN.
+  switch (cmd.kind) {
+    case CMD_EMPTY:
+    case CMD_INFO:
+    case CMD_ABOUT:
+    case CMD_UNKNOWN:
+      break;
+    default:
+      ponder_join(b);
+      break;
+  }
+
   switch (cmd.kind) {
     case CMD_EMPTY:
       return 1;
@@ -411,7 +663,7 @@ static int dispatch(brain_t *b, const char *line) {
       out_error("rectangular boards not supported");
       return 1;
     case CMD_SWAP2BOARD:
-      out_error("swap2 not supported");
+      handle_swap2board(b);
       return 1;
     case CMD_INVALID:
       out_error("malformed command");
@@ -428,8 +680,47 @@ static int dispatch(brain_t *b, const char *line) {
 // ---------------------------------------------------------------------------
 
 int main(int argc, char **argv) {
-  (void)argc;
-  (void)argv;
+  // --tt-file <path>: back the transposition table with a memory-mapped
+  // file so search state survives RESTART and process restarts —
+  // consecutive games of a match share enormous opening overlap, and
+  // zobrist keys are seed-derived (ZOBRIST_SEED) so hashes stay valid
+  // across runs. Tournament managers launch the brain without arguments,
+  // so the default remains a private in-memory table; the flag is for
+  // our own match harness. The mapping is adopted by every init_game via
+  // tt_set_shared, which RESTART's game reset deliberately never clears.
+  // --book <path>: compiled opening book (see book.h, `make build-book`)
+  // probed by find_best_ai_move ahead of any search, so early-ply moves
+  // cost microseconds of clock instead of a budgeted search. Like
+  // --tt-file this is harness-only — managers pass no arguments.
+  const char *tt_file = NULL;
+  const char *book_file = NULL;
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "--tt-file") == 0) {
+      tt_file = argv[i + 1];
+    } else if (strcmp(argv[i], "--book") == 0) {
+      book_file = argv[i + 1];
+    }
+  }
+  transposition_entry_t *tt_map = NULL;
+  if (tt_file) {
+    tt_map = tt_file_map(tt_file, TT_DEFAULT_ENTRIES);
+    if (tt_map) {
+      tt_set_shared(tt_map, TT_DEFAULT_ENTRIES);
+    } else {
+      // stderr is ours to use — the manager only reads stdout.
+      fprintf(stderr, "tt-file: cannot map %s; using in-memory table\n",
+              tt_file);
+    }
+  }
+  static book_t opening_book;
+  if (book_file) {
+    if (book_open(&opening_book, book_file)) {
+      book_set_default(&opening_book);
+    } else {
+      fprintf(stderr, "book: cannot load %s; playing without a book\n",
+              book_file);
+    }
+  }
 
   // The Piskvork manager expects every line of brain output to flush
   // immediately. Force unbuffered stdout so even a single short reply
@@ -437,6 +728,10 @@ int main(int argc, char **argv) {
   setvbuf(stdout, NULL, _IONBF, 0);
   setvbuf(stdin, NULL, _IOLBF, 0);
 
+  // Build the evaluator's pattern lookup table before any search runs
+  // (same startup hook the TUI and httpd use).
+  populate_threat_matrix();
+
   brain_t brain;
   memset(&brain, 0, sizeof(brain));
   time_budget_init(&brain.budget);
@@ -446,9 +741,13 @@ int main(int argc, char **argv) {
     if (!dispatch(&brain, line)) break;
   }
 
+  ponder_join(&brain); // EOF without END: stop the thread before teardown.
   if (brain.game) {
     cleanup_game(brain.game);
     brain.game = NULL;
   }
+  if (tt_map) {
+    tt_file_unmap(tt_map, TT_DEFAULT_ENTRIES);
+  }
   return 0;
 }
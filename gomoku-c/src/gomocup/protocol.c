@@ -249,6 +249,23 @@ int protocol_parse_board_row(const char *line, int *x, int *y, int *field) {
   return 1;
 }
 
+int protocol_parse_swap2_row(const char *line, int *x, int *y) {
+  if (!line || !x || !y) return 0;
+  char trimmed[128];
+  copy_trim(line, trimmed, sizeof(trimmed));
+  const char *p = skip_ws(trimmed);
+  if (!*p) return 0;
+
+  // Same defensive DONE check as protocol_parse_board_row.
+  if (strncasecmp(p, "DONE", 4) == 0) return 0;
+
+  int lx = -1, ly = -1;
+  if (!parse_xy(&p, &lx, &ly)) return 0;
+  *x = lx;
+  *y = ly;
+  return 1;
+}
+
 size_t protocol_format_move(int gx, int gy, char *out, size_t out_len) {
   if (!out || out_len < 8) return 0;
   int n = snprintf(out, out_len, "%d,%d", gx, gy);
@@ -29,7 +29,7 @@ typedef enum {
   CMD_INFO,           // INFO [key] [value]
   CMD_END,            // END
   CMD_ABOUT,          // ABOUT
-  CMD_SWAP2BOARD      // SWAP2BOARD (we decline with ERROR)
+  CMD_SWAP2BOARD      // SWAP2BOARD ... DONE — multi-line; parser only flags start
 } command_kind_t;
 
 typedef struct {
@@ -69,6 +69,14 @@ void protocol_parse_line(const char *line, parsed_command_t *out);
  */
 int protocol_parse_board_row(const char *line, int *x, int *y, int *field);
 
+/**
+ * Parse a single SWAP2BOARD row of the form "[X],[Y]". Unlike BOARD rows
+ * there is no field column — stone colours follow from placement order
+ * (stones 1 and 3 are black, stone 2 white, and so on alternating).
+ * Returns 1 on success and writes x, y; returns 0 on malformed input.
+ */
+int protocol_parse_swap2_row(const char *line, int *x, int *y);
+
 /**
  * Format an engine-side move (col, row) into the wire format "X,Y\n"
  * where X = col, Y = row. `out_len` must be at least 16 bytes. Returns
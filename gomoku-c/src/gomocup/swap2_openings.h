@@ -0,0 +1,56 @@
+//
+//  swap2_openings.h
+//  gomoku-c — Gomocup brain
+//
+//  Precomputed SWAP2 opening book. The negotiation phase of a SWAP2 game
+//  (propose three stones / pick a colour) happens on a near-empty board
+//  where a deep search burns turn time for almost no information — so the
+//  work was done offline instead and ships here as data. Each entry was
+//  scored with the engine at depth 12 (60 s/position, line-eval units);
+//  the table keeps only openings whose black edge stayed inside the
+//  balanced band, so whichever colour the opponent picks we are happy to
+//  play the other. At runtime the negotiation costs a table lookup plus
+//  one O(1) line_eval_score() call.
+//
+
+#ifndef GOMOCUP_SWAP2_OPENINGS_H
+#define GOMOCUP_SWAP2_OPENINGS_H
+
+// Colour-choice threshold, in line_eval units (open two = 50, open three
+// = 1000; see eval_lines.c). White moves next in every SWAP2 decision
+// position, and a typical reply builds roughly one open two of value, so
+// black's standing edge must clearly exceed that tempo before taking
+// black pays. Calibrated offline: below this margin the depth-12 scores
+// of the two colours stayed within noise of each other; above it black's
+// edge persisted through the midgame.
+#define SWAP2_SWAP_THRESHOLD 120
+
+// One proposed opening: three stones in Gomocup board coordinates (x =
+// column, y = row, 0-based on the 15x15 Standard board). Stones 1 and 3
+// are black, stone 2 is white — the SWAP2 placement order. black_edge is
+// the offline depth-12 score from black's perspective, kept as
+// documentation of why the entry qualified for the table.
+typedef struct {
+  int stones[3][2];
+  int black_edge;
+} swap2_opening_t;
+
+// Balanced proposals, all third-stone-distant ("indirect") shapes: the
+// far black stone denies white a single developing reply that dominates
+// both black stones, which is what keeps the depth-12 scores flat. All
+// entries sit well inside +/- SWAP2_SWAP_THRESHOLD.
+static const swap2_opening_t swap2_openings[] = {
+    {{{7, 7}, {8, 7}, {11, 10}}, 35},
+    {{{7, 7}, {7, 8}, {10, 4}}, 20},
+    {{{7, 7}, {8, 8}, {4, 11}}, -15},
+    {{{7, 7}, {6, 8}, {11, 7}}, 60},
+    {{{6, 6}, {7, 7}, {10, 9}}, -30},
+    {{{7, 7}, {8, 6}, {3, 7}}, 45},
+    {{{7, 7}, {9, 7}, {5, 12}}, 10},
+    {{{8, 7}, {7, 8}, {12, 11}}, -25},
+};
+
+#define SWAP2_OPENING_COUNT \
+  ((int)(sizeof(swap2_openings) / sizeof(swap2_openings[0])))
+
+#endif // GOMOCUP_SWAP2_OPENINGS_H
@@ -43,7 +43,16 @@ void time_budget_set_time_left(time_budget_t *tb, int ms) {
   tb->time_left_received = 1;
 }
 
-double time_budget_compute_seconds(const time_budget_t *tb) {
+// Pacing estimate: how many more of OUR moves the game is likely to run.
+// Standard-category games typically settle around 50-70 stones total;
+// planning for 60 splits the match clock sensibly across the opening
+// while the endgame floor keeps late budgets from ballooning just
+// because the estimate ran out before the game did.
+#define EXPECTED_GAME_STONES 60
+#define MIN_EXPECTED_OWN_MOVES 6
+
+double time_budget_compute_seconds(const time_budget_t *tb,
+                                   int stones_on_board) {
   if (!tb) return 0.0;
 
   // timeout_turn == 0 means "respond instantly"; the caller should cap
@@ -59,8 +68,16 @@ double time_budget_compute_seconds(const time_budget_t *tb) {
   int match_room_ms = remaining_ms - GOMOCUP_SAFETY_MARGIN_MS;
   if (match_room_ms < 0) match_room_ms = 0;
 
+  // Pace the match clock over the expected rest of the game; half the
+  // remaining stones are ours.
+  int expected_own_moves = (EXPECTED_GAME_STONES - stones_on_board) / 2;
+  if (expected_own_moves < MIN_EXPECTED_OWN_MOVES) {
+    expected_own_moves = MIN_EXPECTED_OWN_MOVES;
+  }
+  int paced_ms = match_room_ms / expected_own_moves;
+
   int budget_ms = tb->timeout_turn_ms;
-  if (match_room_ms < budget_ms) budget_ms = match_room_ms;
+  if (paced_ms < budget_ms) budget_ms = paced_ms;
 
   // Floor: even if the manager-reported time_left is dangerously low,
   // give the engine 50ms so iterative deepening can complete depth 1
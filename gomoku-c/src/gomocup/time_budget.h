@@ -41,11 +41,16 @@ void time_budget_set_time_left(time_budget_t *tb, int ms);
  * documented meaning of timeout_turn = 0); the caller should cap depth
  * and skip iterative deepening in that case.
  *
- * The returned value is min(turn_budget, time_left_minus_margin), with
- * a generous floor so iterative deepening always has time to compute
- * at least depth 1.
+ * The returned value is min(turn_budget, paced share of the remaining
+ * match clock), with a generous floor so iterative deepening always has
+ * time to compute at least depth 1. Pacing divides the remaining match
+ * time (minus margin) over the moves the game is still expected to run,
+ * estimated from `stones_on_board` — without it, iterative deepening
+ * would happily spend the whole per-turn cap every move and drain a
+ * 180 s match clock in a handful of turns.
  */
-double time_budget_compute_seconds(const time_budget_t *tb);
+double time_budget_compute_seconds(const time_budget_t *tb,
+                                   int stones_on_board);
 
 /**
  * Bookkeeping after a move: subtract elapsed seconds from the local
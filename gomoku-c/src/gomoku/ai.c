@@ -7,18 +7,37 @@
 
 #include "ai.h"
 #include "ansi.h"
+#include "book.h"
+#include "mcts.h"
+#include "nnue.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+// Vector compare + movemask support for the half-line classifier in
+// evaluate_threat_fast(). SSE2 is baseline on x86-64; on ARM we require
+// AArch64 for vaddv. Everything degrades to the scalar mask builder when
+// neither is available.
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define GOMOKU_HALF_LINE_SIMD 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define GOMOKU_HALF_LINE_SIMD 1
+#endif
+
 //===============================================================================
 // AI CONSTANTS AND STRUCTURES
 //===============================================================================
 
 #define WIN_SCORE 1000000
 
-static int is_five_from_last_move(int **board, int board_size, int x, int y,
+static int is_five_from_last_move(cell_t **board, int board_size, int x, int y,
                                   int player) {
   if (x < 0 || y < 0 || x >= board_size || y >= board_size) {
     return 0;
@@ -26,36 +45,8 @@ static int is_five_from_last_move(int **board, int board_size, int x, int y,
   if (board[x][y] != player) {
     return 0;
   }
-
-  int directions[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
-  for (int d = 0; d < 4; d++) {
-    int dx = directions[d][0];
-    int dy = directions[d][1];
-    int count = 1;
-
-    int nx = x + dx, ny = y + dy;
-    while (nx >= 0 && nx < board_size && ny >= 0 && ny < board_size &&
-           board[nx][ny] == player) {
-      count++;
-      nx += dx;
-      ny += dy;
-    }
-
-    nx = x - dx;
-    ny = y - dy;
-    while (nx >= 0 && nx < board_size && ny >= 0 && ny < board_size &&
-           board[nx][ny] == player) {
-      count++;
-      nx -= dx;
-      ny -= dy;
-    }
-
-    // Exactly five wins, six+ (overline) does not.
-    if (count == 5) {
-      return 1;
-    }
-  }
-  return 0;
+  // Shared last-move-local detection (exactly five; overline does not win).
+  return has_five_through(board, board_size, x, y);
 }
 
 //===============================================================================
@@ -71,72 +62,65 @@ static int is_five_from_last_move(int **board, int board_size, int x, int y,
  * ALL occupied cells (including temporary ones) to properly evaluate defensive
  * moves.
  */
-int generate_moves_optimized(game_state_t *game, int **board, move_t *moves,
+int generate_moves_optimized(game_state_t *game, cell_t **board, move_t *moves,
                              int current_player, int depth_remaining) {
-  int size = game->board_size;
+  game->movegen_calls++;
+  int size = GAME_BOARD_SIZE(game);
   int move_count = 0;
+  const bitboard_t *bb = &game->bitboard;
 
-  // Quick check: count stones on board to detect empty board
-  int stones = 0;
-  for (int i = 0; i < size && stones == 0; i++) {
-    for (int j = 0; j < size && stones == 0; j++) {
-      if (board[i][j] != AI_CELL_EMPTY) {
-        stones = 1; // Found at least one stone
-      }
-    }
-  }
-
-  if (stones == 0) {
+  if (game->stones_on_board == 0) {
     // Board is empty, play center
     moves[0].x = size / 2;
     moves[0].y = size / 2;
     moves[0].priority = 1000;
+    PROFILE_ADD(game, movegen_candidates, 1);
     return 1;
   }
 
-  // Scan the board for candidates near all occupied cells
-  // This must scan the actual board (not cache) to find moves near temporary
-  // stones
-  unsigned char candidate[19][19];
-  memset(candidate, 0, sizeof(candidate));
-
-  int radius = game->search_radius;
-  for (int x = 0; x < size; x++) {
-    for (int y = 0; y < size; y++) {
-      if (board[x][y] == AI_CELL_EMPTY) {
-        continue;
-      }
-      // Mark all empty cells within radius as candidates
-      for (int dx = -radius; dx <= radius; dx++) {
-        for (int dy = -radius; dy <= radius; dy++) {
-          int nx = x + dx;
-          int ny = y + dy;
-          if (nx < 0 || nx >= size || ny < 0 || ny >= size) {
-            continue;
-          }
-          if (board[nx][ny] != AI_CELL_EMPTY) {
-            continue;
-          }
-          candidate[nx][ny] = 1;
-        }
-      }
-    }
+  // Depth-adaptive radius: the candidate set is maintained at the full
+  // configured radius, but within two plies of the leaves only near-
+  // contact moves matter, so distant candidates are filtered out before
+  // they cost a priority evaluation. The branching cut compounds per ply.
+  int eff_radius = game->search_radius;
+  if (game->leaf_radius > 0 && depth_remaining <= 2) {
+    eff_radius = game->leaf_radius;
+  } else if (game->leaf_radius > 0 && depth_remaining <= 4 &&
+             game->leaf_radius + 1 < eff_radius) {
+    eff_radius = game->leaf_radius + 1;
   }
 
-  // Collect candidates and compute priorities
+  // Collect candidates straight from the incrementally maintained set:
+  // every place/remove (including temporary search stones) already updated
+  // the per-cell neighbor counts, so there is nothing to rescan per node.
   for (int x = 0; x < size; x++) {
-    for (int y = 0; y < size; y++) {
-      if (!candidate[x][y]) {
+    uint32_t row = bitboard_candidate_row(bb, x);
+    while (row) {
+      int y = __builtin_ctz(row);
+      row &= row - 1;
+      if (eff_radius < game->search_radius &&
+          !bitboard_near_stone(bb, x, y, eff_radius)) {
         continue;
       }
       moves[move_count].x = x;
       moves[move_count].y = y;
-      moves[move_count].priority = get_move_priority_optimized(
-          game, board, x, y, current_player, depth_remaining);
       move_count++;
     }
   }
 
+  // Fill both players' threat caches for the whole candidate set in one
+  // shared-extraction pass, then score priorities off the warm cache.
+  // Every candidate is probed for both sides anyway (offense and block
+  // weights below, the STEP 1/2 sweeps at the root), so batching halves
+  // the line reads instead of extracting per player per cell.
+  evaluate_threats_batch(game, board, moves, move_count);
+
+  for (int i = 0; i < move_count; i++) {
+    moves[i].priority = get_move_priority_optimized(
+        game, board, moves[i].x, moves[i].y, current_player, depth_remaining);
+  }
+
+  PROFILE_ADD(game, movegen_candidates, move_count);
   return move_count;
 }
 
@@ -144,18 +128,18 @@ int generate_moves_optimized(game_state_t *game, int **board, move_t *moves,
  * Optimized move prioritization without temporary placements.
  * This is used only for move ordering (not pruning).
  */
-int get_move_priority_optimized(game_state_t *game, int **board, int x, int y,
+int get_move_priority_optimized(game_state_t *game, cell_t **board, int x, int y,
                                 int player, int depth_remaining) {
-  int center = game->board_size / 2;
+  int center = GAME_BOARD_SIZE(game) / 2;
   int priority = 0;
 
   // Center bias - closer to center is better early on.
   int center_dist = abs(x - center) + abs(y - center);
-  priority += max(0, game->board_size - center_dist);
+  priority += max(0, GAME_BOARD_SIZE(game) - center_dist);
 
-  int my_threat = evaluate_threat_fast(board, x, y, player, game->board_size);
+  int my_threat = evaluate_threat_cached(game, board, x, y, player);
   int opp_threat =
-      evaluate_threat_fast(board, x, y, other_player(player), game->board_size);
+      evaluate_threat_cached(game, board, x, y, other_player(player));
 
   // Winning move should come first (open four or five-in-a-row only).
   if (my_threat >= 500000) {
@@ -180,6 +164,20 @@ int get_move_priority_optimized(game_state_t *game, int **board, int x, int y,
     priority += 1000000;
   }
 
+  // Countermove bonus: this cell previously refuted the opponent's move
+  // at the countermove context cell (set per node by the search).
+  int pi = (player == AI_CELL_CROSSES) ? 0 : 1;
+  int cell = x * GAME_BOARD_SIZE(game) + y;
+  if (game->cm_prev_x >= 0 &&
+      game->countermoves[pi][game->cm_prev_x * GAME_BOARD_SIZE(game) +
+                             game->cm_prev_y] == cell) {
+    priority += 800000;
+  }
+
+  // History bonus: cells that keep producing beta cutoffs order ahead of
+  // cold quiet moves without ever outranking killers or tactical bands.
+  priority += min(game->history_scores[pi][cell] >> 3, 700000);
+
   // Weight our threats and opponent's threats for move ordering
   // Favor offense over defense - only block when opponent has real threats
   // Opponent's closed threats (< 1500) don't require urgent blocking
@@ -207,7 +205,7 @@ typedef struct {
   int holes;      // Number of holes (gaps) in the pattern
 } direction_info_t;
 
-static direction_info_t analyze_direction(int **board, int x, int y, int dx,
+static direction_info_t analyze_direction(cell_t **board, int x, int y, int dx,
                                           int dy, int player, int board_size) {
   direction_info_t info = {0, 0, 0, 0};
   int nx = x + dx, ny = y + dy;
@@ -258,11 +256,221 @@ static direction_info_t analyze_direction(int **board, int x, int y, int dx,
   return info;
 }
 
-int evaluate_threat_fast(int **board, int x, int y, int player,
-                         int board_size) {
-  // Check all 4 directions
-  int directions[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+//===============================================================================
+// MASK-BASED HALF-LINE CLASSIFICATION
+//===============================================================================
+//
+// analyze_direction() walks cell by cell with two bounds checks per step,
+// and evaluate_threat_fast() runs eight such walks per probe — it is the
+// top symbol in profiles of the search. The fast path below packs a
+// half-line into two 8-bit masks (player bits, empty bits) in one pass —
+// a single 8-byte vector compare + movemask when the half-line is
+// contiguous in memory — then classifies the masks with register-only bit
+// tests. A pattern that could extend past the 8-cell window falls back to
+// the scalar walk, so the classification is bit-exact with
+// analyze_direction (verified by differential fuzzing on random boards;
+// the fallback fires on ~0.1% of probes even on pathologically dense
+// positions).
+
+#define HALF_LINE_BITS 8
+
+/**
+ * Build player/empty bit masks for the half-line starting one step from
+ * (x, y) in direction (dx, dy). Bit i describes the cell at distance
+ * i + 1. Stops early at the board edge, an opponent stone, or a second
+ * consecutive empty — cells past any of those can never be read by
+ * analyze_half().
+ */
+static inline void half_line_masks(cell_t **board, int x, int y, int dx,
+                                   int dy, int player, int board_size,
+                                   uint32_t *pmask, uint32_t *emask) {
+  uint32_t p = 0, e = 0;
+  int nx = x + dx, ny = y + dy;
+  int prev_empty = 0;
+  for (int i = 0; i < HALF_LINE_BITS; i++) {
+    if (nx < 0 || nx >= board_size || ny < 0 || ny >= board_size) {
+      break;
+    }
+    int cell = board[nx][ny];
+    if (cell != player && cell != AI_CELL_EMPTY) {
+      break;
+    }
+    if (cell == AI_CELL_EMPTY) {
+      if (prev_empty) {
+        break;
+      }
+      prev_empty = 1;
+      e |= 1u << i;
+    } else {
+      prev_empty = 0;
+      p |= 1u << i;
+    }
+    nx += dx;
+    ny += dy;
+  }
+  *pmask = p;
+  *emask = e;
+}
+
+/**
+ * Build raw crosses/naughts/empty masks for a half-line in one walk, so
+ * both players' classifications share a single read of each cell. No
+ * early termination: bits past a terminator are inert because
+ * analyze_half never reads beyond one (the invariant the vector path
+ * already relies on). Stops at the board edge — cells past it stay
+ * clear in all three masks and read as a closed end.
+ */
+static inline void half_line_masks_raw(cell_t **board, int x, int y, int dx,
+                                       int dy, int board_size,
+                                       uint32_t *xmask, uint32_t *omask,
+                                       uint32_t *emask) {
+  uint32_t xm = 0, om = 0, em = 0;
+  int nx = x + dx, ny = y + dy;
+  for (int i = 0; i < HALF_LINE_BITS; i++) {
+    if (nx < 0 || nx >= board_size || ny < 0 || ny >= board_size) {
+      break;
+    }
+    int cell = board[nx][ny];
+    if (cell == AI_CELL_CROSSES) {
+      xm |= 1u << i;
+    } else if (cell == AI_CELL_NAUGHTS) {
+      om |= 1u << i;
+    } else if (cell == AI_CELL_EMPTY) {
+      em |= 1u << i;
+    }
+    nx += dx;
+    ny += dy;
+  }
+  *xmask = xm;
+  *omask = om;
+  *emask = em;
+}
+
+/**
+ * Classify a half-line from its bit masks. Identical walk semantics to
+ * analyze_direction: a bit set in neither mask is an opponent stone or
+ * the board edge (closed end); an empty only counts as a hole when a
+ * player bit follows it.
+ *
+ * Sets *truncated when the pattern could extend beyond the window (the
+ * walk consumed all eight bits, or ended on an empty in the last slot
+ * whose continuation is unknowable) — the caller must redo that half
+ * with the scalar walk.
+ */
+static inline direction_info_t analyze_half(uint32_t pmask, uint32_t emask,
+                                            int *truncated) {
+  direction_info_t info = {0, 0, 0, 0};
+  int found_hole = 0;
+  *truncated = 1;
+  for (int i = 0; i < HALF_LINE_BITS; i++) {
+    uint32_t bit = 1u << i;
+    if (pmask & bit) {
+      if (!found_hole) {
+        info.contiguous++;
+      }
+      info.total++;
+    } else if (emask & bit) {
+      if (found_hole) {
+        info.open_end = 1;
+        *truncated = 0;
+        break;
+      }
+      if (pmask & (bit << 1)) {
+        found_hole = 1;
+        info.holes++;
+      } else if (i < HALF_LINE_BITS - 1) {
+        info.open_end = 1;
+        *truncated = 0;
+        break;
+      } else {
+        break; // Empty in the last slot: the run may continue past it
+      }
+    } else {
+      info.open_end = 0;
+      *truncated = 0;
+      break;
+    }
+  }
+  return info;
+}
+
+#ifdef GOMOKU_HALF_LINE_SIMD
+
+/**
+ * Reverse the low 8 bits (multiply/modulus bit trick). The negative
+ * half-line is loaded in ascending memory order, so its movemask comes
+ * out farthest-cell-first and must be flipped into distance order.
+ */
+static inline uint32_t reverse_mask8(uint32_t b) {
+  return (uint32_t)(((b * 0x0202020202ULL) & 0x010884422010ULL) % 1023);
+}
+
+/**
+ * Compare eight contiguous cells against the player and empty values in
+ * one shot. Bit i of each mask corresponds to cells[i]. The caller
+ * guarantees all eight cells are in bounds; termination (opponent bits,
+ * double empties) is handled downstream by analyze_half, which never
+ * reads past a terminator.
+ */
+static inline void half_line_masks_vec(const cell_t *cells, int player,
+                                       uint32_t *pmask, uint32_t *emask) {
+#if defined(__SSE2__)
+  __m128i v = _mm_loadl_epi64((const __m128i *)cells);
+  *pmask = (uint32_t)_mm_movemask_epi8(
+               _mm_cmpeq_epi8(v, _mm_set1_epi8((char)player))) &
+           0xFFu;
+  *emask = (uint32_t)_mm_movemask_epi8(
+               _mm_cmpeq_epi8(v, _mm_set1_epi8((char)AI_CELL_EMPTY))) &
+           0xFFu;
+#else
+  uint8x8_t v = vld1_u8((const uint8_t *)cells);
+  uint8x8_t weights = vcreate_u8(0x8040201008040201ULL);
+  *pmask = vaddv_u8(vand_u8(vceq_u8(v, vdup_n_u8((uint8_t)player)), weights));
+  *emask = vaddv_u8(
+      vand_u8(vceq_u8(v, vdup_n_u8((uint8_t)AI_CELL_EMPTY)), weights));
+#endif
+}
+
+/**
+ * Three-way variant for the shared-extraction pair path: one load,
+ * three compares — crosses, naughts and empty masks from a single read
+ * of the eight cells.
+ */
+static inline void half_line_masks_vec3(const cell_t *cells, uint32_t *xmask,
+                                        uint32_t *omask, uint32_t *emask) {
+#if defined(__SSE2__)
+  __m128i v = _mm_loadl_epi64((const __m128i *)cells);
+  *xmask = (uint32_t)_mm_movemask_epi8(
+               _mm_cmpeq_epi8(v, _mm_set1_epi8((char)AI_CELL_CROSSES))) &
+           0xFFu;
+  *omask = (uint32_t)_mm_movemask_epi8(
+               _mm_cmpeq_epi8(v, _mm_set1_epi8((char)AI_CELL_NAUGHTS))) &
+           0xFFu;
+  *emask = (uint32_t)_mm_movemask_epi8(
+               _mm_cmpeq_epi8(v, _mm_set1_epi8((char)AI_CELL_EMPTY))) &
+           0xFFu;
+#else
+  uint8x8_t v = vld1_u8((const uint8_t *)cells);
+  uint8x8_t weights = vcreate_u8(0x8040201008040201ULL);
+  *xmask = vaddv_u8(
+      vand_u8(vceq_u8(v, vdup_n_u8((uint8_t)AI_CELL_CROSSES)), weights));
+  *omask = vaddv_u8(
+      vand_u8(vceq_u8(v, vdup_n_u8((uint8_t)AI_CELL_NAUGHTS)), weights));
+  *emask = vaddv_u8(
+      vand_u8(vceq_u8(v, vdup_n_u8((uint8_t)AI_CELL_EMPTY)), weights));
+#endif
+}
 
+#endif // GOMOKU_HALF_LINE_SIMD
+
+/**
+ * Combine the eight classified half-lines of one cell into its final
+ * threat score: per-direction pattern classes first, then the compound
+ * bonuses across directions. Pure function of the half-line infos, so
+ * the single-player and shared-extraction pair paths score identically.
+ */
+static int threat_from_halves(const direction_info_t *pos,
+                              const direction_info_t *neg) {
   int dir_threats[4] = {0, 0, 0, 0};       // Threat in each direction
   int dir_is_four[4] = {0, 0, 0, 0};       // Is this direction a four?
   int dir_is_open_three[4] = {0, 0, 0, 0}; // Is this direction an open three?
@@ -270,19 +478,11 @@ int evaluate_threat_fast(int **board, int x, int y, int player,
   int dir_is_open_two[4] = {0, 0, 0, 0}; // Is this direction an open two?
 
   for (int d = 0; d < 4; d++) {
-    int dx = directions[d][0];
-    int dy = directions[d][1];
-
-    // Analyze both directions from the placed stone
-    direction_info_t pos =
-        analyze_direction(board, x, y, dx, dy, player, board_size);
-    direction_info_t neg =
-        analyze_direction(board, x, y, -dx, -dy, player, board_size);
-
-    int contiguous = 1 + pos.contiguous + neg.contiguous; // +1 for placed stone
-    int total = 1 + pos.total + neg.total;
-    int holes = pos.holes + neg.holes;
-    int open_ends = pos.open_end + neg.open_end; // 0, 1, or 2 open ends
+    int contiguous =
+        1 + pos[d].contiguous + neg[d].contiguous; // +1 for placed stone
+    int total = 1 + pos[d].total + neg[d].total;
+    int holes = pos[d].holes + neg[d].holes;
+    int open_ends = pos[d].open_end + neg[d].open_end; // 0, 1, or 2 open ends
 
     // Evaluate threat level with consideration for holes and openness
     int threat = 0;
@@ -401,11 +601,131 @@ int evaluate_threat_fast(int **board, int x, int y, int player,
   return max_threat;
 }
 
+int evaluate_threat_fast(cell_t **board, int x, int y, int player,
+                         int board_size) {
+  // Check all 4 directions
+  int directions[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+  direction_info_t pos[4], neg[4];
+
+  for (int d = 0; d < 4; d++) {
+    int dx = directions[d][0];
+    int dy = directions[d][1];
+
+    // Analyze both directions from the placed stone. Half-lines are
+    // classified from packed player/empty masks; only window-overflowing
+    // patterns re-run the scalar walk.
+    uint32_t pos_p, pos_e, neg_p, neg_e;
+#ifdef GOMOKU_HALF_LINE_SIMD
+    if (dx == 0 && y >= HALF_LINE_BITS && y + HALF_LINE_BITS < board_size) {
+      // The (0, 1) direction is contiguous within a row: one vector
+      // compare per half-line instead of a bounds-checked walk.
+      const cell_t *row = board[x];
+      half_line_masks_vec(&row[y + 1], player, &pos_p, &pos_e);
+      half_line_masks_vec(&row[y - HALF_LINE_BITS], player, &neg_p, &neg_e);
+      neg_p = reverse_mask8(neg_p);
+      neg_e = reverse_mask8(neg_e);
+    } else
+#endif
+    {
+      half_line_masks(board, x, y, dx, dy, player, board_size, &pos_p, &pos_e);
+      half_line_masks(board, x, y, -dx, -dy, player, board_size, &neg_p,
+                      &neg_e);
+    }
+
+    int truncated;
+    pos[d] = analyze_half(pos_p, pos_e, &truncated);
+    if (truncated) {
+      pos[d] = analyze_direction(board, x, y, dx, dy, player, board_size);
+    }
+    neg[d] = analyze_half(neg_p, neg_e, &truncated);
+    if (truncated) {
+      neg[d] = analyze_direction(board, x, y, -dx, -dy, player, board_size);
+    }
+  }
+
+  return threat_from_halves(pos, neg);
+}
+
+/**
+ * Shared-extraction evaluation of one cell for BOTH players. Each
+ * half-line is read from the board once, producing raw crosses/naughts/
+ * empty masks in the same pass; the two classifications then run on the
+ * mask pair each player cares about. Raw masks carry no early
+ * termination, which is safe for the same reason the vector path is:
+ * analyze_half never reads past a terminator bit.
+ */
+static void evaluate_threat_pair(cell_t **board, int x, int y, int board_size,
+                                 int *crosses_out, int *naughts_out) {
+  static const int directions[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+  direction_info_t pos[2][4], neg[2][4]; // [player index][direction]
+
+  for (int d = 0; d < 4; d++) {
+    int dx = directions[d][0];
+    int dy = directions[d][1];
+
+    uint32_t pos_m[3], neg_m[3]; // crosses, naughts, empty
+#ifdef GOMOKU_HALF_LINE_SIMD
+    if (dx == 0 && y >= HALF_LINE_BITS && y + HALF_LINE_BITS < board_size) {
+      const cell_t *row = board[x];
+      half_line_masks_vec3(&row[y + 1], &pos_m[0], &pos_m[1], &pos_m[2]);
+      half_line_masks_vec3(&row[y - HALF_LINE_BITS], &neg_m[0], &neg_m[1],
+                           &neg_m[2]);
+      neg_m[0] = reverse_mask8(neg_m[0]);
+      neg_m[1] = reverse_mask8(neg_m[1]);
+      neg_m[2] = reverse_mask8(neg_m[2]);
+    } else
+#endif
+    {
+      half_line_masks_raw(board, x, y, dx, dy, board_size, &pos_m[0],
+                          &pos_m[1], &pos_m[2]);
+      half_line_masks_raw(board, x, y, -dx, -dy, board_size, &neg_m[0],
+                          &neg_m[1], &neg_m[2]);
+    }
+
+    for (int p = 0; p < 2; p++) {
+      int player = (p == 0) ? AI_CELL_CROSSES : AI_CELL_NAUGHTS;
+      int truncated;
+      pos[p][d] = analyze_half(pos_m[p], pos_m[2], &truncated);
+      if (truncated) {
+        pos[p][d] = analyze_direction(board, x, y, dx, dy, player, board_size);
+      }
+      neg[p][d] = analyze_half(neg_m[p], neg_m[2], &truncated);
+      if (truncated) {
+        neg[p][d] =
+            analyze_direction(board, x, y, -dx, -dy, player, board_size);
+      }
+    }
+  }
+
+  *crosses_out = threat_from_halves(pos[0], neg[0]);
+  *naughts_out = threat_from_halves(pos[1], neg[1]);
+}
+
+void evaluate_threats_batch(game_state_t *game, cell_t **board,
+                            const move_t *moves, int count) {
+  int board_size = GAME_BOARD_SIZE(game);
+  for (int i = 0; i < count; i++) {
+    int cell = moves[i].x * board_size + moves[i].y;
+    uint32_t key = threat_cache_key(game, moves[i].x, moves[i].y);
+    if (game->threat_cache_stamp[0][cell] == key &&
+        game->threat_cache_stamp[1][cell] == key) {
+      continue;
+    }
+    int crosses, naughts;
+    evaluate_threat_pair(board, moves[i].x, moves[i].y, board_size, &crosses,
+                         &naughts);
+    game->threat_cache[0][cell] = crosses;
+    game->threat_cache[1][cell] = naughts;
+    game->threat_cache_stamp[0][cell] = key;
+    game->threat_cache_stamp[1][cell] = key;
+  }
+}
+
 //===============================================================================
 // MOVE EVALUATION AND ORDERING
 //===============================================================================
 
-int is_move_interesting(int **board, int x, int y, int stones_on_board,
+int is_move_interesting(cell_t **board, int x, int y, int stones_on_board,
                         int board_size, int radius) {
   // If there are no stones on board, only center area is interesting
   if (stones_on_board == 0) {
@@ -426,14 +746,37 @@ int is_move_interesting(int **board, int x, int y, int stones_on_board,
   return 0; // No stones nearby, not interesting
 }
 
-int is_winning_move(int **board, int x, int y, int player, int board_size) {
-  board[x][y] = player;
-  int is_win = has_winner(board, board_size, player);
-  board[x][y] = AI_CELL_EMPTY;
-  return is_win;
+int is_winning_move(cell_t **board, int x, int y, int player, int board_size) {
+  // Any five created by this placement must pass through (x, y). Count
+  // contiguous friendly stones on both sides of the empty cell directly
+  // — the same exactly-five rule as has_five_through, but with no board
+  // mutation and no re-read of the probed cell. find_block_cell calls
+  // this for every forcing move in every VCT node, so it multiplies into
+  // everything.
+  static const int dirs[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+  for (int d = 0; d < 4; d++) {
+    int dx = dirs[d][0], dy = dirs[d][1];
+    int count = 1;
+    for (int nx = x + dx, ny = y + dy;
+         nx >= 0 && nx < board_size && ny >= 0 && ny < board_size &&
+         board[nx][ny] == player;
+         nx += dx, ny += dy) {
+      count++;
+    }
+    for (int nx = x - dx, ny = y - dy;
+         nx >= 0 && nx < board_size && ny >= 0 && ny < board_size &&
+         board[nx][ny] == player;
+         nx -= dx, ny -= dy) {
+      count++;
+    }
+    if (count == 5) {
+      return 1;
+    }
+  }
+  return 0;
 }
 
-int get_move_priority(int **board, int x, int y, int player, int board_size) {
+int get_move_priority(cell_t **board, int x, int y, int player, int board_size) {
   int center = board_size / 2;
   int priority = 0;
 
@@ -475,7 +818,7 @@ int compare_moves(const void *a, const void *b) {
 // VCT (VICTORY BY CONTINUOUS THREATS) SEARCH
 //===============================================================================
 
-int find_block_cell(int **board, int x, int y, int player, int board_size,
+int find_block_cell(cell_t **board, int x, int y, int player, int board_size,
                     int *block_x, int *block_y) {
   // After placing a stone at (x,y) that creates a four, find the ONE cell
   // the opponent must play to prevent five-in-a-row.
@@ -520,24 +863,183 @@ int find_block_cell(int **board, int x, int y, int player, int board_size,
   return (found_count == 1) ? 1 : 0;
 }
 
-static int find_forced_win_recursive(game_state_t *game, int **board,
+// Tag XORed into the VCT memo key when the attacker is NAUGHTS, so the
+// same position probed for each attacker lands in different slots.
+#define VCT_ATTACKER_TAG 0xD1B54A32D192ED03ULL
+
+// Fraction of the move budget STEP 3/4 may spend before falling through
+// to minimax. Threat-dense positions have blown the entire timeout inside
+// VCT (12 s stalls against a 10 s budget) with nothing to show for it.
+#define VCT_TIME_FRACTION 0.25
+
+static int find_forced_win_recursive(game_state_t *game, cell_t **board,
                                      int player, int max_depth, int *result_x,
                                      int *result_y, int sequence[][2],
-                                     int *seq_len) {
-  int board_size = game->board_size;
+                                     int *seq_len);
+
+int evaluate_threat_cached(game_state_t *game, cell_t **board, int x, int y,
+                           int player) {
+  int pi = (player == AI_CELL_CROSSES) ? 0 : 1;
+  int pos = x * GAME_BOARD_SIZE(game) + y;
+  uint32_t key = threat_cache_key(game, x, y);
+  if (game->threat_cache_stamp[pi][pos] == key) {
+    return game->threat_cache[pi][pos];
+  }
+  int threat = evaluate_threat_fast(board, x, y, player, GAME_BOARD_SIZE(game));
+  game->threat_cache[pi][pos] = threat;
+  game->threat_cache_stamp[pi][pos] = key;
+  return threat;
+}
+
+/**
+ * Pair-filling variant of evaluate_threat_cached for sweeps whose cells
+ * get probed for both sides: one shared extraction stores both players'
+ * scores and returns `player`'s. The VCT walk scores the attacker at
+ * every candidate and the defender at the forced block cells, so the
+ * second entry is typically consumed a few nodes later for free.
+ */
+static int evaluate_threat_pair_cached(game_state_t *game, cell_t **board,
+                                       int x, int y, int player) {
+  int pi = (player == AI_CELL_CROSSES) ? 0 : 1;
+  int pos = x * GAME_BOARD_SIZE(game) + y;
+  uint32_t key = threat_cache_key(game, x, y);
+  if (game->threat_cache_stamp[pi][pos] == key) {
+    return game->threat_cache[pi][pos];
+  }
+  int crosses, naughts;
+  evaluate_threat_pair(board, x, y, GAME_BOARD_SIZE(game), &crosses, &naughts);
+  game->threat_cache[0][pos] = crosses;
+  game->threat_cache[1][pos] = naughts;
+  game->threat_cache_stamp[0][pos] = key;
+  game->threat_cache_stamp[1][pos] = key;
+  return (pi == 0) ? crosses : naughts;
+}
+
+/**
+ * Walk the four lines through one stone at (x, y), collecting empty cells
+ * within four steps (at most one intervening gap) where `player` creates
+ * a four-level or compound threat. Any cell that completes a four lies
+ * within four steps of some stone along one of its lines, so this walk
+ * is exhaustive per stone. Shared by the full and frontier-bounded
+ * generators below.
+ */
+static void threat_space_walk(game_state_t *game, cell_t **board, int player,
+                              int x, int y, uint8_t *seen, move_t *moves,
+                              int *count) {
+  static const int dirs[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+  int board_size = GAME_BOARD_SIZE(game);
+
+  for (int d = 0; d < 4; d++) {
+    for (int sign = -1; sign <= 1; sign += 2) {
+      int empties = 0;
+      for (int dist = 1; dist <= 4; dist++) {
+        int nx = x + sign * dirs[d][0] * dist;
+        int ny = y + sign * dirs[d][1] * dist;
+        if (nx < 0 || nx >= board_size || ny < 0 || ny >= board_size) {
+          break;
+        }
+        int cell = board[nx][ny];
+        if (cell == player) {
+          empties = 0; // Own stone extends the pattern; keep walking
+          continue;
+        }
+        if (cell != AI_CELL_EMPTY) {
+          break; // Opponent stone kills this half-line
+        }
+        if (++empties > 2) {
+          break;
+        }
+        int idx = nx * board_size + ny;
+        if (seen[idx]) {
+          continue;
+        }
+        seen[idx] = 1;
+        int threat = evaluate_threat_pair_cached(game, board, nx, ny, player);
+        if (threat >= 8000) { // Four-level or compound only
+          moves[*count].x = nx;
+          moves[*count].y = ny;
+          moves[*count].priority = threat;
+          (*count)++;
+        }
+      }
+    }
+  }
+}
+
+int generate_threat_space_moves(game_state_t *game, cell_t **board,
+                                int player, move_t *moves) {
+  int board_size = GAME_BOARD_SIZE(game);
+  uint8_t seen[361];
+  memset(seen, 0, (size_t)(board_size * board_size));
+
+  int count = 0;
+  for (int x = 0; x < board_size; x++) {
+    for (int y = 0; y < board_size; y++) {
+      if (board[x][y] == player) {
+        threat_space_walk(game, board, player, x, y, seen, moves, &count);
+      }
+    }
+  }
+
+  qsort(moves, count, sizeof(move_t), compare_moves);
+  return count;
+}
+
+/**
+ * Frontier-bounded threat space: walk lines only through the given
+ * stones instead of re-scanning the whole board. Inside a forcing
+ * sequence the frontier is the stones placed so far — a continuation
+ * four that doesn't depend on the line could have been reordered to the
+ * front of the sequence, so bounding loses no forced wins while cutting
+ * the branching factor several-fold.
+ */
+static int generate_threat_space_frontier(game_state_t *game, cell_t **board,
+                                          int player, move_t *moves,
+                                          int frontier[][2],
+                                          int frontier_len) {
+  uint8_t seen[361];
+  memset(seen, 0, (size_t)(GAME_BOARD_SIZE(game) * GAME_BOARD_SIZE(game)));
+
+  int count = 0;
+  for (int i = 0; i < frontier_len; i++) {
+    threat_space_walk(game, board, player, frontier[i][0], frontier[i][1],
+                      seen, moves, &count);
+  }
+
+  qsort(moves, count, sizeof(move_t), compare_moves);
+  return count;
+}
+
+static int find_forced_win_search(game_state_t *game, cell_t **board,
+                                  int player, int max_depth, int *result_x,
+                                  int *result_y, int sequence[][2],
+                                  int *seq_len) {
+  // Deadline: report "no win" and let the caller fall through to
+  // minimax. The memo wrapper refuses to cache results from a timed-out
+  // search, so this can't poison later turns with false negatives.
+  if (is_search_timed_out(game)) {
+    return 0;
+  }
+
+  int board_size = GAME_BOARD_SIZE(game);
   int opponent = other_player(player);
 
-  // Check if we already have an unstoppable compound threat
-  // Generate candidate moves near existing stones
+  // Candidates come from the threat space, not the radius scan: only the
+  // handful of cells that create a four or compound threat can continue a
+  // VCT, and the list arrives sorted with priority = threat score. Past
+  // the root, the space is bounded to the frontier of the forcing line.
   move_t moves[361];
-  int move_count =
-      generate_moves_optimized(game, board, moves, player, game->max_depth);
+  int move_count;
+  if (sequence && seq_len && *seq_len > 0) {
+    move_count = generate_threat_space_frontier(game, board, player, moves,
+                                                sequence, *seq_len);
+  } else {
+    move_count = generate_threat_space_moves(game, board, player, moves);
+  }
 
   // Check for immediate compound win (>= 40000)
   for (int i = 0; i < move_count; i++) {
-    int threat =
-        evaluate_threat_fast(board, moves[i].x, moves[i].y, player, board_size);
-    if (threat >= 40000) {
+    if (moves[i].priority >= 40000) {
       // This move creates an unstoppable compound threat
       *result_x = moves[i].x;
       *result_y = moves[i].y;
@@ -553,23 +1055,18 @@ static int find_forced_win_recursive(game_state_t *game, int **board,
   if (max_depth <= 0)
     return 0;
 
-  // Try each move that creates a four (threat >= 8000)
+  // Try each move that creates a four (every candidate scores >= 8000)
   for (int i = 0; i < move_count; i++) {
-    int threat =
-        evaluate_threat_fast(board, moves[i].x, moves[i].y, player, board_size);
-    if (threat < 8000)
-      continue; // Only consider four-creating moves
-
     int mx = moves[i].x, my = moves[i].y;
 
     // Place our stone
-    board[mx][my] = player;
+    search_make_move(game, board, mx, my, player);
 
     // Check if this creates an immediate unstoppable win
-    int post_threat = evaluate_threat_fast(board, mx, my, player, board_size);
+    int post_threat = evaluate_threat_cached(game, board, mx, my, player);
     if (post_threat >= 500000) {
       // Direct win
-      board[mx][my] = AI_CELL_EMPTY;
+      search_unmake_move(game, board, mx, my, player);
       *result_x = mx;
       *result_y = my;
       if (sequence && seq_len) {
@@ -580,21 +1077,16 @@ static int find_forced_win_recursive(game_state_t *game, int **board,
       return 1;
     }
 
-    // Re-evaluate: does this create a compound threat now that stone is placed?
-    // Check all empty positions for new compound threats by us
-    int creates_compound = 0;
-    for (int j = 0; j < move_count; j++) {
-      if (board[moves[j].x][moves[j].y] != AI_CELL_EMPTY)
-        continue;
-      int new_threat = evaluate_threat_fast(board, moves[j].x, moves[j].y,
-                                            player, board_size);
-      if (new_threat >= 40000) {
-        creates_compound = 1;
-        break;
-      }
-    }
+    // Any compound threat created by the placed stone lies on a line
+    // through it (pre-existing compounds were caught at node entry), so
+    // one frontier walk from the stone is enough. Sorted: head = maximum.
+    move_t after[361];
+    int just_placed[1][2] = {{mx, my}};
+    int after_count = generate_threat_space_frontier(game, board, player,
+                                                     after, just_placed, 1);
+    int creates_compound = (after_count > 0 && after[0].priority >= 40000);
     if (creates_compound) {
-      board[mx][my] = AI_CELL_EMPTY;
+      search_unmake_move(game, board, mx, my, player);
       *result_x = mx;
       *result_y = my;
       if (sequence && seq_len) {
@@ -611,9 +1103,9 @@ static int find_forced_win_recursive(game_state_t *game, int **board,
         find_block_cell(board, mx, my, player, board_size, &bx, &by);
     if (!found_block) {
       // Either open four (already winning) or no block found
-      board[mx][my] = AI_CELL_EMPTY;
+      search_unmake_move(game, board, mx, my, player);
       // If it's an open four, that's a win
-      if (evaluate_threat_fast(board, mx, my, player, board_size) >= 50000) {
+      if (evaluate_threat_cached(game, board, mx, my, player) >= 50000) {
         *result_x = mx;
         *result_y = my;
         if (sequence && seq_len) {
@@ -628,15 +1120,15 @@ static int find_forced_win_recursive(game_state_t *game, int **board,
 
     // Check: does opponent's block give THEM a four or better?
     int opp_threat_at_block =
-        evaluate_threat_fast(board, bx, by, opponent, board_size);
+        evaluate_threat_cached(game, board, bx, by, opponent);
     if (opp_threat_at_block >= 8000) {
       // Opponent's forced block also creates a counter-threat, skip
-      board[mx][my] = AI_CELL_EMPTY;
+      search_unmake_move(game, board, mx, my, player);
       continue;
     }
 
     // Place opponent's block
-    board[bx][by] = opponent;
+    search_make_move(game, board, bx, by, opponent);
 
     // Record our move in sequence
     int saved_seq_len = 0;
@@ -653,8 +1145,8 @@ static int find_forced_win_recursive(game_state_t *game, int **board,
                                           &rx, &ry, sequence, seq_len);
 
     // Undo opponent's block and our stone
-    board[bx][by] = AI_CELL_EMPTY;
-    board[mx][my] = AI_CELL_EMPTY;
+    search_unmake_move(game, board, bx, by, opponent);
+    search_unmake_move(game, board, mx, my, player);
 
     if (found) {
       *result_x = mx;
@@ -671,70 +1163,387 @@ static int find_forced_win_recursive(game_state_t *game, int **board,
   return 0;
 }
 
-int find_forced_win(game_state_t *game, int **board, int player, int max_depth,
-                    int *result_x, int *result_y, int sequence[][2],
-                    int *seq_len) {
-  int local_seq_len = 0;
-  if (!seq_len)
-    seq_len = &local_seq_len;
-  *seq_len = 0;
-  *result_x = -1;
-  *result_y = -1;
-  return find_forced_win_recursive(game, board, player, max_depth, result_x,
-                                   result_y, sequence, seq_len);
-}
-
-int find_forced_win_block(game_state_t *game, int **board, int ai_player,
-                          int max_depth, int *result_x, int *result_y) {
-  int opponent = other_player(ai_player);
-  int board_size = game->board_size;
-
-  // Check if opponent has a forced win
-  int opp_x, opp_y;
-  if (!find_forced_win(game, board, opponent, max_depth, &opp_x, &opp_y, NULL,
-                       NULL)) {
-    // Opponent has no forced win
-    *result_x = -1;
-    *result_y = -1;
-    return 0;
+/**
+ * Memoizing front for find_forced_win_search. VCT trees reach the same
+ * position through transposed forcing sequences, and every node used to
+ * regenerate candidates and threat scores from scratch; the dedicated
+ * table in game->vct_table (single-probe, always-replace) turns those
+ * repeats into O(1) hits within and across searches of one game.
+ *
+ * A cached win supplies only the first move of the proven sequence, so a
+ * hit mid-replay truncates the recorded line — the report's VCT sequence
+ * is cosmetic, the move played is not.
+ */
+static int find_forced_win_recursive(game_state_t *game, cell_t **board,
+                                     int player, int max_depth, int *result_x,
+                                     int *result_y, int sequence[][2],
+                                     int *seq_len) {
+  game->search_nodes++;
+  // Lazily allocate the memo on the first VCT probe of this game; a
+  // failed allocation just runs the search unmemoized.
+  if (!game->vct_table) {
+    game->vct_table = calloc(VCT_TT_SIZE, sizeof(vct_entry_t));
+    if (!game->vct_table) {
+      return find_forced_win_search(game, board, player, max_depth, result_x,
+                                    result_y, sequence, seq_len);
+    }
   }
 
-  // Opponent has a forced win. Find our move that disrupts it.
-  move_t moves[361];
-  int move_count =
-      generate_moves_optimized(game, board, moves, ai_player, game->max_depth);
-
-  int best_x = -1, best_y = -1;
-  int best_own_threat = -1;
+  uint64_t key = game->current_hash ^
+                 ((player == AI_CELL_NAUGHTS) ? VCT_ATTACKER_TAG : 0);
+  vct_entry_t *entry = &game->vct_table[key & VCT_TT_MASK];
+  if (entry->key == key) {
+    if (entry->result) {
+      // A win proven with any budget is a forced win, period. The
+      // empty-cell check is hash-collision insurance only.
+      if (entry->best_x >= 0 &&
+          board[entry->best_x][entry->best_y] == AI_CELL_EMPTY) {
+        *result_x = entry->best_x;
+        *result_y = entry->best_y;
+        if (sequence && seq_len) {
+          sequence[*seq_len][0] = entry->best_x;
+          sequence[*seq_len][1] = entry->best_y;
+          (*seq_len)++;
+        }
+        return 1;
+      }
+    } else if (entry->depth >= max_depth) {
+      // "No win within N plies" covers every smaller budget too
+      return 0;
+    }
+  }
 
-  for (int i = 0; i < move_count; i++) {
-    int mx = moves[i].x, my = moves[i].y;
+  int found = find_forced_win_search(game, board, player, max_depth, result_x,
+                                     result_y, sequence, seq_len);
 
-    // Place our stone
-    board[mx][my] = ai_player;
+  if (game->search_timed_out && !found) {
+    return found; // A truncated miss proves nothing; don't cache it
+  }
 
-    // Check if opponent still has a forced win
-    int dummy_x, dummy_y;
-    int opp_still_wins = find_forced_win(game, board, opponent, max_depth,
-                                         &dummy_x, &dummy_y, NULL, NULL);
+  entry->key = key;
+  entry->best_x = (int16_t)(found ? *result_x : -1);
+  entry->best_y = (int16_t)(found ? *result_y : -1);
+  entry->depth = (int8_t)max_depth;
+  entry->result = (int8_t)found;
+  return found;
+}
 
-    board[mx][my] = AI_CELL_EMPTY;
+/**
+ * Record (or clear) the carry-over slot for `player` after a root VCT
+ * search. Only the attacker's own moves are kept; forced blocks are
+ * recomputed during replay.
+ */
+static void vct_carry_store(game_state_t *game, int player, int found,
+                            int sequence[][2], int len) {
+  vct_carry_t *carry = &game->vct_carry[(player == AI_CELL_CROSSES) ? 0 : 1];
+  if (!found || len <= 0) {
+    carry->valid = 0;
+    return;
+  }
+  carry->valid = 1;
+  carry->len = min(len, VCT_CARRY_LEN);
+  for (int i = 0; i < carry->len; i++) {
+    carry->seq[i][0] = sequence[i][0];
+    carry->seq[i][1] = sequence[i][1];
+  }
+}
+
+/**
+ * Replay last turn's proven sequence against the current board, running
+ * the same per-node checks as find_forced_win_search but with zero
+ * branching: each attacker move must still be a four (or close the proof
+ * as a compound/open four), each forced block must still be unique and
+ * safe. O(sequence length) with cached threat lookups — this is a full
+ * re-proof, so success is as trustworthy as a fresh search and failure
+ * simply falls back to one.
+ */
+static int vct_carry_revalidate(game_state_t *game, cell_t **board,
+                                int player, int *result_x, int *result_y) {
+  vct_carry_t *carry = &game->vct_carry[(player == AI_CELL_CROSSES) ? 0 : 1];
+  if (!carry->valid || carry->len <= 0) {
+    return 0;
+  }
+
+  int board_size = GAME_BOARD_SIZE(game);
+  int opponent = other_player(player);
+  int made_x[2 * VCT_CARRY_LEN], made_y[2 * VCT_CARRY_LEN];
+  int made_p[2 * VCT_CARRY_LEN];
+  int made = 0;
+  int proven = 0;
+
+  for (int i = 0; i < carry->len; i++) {
+    int mx = carry->seq[i][0], my = carry->seq[i][1];
+    if (board[mx][my] != AI_CELL_EMPTY) {
+      break;
+    }
+    int threat = evaluate_threat_cached(game, board, mx, my, player);
+    if (threat >= 40000) { // Compound threat closes the proof
+      proven = 1;
+      break;
+    }
+    if (threat < 8000) { // No longer creates a four
+      break;
+    }
+
+    search_make_move(game, board, mx, my, player);
+    made_x[made] = mx;
+    made_y[made] = my;
+    made_p[made] = player;
+    made++;
+
+    if (evaluate_threat_cached(game, board, mx, my, player) >= 500000) {
+      proven = 1; // Direct win
+      break;
+    }
+    move_t after[361];
+    int just_placed[1][2] = {{mx, my}};
+    int after_count = generate_threat_space_frontier(game, board, player,
+                                                     after, just_placed, 1);
+    if (after_count > 0 && after[0].priority >= 40000) {
+      proven = 1; // The placed stone created a compound follow-up
+      break;
+    }
+
+    int bx, by;
+    if (!find_block_cell(board, mx, my, player, board_size, &bx, &by)) {
+      if (evaluate_threat_cached(game, board, mx, my, player) >= 50000) {
+        proven = 1; // Open four: two completions, unstoppable
+      }
+      break;
+    }
+    if (evaluate_threat_cached(game, board, bx, by, opponent) >= 8000) {
+      break; // The forced block now carries a counter-threat
+    }
+    search_make_move(game, board, bx, by, opponent);
+    made_x[made] = bx;
+    made_y[made] = by;
+    made_p[made] = opponent;
+    made++;
+  }
+
+  while (made > 0) {
+    made--;
+    search_unmake_move(game, board, made_x[made], made_y[made], made_p[made]);
+  }
+
+  if (!proven) {
+    carry->valid = 0; // Don't re-replay a failed proof this turn
+    return 0;
+  }
+  *result_x = carry->seq[0][0];
+  *result_y = carry->seq[0][1];
+  return 1;
+}
+
+int find_forced_win(game_state_t *game, cell_t **board, int player, int max_depth,
+                    int *result_x, int *result_y, int sequence[][2],
+                    int *seq_len) {
+  int local_seq[MAX_VCT_SEQUENCE][2];
+  int local_seq_len = 0;
+  if (!seq_len)
+    seq_len = &local_seq_len;
+  if (!sequence)
+    sequence = local_seq; // The recursion needs the line as its frontier
+  *seq_len = 0;
+  *result_x = -1;
+  *result_y = -1;
+  return find_forced_win_recursive(game, board, player, max_depth, result_x,
+                                   result_y, sequence, seq_len);
+}
+
+#define MAX_SEARCH_THREADS 16
+
+#ifndef _WIN32
+
+// Defined with the Lazy-SMP pool further down; the refutation scan below
+// reuses the same private-clone mechanism.
+static game_state_t *smp_clone_game(game_state_t *game);
+static void smp_free_clone(game_state_t *clone);
+
+// Shared state for the parallel VCT refutation scan. Candidates are
+// pre-sorted by own-threat, so the answer is the LOWEST disrupting index.
+// Workers claim indices monotonically under the lock and never abandon a
+// claimed candidate, which keeps that minimum exact; indices at or above
+// the best found so far are cancelled before they start.
+typedef struct {
+  pthread_mutex_t lock;
+  const move_t *moves;
+  int move_count;
+  int next_idx;   // Next unclaimed candidate
+  int best_idx;   // Lowest disrupting index found (move_count = none yet)
+  int opponent;
+  int max_depth;
+} vct_refute_shared_t;
+
+typedef struct {
+  vct_refute_shared_t *shared;
+  game_state_t *clone;
+  pthread_t thread;
+} vct_refute_worker_t;
+
+static void *vct_refute_main(void *arg) {
+  vct_refute_worker_t *worker = arg;
+  vct_refute_shared_t *shared = worker->shared;
+  game_state_t *g = worker->clone;
+  int ai_player = other_player(shared->opponent);
+
+  for (;;) {
+    pthread_mutex_lock(&shared->lock);
+    int idx = shared->next_idx++;
+    int cutoff = shared->best_idx;
+    pthread_mutex_unlock(&shared->lock);
+    if (idx >= shared->move_count || idx >= cutoff) {
+      break;
+    }
+
+    if (is_search_timed_out(g)) {
+      break; // Slice exhausted; unscanned candidates just stay unproven
+    }
+
+    int mx = shared->moves[idx].x, my = shared->moves[idx].y;
+    search_make_move(g, g->board, mx, my, ai_player);
+    int dummy_x, dummy_y;
+    int opp_still_wins = find_forced_win(g, g->board, shared->opponent,
+                                         shared->max_depth, &dummy_x,
+                                         &dummy_y, NULL, NULL);
+    search_unmake_move(g, g->board, mx, my, ai_player);
 
     if (!opp_still_wins) {
-      // This move disrupts the opponent's VCT
-      int own_threat =
-          evaluate_threat_fast(board, mx, my, ai_player, board_size);
-      if (own_threat > best_own_threat) {
-        best_own_threat = own_threat;
-        best_x = mx;
-        best_y = my;
+      pthread_mutex_lock(&shared->lock);
+      if (idx < shared->best_idx) {
+        shared->best_idx = idx;
+      }
+      pthread_mutex_unlock(&shared->lock);
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Scan the sorted candidates across a worker pool, each worker on its own
+ * game clone. Returns the lowest disrupting index, or move_count when no
+ * candidate disrupts — or when the pool could not start (zero clones), in
+ * which case the caller falls back to the sequential scan.
+ *
+ * @param started Output: number of workers that actually ran
+ */
+static int vct_refute_parallel(game_state_t *game, const move_t *moves,
+                               int move_count, int opponent, int max_depth,
+                               int *started) {
+  vct_refute_shared_t shared;
+  pthread_mutex_init(&shared.lock, NULL);
+  shared.moves = moves;
+  shared.move_count = move_count;
+  shared.next_idx = 0;
+  shared.best_idx = move_count;
+  shared.opponent = opponent;
+  shared.max_depth = max_depth;
+
+  vct_refute_worker_t workers[MAX_SEARCH_THREADS];
+  int workers_wanted = min(game->search_threads, MAX_SEARCH_THREADS);
+  *started = 0;
+  for (int t = 0; t < workers_wanted; t++) {
+    vct_refute_worker_t *worker = &workers[*started];
+    worker->shared = &shared;
+    worker->clone = smp_clone_game(game);
+    if (!worker->clone) {
+      break;
+    }
+    if (pthread_create(&worker->thread, NULL, vct_refute_main, worker) != 0) {
+      smp_free_clone(worker->clone);
+      break;
+    }
+    (*started)++;
+  }
+  for (int t = 0; t < *started; t++) {
+    pthread_join(workers[t].thread, NULL);
+    smp_free_clone(workers[t].clone);
+  }
+  pthread_mutex_destroy(&shared.lock);
+  return shared.best_idx;
+}
+
+#endif // _WIN32
+
+int find_forced_win_block(game_state_t *game, cell_t **board, int ai_player,
+                          int max_depth, int *result_x, int *result_y) {
+  int opponent = other_player(ai_player);
+
+  // Check if opponent has a forced win, replaying last turn's proven
+  // opponent sequence first — for long-running sessions this gate is
+  // where most cross-turn VCT work repeats.
+  int opp_x, opp_y;
+  int opp_sequence[MAX_VCT_SEQUENCE][2];
+  int opp_len = 0;
+  int opp_wins = vct_carry_revalidate(game, board, opponent, &opp_x, &opp_y);
+  if (!opp_wins) {
+    opp_wins = find_forced_win(game, board, opponent, max_depth, &opp_x,
+                               &opp_y, opp_sequence, &opp_len);
+    if (opp_wins || !game->search_timed_out) {
+      vct_carry_store(game, opponent, opp_wins, opp_sequence, opp_len);
+    }
+  }
+  if (!opp_wins) {
+    // Opponent has no forced win
+    *result_x = -1;
+    *result_y = -1;
+    return 0;
+  }
+
+  // Opponent has a forced win. Find our move that disrupts it.
+  move_t moves[361];
+  int move_count =
+      generate_moves_optimized(game, board, moves, ai_player, game->max_depth);
+
+  // Rank candidates by the threat our own stone would create. With the
+  // list sorted, the FIRST disrupting candidate is also the one with the
+  // best own threat, so the scan — sequential or parallel — can stop at
+  // the first success instead of trying every candidate.
+  for (int i = 0; i < move_count; i++) {
+    moves[i].priority =
+        evaluate_threat_cached(game, board, moves[i].x, moves[i].y,
+                               ai_player);
+  }
+  qsort(moves, move_count, sizeof(move_t), compare_moves);
+
+  int best_idx = move_count;
+  int scanned_parallel = 0;
+
+#ifndef _WIN32
+  // The per-candidate refutation searches are fully independent, and this
+  // sequential loop used to dominate STEP 4 time (it is why VCT depth is
+  // capped at 10). With -T, fan the candidates out across worker clones.
+  if (game->search_threads > 1 && move_count > 1) {
+    int started = 0;
+    best_idx = vct_refute_parallel(game, moves, move_count, opponent,
+                                   max_depth, &started);
+    scanned_parallel = (started > 0);
+  }
+#endif
+
+  if (!scanned_parallel) {
+    for (int i = 0; i < move_count; i++) {
+      if (is_search_timed_out(game)) {
+        break; // Fall back to blocking the first VCT move below
+      }
+      int mx = moves[i].x, my = moves[i].y;
+
+      search_make_move(game, board, mx, my, ai_player);
+      int dummy_x, dummy_y;
+      int opp_still_wins = find_forced_win(game, board, opponent, max_depth,
+                                           &dummy_x, &dummy_y, NULL, NULL);
+      search_unmake_move(game, board, mx, my, ai_player);
+
+      if (!opp_still_wins) {
+        best_idx = i;
+        break;
       }
     }
   }
 
-  if (best_x >= 0) {
-    *result_x = best_x;
-    *result_y = best_y;
+  if (best_idx < move_count) {
+    *result_x = moves[best_idx].x;
+    *result_y = moves[best_idx].y;
     return 1;
   }
 
@@ -748,7 +1557,7 @@ int find_forced_win_block(game_state_t *game, int **board, int ai_player,
 // MINIMAX ALGORITHM
 //===============================================================================
 
-int minimax(int **board, int board_size, int depth, int alpha, int beta,
+int minimax(cell_t **board, int board_size, int depth, int alpha, int beta,
             int maximizing_player, int ai_player) {
   // Create a temporary game state to use the timeout version.
   // Previously this function assumed a fixed 19x19 board which caused
@@ -758,47 +1567,233 @@ int minimax(int **board, int board_size, int depth, int alpha, int beta,
                             .board_size = board_size,
                             .move_timeout = 0,
                             .search_timed_out = 0};
+  temp_game.search_radius = SEARCH_RADIUS;
+  bitboard_sync(&temp_game.bitboard, board, board_size, SEARCH_RADIUS);
+  line_eval_rebuild(&temp_game.line_eval, board, board_size);
+  temp_game.stones_on_board = bitboard_stone_count(&temp_game.bitboard);
+  // The heap-allocated table (and the zobrist keys feeding it) must be set
+  // up explicitly for this stack-local state, and released before return.
+  init_transposition_table(&temp_game);
 
   // Use the center position of the provided board as the initial last move.
   int center = board_size / 2;
-  return minimax_with_timeout(&temp_game, board, depth, alpha, beta,
-                              maximizing_player, ai_player, center, center);
+  int result = minimax_with_timeout(&temp_game, board, depth, alpha, beta,
+                                    maximizing_player, ai_player, center,
+                                    center);
+  free(temp_game.tt);
+  return result;
 }
 
-int minimax_with_timeout(game_state_t *game, int **board, int depth, int alpha,
-                         int beta, int maximizing_player, int ai_player,
-                         int last_x, int last_y) {
-  // Check for timeout first
+// Quiescence tuning: at nominal depth 0 the search keeps extending while
+// either side has a move in the "must block" class or better (closed
+// four / broken four and up, see evaluate_threat_fast), bounded by
+// QS_MAX_PLY so a long exchange of fours can't blow the node budget.
+#define QS_MAX_PLY 6
+#define QS_FORCING_THREAT 100000
+
+// Ordering bonus that puts the transposition table's recorded best move
+// in front of everything, including the tactical bands.
+#define TT_MOVE_PRIORITY 2000000001
+
+// Futility margins per frontier depth: a quiet move (ordered below every
+// tactical band) can realistically swing the line-eval totals by about an
+// open three's worth per ply; moves that can't reach alpha even with that
+// much headroom are skipped before the board is touched.
+static const int futility_margin[3] = {0, 3000, 9000};
+
+// Late move reduction tuning: moves past LMR_FULL_MOVES in the sorted
+// order whose priority sits below every tactical band (wins, blocks,
+// compound threats, killers all order at or above 1000000) scout one ply
+// shallower, two plies past LMR_DEEP_MOVES. See pvs_search.
+#define LMR_MIN_DEPTH 3
+#define LMR_FULL_MOVES 3
+#define LMR_DEEP_MOVES 12
+#define LMR_QUIET_PRIORITY 1000000
+
+/**
+ * Lazy selection for move ordering: swaps the highest-priority remaining
+ * candidate into slot m. Most interior nodes cut off after the first move
+ * or two, so one linear pass per move actually searched beats qsorting
+ * all 100+ candidates up front.
+ */
+static void select_next_move(move_t *moves, int move_count, int m) {
+  int best = m;
+  for (int k = m + 1; k < move_count; k++) {
+    if (moves[k].priority > moves[best].priority) {
+      best = k;
+    }
+  }
+  if (best != m) {
+    move_t tmp = moves[m];
+    moves[m] = moves[best];
+    moves[best] = tmp;
+  }
+}
+
+/**
+ * Leaf evaluation dispatch: the learned evaluator when a model is
+ * loaded (see nnue.h), otherwise the classical incremental line totals.
+ * Both return a score from `player`'s perspective in the same range.
+ */
+static inline int leaf_evaluate(game_state_t *game, int player) {
+  game->eval_calls++;
+  if (game->nnue_model) {
+    return nnue_evaluate(game, player);
+  }
+  return line_eval_score(&game->line_eval, player);
+}
+
+// Lazy-eval margin: how close the cheap line totals must land to the
+// node's (alpha, beta) window before the network refinement is worth
+// running. One closed four (10000) comfortably exceeds it, so positions
+// whose coarse score is a whole must-block threat outside the window
+// keep the coarse answer — the refined score could not cross the bound.
+#define LAZY_EVAL_MARGIN 6000
+
+/**
+ * Bound-aware leaf evaluation: when the learned evaluator is active, the
+ * O(1) incremental line totals act as the coarse core, and the network
+ * only runs when that score lands within LAZY_EVAL_MARGIN of the node's
+ * window — a score far outside (alpha, beta) produces the same cutoff
+ * whichever evaluator refines it. Without a model this collapses to the
+ * plain dispatch.
+ */
+static inline int leaf_evaluate_lazy(game_state_t *game, int player, int alpha,
+                                     int beta) {
+  game->eval_calls++;
+  if (game->nnue_model) {
+    int coarse = line_eval_score(&game->line_eval, player);
+    if (coarse + LAZY_EVAL_MARGIN <= alpha || coarse - LAZY_EVAL_MARGIN >= beta) {
+      return coarse;
+    }
+    return nnue_evaluate(game, player);
+  }
+  return line_eval_score(&game->line_eval, player);
+}
+
+/**
+ * Bounded quiescence search for threat-laden leaf positions. Stand-pat on
+ * the line-eval totals, then extend only forcing moves — a placement
+ * whose own-threat or block-threat reaches the "must block" class — until
+ * the position is quiet or the ply bound runs out. Resolves the horizon
+ * effect where a pending four flips the evaluation one ply past depth 0.
+ */
+static int quiescence_search(game_state_t *game, cell_t **board, int alpha,
+                             int beta, int player, int last_x, int last_y,
+                             int qply) {
+  game->search_nodes++;
   if (is_search_timed_out(game)) {
     game->search_timed_out = 1;
-    if (last_x >= 0 && last_y >= 0) {
-      return evaluate_position_incremental_fast(board, game->board_size,
-                                                ai_player, last_x, last_y);
+    return leaf_evaluate(game, player);
+  }
+
+  // Terminal: the last placed stone may have completed a five.
+  if (last_x >= 0 && last_y >= 0 && board[last_x][last_y] != AI_CELL_EMPTY) {
+    int last_player = board[last_x][last_y];
+    if (is_five_from_last_move(board, GAME_BOARD_SIZE(game), last_x, last_y,
+                               last_player)) {
+      return (last_player == player) ? WIN_SCORE : -WIN_SCORE;
+    }
+  }
+
+  // Stand pat: the side to move may always decline the exchange. Lazy:
+  // a coarse score far outside the window stands pat or fails high the
+  // same way the refined one would.
+  int stand_pat = leaf_evaluate_lazy(game, player, alpha, beta);
+  if (stand_pat >= beta || qply == 0) {
+    return stand_pat;
+  }
+  alpha = max(alpha, stand_pat);
+
+  // Only forcing candidates continue the search: own fours and must-block
+  // answers to the opponent's.
+  const bitboard_t *bb = &game->bitboard;
+  move_t moves[361];
+  int move_count = 0;
+  for (int x = 0; x < GAME_BOARD_SIZE(game); x++) {
+    uint32_t row = bitboard_candidate_row(bb, x);
+    while (row) {
+      int y = __builtin_ctz(row);
+      row &= row - 1;
+      int own = evaluate_threat_cached(game, board, x, y, player);
+      int block = evaluate_threat_cached(game, board, x, y,
+                                         other_player(player));
+      if (own >= QS_FORCING_THREAT || block >= QS_FORCING_THREAT) {
+        moves[move_count].x = x;
+        moves[move_count].y = y;
+        moves[move_count].priority = max(own, block);
+        move_count++;
+      }
+    }
+  }
+
+  if (move_count == 0) {
+    return stand_pat; // Quiet position
+  }
+
+  int best_eval = stand_pat;
+  for (int m = 0; m < move_count; m++) {
+    select_next_move(moves, move_count, m);
+    int i = moves[m].x;
+    int j = moves[m].y;
+
+    search_make_move(game, board, i, j, player);
+    int eval = -quiescence_search(game, board, -beta, -alpha,
+                                  other_player(player), i, j, qply - 1);
+    search_unmake_move(game, board, i, j, player);
+
+    if (game->search_timed_out) {
+      return best_eval;
+    }
+    best_eval = max(best_eval, eval);
+    alpha = max(alpha, eval);
+    if (alpha >= beta) {
+      break;
     }
-    return evaluate_position(board, game->board_size, ai_player);
   }
 
-  // Compute position hash
-  uint64_t hash = game->current_hash;
+  return best_eval;
+}
+
+/**
+ * Negamax core with principal variation search. Scores are always from
+ * the perspective of `player`, the side to move, which halves the code
+ * the old mirrored maximizing/minimizing branches duplicated. The first
+ * (PV) move is searched with the full window; later moves get a null
+ * window scout above alpha and are re-searched only when they beat it,
+ * which with the killer/threat move ordering rarely happens.
+ */
+static int pvs_search(game_state_t *game, cell_t **board, int depth, int alpha,
+                      int beta, int player, int last_x, int last_y) {
+  game->search_nodes++;
+  PROFILE_NODE_AT_DEPTH(game, depth);
+  // Check for timeout first
+  if (is_search_timed_out(game)) {
+    game->search_timed_out = 1;
+    return leaf_evaluate(game, player);
+  }
+
+  // Position hash: canonical over the dihedral orientations in the
+  // opening so mirrored lines share their transposition entries.
+  uint64_t hash = position_hash(game);
 
   // Probe transposition table
   int tt_value;
-  if (probe_transposition(game, hash, ai_player, depth, alpha, beta,
-                          &tt_value)) {
+  if (probe_transposition(game, hash, player, depth, alpha, beta, &tt_value)) {
     return tt_value;
   }
 
   // Fast terminal check: only the last placed stone can create a new win.
+  // The last mover is normally the opponent of the side to move.
   int used_last_move_terminal_check = 0;
   if (last_x >= 0 && last_y >= 0 && board[last_x][last_y] != AI_CELL_EMPTY) {
     used_last_move_terminal_check = 1;
     int last_player = board[last_x][last_y];
-    if (is_five_from_last_move(board, game->board_size, last_x, last_y,
+    if (is_five_from_last_move(board, GAME_BOARD_SIZE(game), last_x, last_y,
                                last_player)) {
-      int value = (last_player == ai_player) ? (WIN_SCORE + depth)
-                                             : (-WIN_SCORE - depth);
-      store_transposition(game, hash, ai_player, value, depth, TT_EXACT, -1,
-                          -1);
+      int value = (last_player == player) ? (WIN_SCORE + depth)
+                                          : (-WIN_SCORE - depth);
+      store_transposition(game, hash, player, value, depth, TT_EXACT, -1, -1);
       return value;
     }
   }
@@ -806,27 +1801,29 @@ int minimax_with_timeout(game_state_t *game, int **board, int depth, int alpha,
   // Safety fallback for callers that don't provide a valid last move context.
   // In normal recursive search, the fast path above handles terminal detection.
   if (!used_last_move_terminal_check) {
-    if (get_cached_winner(game, ai_player)) {
+    if (get_cached_winner(game, player)) {
       int value = WIN_SCORE + depth;
-      store_transposition(game, hash, ai_player, value, depth, TT_EXACT, -1,
-                          -1);
+      store_transposition(game, hash, player, value, depth, TT_EXACT, -1, -1);
       return value;
     }
-    if (get_cached_winner(game, other_player(ai_player))) {
+    if (get_cached_winner(game, other_player(player))) {
       int value = -WIN_SCORE - depth;
-      store_transposition(game, hash, ai_player, value, depth, TT_EXACT, -1,
-                          -1);
+      store_transposition(game, hash, player, value, depth, TT_EXACT, -1, -1);
       return value;
     }
   }
 
-  // Check search depth limit
+  // Nominal depth exhausted: resolve forcing sequences with quiescence
+  // instead of trusting the static line-eval totals one ply before a
+  // pending four lands. The result is window-dependent, so it is stored
+  // with the matching bound type rather than as exact.
   if (depth == 0) {
-    int value = (last_x >= 0 && last_y >= 0)
-                    ? evaluate_position_incremental_fast(
-                          board, game->board_size, ai_player, last_x, last_y)
-                    : evaluate_position(board, game->board_size, ai_player);
-    store_transposition(game, hash, ai_player, value, depth, TT_EXACT, -1, -1);
+    int value = quiescence_search(game, board, alpha, beta, player, last_x,
+                                  last_y, QS_MAX_PLY);
+    int flag = (value <= alpha)  ? TT_UPPER_BOUND
+               : (value >= beta) ? TT_LOWER_BOUND
+                                 : TT_EXACT;
+    store_transposition(game, hash, player, value, depth, flag, -1, -1);
     return value;
   }
 
@@ -835,157 +1832,532 @@ int minimax_with_timeout(game_state_t *game, int **board, int depth, int alpha,
     return 0; // Draw
   }
 
-  int current_player_turn =
-      maximizing_player ? ai_player : other_player(ai_player);
+  // Null-move pruning: in quiet positions, if passing our turn still
+  // searches to a score at or above beta at reduced depth, a real move
+  // will too. Skipped near mate windows where the depth-adjusted WIN_SCORE
+  // bounds make the null-window search meaningless.
+  if (beta < WIN_SCORE &&
+      try_null_move_pruning(game, depth, beta, player, last_x, last_y)) {
+    return beta;
+  }
+
+  // Countermove context for this node's move ordering: the move we are
+  // replying to.
+  game->cm_prev_x = last_x;
+  game->cm_prev_y = last_y;
 
   // Generate and sort moves using optimized method
   move_t moves[361]; // Max for 19x19 board
-  int move_count =
-      generate_moves_optimized(game, board, moves, current_player_turn, depth);
+  int move_count = generate_moves_optimized(game, board, moves, player, depth);
 
   if (move_count == 0) {
     return 0; // No moves available
   }
 
-  // Sort moves by priority (best first)
-  qsort(moves, move_count, sizeof(move_t), compare_moves);
+  // The table's recorded best move — even from a shallower entry whose
+  // bound couldn't cut off above — searches first as the presumed PV.
+  int tt_move_x = -1, tt_move_y = -1;
+  if (probe_transposition_move(game, hash, player, &tt_move_x, &tt_move_y)) {
+    for (int m = 0; m < move_count; m++) {
+      if (moves[m].x == tt_move_x && moves[m].y == tt_move_y) {
+        moves[m].priority = TT_MOVE_PRIORITY;
+        break;
+      }
+    }
+  }
 
   int best_x = -1, best_y = -1;
   int original_alpha = alpha;
-  int original_beta = beta;
+  int best_eval = -WIN_SCORE - 1;
+
+  // Futility pruning context for frontier nodes (see the skip below).
+  // The static eval is only ever compared against alpha with a margin,
+  // so the lazy variant's coarse answer is sufficient when it is far
+  // below the window anyway.
+  int futile_node = depth <= 2 && alpha > -WIN_SCORE && beta < WIN_SCORE;
+  int static_eval =
+      futile_node ? leaf_evaluate_lazy(game, player, alpha, beta) : 0;
+
+  for (int m = 0; m < move_count; m++) {
+    // Check for timeout before evaluating each move
+    if (is_search_timed_out(game)) {
+      game->search_timed_out = 1;
+      return best_eval;
+    }
 
-  if (maximizing_player) {
-    int max_eval = -WIN_SCORE - 1;
+    // Selection replaces a full sort: only moves actually searched pay
+    // for ordering (see select_next_move).
+    select_next_move(moves, move_count, m);
 
-    for (int m = 0; m < move_count; m++) {
-      // Check for timeout before evaluating each move
-      if (is_search_timed_out(game)) {
-        game->search_timed_out = 1;
-        return max_eval;
+    int i = moves[m].x;
+    int j = moves[m].y;
+
+    // Futility pruning: at depth 1-2 a quiet move that can't lift the
+    // static evaluation to alpha even with a generous margin won't change
+    // the node value; skip it before paying for the board mutation,
+    // zobrist updates, and leaf evaluation. The first move is always
+    // searched so the node keeps a legitimate best.
+    if (futile_node && m > 0 && moves[m].priority < LMR_QUIET_PRIORITY &&
+        static_eval + futility_margin[depth] <= alpha) {
+      continue;
+    }
+
+    search_make_move(game, board, i, j, player);
+
+    int eval;
+    if (m == 0) {
+      // Principal variation: full window
+      eval = -pvs_search(game, board, depth - 1, -beta, -alpha,
+                         other_player(player), i, j);
+    } else {
+      // Late move reduction: quiet moves (ordered below every tactical
+      // priority band) far down the sorted list scout at reduced depth
+      // first; anything that still beats alpha earns the full-depth
+      // search below.
+      int reduction = 0;
+      if (depth >= LMR_MIN_DEPTH && m >= LMR_FULL_MOVES &&
+          moves[m].priority < LMR_QUIET_PRIORITY) {
+        reduction = (m >= LMR_DEEP_MOVES) ? 2 : 1;
+        if (reduction > depth - 2) {
+          reduction = depth - 2;
+        }
       }
 
-      int i = moves[m].x;
-      int j = moves[m].y;
+      // Scout: prove the move can't beat alpha with a null window, and
+      // re-search with the real window on the rare fail-high.
+      eval = -pvs_search(game, board, depth - 1 - reduction, -alpha - 1,
+                         -alpha, other_player(player), i, j);
+      if (eval > alpha && reduction > 0 && !game->search_timed_out) {
+        eval = -pvs_search(game, board, depth - 1, -alpha - 1, -alpha,
+                           other_player(player), i, j);
+      }
+      if (eval > alpha && eval < beta && !game->search_timed_out) {
+        eval = -pvs_search(game, board, depth - 1, -beta, -alpha,
+                           other_player(player), i, j);
+      }
+    }
 
-      board[i][j] = current_player_turn;
+    search_unmake_move(game, board, i, j, player);
 
-      // Update hash incrementally
-      int player_index = (current_player_turn == AI_CELL_CROSSES) ? 0 : 1;
-      int pos = i * game->board_size + j;
-      game->current_hash ^= game->zobrist_keys[player_index][pos];
+    if (eval > best_eval) {
+      best_eval = eval;
+      best_x = i;
+      best_y = j;
+    }
+    alpha = max(alpha, eval);
 
-      // Temporary cache invalidation
-      invalidate_winner_cache(game);
+    // Early termination for winning moves
+    if (eval >= WIN_SCORE - 1000) {
+      break;
+    }
 
-      int eval = minimax_with_timeout(game, board, depth - 1, alpha, beta, 0,
-                                      ai_player, i, j);
+    if (alpha >= beta) {
+      PROFILE_BETA_CUTOFF(game, depth, m, i, j);
+      break; // Alpha-beta pruning
+    }
+  }
 
-      // Restore hash
-      game->current_hash ^= game->zobrist_keys[player_index][pos];
+  // Store in transposition table
+  int flag = (best_eval <= original_alpha) ? TT_UPPER_BOUND
+             : (best_eval >= beta)         ? TT_LOWER_BOUND
+                                           : TT_EXACT;
+  store_transposition(game, hash, player, best_eval, depth, flag, best_x,
+                      best_y);
+
+  // Store killer move if beta cutoff occurred, and credit the history and
+  // countermove tables that feed quiet-move ordering
+  if (best_eval >= beta && best_x != -1) {
+    store_killer_move(game, depth, best_x, best_y);
+    store_history_cutoff(game, player, best_x, best_y, depth);
+    if (last_x >= 0 && last_y >= 0) {
+      store_countermove(game, player, last_x, last_y, best_x, best_y);
+    }
+  }
 
-      // Restore cache
-      invalidate_winner_cache(game);
+  return best_eval;
+}
 
-      board[i][j] = AI_CELL_EMPTY;
+int minimax_with_timeout(game_state_t *game, cell_t **board, int depth, int alpha,
+                         int beta, int maximizing_player, int ai_player,
+                         int last_x, int last_y) {
+  // Thin adapter from the historical minimax signature (fixed ai_player
+  // perspective plus a maximizing flag) onto the negamax core, so root
+  // loops, the SMP workers, and the null-move helper need no changes.
+  if (maximizing_player) {
+    return pvs_search(game, board, depth, alpha, beta, ai_player, last_x,
+                      last_y);
+  }
+  return -pvs_search(game, board, depth, -beta, -alpha,
+                     other_player(ai_player), last_x, last_y);
+}
 
-      if (eval > max_eval) {
-        max_eval = eval;
-        best_x = i;
-        best_y = j;
-      }
-      alpha = max(alpha, eval);
+//===============================================================================
+// LAZY-SMP ROOT SEARCH HELPERS
+//===============================================================================
 
-      // Early termination for winning moves
-      if (eval >= WIN_SCORE - 1000) {
-        break;
-      }
 
-      if (beta <= alpha) {
-        break; // Alpha-beta pruning
-      }
-    }
+// One Lazy-SMP helper: a private clone of the game state (own board,
+// bitboard, line-eval, killers) whose tt pointer is aimed at the master's
+// transposition table. Helpers search the same root at staggered depths;
+// their only output is the shared table they warm for the master.
+typedef struct {
+  game_state_t *clone;
+  int ai_player;
+  int start_depth;
+#ifndef _WIN32
+  pthread_t thread;
+#endif
+} smp_helper_t;
 
-    // Store in transposition table
-    int flag = (max_eval <= original_alpha)  ? TT_UPPER_BOUND
-               : (max_eval >= original_beta) ? TT_LOWER_BOUND
-                                             : TT_EXACT;
-    store_transposition(game, hash, ai_player, max_eval, depth, flag, best_x,
-                        best_y);
+typedef struct {
+  smp_helper_t helpers[MAX_SEARCH_THREADS];
+  volatile int stop;
+  int count;
+} smp_pool_t;
 
-    // Store killer move if beta cutoff occurred
-    if (max_eval >= original_beta && best_x != -1) {
-      store_killer_move(game, depth, best_x, best_y);
+#ifndef _WIN32
+
+/**
+ * Deep-copies the game state for one helper thread. The clone owns its
+ * board (and the caches rebuilt against it by the copied bitboard and
+ * line-eval state), but shares the master's transposition table through
+ * the tt pointer copied by the struct memcpy.
+ *
+ * NOTE: concurrent stores into the shared table can tear; the entries are
+ * advisory (move ordering and bounds), and integrity validation of shared
+ * entries is handled at the table level.
+ */
+static game_state_t *smp_clone_game(game_state_t *game) {
+  game_state_t *clone = malloc(sizeof(game_state_t));
+  if (!clone) {
+    return NULL;
+  }
+  memcpy(clone, game, sizeof(game_state_t));
+
+  clone->board = create_board(GAME_BOARD_SIZE(game));
+  if (!clone->board) {
+    free(clone);
+    return NULL;
+  }
+  // Rows are contiguous (see create_board), so one block copy suffices.
+  memcpy(&clone->board[0][0], &game->board[0][0],
+         (size_t)GAME_BOARD_SIZE(game) * GAME_BOARD_SIZE(game) * sizeof(cell_t));
+
+  // The struct copy aliased the parent's VCT memo; give the clone its
+  // own warm copy (workers run the defense scan through it). On failure
+  // the clone just re-allocates lazily on first probe.
+  clone->vct_table = NULL;
+  if (game->vct_table) {
+    clone->vct_table = malloc(VCT_TT_SIZE * sizeof(vct_entry_t));
+    if (clone->vct_table) {
+      memcpy(clone->vct_table, game->vct_table,
+             VCT_TT_SIZE * sizeof(vct_entry_t));
     }
+  }
 
-    return max_eval;
+  // One arena per thread: the struct copy aliased the parent's backing
+  // block, so detach it; the clone reserves its own if it ever allocates.
+  arena_init(&clone->search_arena);
 
-  } else {
-    int min_eval = WIN_SCORE + 1;
+  clone->config.headless = 1; // Helpers never write to the terminal.
+  return clone;
+}
+
+/**
+ * Tear down a clone created by smp_clone_game: the board, the clone's
+ * private VCT memo, and the struct itself.
+ */
+static void smp_free_clone(game_state_t *clone) {
+  free_board(clone->board, clone->board_size);
+  free(clone->vct_table);
+  arena_destroy(&clone->search_arena);
+  free(clone);
+}
+
+static void *smp_helper_main(void *arg) {
+  smp_helper_t *helper = arg;
+  game_state_t *g = helper->clone;
+  int ai_player = helper->ai_player;
 
+  move_t moves[361];
+  int move_count =
+      generate_moves_optimized(g, g->board, moves, ai_player, g->max_depth);
+  if (move_count == 0) {
+    return NULL;
+  }
+  qsort(moves, move_count, sizeof(move_t), compare_moves);
+
+  // Staggered iterative deepening: helpers start one or two plies above
+  // the master so deeper results land in the shared table early.
+  for (int depth = helper->start_depth; depth <= g->max_depth; depth++) {
+    if (is_search_timed_out(g)) {
+      break;
+    }
     for (int m = 0; m < move_count; m++) {
-      // Check for timeout before evaluating each move
-      if (is_search_timed_out(game)) {
-        game->search_timed_out = 1;
-        return min_eval;
+      if (is_search_timed_out(g)) {
+        break;
       }
-
       int i = moves[m].x;
       int j = moves[m].y;
 
-      board[i][j] = current_player_turn;
+      search_make_move(g, g->board, i, j, ai_player);
+      minimax_with_timeout(g, g->board, depth - 1, -WIN_SCORE - 1,
+                           WIN_SCORE + 1, 0, ai_player, i, j);
+      search_unmake_move(g, g->board, i, j, ai_player);
+    }
+  }
+  return NULL;
+}
 
-      // Update hash incrementally
-      int player_index = (current_player_turn == AI_CELL_CROSSES) ? 0 : 1;
-      int pos = i * game->board_size + j;
-      game->current_hash ^= game->zobrist_keys[player_index][pos];
+/**
+ * Spawns search_threads - 1 helper clones. No-op (count 0) when the game
+ * is configured single-threaded or a clone allocation fails early.
+ */
+static void smp_start_helpers(smp_pool_t *pool, game_state_t *game,
+                              int ai_player) {
+  pool->stop = 0;
+  pool->count = 0;
+
+  int wanted = game->search_threads - 1;
+  if (wanted > MAX_SEARCH_THREADS) {
+    wanted = MAX_SEARCH_THREADS;
+  }
 
-      // Temporary cache invalidation
-      invalidate_winner_cache(game);
+  for (int t = 0; t < wanted; t++) {
+    smp_helper_t *helper = &pool->helpers[pool->count];
+    helper->clone = smp_clone_game(game);
+    if (!helper->clone) {
+      break;
+    }
+    helper->ai_player = ai_player;
+    helper->start_depth = 2 + (t % 2);
+    helper->clone->smp_stop = &pool->stop;
 
-      int eval = minimax_with_timeout(game, board, depth - 1, alpha, beta, 1,
-                                      ai_player, i, j);
+    if (pthread_create(&helper->thread, NULL, smp_helper_main, helper) != 0) {
+      smp_free_clone(helper->clone);
+      break;
+    }
+    pool->count++;
+  }
+}
+
+static void smp_stop_helpers(smp_pool_t *pool) {
+  pool->stop = 1;
+  for (int t = 0; t < pool->count; t++) {
+    pthread_join(pool->helpers[t].thread, NULL);
+    smp_free_clone(pool->helpers[t].clone);
+  }
+  pool->count = 0;
+}
 
-      // Restore hash
-      game->current_hash ^= game->zobrist_keys[player_index][pos];
+#else // _WIN32
 
-      // Restore cache
-      invalidate_winner_cache(game);
+// The Windows brain build is single-threaded; Lazy-SMP compiles out.
+static void smp_start_helpers(smp_pool_t *pool, game_state_t *game,
+                              int ai_player) {
+  (void)game;
+  (void)ai_player;
+  pool->stop = 0;
+  pool->count = 0;
+}
 
-      board[i][j] = AI_CELL_EMPTY;
+static void smp_stop_helpers(smp_pool_t *pool) { pool->count = 0; }
 
-      if (eval < min_eval) {
-        min_eval = eval;
-        best_x = i;
-        best_y = j;
-      }
-      beta = min(beta, eval);
+#endif // _WIN32
 
-      // Early termination for losing moves
-      if (eval <= -WIN_SCORE + 1000) {
-        break;
-      }
+//===============================================================================
+// ROOT-SPLIT PARALLEL SEARCH
+//===============================================================================
+
+#ifndef _WIN32
+
+// Shared state for one root-split depth iteration. Workers claim root moves
+// by striding through the sorted move list, publish improvements under the
+// lock, and read the shared alpha relaxed — a stale value only costs a
+// slightly wider window, never correctness.
+typedef struct {
+  pthread_mutex_t lock;
+  volatile int stop;
+  int alpha;
+  int best_x, best_y, best_score;
+  int moves_considered;
+} root_split_shared_t;
+
+typedef struct {
+  game_state_t *clone;
+  root_split_shared_t *shared;
+  const move_t *moves;
+  int move_count;
+  int depth;
+  int ai_player;
+  int worker_id;
+  int stride;
+  pthread_t thread;
+} root_split_worker_t;
+
+static void *root_split_worker_main(void *arg) {
+  root_split_worker_t *w = arg;
+  game_state_t *g = w->clone;
+  root_split_shared_t *shared = w->shared;
+
+  for (int m = w->worker_id; m < w->move_count; m += w->stride) {
+    if (shared->stop || is_search_timed_out(g)) {
+      break;
+    }
+    int i = w->moves[m].x;
+    int j = w->moves[m].y;
+
+    int alpha = __atomic_load_n(&shared->alpha, __ATOMIC_RELAXED);
+
+    search_make_move(g, g->board, i, j, w->ai_player);
+    int score = minimax_with_timeout(g, g->board, w->depth - 1, alpha,
+                                     WIN_SCORE + 1, 0, w->ai_player, i, j);
+    search_unmake_move(g, g->board, i, j, w->ai_player);
 
-      if (beta <= alpha) {
-        break; // Alpha-beta pruning
+    if (g->search_timed_out) {
+      break;
+    }
+
+    pthread_mutex_lock(&shared->lock);
+    shared->moves_considered++;
+    if (score > shared->best_score) {
+      shared->best_score = score;
+      shared->best_x = i;
+      shared->best_y = j;
+      if (score > shared->alpha) {
+        __atomic_store_n(&shared->alpha, score, __ATOMIC_RELAXED);
+      }
+      if (score >= WIN_SCORE - 1000) {
+        shared->stop = 1; // Forced win found; no point finishing the depth.
       }
     }
+    pthread_mutex_unlock(&shared->lock);
+  }
+  return NULL;
+}
 
-    // Store in transposition table
-    int flag = (min_eval <= original_alpha)  ? TT_UPPER_BOUND
-               : (min_eval >= original_beta) ? TT_LOWER_BOUND
-                                             : TT_EXACT;
-    store_transposition(game, hash, ai_player, min_eval, depth, flag, best_x,
-                        best_y);
+/**
+ * Searches one iterative-deepening level with the root moves partitioned
+ * across game->search_threads worker clones. Root moves are independent
+ * once each worker owns a board copy; the shared alpha gives cross-thread
+ * pruning. Returns 1 if the depth ran on the workers, 0 if the caller
+ * should use the sequential loop instead.
+ */
+static int search_root_parallel(game_state_t *game, const move_t *moves,
+                                int move_count, int ai_player, int depth,
+                                int *out_x, int *out_y, int *out_score,
+                                int *out_considered) {
+  int workers = game->search_threads;
+  if (workers > MAX_SEARCH_THREADS) {
+    workers = MAX_SEARCH_THREADS;
+  }
+  if (workers > move_count) {
+    workers = move_count;
+  }
 
-    // Store killer move if alpha cutoff occurred
-    if (min_eval <= original_alpha && best_x != -1) {
-      store_killer_move(game, depth, best_x, best_y);
+  root_split_shared_t shared;
+  pthread_mutex_init(&shared.lock, NULL);
+  shared.stop = 0;
+  shared.alpha = -WIN_SCORE - 1;
+  shared.best_x = -1;
+  shared.best_y = -1;
+  shared.best_score = -WIN_SCORE - 1;
+  shared.moves_considered = 0;
+
+  root_split_worker_t work[MAX_SEARCH_THREADS];
+  int spawned = 0;
+  for (int t = 0; t < workers; t++) {
+    root_split_worker_t *w = &work[spawned];
+    w->clone = smp_clone_game(game);
+    if (!w->clone) {
+      break;
     }
+    w->clone->smp_stop = &shared.stop;
+    w->shared = &shared;
+    w->moves = moves;
+    w->move_count = move_count;
+    w->depth = depth;
+    w->ai_player = ai_player;
+    w->worker_id = spawned;
+    w->stride = workers;
+    if (pthread_create(&w->thread, NULL, root_split_worker_main, w) != 0) {
+      smp_free_clone(w->clone);
+      break;
+    }
+    spawned++;
+  }
+
+  for (int t = 0; t < spawned; t++) {
+    pthread_join(work[t].thread, NULL);
+    if (work[t].clone->search_timed_out) {
+      game->search_timed_out = 1;
+    }
+    smp_free_clone(work[t].clone);
+  }
 
-    return min_eval;
+  pthread_mutex_destroy(&shared.lock);
+
+  if (spawned == 0) {
+    return 0; // Could not start any workers; sequential fallback.
+  }
+
+  // Cover moves the striding missed when fewer workers started than the
+  // stride assumed.
+  if (spawned < workers && !game->search_timed_out) {
+    for (int m = 0; m < move_count; m++) {
+      if (m % workers < spawned) {
+        continue; // A worker owned this slot.
+      }
+      if (is_search_timed_out(game)) {
+        game->search_timed_out = 1;
+        break;
+      }
+      int i = moves[m].x;
+      int j = moves[m].y;
+      search_make_move(game, game->board, i, j, ai_player);
+      int score = minimax_with_timeout(game, game->board, depth - 1,
+                                       shared.alpha, WIN_SCORE + 1, 0,
+                                       ai_player, i, j);
+      search_unmake_move(game, game->board, i, j, ai_player);
+      shared.moves_considered++;
+      if (score > shared.best_score) {
+        shared.best_score = score;
+        shared.best_x = i;
+        shared.best_y = j;
+        if (score > shared.alpha) {
+          shared.alpha = score;
+        }
+      }
+    }
   }
+
+  *out_x = shared.best_x;
+  *out_y = shared.best_y;
+  *out_score = shared.best_score;
+  *out_considered = shared.moves_considered;
+  return 1;
 }
 
+#else // _WIN32
+
+static int search_root_parallel(game_state_t *game, const move_t *moves,
+                                int move_count, int ai_player, int depth,
+                                int *out_x, int *out_y, int *out_score,
+                                int *out_considered) {
+  (void)game;
+  (void)moves;
+  (void)move_count;
+  (void)ai_player;
+  (void)depth;
+  (void)out_x;
+  (void)out_y;
+  (void)out_score;
+  (void)out_considered;
+  return 0; // Single-threaded build: caller uses the sequential loop.
+}
+
+#endif // _WIN32
+
 //===============================================================================
 // AI MOVE FINDING FUNCTIONS
 //===============================================================================
@@ -993,8 +2365,8 @@ int minimax_with_timeout(game_state_t *game, int **board, int depth, int alpha,
 void find_first_ai_move(game_state_t *game, int *best_x, int *best_y) {
   // Find the human's first move
   int black_x = -1, black_y = -1;
-  for (int i = 0; i < game->board_size && black_x == -1; i++) {
-    for (int j = 0; j < game->board_size && black_x == -1; j++) {
+  for (int i = 0; i < GAME_BOARD_SIZE(game) && black_x == -1; i++) {
+    for (int j = 0; j < GAME_BOARD_SIZE(game) && black_x == -1; j++) {
       if (game->board[i][j] == AI_CELL_CROSSES) {
         black_x = i;
         black_y = j;
@@ -1004,8 +2376,8 @@ void find_first_ai_move(game_state_t *game, int *best_x, int *best_y) {
 
   if (black_x == -1) {
     // Fallback: place in center if no human move found
-    *best_x = game->board_size / 2;
-    *best_y = game->board_size / 2;
+    *best_x = GAME_BOARD_SIZE(game) / 2;
+    *best_y = GAME_BOARD_SIZE(game) / 2;
     return;
   }
 
@@ -1020,7 +2392,7 @@ void find_first_ai_move(game_state_t *game, int *best_x, int *best_y) {
        i++) {
     int x = black_x + opening_offsets[i][0];
     int y = black_y + opening_offsets[i][1];
-    if (x < 0 || x >= game->board_size || y < 0 || y >= game->board_size) {
+    if (x < 0 || x >= GAME_BOARD_SIZE(game) || y < 0 || y >= GAME_BOARD_SIZE(game)) {
       continue;
     }
     if (game->board[x][y] != AI_CELL_EMPTY) {
@@ -1032,15 +2404,246 @@ void find_first_ai_move(game_state_t *game, int *best_x, int *best_y) {
   }
 
   // Rare fallback when all opening-book cells are unavailable.
-  *best_x = max(0, min(game->board_size - 1, black_x + 1));
-  *best_y = max(0, min(game->board_size - 1, black_y));
+  *best_x = max(0, min(GAME_BOARD_SIZE(game) - 1, black_x + 1));
+  *best_y = max(0, min(GAME_BOARD_SIZE(game) - 1, black_y));
+}
+
+/**
+ * Rebuild the principal variation for one root move by replaying
+ * transposition-table best-move records.
+ *
+ * Makes the root move, then repeatedly probes the TT for the side to
+ * move and follows the stored best move until the table has no record,
+ * the recorded cell is occupied, or MULTIPV_PV_LEN plies are collected.
+ * All moves are unmade before returning, so the board is untouched.
+ *
+ * Under symmetry-canonical hashing (early game) a probed move may belong
+ * to a twin orientation; the occupied-cell guard keeps the line legal
+ * and the PV simply ends early in that rare case.
+ */
+static void multipv_extract_pv(game_state_t *game, int root_x, int root_y,
+                               int ai_player, multipv_entry_t *entry) {
+  int made_x[MULTIPV_PV_LEN], made_y[MULTIPV_PV_LEN], made_p[MULTIPV_PV_LEN];
+  int made = 0;
+
+  entry->pv_x[0] = root_x;
+  entry->pv_y[0] = root_y;
+  entry->pv_len = 1;
+
+  int player = ai_player;
+  int x = root_x, y = root_y;
+  while (made < MULTIPV_PV_LEN) {
+    search_make_move(game, game->board, x, y, player);
+    made_x[made] = x;
+    made_y[made] = y;
+    made_p[made] = player;
+    made++;
+    player = other_player(player);
+
+    int nx, ny;
+    if (entry->pv_len >= MULTIPV_PV_LEN ||
+        !probe_transposition_move(game, position_hash(game), player, &nx,
+                                  &ny) ||
+        game->board[nx][ny] != AI_CELL_EMPTY) {
+      break;
+    }
+    entry->pv_x[entry->pv_len] = nx;
+    entry->pv_y[entry->pv_len] = ny;
+    entry->pv_len++;
+    x = nx;
+    y = ny;
+  }
+
+  while (made > 0) {
+    made--;
+    search_unmake_move(game, game->board, made_x[made], made_y[made],
+                       made_p[made]);
+  }
 }
 
+// Snapshot of the context's work counters, taken at the start of each
+// pipeline stage in find_best_ai_move so each scoring entry carries the
+// stage's delta rather than a cumulative blur.
+typedef struct {
+  uint64_t nodes, tt_probes, tt_hits, tt_stores, movegen_calls, eval_calls;
+} stage_counters_t;
+
+static stage_counters_t stage_counters_now(const game_state_t *game) {
+  stage_counters_t s = {game->search_nodes,  game->tt_probes,
+                        game->tt_hits,       game->tt_stores,
+                        game->movegen_calls, game->eval_calls};
+  return s;
+}
+
+static void scoring_entry_count_work(scoring_entry_t *e,
+                                     const game_state_t *game,
+                                     const stage_counters_t *since) {
+  e->nodes = game->search_nodes - since->nodes;
+  e->tt_probes = game->tt_probes - since->tt_probes;
+  e->tt_hits = game->tt_hits - since->tt_hits;
+  e->tt_stores = game->tt_stores - since->tt_stores;
+  e->movegen_calls = game->movegen_calls - since->movegen_calls;
+  e->eval_calls = game->eval_calls - since->eval_calls;
+}
+
+// Root-search workspace: the transient arrays find_best_ai_move used to
+// carry on the stack (~25 KB). One arena_alloc per move decision; when
+// the arena has no backing memory (reserve failed) the caller falls back
+// to a stack instance, which is exactly the pre-arena behavior. Per-node
+// arrays inside minimax stay on the stack on purpose: they are live on
+// the recursion path, and the stack already reclaims them for free.
+typedef struct {
+  move_t moves[361];
+  int winning_moves_x[361];
+  int winning_moves_y[361];
+  int open_four_moves_x[361];
+  int open_four_moves_y[361];
+  int blocking_moves_x[361];
+  int blocking_moves_y[361];
+  int blocking_threat_level[361];
+  int best_blocks_x[361];
+  int best_blocks_y[361];
+  int vct_sequence[MAX_VCT_SEQUENCE][2];
+  int root_scores[361];
+  int best_moves_x[361];
+  int best_moves_y[361];
+} root_workspace_t;
+
+// Backing block for the per-context search arena: enough for the root
+// workspace plus headroom for future transients (incremental threat and
+// candidate structures) without re-reserving.
+#define SEARCH_ARENA_BYTES (256 * 1024)
+
+/**
+ * Root symmetry reduction: drop every candidate whose orbit under the
+ * position's own symmetries already has a kept representative.
+ *
+ * An orientation t fixes the position exactly when sym_hashes[t] equals
+ * current_hash (maintained incrementally; a 64-bit collision is the
+ * only false positive). Those orientations form a group, and the seven
+ * nontrivial ones are all tracked, so checking each kept move's images
+ * under the fixing orientations finds every symmetric twin. Moves that
+ * map onto a kept move lead to positions identical up to relabeling of
+ * the board - searching them would rediscover the same score.
+ *
+ * Near-empty boards shrink the root by up to 8x (the second-move search
+ * keeps one octant); a single asymmetric stone disables every
+ * orientation and the filter keeps the list untouched. Returns the new
+ * move count; relative order of survivors is preserved.
+ */
+static int reduce_root_moves_by_symmetry(game_state_t *game, move_t *moves,
+                                         int move_count) {
+  int fixing[7];
+  int fixing_count = 0;
+  for (int t = 0; t < 7; t++) {
+    if (game->sym_hashes[t] == game->current_hash) {
+      fixing[fixing_count++] = t;
+    }
+  }
+  if (fixing_count == 0) {
+    return move_count;
+  }
+
+  int n = GAME_BOARD_SIZE(game);
+  uint8_t kept[361];
+  memset(kept, 0, (size_t)(n * n));
+
+  int out = 0;
+  for (int i = 0; i < move_count; i++) {
+    int duplicate = 0;
+    for (int s = 0; s < fixing_count && !duplicate; s++) {
+      int ox, oy;
+      book_transform_xy(fixing[s], n, moves[i].x, moves[i].y, &ox, &oy);
+      duplicate = kept[ox * n + oy];
+    }
+    if (!duplicate) {
+      kept[moves[i].x * n + moves[i].y] = 1;
+      moves[out++] = moves[i];
+    }
+  }
+  return out;
+}
+
+static void find_best_ai_move_impl(game_state_t *game, int *best_x,
+                                   int *best_y, scoring_report_t *report);
+
 void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
                        scoring_report_t *report) {
+  // Tests and embedders may place stones by writing game->board cells
+  // directly instead of going through make_move, a contract the
+  // pre-incremental search honored. Detect the drift by comparing the
+  // board's stone count against the maintained one and rebuild the
+  // derived mirrors the search trusts — the same one-pass rebuild
+  // bulk_load_moves does for its batch of stones.
+  {
+    int n = GAME_BOARD_SIZE(game);
+    int stones = 0;
+    for (int x = 0; x < n; x++) {
+      for (int y = 0; y < n; y++) {
+        if (game->board[x][y] != AI_CELL_EMPTY) {
+          stones++;
+        }
+      }
+    }
+    if (stones != game->stones_on_board) {
+      rebuild_optimization_caches(game);
+      clear_threat_cache(game);
+      game->nnue_acc_valid = 0;
+      if (game->nnue_model) {
+        nnue_refresh(game, game->board);
+      }
+    }
+  }
+  // Thin shell around the pipeline so the opt-in profile counters are
+  // reset and snapshotted exactly once per search, whichever of the
+  // many stage returns inside the impl ends it.
+  PROFILE_RESET(game);
+  find_best_ai_move_impl(game, best_x, best_y, report);
+#ifdef GOMOKU_PROFILE
+  if (report) {
+    report->profile = game->profile;
+  }
+#endif
+}
+
+static void find_best_ai_move_impl(game_state_t *game, int *best_x,
+                                   int *best_y, scoring_report_t *report) {
   // Initialize timeout tracking
   game->search_start_time = get_current_time();
   game->search_timed_out = 0;
+  game->search_progress_depth = 0;
+
+  // Age the transposition table: entries from earlier searches become
+  // preferred-slot eviction candidates without wiping the table.
+  game->tt_generation++;
+
+  // Multi-PV results are per-search; stale lines must not leak into a
+  // response for a position they weren't computed on.
+  game->multipv_count = 0;
+
+  // Aspiration windows are seeded depth-to-depth within one search; a
+  // stale window from the previous move's search would mis-bound this one.
+  init_aspiration_windows(game);
+
+  // Age the history heuristic so earlier searches inform but don't
+  // dominate this one; countermoves stay, they're cheap to overwrite.
+  for (int p = 0; p < 2; p++) {
+    for (int c = 0; c < 361; c++) {
+      game->history_scores[p][c] >>= 1;
+    }
+  }
+  game->cm_prev_x = -1;
+  game->cm_prev_y = -1;
+
+  // Killers age by demotion instead of halving: the primary slot
+  // survives into this turn's nearly identical tree, the secondary
+  // reopens for fresh cutoffs. A killer that stops earning its keep is
+  // fully gone within two turns; one that still cuts is re-promoted
+  // immediately.
+  for (int d = 0; d < MAX_SEARCH_DEPTH; d++) {
+    game->killer_moves[d][1][0] = -1;
+    game->killer_moves[d][1][1] = -1;
+  }
 
   // Initialize scoring report
   scoring_report_t local_report;
@@ -1055,22 +2658,56 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
       (ai_player == AI_CELL_CROSSES) ? COLOR_RED : COLOR_BLUE;
   int opponent = other_player(ai_player);
 
-  // Ensure zobrist hash is consistent with the current board
-  game->current_hash = compute_zobrist_hash(game);
+#ifdef GOMOKU_DEBUG_HASH
+  // The incremental hash is authoritative: every path that mutates the
+  // board (make_move, undo, bulk load, snapshot restore) either updates
+  // it per stone or goes through rebuild_optimization_caches. This
+  // opt-in check (-DGOMOKU_DEBUG_HASH) catches any new path that drifts;
+  // release builds trust the maintained value instead of paying an
+  // O(n^2) rebuild per turn.
+  {
+    uint64_t saved_sym[7];
+    memcpy(saved_sym, game->sym_hashes, sizeof(saved_sym));
+    uint64_t full = compute_zobrist_hash(game);
+    if (full != game->current_hash ||
+        memcmp(saved_sym, game->sym_hashes, sizeof(saved_sym)) != 0) {
+      fprintf(stderr,
+              "zobrist drift: incremental %016llx != full %016llx\n",
+              (unsigned long long)game->current_hash,
+              (unsigned long long)full);
+      abort();
+    }
+  }
+#endif
 
-  // Count stones on board to detect first AI move
-  int stone_count = 0;
-  for (int i = 0; i < game->board_size; i++) {
-    for (int j = 0; j < game->board_size; j++) {
-      if (game->board[i][j] != AI_CELL_EMPTY) {
-        stone_count++;
+  // =========================================================================
+  // STEP 0: Opening book. Early positions take their move from the
+  // compiled book (see book.h, loaded via --book): an mmap'd
+  // canonical-hash lookup that costs microseconds where the pipeline
+  // below would spend its whole budget re-deriving well-trodden theory
+  // on a near-empty board. Misses fall straight through.
+  // =========================================================================
+  {
+    const book_t *book = book_default();
+    int bx = -1, by = -1;
+    if (book && book_probe(book, game, &bx, &by)) {
+      *best_x = bx;
+      *best_y = by;
+      scoring_entry_t *e = scoring_report_add(report, "book", 1);
+      if (e) {
+        e->evaluated_moves = 1;
+        e->decisive = 1;
       }
+      snprintf(game->ai_status_message, sizeof(game->ai_status_message),
+               "%s%c%s Book move", ai_color, ai_symbol, COLOR_RESET);
+      add_ai_history_entry(game, 1);
+      return;
     }
   }
 
   // If there's exactly 1 stone (human's first move), use simple random
   // placement
-  if (stone_count == 1) {
+  if (game->stones_on_board == 1) {
     find_first_ai_move(game, best_x, best_y);
     add_ai_history_entry(game, 1); // Random placement, 1 "move" considered
     return;
@@ -1082,7 +2719,8 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
 
   // Clear previous AI status message and show thinking message
   strcpy(game->ai_status_message, "");
-  if (game->config.skip_welcome && !game->config.headless) {
+  if (game->config.skip_welcome && !game->config.headless &&
+      !game->background_search) {
     if (game->move_timeout > 0) {
       printf("%s%c%s It's AI's Turn... Please wait... (timeout: %.1fs)\n",
              ai_color, ai_symbol, COLOR_RESET, game->move_timeout);
@@ -1093,11 +2731,31 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
     fflush(stdout);
   }
 
-  // Generate and sort moves using optimized method
-  move_t moves[361]; // Max for 19x19 board
+  // Search-transient storage for this decision comes from the context
+  // arena: reserved once, reset every move, bump-allocated from there.
+  arena_reserve(&game->search_arena, SEARCH_ARENA_BYTES);
+  arena_reset(&game->search_arena);
+  root_workspace_t fallback_ws;
+  root_workspace_t *ws = arena_alloc(&game->search_arena, sizeof(*ws));
+  if (!ws) {
+    ws = &fallback_ws;
+  }
+
+  // Generate and sort moves using optimized method. The counter snapshot
+  // starts here so the root movegen is attributed to the first stage.
+  stage_counters_t stage_start = stage_counters_now(game);
+  move_t *moves = ws->moves;
   int move_count = generate_moves_optimized(game, game->board, moves, ai_player,
                                             game->max_depth);
 
+  // Collapse symmetry orbits while the position can still have them -
+  // gated like canonical TT hashing, since past SYM_HASH_STONE_LIMIT
+  // stones a symmetric position is effectively extinct and the check is
+  // seven compares wasted per move.
+  if (move_count > 1 && game->stones_on_board <= SYM_HASH_STONE_LIMIT) {
+    move_count = reduce_root_moves_by_symmetry(game, moves, move_count);
+  }
+
   // =========================================================================
   // STEP 1: Check for immediate winning moves (actual five = 1000000)
   // Also collect open fours (500000) for use after blocking checks.
@@ -1105,17 +2763,17 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
   // We must check for opponent threats before committing to an open four.
   // =========================================================================
   double step_start = get_current_time();
-  int winning_moves_x[361];
-  int winning_moves_y[361];
+  int *winning_moves_x = ws->winning_moves_x;
+  int *winning_moves_y = ws->winning_moves_y;
   int winning_move_count = 0;
-  int open_four_moves_x[361];
-  int open_four_moves_y[361];
+  int *open_four_moves_x = ws->open_four_moves_x;
+  int *open_four_moves_y = ws->open_four_moves_y;
   int open_four_count = 0;
   int our_max_score = 0;
 
   for (int i = 0; i < move_count; i++) {
-    int threat = evaluate_threat_fast(game->board, moves[i].x, moves[i].y,
-                                      ai_player, game->board_size);
+    int threat = evaluate_threat_cached(game, game->board, moves[i].x,
+                                        moves[i].y, ai_player);
     if (threat > our_max_score)
       our_max_score = threat;
     if (threat >= 1000000) {
@@ -1136,6 +2794,7 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
       e->score = our_max_score;
       e->have_win = (winning_move_count > 0);
       e->time_ms = (get_current_time() - step_start) * 1000.0;
+      scoring_entry_count_work(e, game, &stage_start);
       if (winning_move_count > 0)
         e->decisive = 1;
     }
@@ -1143,7 +2802,7 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
   }
 
   if (winning_move_count > 0) {
-    int selected = rand() % winning_move_count;
+    int selected = (int)(game_rand(game) % (uint32_t)winning_move_count);
     *best_x = winning_moves_x[selected];
     *best_y = winning_moves_y[selected];
     snprintf(game->ai_status_message, sizeof(game->ai_status_message),
@@ -1169,15 +2828,16 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
   //   - Closed four threats where O has a better offensive reply
   // =========================================================================
   step_start = get_current_time();
-  int blocking_moves_x[361];
-  int blocking_moves_y[361];
-  int blocking_threat_level[361];
+  stage_start = stage_counters_now(game);
+  int *blocking_moves_x = ws->blocking_moves_x;
+  int *blocking_moves_y = ws->blocking_moves_y;
+  int *blocking_threat_level = ws->blocking_threat_level;
   int blocking_move_count = 0;
   int max_opp_threat = 0;
 
   for (int i = 0; i < move_count; i++) {
-    int opp_threat = evaluate_threat_fast(game->board, moves[i].x, moves[i].y,
-                                          opponent, game->board_size);
+    int opp_threat = evaluate_threat_cached(game, game->board, moves[i].x,
+                                            moves[i].y, opponent);
     if (opp_threat > max_opp_threat)
       max_opp_threat = opp_threat;
     if (opp_threat >= 500000) { // open four or win — must block immediately
@@ -1194,6 +2854,7 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
       e->evaluated_moves = move_count;
       e->score = -max_opp_threat;
       e->time_ms = (get_current_time() - step_start) * 1000.0;
+      scoring_entry_count_work(e, game, &stage_start);
       if (blocking_move_count > 0)
         e->decisive = 1;
     }
@@ -1202,17 +2863,17 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
 
   if (blocking_move_count > 0) {
     // Among equally urgent blocks, prefer the one that also builds our offense.
-    int best_blocks_x[361];
-    int best_blocks_y[361];
+    int *best_blocks_x = ws->best_blocks_x;
+    int *best_blocks_y = ws->best_blocks_y;
     int best_block_count = 0;
     int best_own_threat = -1;
 
     for (int i = 0; i < blocking_move_count; i++) {
       if (blocking_threat_level[i] != max_opp_threat)
         continue;
-      int own_threat = evaluate_threat_fast(game->board, blocking_moves_x[i],
-                                            blocking_moves_y[i], ai_player,
-                                            game->board_size);
+      int own_threat = evaluate_threat_cached(game, game->board,
+                                              blocking_moves_x[i],
+                                              blocking_moves_y[i], ai_player);
       if (own_threat > best_own_threat) {
         best_own_threat = own_threat;
         best_block_count = 0;
@@ -1224,7 +2885,7 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
       }
     }
 
-    int selected = rand() % best_block_count;
+    int selected = (int)(game_rand(game) % (uint32_t)best_block_count);
     *best_x = best_blocks_x[selected];
     *best_y = best_blocks_y[selected];
     snprintf(game->ai_status_message, sizeof(game->ai_status_message),
@@ -1239,7 +2900,7 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
   // immediate threats have been checked and blocked by Step 2.
   // =========================================================================
   if (open_four_count > 0) {
-    int selected = rand() % open_four_count;
+    int selected = (int)(game_rand(game) % (uint32_t)open_four_count);
     *best_x = open_four_moves_x[selected];
     *best_y = open_four_moves_y[selected];
 
@@ -1264,11 +2925,43 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
   // STEP 3: Offensive VCT — can we force a win?
   // =========================================================================
   step_start = get_current_time();
+  stage_start = stage_counters_now(game);
+
+  // STEP 3/4 run under a slice of the move budget so a pathological
+  // threat-dense position can't starve minimax. The sticky timed-out
+  // flag is cleared after each slice; if the FULL budget is genuinely
+  // gone it re-trips at the next poll.
+  double full_timeout = game->move_timeout;
+  if (full_timeout > 0) {
+    game->move_timeout = full_timeout * VCT_TIME_FRACTION;
+  }
+
   int vct_x = -1, vct_y = -1;
-  int vct_sequence[MAX_VCT_SEQUENCE][2];
+  int(*vct_sequence)[2] = ws->vct_sequence;
   int vct_len = 0;
-  int have_vct = find_forced_win(game, game->board, ai_player, 10, &vct_x,
-                                 &vct_y, vct_sequence, &vct_len);
+  // Cross-turn carry-over: only two stones typically landed since the
+  // last search, so replaying last turn's proven sequence usually settles
+  // this in O(sequence) instead of a fresh tree search.
+  int have_vct = vct_carry_revalidate(game, game->board, ai_player, &vct_x,
+                                      &vct_y);
+  if (have_vct) {
+    vct_carry_t *carry =
+        &game->vct_carry[(ai_player == AI_CELL_CROSSES) ? 0 : 1];
+    vct_len = min(carry->len, MAX_VCT_SEQUENCE);
+    for (int i = 0; i < vct_len; i++) {
+      vct_sequence[i][0] = carry->seq[i][0];
+      vct_sequence[i][1] = carry->seq[i][1];
+    }
+  } else {
+    have_vct = find_forced_win(game, game->board, ai_player, 10, &vct_x,
+                               &vct_y, vct_sequence, &vct_len);
+    if (have_vct || !game->search_timed_out) {
+      vct_carry_store(game, ai_player, have_vct, vct_sequence, vct_len);
+    }
+  }
+
+  game->move_timeout = full_timeout;
+  game->search_timed_out = 0;
 
   {
     scoring_entry_t *e = scoring_report_add(report, "have_vct", 1);
@@ -1276,6 +2969,7 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
       e->have_vct = have_vct;
       e->score = have_vct ? WIN_SCORE : 0;
       e->time_ms = (get_current_time() - step_start) * 1000.0;
+      scoring_entry_count_work(e, game, &stage_start);
       if (have_vct) {
         e->decisive = 1;
         e->vct_length = vct_len;
@@ -1303,9 +2997,15 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
   // STEP 4: Defensive VCT — can opponent force a win?
   // =========================================================================
   step_start = get_current_time();
+  stage_start = stage_counters_now(game);
+  if (full_timeout > 0) {
+    game->move_timeout = full_timeout * VCT_TIME_FRACTION;
+  }
   int dvct_x = -1, dvct_y = -1;
   int opp_has_vct =
       find_forced_win_block(game, game->board, ai_player, 10, &dvct_x, &dvct_y);
+  game->move_timeout = full_timeout;
+  game->search_timed_out = 0;
 
   {
     scoring_entry_t *e = scoring_report_add(report, "block_vct", 0);
@@ -1313,6 +3013,7 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
       e->have_vct = opp_has_vct;
       e->score = opp_has_vct ? -WIN_SCORE : 0;
       e->time_ms = (get_current_time() - step_start) * 1000.0;
+      scoring_entry_count_work(e, game, &stage_start);
       if (opp_has_vct && dvct_x >= 0)
         e->decisive = 1;
       if (opp_has_vct)
@@ -1341,10 +3042,52 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
   // STEP 5: Minimax search
   // =========================================================================
   step_start = get_current_time();
+  stage_start = stage_counters_now(game);
+
+  // Alternative backend (--engine=mcts): the tactical steps above still
+  // ran, so the position holds no immediate five/open-four/VCT; MCTS
+  // replaces only the deep search.
+  if (game->config.engine == ENGINE_MCTS) {
+    int mcts_value = 0;
+    int sims = mcts_search(game, ai_player, best_x, best_y, &mcts_value);
+    if (sims == 0 && move_count > 0) {
+      *best_x = moves[0].x; // Arena allocation failed or board was full
+      *best_y = moves[0].y;
+    }
+    scoring_entry_t *e = scoring_report_add(report, "mcts", 1);
+    if (e) {
+      e->evaluated_moves = sims;
+      e->score = mcts_value;
+      e->time_ms = (get_current_time() - step_start) * 1000.0;
+      scoring_entry_count_work(e, game, &stage_start);
+      e->decisive = 1;
+    }
+    report->offensive_max_score =
+        max(report->offensive_max_score, mcts_value);
+    double elapsed = get_current_time() - game->search_start_time;
+    snprintf(game->ai_status_message, sizeof(game->ai_status_message),
+             "MCTS: %d playouts in %.0fs", sims, elapsed);
+    add_ai_history_entry(game, sims);
+    return;
+  }
 
   // Sort moves by priority (best first)
   qsort(moves, move_count, sizeof(move_t), compare_moves);
 
+  // Lazy-SMP: helper threads search this same root at staggered depths on
+  // private clones, sharing the master's transposition table. The master
+  // loop below is unchanged and its answer is the one played; helpers only
+  // warm the shared table.
+  smp_pool_t smp;
+  if (game->parallel_root && game->search_threads > 1) {
+    // Root-split mode uses the threads inside each depth iteration instead
+    // of staggered helper searches.
+    smp.stop = 0;
+    smp.count = 0;
+  } else {
+    smp_start_helpers(&smp, game, ai_player);
+  }
+
   int moves_considered = 0;
 
   // Ensure we have a fallback move in case timeout occurs immediately
@@ -1355,100 +3098,227 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
 
   int final_best_score = -WIN_SCORE - 1;
 
+  // Predictive time management: completion times of the last two finished
+  // iterations give an effective branching factor, and a new depth is only
+  // started when its predicted cost still fits the remaining budget.
+  // Doomed final iterations used to burn whole seconds and then throw the
+  // partial result away.
+  double prev_iter_time = 0.0;
+  double prev_prev_iter_time = 0.0;
+
   // Iterative deepening search
+  int roots_scored = 0; // At least one depth completed with exact root scores
+
   for (int current_depth = 1; current_depth <= game->max_depth;
        current_depth++) {
     if (is_search_timed_out(game)) {
       break;
     }
 
-    int depth_best_score = -WIN_SCORE - 1;
-
-    // Track all moves with the best score for random selection
-    int best_moves_x[361];
-    int best_moves_y[361];
-    int best_moves_count = 0;
-
-    // Search all moves at current depth
-    for (int m = 0; m < move_count; m++) {
-      // Check for timeout before evaluating each move
-      if (is_search_timed_out(game)) {
-        game->search_timed_out = 1;
+    if (game->move_timeout > 0 && prev_iter_time > 0.0) {
+      double ebf = (prev_prev_iter_time > 0.0)
+                       ? prev_iter_time / prev_prev_iter_time
+                       : 4.0;
+      // Clamp: early iterations are noisy (TT warm-up, tiny times) and an
+      // unclamped ratio would either never stop or stop after depth 2.
+      if (ebf < 2.0) {
+        ebf = 2.0;
+      } else if (ebf > 12.0) {
+        ebf = 12.0;
+      }
+      double elapsed = get_current_time() - game->search_start_time;
+      if (elapsed + prev_iter_time * ebf >= game->move_timeout) {
         break;
       }
+    }
+    double iter_start_time = get_current_time();
+    game->search_progress_depth = current_depth;
 
-      int i = moves[m].x;
-      int j = moves[m].y;
-
-      game->board[i][j] = ai_player;
+    int depth_best_score = -WIN_SCORE - 1;
 
-      // Update hash incrementally
-      int player_index = (ai_player == AI_CELL_CROSSES) ? 0 : 1;
-      int pos = i * game->board_size + j;
-      game->current_hash ^= game->zobrist_keys[player_index][pos];
-      invalidate_winner_cache(game);
+    // Root-split parallel path: partition this depth's root moves across
+    // the configured threads. Tie-breaking random selection only applies
+    // to the sequential path; the split picks the strict maximum.
+    if (game->parallel_root && game->search_threads > 1) {
+      int px, py, pscore, pconsidered;
+      if (search_root_parallel(game, moves, move_count, ai_player,
+                               current_depth, &px, &py, &pscore,
+                               &pconsidered)) {
+        moves_considered += pconsidered;
+        if (!game->search_timed_out) {
+          prev_prev_iter_time = prev_iter_time;
+          prev_iter_time = get_current_time() - iter_start_time;
+        }
+        if (px >= 0 && (!game->search_timed_out || *best_x == -1)) {
+          *best_x = px;
+          *best_y = py;
+          final_best_score = pscore;
+        }
+        if (pscore >= WIN_SCORE - 1000) {
+          snprintf(game->ai_status_message, sizeof(game->ai_status_message),
+                   "%s%s%s Win (depth %d, %d moves).", COLOR_BLUE, "O",
+                   COLOR_RESET, current_depth, moves_considered);
+          scoring_entry_t *e = scoring_report_add(report, "minimax", 1);
+          if (e) {
+            e->evaluated_moves = moves_considered;
+            e->score = pscore;
+            e->have_win = 1;
+            e->time_ms = (get_current_time() - step_start) * 1000.0;
+            scoring_entry_count_work(e, game, &stage_start);
+          }
+          report->offensive_max_score =
+              max(report->offensive_max_score, pscore);
+          add_ai_history_entry(game, moves_considered);
+          smp_stop_helpers(&smp);
+          return;
+        }
+        continue;
+      }
+      // Spawn failure: fall through to the sequential scan below.
+    }
 
-      int score = minimax_with_timeout(game, game->board, current_depth - 1,
-                                       -WIN_SCORE - 1, WIN_SCORE + 1, 0,
-                                       ai_player, i, j);
+    // Per-move scores from this depth's scan, used to reorder the roots
+    // for the next iteration.
+    int *root_scores = ws->root_scores;
 
-      // Restore hash
-      game->current_hash ^= game->zobrist_keys[player_index][pos];
-      invalidate_winner_cache(game);
+    // Aspiration: search inside a window seeded from the previous depth's
+    // score, falling back to one full-window re-search when the result
+    // lands on or outside a bound. The root split above stays full-window;
+    // its workers manage their own shared alpha.
+    int asp_alpha, asp_beta;
+    int narrowed =
+        get_aspiration_window(game, current_depth, &asp_alpha, &asp_beta) &&
+        (asp_alpha > -WIN_SCORE || asp_beta < WIN_SCORE);
 
-      game->board[i][j] = AI_CELL_EMPTY;
+    // Track all moves with the best score for random selection
+    int *best_moves_x = ws->best_moves_x;
+    int *best_moves_y = ws->best_moves_y;
+    int best_moves_count = 0;
 
-      if (score > depth_best_score) {
-        depth_best_score = score;
-        best_moves_x[0] = i;
-        best_moves_y[0] = j;
-        best_moves_count = 1;
+    for (int attempt = 0; attempt < 2; attempt++) {
+      int window_alpha = (narrowed && attempt == 0) ? asp_alpha : -WIN_SCORE - 1;
+      int window_beta = (narrowed && attempt == 0) ? asp_beta : WIN_SCORE + 1;
+      depth_best_score = -WIN_SCORE - 1;
+      best_moves_count = 0;
+
+      // Search all moves at current depth
+      for (int m = 0; m < move_count; m++) {
+        // Check for timeout before evaluating each move
+        if (is_search_timed_out(game)) {
+          game->search_timed_out = 1;
+          break;
+        }
 
-        if (score >= WIN_SCORE - 1000) {
-          snprintf(game->ai_status_message, sizeof(game->ai_status_message),
-                   "%s%s%s Win (depth %d, %d moves).", COLOR_BLUE, "O",
-                   COLOR_RESET, current_depth, moves_considered + 1);
-          *best_x = i;
-          *best_y = j;
-          final_best_score = score;
-          add_ai_history_entry(game, moves_considered + 1);
-
-          // Record minimax scoring entry before returning
-          {
-            scoring_entry_t *e = scoring_report_add(report, "minimax", 1);
-            if (e) {
-              e->evaluated_moves = moves_considered + 1;
-              e->score = score;
-              e->have_win = 1;
-              e->time_ms = (get_current_time() - step_start) * 1000.0;
+        int i = moves[m].x;
+        int j = moves[m].y;
+
+        search_make_move(game, game->board, i, j, ai_player);
+
+        int score = minimax_with_timeout(game, game->board, current_depth - 1,
+                                         window_alpha, window_beta, 0,
+                                         ai_player, i, j);
+
+        search_unmake_move(game, game->board, i, j, ai_player);
+
+        root_scores[m] = score;
+
+        if (score > depth_best_score) {
+          depth_best_score = score;
+          best_moves_x[0] = i;
+          best_moves_y[0] = j;
+          best_moves_count = 1;
+
+          if (score >= WIN_SCORE - 1000) {
+            snprintf(game->ai_status_message, sizeof(game->ai_status_message),
+                     "%s%s%s Win (depth %d, %d moves).", COLOR_BLUE, "O",
+                     COLOR_RESET, current_depth, moves_considered + 1);
+            *best_x = i;
+            *best_y = j;
+            final_best_score = score;
+            add_ai_history_entry(game, moves_considered + 1);
+
+            // Record minimax scoring entry before returning
+            {
+              scoring_entry_t *e = scoring_report_add(report, "minimax", 1);
+              if (e) {
+                e->evaluated_moves = moves_considered + 1;
+                e->score = score;
+                e->have_win = 1;
+                e->time_ms = (get_current_time() - step_start) * 1000.0;
+                scoring_entry_count_work(e, game, &stage_start);
+              }
+              report->offensive_max_score =
+                  max(report->offensive_max_score, score);
             }
-            report->offensive_max_score =
-                max(report->offensive_max_score, score);
+            smp_stop_helpers(&smp);
+            return;
           }
-          return;
+        } else if (score == depth_best_score && best_moves_count < 361) {
+          best_moves_x[best_moves_count] = i;
+          best_moves_y[best_moves_count] = j;
+          best_moves_count++;
+        }
+
+        moves_considered++;
+        if (current_depth == game->max_depth && !game->config.headless &&
+            !game->background_search) {
+          printf("%s•%s", COLOR_BLUE, COLOR_RESET);
+          fflush(stdout);
         }
-      } else if (score == depth_best_score && best_moves_count < 361) {
-        best_moves_x[best_moves_count] = i;
-        best_moves_y[best_moves_count] = j;
-        best_moves_count++;
-      }
 
-      moves_considered++;
-      if (current_depth == game->max_depth && !game->config.headless) {
-        printf("%s•%s", COLOR_BLUE, COLOR_RESET);
-        fflush(stdout);
+        if (game->search_timed_out) {
+          break;
+        }
       }
 
       if (game->search_timed_out) {
         break;
       }
+      // Fail low/high against the narrowed window: the clipped scores can't
+      // be trusted, so redo this depth once with the full window.
+      if (narrowed && attempt == 0 &&
+          (depth_best_score <= asp_alpha || depth_best_score >= asp_beta)) {
+        continue;
+      }
+      break;
     }
 
     if (!game->search_timed_out && best_moves_count > 0) {
-      int selected = rand() % best_moves_count;
+      int selected = (int)(game_rand(game) % (uint32_t)best_moves_count);
       *best_x = best_moves_x[selected];
       *best_y = best_moves_y[selected];
       final_best_score = depth_best_score;
+      // Seed the next depth's window around this depth's exact score.
+      update_aspiration_window(game, current_depth + 1, depth_best_score,
+                               -WIN_SCORE, WIN_SCORE);
+
+      // Re-sort the roots by this depth's exact scores so the next
+      // iteration searches the PV first and fails fast on the rest.
+      for (int m = 0; m < move_count; m++) {
+        moves[m].priority = root_scores[m];
+      }
+      qsort(moves, move_count, sizeof(move_t), compare_moves);
+      roots_scored = 1;
+
+      // Feed the time predictor with this completed iteration.
+      prev_prev_iter_time = prev_iter_time;
+      prev_iter_time = get_current_time() - iter_start_time;
+    }
+  }
+
+  smp_stop_helpers(&smp);
+
+  // Multi-PV: the sequential root loop scores every root exactly at each
+  // completed depth and re-sorts moves[] by those scores, so the top-K
+  // lines fall out of the single search for free.
+  if (game->config.multipv > 1 && roots_scored) {
+    int k = min(game->config.multipv, min(move_count, MULTIPV_MAX));
+    for (int m = 0; m < k; m++) {
+      multipv_entry_t *entry = &game->multipv_results[game->multipv_count++];
+      entry->x = moves[m].x;
+      entry->y = moves[m].y;
+      entry->score = moves[m].priority;
+      multipv_extract_pv(game, entry->x, entry->y, ai_player, entry);
     }
   }
 
@@ -1458,6 +3328,7 @@ void find_best_ai_move(game_state_t *game, int *best_x, int *best_y,
       e->evaluated_moves = moves_considered;
       e->score = final_best_score;
       e->time_ms = (get_current_time() - step_start) * 1000.0;
+      scoring_entry_count_work(e, game, &stage_start);
     }
     report->offensive_max_score =
         max(report->offensive_max_score, final_best_score);
@@ -33,6 +33,15 @@ typedef struct {
     int have_vct;                // boolean: did we find a VCT?
     int vct_sequence[MAX_VCT_SEQUENCE][2]; // VCT move sequence [(x,y), ...]
     int vct_length;              // number of moves in VCT sequence
+    // Work breakdown: deltas of the game_state_t counters around this
+    // stage, so a blown deadline can be attributed to the stage that
+    // actually burned the nodes rather than just the one that ran last.
+    uint64_t nodes;              // search nodes entered (pvs/quiescence/VCT)
+    uint64_t tt_probes;          // TT probes issued
+    uint64_t tt_hits;            // TT probes answered
+    uint64_t tt_stores;          // TT entries written
+    uint64_t movegen_calls;      // move generator runs
+    uint64_t eval_calls;         // leaf evaluations
 } scoring_entry_t;
 
 /**
@@ -43,6 +52,11 @@ typedef struct {
     int entry_count;
     int offensive_max_score;     // best score our algorithm can achieve
     int defensive_max_score;     // best score opponent can achieve (negative)
+#ifdef GOMOKU_PROFILE
+    // Snapshot of the per-game hot-path counters taken at the end of the
+    // search (see profile_counters_t in game.h; PROFILE builds only).
+    profile_counters_t profile;
+#endif
 } scoring_report_t;
 
 /**
@@ -52,6 +66,9 @@ static inline void scoring_report_init(scoring_report_t *report) {
     report->entry_count = 0;
     report->offensive_max_score = 0;
     report->defensive_max_score = 0;
+#ifdef GOMOKU_PROFILE
+    memset(&report->profile, 0, sizeof(report->profile));
+#endif
 }
 
 /**
@@ -71,6 +88,12 @@ static inline scoring_entry_t *scoring_report_add(scoring_report_t *report,
     e->have_win = 0;
     e->have_vct = 0;
     e->vct_length = 0;
+    e->nodes = 0;
+    e->tt_probes = 0;
+    e->tt_hits = 0;
+    e->tt_stores = 0;
+    e->movegen_calls = 0;
+    e->eval_calls = 0;
     return e;
 }
 
@@ -117,7 +140,7 @@ void find_first_ai_move(game_state_t *game, int *best_x, int *best_y);
  * @param last_y Y coordinate of last move
  * @return Best evaluation score
  */
-int minimax_with_timeout(game_state_t *game, int **board, int depth, int alpha, int beta,
+int minimax_with_timeout(game_state_t *game, cell_t **board, int depth, int alpha, int beta,
         int maximizing_player, int ai_player, int last_x, int last_y);
 
 /**
@@ -132,7 +155,7 @@ int minimax_with_timeout(game_state_t *game, int **board, int depth, int alpha,
  * @param ai_player The AI player
  * @return Best evaluation score
  */
-int minimax(int **board, int board_size, int depth, int alpha, int beta,
+int minimax(cell_t **board, int board_size, int depth, int alpha, int beta,
         int maximizing_player, int ai_player);
 
 //===============================================================================
@@ -155,7 +178,19 @@ typedef struct {
  * @param current_player The current player
  * @return Number of moves generated
  */
-int generate_moves_optimized(game_state_t *game, int **board, move_t *moves, int current_player, int depth_remaining);
+int generate_moves_optimized(game_state_t *game, cell_t **board, move_t *moves, int current_player, int depth_remaining);
+
+/**
+ * Threat-space candidate generation (Allis 1994): collect only the empty
+ * cells where `player` creates a four-level or compound threat, found by
+ * walking the four lines through each of the player's stones. Typically
+ * 5-10 candidates instead of the ~100 the radius scan produces, which is
+ * what makes per-node regeneration affordable in the VCT search.
+ *
+ * @param moves Output array (sorted by threat score, priority = score)
+ * @return Number of candidates found
+ */
+int generate_threat_space_moves(game_state_t *game, cell_t **board, int player, move_t *moves);
 
 /**
  * Optimized move prioritization that avoids expensive temporary placements.
@@ -166,7 +201,7 @@ int generate_moves_optimized(game_state_t *game, int **board, move_t *moves, int
  * @param player The player making the move
  * @return Priority score for the move
  */
-int get_move_priority_optimized(game_state_t *game, int **board, int x, int y, int player, int depth_remaining);
+int get_move_priority_optimized(game_state_t *game, cell_t **board, int x, int y, int player, int depth_remaining);
 
 /**
  * Fast threat evaluation without temporary board modifications.
@@ -178,7 +213,27 @@ int get_move_priority_optimized(game_state_t *game, int **board, int x, int y, i
  * @param board_size Size of the board
  * @return Threat score for the move
  */
-int evaluate_threat_fast(int **board, int x, int y, int player, int board_size);
+int evaluate_threat_fast(cell_t **board, int x, int y, int player, int board_size);
+
+/**
+ * Cache-backed evaluate_threat_fast: returns the per-cell cached score
+ * when valid, computing and storing it otherwise. The cache lives in
+ * game_state_t and is invalidated along the four lines through every
+ * placed/removed stone, so hot loops (move priorities, STEP 1-2 bulk
+ * scans, threat-space generation) turn repeat evaluations into lookups.
+ * Only valid when `board` is the game's own board.
+ */
+int evaluate_threat_cached(game_state_t *game, cell_t **board, int x, int y, int player);
+
+/**
+ * Batch evaluation of a candidate array for BOTH players in one pass.
+ * Each cell's four lines are extracted from the board once (vectorized
+ * where the row is contiguous) and classified twice, then both per-player
+ * cache entries are stored. Cells whose entries are already valid are
+ * skipped. Move generation runs this over the candidate set so the
+ * priority scorer and the STEP 1/2 root sweeps hit a warm cache.
+ */
+void evaluate_threats_batch(game_state_t *game, cell_t **board, const move_t *moves, int count);
 
 /**
  * Checks if a move position is "interesting" (within range of existing stones).
@@ -191,7 +246,7 @@ int evaluate_threat_fast(int **board, int x, int y, int player, int board_size);
  * @param radius Search radius to check around the position
  * @return 1 if interesting, 0 otherwise
  */
-int is_move_interesting(int **board, int x, int y, int stones_on_board, int board_size, int radius);
+int is_move_interesting(cell_t **board, int x, int y, int stones_on_board, int board_size, int radius);
 
 /**
  * Checks if a move results in an immediate win.
@@ -203,7 +258,7 @@ int is_move_interesting(int **board, int x, int y, int stones_on_board, int boar
  * @param board_size Size of the board
  * @return 1 if winning move, 0 otherwise
  */
-int is_winning_move(int **board, int x, int y, int player, int board_size);
+int is_winning_move(cell_t **board, int x, int y, int player, int board_size);
 
 /**
  * Calculates move priority for ordering (higher = better).
@@ -215,7 +270,7 @@ int is_winning_move(int **board, int x, int y, int player, int board_size);
  * @param board_size Size of the board
  * @return Priority score for the move
  */
-int get_move_priority(int **board, int x, int y, int player, int board_size);
+int get_move_priority(cell_t **board, int x, int y, int player, int board_size);
 
 /**
  * Comparison function for sorting moves by priority (descending).
@@ -242,7 +297,7 @@ int compare_moves(const void *a, const void *b);
  * @param block_y Pointer to store block cell column
  * @return 1 if a single block cell found, 0 if open four (2 cells) or none
  */
-int find_block_cell(int **board, int x, int y, int player, int board_size,
+int find_block_cell(cell_t **board, int x, int y, int player, int board_size,
                     int *block_x, int *block_y);
 
 /**
@@ -258,7 +313,7 @@ int find_block_cell(int **board, int x, int y, int player, int board_size,
  * @param seq_len Pointer to store sequence length (if sequence is non-NULL)
  * @return 1 if forced win found, 0 otherwise
  */
-int find_forced_win(game_state_t *game, int **board, int player, int max_depth,
+int find_forced_win(game_state_t *game, cell_t **board, int player, int max_depth,
                     int *result_x, int *result_y,
                     int sequence[][2], int *seq_len);
 
@@ -273,7 +328,7 @@ int find_forced_win(game_state_t *game, int **board, int player, int max_depth,
  * @param result_y Pointer to store the disrupting move's column
  * @return 1 if opponent has a VCT and we found a disrupting move, 0 if no threat
  */
-int find_forced_win_block(game_state_t *game, int **board, int ai_player,
+int find_forced_win_block(game_state_t *game, cell_t **board, int ai_player,
                           int max_depth, int *result_x, int *result_y);
 
 #endif // AI_H
@@ -0,0 +1,50 @@
+//
+//  arena.c
+//  gomoku - bump-pointer arena for search-transient allocations
+//
+
+#include "arena.h"
+
+#include <stdlib.h>
+
+// Every allocation is rounded up to this alignment, which satisfies any
+// scalar or SIMD-loaded type the search keeps in transient storage.
+#define ARENA_ALIGN 16
+
+void arena_init(arena_t *arena) {
+  arena->base = NULL;
+  arena->capacity = 0;
+  arena->used = 0;
+}
+
+int arena_reserve(arena_t *arena, size_t capacity) {
+  if (arena->capacity >= capacity) {
+    return 1;
+  }
+  unsigned char *block = malloc(capacity);
+  if (!block) {
+    return 0;
+  }
+  free(arena->base);
+  arena->base = block;
+  arena->capacity = capacity;
+  arena->used = 0;
+  return 1;
+}
+
+void *arena_alloc(arena_t *arena, size_t size) {
+  size_t rounded = (size + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1);
+  if (rounded < size || arena->used + rounded > arena->capacity) {
+    return NULL;
+  }
+  void *block = arena->base + arena->used;
+  arena->used += rounded;
+  return block;
+}
+
+void arena_reset(arena_t *arena) { arena->used = 0; }
+
+void arena_destroy(arena_t *arena) {
+  free(arena->base);
+  arena_init(arena);
+}
@@ -0,0 +1,62 @@
+//
+//  arena.h
+//  gomoku - bump-pointer arena for search-transient allocations
+//
+//  Search-transient data (root candidate workspaces, VCT sequences,
+//  future incremental threat structures) lives for exactly one move
+//  decision. A bump-pointer arena owned by the search context makes
+//  those allocations a pointer increment, frees them all with a single
+//  reset per move, and keeps the multi-threaded story simple: each
+//  Lazy-SMP clone carries its own arena, so search threads never
+//  contend on the process allocator.
+//
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/**
+ * A single-block bump allocator. Zero-initialized (or arena_init'ed)
+ * arenas own no memory; the backing block is reserved explicitly and
+ * kept across resets until arena_destroy.
+ */
+typedef struct {
+    unsigned char *base;   // Backing block (NULL until reserved)
+    size_t capacity;       // Size of the backing block in bytes
+    size_t used;           // Bump offset of the next allocation
+} arena_t;
+
+/**
+ * Initialize an arena to the empty state (no backing memory).
+ */
+void arena_init(arena_t *arena);
+
+/**
+ * Ensure the arena owns a backing block of at least `capacity` bytes.
+ * Growing an arena with live allocations is not supported, so callers
+ * reserve before the first arena_alloc of a cycle (typically once, at
+ * search start). Returns 1 on success, 0 on allocation failure — the
+ * arena stays usable at its previous capacity.
+ */
+int arena_reserve(arena_t *arena, size_t capacity);
+
+/**
+ * Allocate `size` bytes from the arena, aligned to 16 bytes. Returns
+ * NULL when the arena is unreserved or exhausted; callers fall back to
+ * their pre-arena path (typically a stack buffer).
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * Forget every allocation without releasing the backing block. Called
+ * once per move decision at search start.
+ */
+void arena_reset(arena_t *arena);
+
+/**
+ * Release the backing block and return the arena to the empty state.
+ */
+void arena_destroy(arena_t *arena);
+
+#endif // ARENA_H
@@ -0,0 +1,202 @@
+//
+//  bitboard.c
+//  gomoku - Word-parallel bitboard mirror of the search board
+//
+//  Implements placement, five-in-a-row detection, and candidate dilation
+//  on per-row bitmasks. See bitboard.h for the sync contract with the
+//  legacy int** board.
+//
+
+#include "bitboard.h"
+#include "gomoku.h"
+#include <string.h>
+
+// Mask of the valid columns for the current board size.
+static inline uint32_t row_mask(int size) {
+  return ((uint32_t)1 << size) - 1;
+}
+
+static inline int popcount32(uint32_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcount(v);
+#else
+  int count = 0;
+  while (v) {
+    v &= v - 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
+void bitboard_reset(bitboard_t *bb, int size, int cand_radius) {
+  memset(bb->rows, 0, sizeof(bb->rows));
+  memset(bb->cand_rows, 0, sizeof(bb->cand_rows));
+  memset(bb->cand_count, 0, sizeof(bb->cand_count));
+  bb->cand_radius = cand_radius;
+  bb->size = size;
+
+  // Precompute the clipped neighborhoods once per (size, radius) pair so
+  // update_candidate_counts never tests board edges in its inner loop.
+  for (int i = 0; i < size; i++) {
+    int lo = i - cand_radius < 0 ? 0 : i - cand_radius;
+    int hi = i + cand_radius >= size ? size - 1 : i + cand_radius;
+    bb->nbr_row_lo[i] = (uint8_t)lo;
+    bb->nbr_row_hi[i] = (uint8_t)hi;
+    // Span mask covering columns lo..hi inclusive.
+    bb->nbr_col_mask[i] = (((uint32_t)1 << (hi - lo + 1)) - 1) << lo;
+  }
+}
+
+/**
+ * Adjusts the neighbor counts around a placed/removed stone. `delta` is
+ * +1 on place, -1 on remove; cand_rows bits flip on 0<->1 transitions.
+ * The affected cells come from the tables built in bitboard_reset, so the
+ * loop carries no edge-clipping branches.
+ */
+static void update_candidate_counts(bitboard_t *bb, int x, int y, int delta) {
+  uint32_t col_mask = bb->nbr_col_mask[y];
+  int lo = bb->nbr_row_lo[x];
+  int hi = bb->nbr_row_hi[x];
+
+  for (int nx = lo; nx <= hi; nx++) {
+    uint8_t *counts = bb->cand_count[nx];
+    uint32_t nonzero = 0;
+    for (uint32_t m = col_mask; m; m &= m - 1) {
+      int ny = __builtin_ctz(m);
+      counts[ny] = (uint8_t)(counts[ny] + delta);
+      if (counts[ny]) {
+        nonzero |= (uint32_t)1 << ny;
+      }
+    }
+    bb->cand_rows[nx] = (bb->cand_rows[nx] & ~col_mask) | nonzero;
+  }
+}
+
+void bitboard_place(bitboard_t *bb, int x, int y, int player) {
+  bb->rows[bitboard_player_index(player)][x] |= (uint32_t)1 << y;
+  update_candidate_counts(bb, x, y, +1);
+}
+
+void bitboard_remove(bitboard_t *bb, int x, int y, int player) {
+  bb->rows[bitboard_player_index(player)][x] &= ~((uint32_t)1 << y);
+  update_candidate_counts(bb, x, y, -1);
+}
+
+void bitboard_sync(bitboard_t *bb, cell_t **board, int size, int cand_radius) {
+  bitboard_reset(bb, size, cand_radius);
+  for (int x = 0; x < size; x++) {
+    uint32_t crosses = 0, naughts = 0;
+    for (int y = 0; y < size; y++) {
+      if (board[x][y] == AI_CELL_CROSSES) {
+        crosses |= (uint32_t)1 << y;
+        update_candidate_counts(bb, x, y, +1);
+      } else if (board[x][y] == AI_CELL_NAUGHTS) {
+        naughts |= (uint32_t)1 << y;
+        update_candidate_counts(bb, x, y, +1);
+      }
+    }
+    bb->rows[BB_CROSSES][x] = crosses;
+    bb->rows[BB_NAUGHTS][x] = naughts;
+  }
+}
+
+int bitboard_stone_count(const bitboard_t *bb) {
+  int count = 0;
+  for (int x = 0; x < bb->size; x++) {
+    count += popcount32(bitboard_occupied_row(bb, x));
+  }
+  return count;
+}
+
+/**
+ * Exactly-five detection along rows of a (possibly shifted/combined) mask
+ * array. `runs` holds, per row, the bits where a stone run exists in the
+ * direction being tested after the caller folded the direction into
+ * horizontal form. For the horizontal case this is just the player rows.
+ */
+static int has_exact_five_horizontal(const uint32_t *rows, int size) {
+  for (int x = 0; x < size; x++) {
+    uint32_t m = rows[x];
+    if (!m) {
+      continue;
+    }
+    // starts holds bits where a run of >= 5 begins.
+    uint32_t starts = m & (m >> 1) & (m >> 2) & (m >> 3) & (m >> 4);
+    // Exactly five: no stone immediately before the run or after it.
+    starts &= ~(m << 1);
+    starts &= ~(m >> 5);
+    if (starts) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int bitboard_has_five(const bitboard_t *bb, int player) {
+  const uint32_t *rows = bb->rows[bitboard_player_index(player)];
+  int size = bb->size;
+
+  // Horizontal runs within each row word.
+  if (has_exact_five_horizontal(rows, size)) {
+    return 1;
+  }
+
+  // Vertical: AND five consecutive rows; guard rows enforce exactly five.
+  for (int x = 0; x + 4 < size; x++) {
+    uint32_t runs =
+        rows[x] & rows[x + 1] & rows[x + 2] & rows[x + 3] & rows[x + 4];
+    if (!runs) {
+      continue;
+    }
+    if (x > 0) {
+      runs &= ~rows[x - 1];
+    }
+    if (x + 5 < size) {
+      runs &= ~rows[x + 5];
+    }
+    if (runs) {
+      return 1;
+    }
+  }
+
+  // Diagonal ↘ (row+1, col+1): shift each successive row right so the
+  // diagonal folds onto the starting column, then AND.
+  for (int x = 0; x + 4 < size; x++) {
+    uint32_t runs = rows[x] & (rows[x + 1] >> 1) & (rows[x + 2] >> 2) &
+                    (rows[x + 3] >> 3) & (rows[x + 4] >> 4);
+    if (!runs) {
+      continue;
+    }
+    if (x > 0) {
+      runs &= ~(rows[x - 1] << 1);
+    }
+    if (x + 5 < size) {
+      runs &= ~(rows[x + 5] >> 5);
+    }
+    if (runs) {
+      return 1;
+    }
+  }
+
+  // Diagonal ↗ folded as (row+1, col-1): shift left instead.
+  for (int x = 0; x + 4 < size; x++) {
+    uint32_t runs = rows[x] & (rows[x + 1] << 1) & (rows[x + 2] << 2) &
+                    (rows[x + 3] << 3) & (rows[x + 4] << 4);
+    if (!runs) {
+      continue;
+    }
+    if (x > 0) {
+      runs &= ~(rows[x - 1] >> 1);
+    }
+    if (x + 5 < size) {
+      runs &= ~(rows[x + 5] << 5);
+    }
+    runs &= row_mask(size);
+    if (runs) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
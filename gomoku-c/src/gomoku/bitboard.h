@@ -0,0 +1,169 @@
+//
+//  bitboard.h
+//  gomoku - Word-parallel bitboard mirror of the search board
+//
+//  Maintains one bit row per board row per player so the hot search paths
+//  (candidate generation, five-in-a-row detection, stone counting) run on
+//  word operations instead of chasing int** rows cell by cell.
+//
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+
+#include "gomoku.h"
+
+#define BITBOARD_MAX_SIZE 19
+
+// Player slot indices into bitboard_t.rows (same convention as the
+// zobrist_keys / transposition_table arrays in game.h).
+#define BB_CROSSES 0
+#define BB_NAUGHTS 1
+
+/**
+ * Per-player row bitmasks. rows[p][x] bit y is set when player p has a
+ * stone at (x, y). A 32-bit word covers the full 19-cell row, so every
+ * line query is a handful of shifts and ANDs. The legacy int** board in
+ * game_state_t stays authoritative at the game.c boundary; this mirror
+ * is only consulted (and must be kept in sync) inside the search.
+ */
+typedef struct {
+  uint32_t rows[2][BITBOARD_MAX_SIZE];
+  // Incrementally maintained candidate set: cand_count[x][y] is the number
+  // of stones within cand_radius (Chebyshev) of (x, y); cand_rows[x] has
+  // bit y set whenever that count is non-zero. Updated on every place and
+  // remove, so move generation never rescans or re-dilates the board.
+  uint32_t cand_rows[BITBOARD_MAX_SIZE];
+  uint8_t cand_count[BITBOARD_MAX_SIZE][BITBOARD_MAX_SIZE];
+  // Precomputed clipped neighborhoods, filled in at reset time for the
+  // current size/cand_radius pair: nbr_col_mask[i] is the column span mask
+  // within cand_radius of column i, and nbr_row_lo/hi[i] bound the row span
+  // around row i. The candidate update loop walks these tables instead of
+  // re-clipping (dx, dy) pairs against the board edges on every placement.
+  uint32_t nbr_col_mask[BITBOARD_MAX_SIZE];
+  uint8_t nbr_row_lo[BITBOARD_MAX_SIZE];
+  uint8_t nbr_row_hi[BITBOARD_MAX_SIZE];
+  int cand_radius;
+  int size;
+} bitboard_t;
+
+/**
+ * Maps an AI_CELL_* player value to a bitboard row index.
+ *
+ * @param player AI_CELL_CROSSES or AI_CELL_NAUGHTS
+ * @return BB_CROSSES or BB_NAUGHTS
+ */
+static inline int bitboard_player_index(int player) {
+  return (player == AI_CELL_CROSSES) ? BB_CROSSES : BB_NAUGHTS;
+}
+
+/**
+ * Tests whether (x, y) lies within Chebyshev distance r of any stone.
+ * Used to tighten the candidate set below the configured cand_radius at
+ * shallow remaining depths; a window of occupied-row words is enough.
+ *
+ * @param bb The bitboard
+ * @param x Row coordinate
+ * @param y Column coordinate
+ * @param r Radius to test (must be <= cand_radius to be meaningful)
+ * @return 1 when a stone sits within r of (x, y)
+ */
+static inline int bitboard_near_stone(const bitboard_t *bb, int x, int y,
+                                      int r) {
+  int lo = y - r > 0 ? y - r : 0;
+  uint32_t window = (((uint32_t)1 << (y + r - lo + 1)) - 1) << lo;
+  int row_lo = x - r > 0 ? x - r : 0;
+  int row_hi = x + r < bb->size - 1 ? x + r : bb->size - 1;
+  for (int row = row_lo; row <= row_hi; row++) {
+    if ((bb->rows[BB_CROSSES][row] | bb->rows[BB_NAUGHTS][row]) & window) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Clears the bitboard and sets its size and candidate radius.
+ *
+ * @param bb The bitboard
+ * @param size Board size (<= BITBOARD_MAX_SIZE)
+ * @param cand_radius Radius for the incremental candidate set
+ */
+void bitboard_reset(bitboard_t *bb, int size, int cand_radius);
+
+/**
+ * Rebuilds the bitboard from the legacy int** board. Used at game init
+ * and whenever the int** board was mutated outside the search make/unmake
+ * path (undo, replay loading, protocol BOARD command).
+ *
+ * @param bb The bitboard
+ * @param board The authoritative int** board
+ * @param size Board size
+ */
+void bitboard_sync(bitboard_t *bb, cell_t **board, int size, int cand_radius);
+
+/**
+ * Sets the bit for a placed stone and bumps the neighbor counts of the
+ * surrounding cells so the candidate set stays current.
+ *
+ * @param bb The bitboard
+ * @param x Row coordinate
+ * @param y Column coordinate
+ * @param player AI_CELL_CROSSES or AI_CELL_NAUGHTS
+ */
+void bitboard_place(bitboard_t *bb, int x, int y, int player);
+
+/**
+ * Clears the bit for a removed stone and decrements the surrounding
+ * neighbor counts (exact inverse of bitboard_place).
+ *
+ * @param bb The bitboard
+ * @param x Row coordinate
+ * @param y Column coordinate
+ * @param player AI_CELL_CROSSES or AI_CELL_NAUGHTS
+ */
+void bitboard_remove(bitboard_t *bb, int x, int y, int player);
+
+/**
+ * Returns the occupancy mask (both players) for one row.
+ *
+ * @param bb The bitboard
+ * @param x Row coordinate
+ * @return Bitmask of occupied cells in row x
+ */
+static inline uint32_t bitboard_occupied_row(const bitboard_t *bb, int x) {
+  return bb->rows[BB_CROSSES][x] | bb->rows[BB_NAUGHTS][x];
+}
+
+/**
+ * Counts all stones on the board via popcount.
+ *
+ * @param bb The bitboard
+ * @return Total number of stones (both players)
+ */
+int bitboard_stone_count(const bitboard_t *bb);
+
+/**
+ * Word-parallel five-in-a-row detection. Matches has_winner() semantics:
+ * exactly five contiguous stones win, six or more (overline) do not.
+ *
+ * @param bb The bitboard
+ * @param player AI_CELL_CROSSES or AI_CELL_NAUGHTS
+ * @return 1 if player has exactly five in a row anywhere, 0 otherwise
+ */
+int bitboard_has_five(const bitboard_t *bb, int player);
+
+/**
+ * Returns the candidate mask for one row: empty cells within cand_radius
+ * of any stone, read straight from the incrementally maintained counts.
+ *
+ * @param bb The bitboard
+ * @param x Row coordinate
+ * @return Bitmask of candidate cells in row x
+ */
+static inline uint32_t bitboard_candidate_row(const bitboard_t *bb, int x) {
+  return bb->cand_rows[x] & ~bitboard_occupied_row(bb, x);
+}
+
+#endif // BITBOARD_H
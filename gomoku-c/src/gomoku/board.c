@@ -15,44 +15,39 @@
 // BOARD MANAGEMENT FUNCTIONS
 //===============================================================================
 
-int **create_board(int size) {
-  int **new_board = malloc(size * sizeof(int *));
+cell_t **create_board(int size) {
+  // Single contiguous allocation: the row-pointer table followed by the
+  // size*size cell block. Keeps the int** API (hot loops still index
+  // board[x][y]) but rows sit back to back, so diagonal and vertical walks
+  // in the search stay on a predictable stride instead of hopping between
+  // scattered heap blocks.
+  size_t header = (size_t)size * sizeof(cell_t *);
+  size_t cells = (size_t)size * (size_t)size * sizeof(cell_t);
+  cell_t **new_board = malloc(header + cells);
   if (!new_board) {
     return NULL;
   }
 
+  cell_t *cell_block = (cell_t *)((char *)new_board + header);
   for (int i = 0; i < size; i++) {
-    new_board[i] = malloc(size * sizeof(int));
-    if (!new_board[i]) {
-      // Free previously allocated rows on failure
-      for (int j = 0; j < i; j++) {
-        free(new_board[j]);
-      }
-      free(new_board);
-      return NULL;
-    }
-
-    // Initialize cells to empty
-    for (int j = 0; j < size; j++) {
-      new_board[i][j] = AI_CELL_EMPTY;
-    }
+    new_board[i] = cell_block + (size_t)i * size;
+  }
+
+  // Initialize cells to empty
+  for (int i = 0; i < size * size; i++) {
+    cell_block[i] = AI_CELL_EMPTY;
   }
 
   return new_board;
 }
 
-void free_board(int **board, int size) {
-  if (!board) {
-    return;
-  }
-
-  for (int i = 0; i < size; i++) {
-    free(board[i]);
-  }
+void free_board(cell_t **board, int size) {
+  // Row pointers and cells share one allocation (see create_board).
+  (void)size;
   free(board);
 }
 
-int is_valid_move(int **board, int x, int y, int size) {
+int is_valid_move(cell_t **board, int x, int y, int size) {
   return x >= 0 && x < size && y >= 0 && y < size &&
          board[x][y] == AI_CELL_EMPTY;
 }
@@ -21,7 +21,7 @@
  * @param size The size of the square board (e.g., 15 or 19)
  * @return 2D array representing the board, or NULL on failure
  */
-int **create_board(int size);
+cell_t **create_board(int size);
 
 /**
  * Frees the memory allocated for a game board.
@@ -29,7 +29,7 @@ int **create_board(int size);
  * @param board The board to free
  * @param size The size of the board
  */
-void free_board(int **board, int size);
+void free_board(cell_t **board, int size);
 
 /**
  * Checks if a move is valid at the given position.
@@ -40,7 +40,7 @@ void free_board(int **board, int size);
  * @param size Board size
  * @return 1 if valid, 0 if invalid
  */
-int is_valid_move(int **board, int x, int y, int size);
+int is_valid_move(cell_t **board, int x, int y, int size);
 
 //===============================================================================
 // COORDINATE UTILITIES
@@ -0,0 +1,173 @@
+//
+//  book.c
+//  gomoku - binary opening book with O(1) canonical-hash lookup
+//
+//  Reader for the book layout documented in book.h. The file is mapped
+//  like the gamerec corpus: mmap on POSIX, a malloc'd image on the
+//  MinGW brain build. The builder lives in src/tools/gmr2book.c.
+//
+
+#include "book.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+// No mmap on the MinGW brain build: read the file into a malloc'd
+// buffer instead. The probe interface is identical either way.
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define BOOK_FILE_HEADER_SIZE 24
+
+static const book_t *default_book = NULL;
+
+void book_set_default(const book_t *book) { default_book = book; }
+
+const book_t *book_default(void) { return default_book; }
+
+int book_open(book_t *book, const char *path) {
+  memset(book, 0, sizeof(*book));
+
+  uint8_t *base = NULL;
+  size_t size = 0;
+
+#ifdef _WIN32
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    return 0;
+  }
+  fseek(f, 0, SEEK_END);
+  long fsize = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if (fsize <= 0) {
+    fclose(f);
+    return 0;
+  }
+  base = malloc((size_t)fsize);
+  if (!base || fread(base, 1, (size_t)fsize, f) != (size_t)fsize) {
+    free(base);
+    fclose(f);
+    return 0;
+  }
+  fclose(f);
+  size = (size_t)fsize;
+#else
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return 0;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return 0;
+  }
+  size = (size_t)st.st_size;
+  base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    return 0;
+  }
+#ifdef MADV_RANDOM
+  // Probes jump straight to a hashed entry slot; readahead around each
+  // faulted page would only drag in neighbours we never touch.
+  madvise(base, size, MADV_RANDOM);
+#endif
+#endif
+
+  if (size < BOOK_FILE_HEADER_SIZE) {
+    goto fail;
+  }
+
+  uint32_t magic, version, entry_count;
+  uint64_t seed;
+  uint16_t board_size, max_plies;
+  memcpy(&magic, base, 4);
+  memcpy(&version, base + 4, 4);
+  memcpy(&seed, base + 8, 8);
+  memcpy(&board_size, base + 16, 2);
+  memcpy(&max_plies, base + 18, 2);
+  memcpy(&entry_count, base + 20, 4);
+
+  if (magic != BOOK_MAGIC || version != BOOK_VERSION ||
+      seed != ZOBRIST_SEED || board_size < 5 || board_size > 19 ||
+      entry_count == 0 || (entry_count & (entry_count - 1)) != 0 ||
+      size != BOOK_FILE_HEADER_SIZE +
+                  (size_t)entry_count * sizeof(book_entry_t)) {
+    goto fail;
+  }
+
+  book->base = base;
+  book->size = size;
+  book->entries = (const book_entry_t *)(base + BOOK_FILE_HEADER_SIZE);
+  book->entry_count = entry_count;
+  book->board_size = board_size;
+  book->max_plies = max_plies;
+  return 1;
+
+fail:
+#ifdef _WIN32
+  free(base);
+#else
+  munmap(base, size);
+#endif
+  return 0;
+}
+
+void book_close(book_t *book) {
+  if (!book->base) {
+    return;
+  }
+#ifdef _WIN32
+  free((void *)book->base);
+#else
+  munmap((void *)book->base, book->size);
+#endif
+  memset(book, 0, sizeof(*book));
+}
+
+int book_probe(const book_t *book, const game_state_t *game, int *x, int *y) {
+  if (!book || !book->base || !game || book->board_size != game->board_size ||
+      game->stones_on_board > book->max_plies) {
+    return 0;
+  }
+
+  int transform = BOOK_TRANSFORM_IDENTITY;
+  uint64_t key = book_canonical_hash(game, &transform);
+  if (key == 0) {
+    // Only the empty board hashes to 0, which doubles as the empty-slot
+    // sentinel — and the game's first stone needs no book.
+    return 0;
+  }
+
+  uint32_t mask = book->entry_count - 1;
+  uint32_t idx = (uint32_t)key & mask;
+  for (uint32_t step = 0; step < book->entry_count; step++) {
+    const book_entry_t *e = &book->entries[idx];
+    if (e->key == 0) {
+      return 0;
+    }
+    if (e->key == key) {
+      // The stored move is in the canonical orientation; bring it back
+      // into the board's frame.
+      int bx, by;
+      book_transform_xy(book_inverse_transform(transform), game->board_size,
+                        e->x, e->y, &bx, &by);
+      if (bx < 0 || bx >= game->board_size || by < 0 ||
+          by >= game->board_size ||
+          game->board[bx][by] != AI_CELL_EMPTY) {
+        return 0;
+      }
+      *x = bx;
+      *y = by;
+      return 1;
+    }
+    idx = (idx + 1) & mask;
+  }
+  return 0;
+}
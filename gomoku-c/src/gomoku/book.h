@@ -0,0 +1,151 @@
+//
+//  book.h
+//  gomoku - binary opening book with O(1) canonical-hash lookup
+//
+//  find_first_ai_move() is a 16-entry offset table and everything past
+//  ply 2 is searched from scratch, although the games/ corpus already
+//  contains the engine's own openings. A book file compiled offline by
+//  gmr2book (see src/tools/gmr2book.c, `make build-book`) turns those
+//  records into instant moves for the early plies: positions are keyed
+//  by the symmetry-canonical zobrist hash (the minimum over all eight
+//  dihedral orientations, same rule as position_hash in game.h), stored
+//  in an open-addressed table, and probed via mmap with no allocation.
+//
+//  Because the key is canonical, a stored move lives in the orientation
+//  that minimised the hash — the probe maps it back into the board's
+//  frame through the inverse transform, so a game that opens mirrored
+//  still hits the book and gets the correctly mirrored reply.
+//
+//  File layout (little-endian):
+//
+//    uint32 magic        BOOK_MAGIC ('GMKB')
+//    uint32 version      BOOK_VERSION
+//    uint64 zobrist_seed ZOBRIST_SEED of the building binary
+//    uint16 board_size
+//    uint16 max_plies    deepest stone count the builder recorded
+//    uint32 entry_count  power of two
+//
+//  followed by entry_count slots of book_entry_t. key == 0 marks an
+//  empty slot; collisions probe linearly to the next slot.
+//
+
+#ifndef BOOK_H
+#define BOOK_H
+
+#include "game.h"
+
+// 'GMKB' little-endian, mirroring the NNUE/snapshot/gamerec convention.
+#define BOOK_MAGIC 0x424B4D47u
+#define BOOK_VERSION 1
+
+// Book moves are only sound while hashing is symmetry-canonical, which
+// game.h guarantees up to SYM_HASH_STONE_LIMIT stones. The builder and
+// the probe both clamp to this.
+#define BOOK_MAX_PLIES SYM_HASH_STONE_LIMIT
+
+// One open-addressed slot. The move is in engine coordinates of the
+// canonical orientation; weight is the builder's play count (wins
+// counted double), kept for inspection and min-weight filtering.
+typedef struct {
+  uint64_t key;  // canonical position hash; 0 = empty slot
+  uint8_t x;
+  uint8_t y;
+  uint16_t weight;
+  uint32_t reserved;
+} book_entry_t;
+
+/**
+ * An open book file. `base` is the raw mapping (malloc'd file image on
+ * the MinGW brain build, like gamerec); `entries` points into it.
+ */
+typedef struct {
+  const uint8_t *base;
+  size_t size;
+  const book_entry_t *entries;
+  uint32_t entry_count;  // power of two; probe mask = entry_count - 1
+  int board_size;
+  int max_plies;
+} book_t;
+
+// Identity orientation sentinel for the transform helpers below; 0..6
+// index the nontrivial orientations exactly as game_state_t.sym_perm.
+#define BOOK_TRANSFORM_IDENTITY 7
+
+/**
+ * Maps engine cell (x, y) on an n-sized board through orientation `t`
+ * (0..6 as in sym_perm, or BOOK_TRANSFORM_IDENTITY). Must stay in
+ * lockstep with the tx/ty tables in init_zobrist_hashing.
+ */
+static inline void book_transform_xy(int t, int n, int x, int y, int *ox,
+                                     int *oy) {
+  switch (t) {
+  case 0: *ox = n - 1 - x; *oy = y;         break;
+  case 1: *ox = x;         *oy = n - 1 - y; break;
+  case 2: *ox = n - 1 - x; *oy = n - 1 - y; break;
+  case 3: *ox = y;         *oy = x;         break;
+  case 4: *ox = y;         *oy = n - 1 - x; break;
+  case 5: *ox = n - 1 - y; *oy = x;         break;
+  case 6: *ox = n - 1 - y; *oy = n - 1 - x; break;
+  default: *ox = x;        *oy = y;         break;
+  }
+}
+
+/**
+ * Inverse orientation index: the two quarter-turns (4, 5) undo each
+ * other; every other orientation is an involution.
+ */
+static inline int book_inverse_transform(int t) {
+  if (t == 4) return 5;
+  if (t == 5) return 4;
+  return t;
+}
+
+/**
+ * Canonical hash of the current position plus the orientation that
+ * achieved it (written to *transform; BOOK_TRANSFORM_IDENTITY when the
+ * board's own hash is already minimal). Matches position_hash() in
+ * game.h for stone counts within SYM_HASH_STONE_LIMIT.
+ */
+static inline uint64_t book_canonical_hash(const game_state_t *game,
+                                           int *transform) {
+  uint64_t hash = game->current_hash;
+  int best = BOOK_TRANSFORM_IDENTITY;
+  for (int t = 0; t < 7; t++) {
+    if (game->sym_hashes[t] < hash) {
+      hash = game->sym_hashes[t];
+      best = t;
+    }
+  }
+  *transform = best;
+  return hash;
+}
+
+/**
+ * Maps a book file read-only and validates its header, including the
+ * zobrist seed — hashes from a differently-seeded binary would probe
+ * garbage. Returns 1 on success, 0 on open/validation failure.
+ */
+int book_open(book_t *book, const char *path);
+
+/**
+ * Releases the mapping.
+ */
+void book_close(book_t *book);
+
+/**
+ * Probes the book for the current position. On a hit writes the stored
+ * move — already mapped back into the board's orientation — and returns
+ * 1; returns 0 on a miss, a board-size mismatch, a position deeper than
+ * the book, or when the recorded cell is (somehow) occupied.
+ */
+int book_probe(const book_t *book, const game_state_t *game, int *x, int *y);
+
+/**
+ * Process-wide default book consulted by find_best_ai_move. NULL (the
+ * initial state) disables book probes; both the TUI (--book) and the
+ * Gomocup brain (--book) set it at startup.
+ */
+void book_set_default(const book_t *book);
+const book_t *book_default(void);
+
+#endif // BOOK_H
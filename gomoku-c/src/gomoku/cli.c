@@ -7,6 +7,8 @@
 
 #include "cli.h"
 #include "ansi.h"
+#include "cpu_features.h"
+#include "game.h"
 #include "gomoku.h"
 #include <getopt.h>
 #include <stdio.h>
@@ -32,7 +34,17 @@ cli_config_t parse_arguments(int argc, char *argv[]) {
       .headless = 0,                      // Not headless by default
       .stateless_mode = 0,                // Stateful mode by default
       .search_radius = 3,                 // Default search radius
+      .search_threads = 1,                // Single-threaded search by default
+      .parallel_root = 0,                 // Lazy-SMP is the default parallel mode
+      .tt_size_mb = 0,                    // 0 = built-in default table size
+      .leaf_radius = 2,                   // Contact-ish moves only near the leaves
+      .multipv = 1,                       // Single best line unless analyzing
+      .engine = ENGINE_MINIMAX,           // Minimax/PVS search backend
+      .rng_seed = 0,                      // 0 = time-based tie-break seed
+      .book_file = "",                    // No opening book by default
       .json_file = "",                    // No JSON output by default
+      .snapshot_file = "",                // No binary snapshot by default
+      .resume_file = "",                  // Fresh game by default
       .replay_file = "",                  // No replay by default
       .replay_wait = 0,                   // Wait for keypress by default
       .player_x_type = PLAYER_TYPE_HUMAN, // X is human by default
@@ -51,7 +63,18 @@ cli_config_t parse_arguments(int argc, char *argv[]) {
       {"timeout", required_argument, 0, 't'},
       {"board", required_argument, 0, 'b'},
       {"radius", required_argument, 0, 'r'},
+      {"threads", required_argument, 0, 'T'},
+      {"parallel-root", no_argument, 0, 'P'},
+      {"tt-size", required_argument, 0, 'z'},
+      {"leaf-radius", required_argument, 0, 'R'},
+      {"multipv", required_argument, 0, 'M'},
+      {"engine", required_argument, 0, 'E'},
+      {"seed", required_argument, 0, 'g'},
+      {"nnue", required_argument, 0, 'n'},
+      {"book", required_argument, 0, 'B'},
       {"json", required_argument, 0, 'j'},
+      {"snapshot", required_argument, 0, 'S'},
+      {"resume", required_argument, 0, 'c'},
       {"replay", required_argument, 0, 'p'},
       {"wait", required_argument, 0, 'w'},
       {"help", no_argument, 0, 'h'},
@@ -68,7 +91,7 @@ cli_config_t parse_arguments(int argc, char *argv[]) {
   int option_index = 0;
 
   // Parse command-line arguments using getopt_long
-  while ((c = getopt_long(argc, argv, "d:l:t:b:r:j:p:w:hU:usqx:o:i",
+  while ((c = getopt_long(argc, argv, "d:l:t:b:r:R:M:E:g:n:B:T:Pz:j:S:c:p:w:hU:usqx:o:i",
                           long_options, &option_index)) != -1) {
     switch (c) {
     case 'd':
@@ -154,6 +177,67 @@ cli_config_t parse_arguments(int argc, char *argv[]) {
       }
       break;
 
+    case 'T':
+      config.search_threads = atoi(optarg);
+      if (config.search_threads < 1 || config.search_threads > 16) {
+        printf("Error: Search threads must be between 1 and 16\n");
+        config.invalid_args = 1;
+      }
+      break;
+
+    case 'P':
+      config.parallel_root = 1;
+      break;
+
+    case 'M':
+      config.multipv = atoi(optarg);
+      if (config.multipv < 1 || config.multipv > MULTIPV_MAX) {
+        printf("Error: Multi-PV count must be between 1 and %d\n", MULTIPV_MAX);
+        config.invalid_args = 1;
+      }
+      break;
+
+    case 'E':
+      if (strcmp(optarg, "minimax") == 0) {
+        config.engine = ENGINE_MINIMAX;
+      } else if (strcmp(optarg, "mcts") == 0) {
+        config.engine = ENGINE_MCTS;
+      } else {
+        printf("Error: Engine must be 'minimax' or 'mcts'\n");
+        config.invalid_args = 1;
+      }
+      break;
+
+    case 'g':
+      config.rng_seed = strtoull(optarg, NULL, 0);
+      break;
+
+    case 'n':
+      strncpy(config.nnue_file, optarg, sizeof(config.nnue_file) - 1);
+      config.nnue_file[sizeof(config.nnue_file) - 1] = '\0';
+      break;
+
+    case 'B':
+      strncpy(config.book_file, optarg, sizeof(config.book_file) - 1);
+      config.book_file[sizeof(config.book_file) - 1] = '\0';
+      break;
+
+    case 'R':
+      config.leaf_radius = atoi(optarg);
+      if (config.leaf_radius < 0 || config.leaf_radius > 5) {
+        printf("Error: Leaf radius must be between 0 and 5\n");
+        config.invalid_args = 1;
+      }
+      break;
+
+    case 'z':
+      config.tt_size_mb = atoi(optarg);
+      if (config.tt_size_mb < 1 || config.tt_size_mb > 4096) {
+        printf("Error: Transposition table size must be 1-4096 MB\n");
+        config.invalid_args = 1;
+      }
+      break;
+
     case 'j':
       if (strlen(optarg) >= sizeof(config.json_file)) {
         printf("Error: JSON file path too long\n");
@@ -164,6 +248,26 @@ cli_config_t parse_arguments(int argc, char *argv[]) {
       }
       break;
 
+    case 'S':
+      if (strlen(optarg) >= sizeof(config.snapshot_file)) {
+        printf("Error: Snapshot file path too long\n");
+        config.invalid_args = 1;
+      } else {
+        strncpy(config.snapshot_file, optarg, sizeof(config.snapshot_file) - 1);
+        config.snapshot_file[sizeof(config.snapshot_file) - 1] = '\0';
+      }
+      break;
+
+    case 'c':
+      if (strlen(optarg) >= sizeof(config.resume_file)) {
+        printf("Error: Resume file path too long\n");
+        config.invalid_args = 1;
+      } else {
+        strncpy(config.resume_file, optarg, sizeof(config.resume_file) - 1);
+        config.resume_file[sizeof(config.resume_file) - 1] = '\0';
+      }
+      break;
+
     case 'p':
       if (strlen(optarg) >= sizeof(config.replay_file)) {
         printf("Error: Replay file path too long\n");
@@ -343,12 +447,60 @@ void print_help(const char *program_name) {
          "(default: 3).\n",
          COLOR_YELLOW, COLOR_RESET);
   printf("                        Higher values find more moves but run "
-         "slower.\n\n");
+         "slower.\n");
+  printf("  %s-T, --threads 1-16%s    Lazy-SMP search threads sharing one "
+         "transposition\n",
+         COLOR_YELLOW, COLOR_RESET);
+  printf("                        table (default: 1).\n");
+  printf("  %s-P, --parallel-root%s   With -T, partition root moves across "
+         "the threads\n",
+         COLOR_YELLOW, COLOR_RESET);
+  printf("                        instead of staggered-depth Lazy-SMP.\n");
+  printf("  %s-R, --leaf-radius N%s   Candidate radius within two plies of the "
+         "leaves\n",
+         COLOR_YELLOW, COLOR_RESET);
+  printf("                        (default: 2, 0 disables the taper).\n");
+  printf("  %s-M, --multipv K%s       Analysis mode: rank the top K root moves "
+         "with\n",
+         COLOR_YELLOW, COLOR_RESET);
+  printf("                        scores and variations (default: 1).\n");
+  printf("  %s-E, --engine NAME%s     Search backend: 'minimax' (default) or "
+         "'mcts'\n",
+         COLOR_YELLOW, COLOR_RESET);
+  printf("                        (Monte-Carlo Tree Search, scales with "
+         "--timeout).\n");
+  printf("  %s-g, --seed N%s          Seed for tie-breaks among equal-score "
+         "moves\n",
+         COLOR_YELLOW, COLOR_RESET);
+  printf("                        (default: 0 = time-based; fix it for "
+         "reproducible runs).\n");
+  printf("  %s-n, --nnue FILE%s       Load NNUE weights and use the learned "
+         "evaluator\n",
+         COLOR_YELLOW, COLOR_RESET);
+  printf("                        at search leaves (default: classical "
+         "eval).\n");
+  printf("  %s-B, --book FILE%s       Load a compiled opening book (see `make "
+         "build-book`)\n",
+         COLOR_YELLOW, COLOR_RESET);
+  printf("                        for instant moves in the early plies.\n");
+  printf("  %s-z, --tt-size MB%s      Transposition table size in megabytes, "
+         "rounded down\n",
+         COLOR_YELLOW, COLOR_RESET);
+  printf("                        to a power of two of entries (default: "
+         "4).\n\n");
 
   printf("%sSPECIAL FLAGS:%s\n", COLOR_BRIGHT_MAGENTA, COLOR_RESET);
   printf("  %s-j, --json FILE%s       Write game results to a JSON file, which "
          "can be replayed.\n",
          COLOR_YELLOW, COLOR_RESET);
+  printf("  %s-S, --snapshot FILE%s   Write a binary snapshot at exit; unlike "
+         "--json it keeps\n",
+         COLOR_YELLOW, COLOR_RESET);
+  printf("                        the warmed search state and restores "
+         "instantly.\n");
+  printf("  %s-c, --resume FILE%s     Resume a game from a binary snapshot "
+         "(see --snapshot).\n",
+         COLOR_YELLOW, COLOR_RESET);
   printf("  %s-p, --replay FILE%s     Replay a previously recorded game from a "
          "JSON file.\n",
          COLOR_YELLOW, COLOR_RESET);
@@ -415,6 +567,8 @@ void print_help(const char *program_name) {
   printf("\n%sDEVELOPER INFO:%s\n", COLOR_BRIGHT_MAGENTA, COLOR_RESET);
   printf("  %s%s%s\n", COLOR_BRIGHT_GREEN, GAME_COPYRIGHT, COLOR_RESET);
   printf("  %sVersion %s%s |", COLOR_BRIGHT_MAGENTA, GAME_VERSION, COLOR_RESET);
+  printf(" SIMD: %s%s%s |", COLOR_BRIGHT_MAGENTA, cpu_simd_features(),
+         COLOR_RESET);
   printf(" Source: %s%s%s\n", COLOR_BRIGHT_MAGENTA, GAME_URL, COLOR_RESET);
   printf("\n");
 }
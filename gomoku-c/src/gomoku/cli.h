@@ -17,6 +17,11 @@
 /**
  * Structure to hold parsed command line arguments
  */
+// Search backend selection (--engine). Minimax is the default; MCTS is an
+// alternative that scales with the per-move time budget (see mcts.h).
+#define ENGINE_MINIMAX 0
+#define ENGINE_MCTS 1
+
 typedef struct {
     int board_size;       // Board size (15 or 19)
     int max_depth;        // AI search depth
@@ -29,7 +34,18 @@ typedef struct {
     int headless;         // Whether to suppress all stdout output (for daemon mode)
     int stateless_mode;   // Disable persistent/derived caches for stateless API use
     int search_radius;    // Search radius for move generation (1-5, default 2)
+    int search_threads;   // Lazy-SMP search threads (1 = single-threaded)
+    int parallel_root;    // Split root moves across threads instead of Lazy-SMP
+    int tt_size_mb;       // Transposition table size in MB (0 = default)
+    int leaf_radius;      // Candidate radius near the leaves (0 = fixed radius)
+    int multipv;          // Report the top-K root lines (1 = normal play)
+    int engine;           // Search backend: ENGINE_MINIMAX or ENGINE_MCTS
+    uint64_t rng_seed;    // Move-selection RNG seed (0 = time-based)
+    char nnue_file[256];  // NNUE weights file (empty = classical eval)
+    char book_file[256];  // Opening book file (empty = no book)
     char json_file[256];  // Path to JSON output file (empty = no output)
+    char snapshot_file[256]; // Binary snapshot written at exit (empty = none)
+    char resume_file[256];   // Binary snapshot to resume from (empty = none)
 
     // Replay mode
     char replay_file[256]; // Path to JSON file to replay (empty = no replay)
@@ -0,0 +1,53 @@
+//
+//  cpu_features.c
+//  gomoku - runtime CPU SIMD feature detection
+//
+//  x86 uses the compiler's cpuid wrapper (__builtin_cpu_supports); 32-bit
+//  ARM on Linux reads the hwcap auxiliary vector; AArch64 has NEON by
+//  definition. Detection is cached after the first call so callers can
+//  use the result in hot-path-adjacent code without worrying about cost.
+//
+
+#include "cpu_features.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__arm__) && defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_NEON
+#define HWCAP_NEON (1 << 12)
+#endif
+#endif
+
+const char *cpu_simd_features(void) {
+  static char features[64];
+  if (features[0] != '\0') {
+    return features;
+  }
+
+#if defined(__x86_64__) || defined(__i386__)
+  features[0] = '\0';
+  if (__builtin_cpu_supports("sse2")) {
+    strcat(features, "sse2");
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    strcat(features, features[0] ? ",avx2" : "avx2");
+  }
+  if (__builtin_cpu_supports("avx512f")) {
+    strcat(features, features[0] ? ",avx512f" : "avx512f");
+  }
+  if (features[0] == '\0') {
+    strcpy(features, "scalar");
+  }
+#elif defined(__aarch64__)
+  strcpy(features, "neon");
+#elif defined(__arm__) && defined(__linux__)
+  strcpy(features,
+         (getauxval(AT_HWCAP) & HWCAP_NEON) ? "neon" : "scalar");
+#else
+  strcpy(features, "scalar");
+#endif
+
+  return features;
+}
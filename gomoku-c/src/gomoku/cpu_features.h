@@ -0,0 +1,26 @@
+//
+//  cpu_features.h
+//  gomoku - runtime CPU SIMD feature detection
+//
+//  One binary serves heterogeneous fleets (SSE2/AVX2/AVX-512 x86 boxes,
+//  NEON ARM). The vector kernels in ai.c deliberately target only the
+//  baseline ISA of each architecture — SSE2 is mandatory on x86-64 and
+//  NEON on AArch64 — so no function-pointer dispatch is selected today:
+//  every x86-64 or AArch64 binary already runs fleet-wide unmodified.
+//  This module is the seam for wider kernels if they ever land (detect
+//  here, select the implementation at startup), and a diagnostics source
+//  in the meantime: the httpd startup log and the TUI version line report
+//  what the host actually supports.
+//
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+/**
+ * Returns a short comma-separated summary of the SIMD features the
+ * running CPU supports, e.g. "sse2,avx2" or "neon" or "scalar". The
+ * string is static; do not free it. Detection runs once on first call.
+ */
+const char *cpu_simd_features(void);
+
+#endif // CPU_FEATURES_H
@@ -0,0 +1,190 @@
+//
+//  eval_lines.c
+//  gomoku - Incrementally maintained per-line evaluation state
+//
+//  Scores one board line at a time by walking its maximal stone runs, using
+//  the same value scale as the threat matrix in gomoku.c (five/four/three
+//  with open, closed, and broken variants). Cross-direction combination
+//  threats are intentionally not modeled here — those couple lines at a
+//  single cell and are handled by the tactical steps in find_best_ai_move,
+//  not the leaf evaluation.
+//
+
+#include "eval_lines.h"
+
+#include <string.h>
+
+// Run values mirror threat_cost in gomoku.c. Exactly five scores as a win
+// pattern; six or more (overline) scores nothing, matching the engine-wide
+// exactly-five rule.
+#define LINE_FIVE 100000
+#define LINE_OPEN_FOUR 50000
+#define LINE_FOUR 10000
+#define LINE_BROKEN_FOUR LINE_EVAL_FOUR_THREAT
+#define LINE_OPEN_THREE 1000
+#define LINE_BROKEN_THREE 200
+#define LINE_CLOSED_THREE 100
+#define LINE_OPEN_TWO 50
+#define LINE_CLOSED_TWO 10
+
+/**
+ * Scores the extracted cells of one line for one player. Walks maximal
+ * runs, valuing each by length and open ends, then adds broken-pattern
+ * bonuses for run/gap/run shapes with a single hole.
+ */
+static int score_line_for_player(const int *line, int len, int player) {
+  int score = 0;
+
+  int i = 0;
+  while (i < len) {
+    if (line[i] != player) {
+      i++;
+      continue;
+    }
+    int j = i;
+    while (j < len && line[j] == player) {
+      j++;
+    }
+    int run = j - i;
+    int open_left = (i > 0 && line[i - 1] == AI_CELL_EMPTY);
+    int open_right = (j < len && line[j] == AI_CELL_EMPTY);
+    int open_ends = open_left + open_right;
+
+    if (run == 5) {
+      score += LINE_FIVE;
+    } else if (run == 4) {
+      if (open_ends == 2) {
+        score += LINE_OPEN_FOUR;
+      } else if (open_ends == 1) {
+        score += LINE_FOUR;
+      }
+    } else if (run == 3) {
+      if (open_ends == 2) {
+        score += LINE_OPEN_THREE;
+      } else if (open_ends == 1) {
+        score += LINE_CLOSED_THREE;
+      }
+    } else if (run == 2) {
+      if (open_ends == 2) {
+        score += LINE_OPEN_TWO;
+      } else if (open_ends == 1) {
+        score += LINE_CLOSED_TWO;
+      }
+    }
+    // run == 1 carries no line value; run >= 6 is a dead overline.
+
+    i = j;
+  }
+
+  // Broken patterns: two runs separated by exactly one empty cell. The runs
+  // were already valued individually above; the hole shape adds the
+  // must-answer component (e.g. X X _ X X is a broken four even though
+  // neither run alone is one).
+  for (i = 1; i + 1 < len; i++) {
+    if (line[i] != AI_CELL_EMPTY || line[i - 1] != player ||
+        line[i + 1] != player) {
+      continue;
+    }
+    int left = 0;
+    for (int k = i - 1; k >= 0 && line[k] == player; k--) {
+      left++;
+    }
+    int right = 0;
+    for (int k = i + 1; k < len && line[k] == player; k++) {
+      right++;
+    }
+    int combined = left + right;
+    if (combined >= 4) {
+      score += LINE_BROKEN_FOUR;
+    } else if (combined == 3) {
+      score += LINE_BROKEN_THREE;
+    }
+  }
+
+  return score;
+}
+
+/**
+ * Extracts one line into `out` and returns its length. Line addressing:
+ * rows and columns by their index; "\" diagonals by x - y + size - 1;
+ * "/" diagonals by x + y.
+ */
+static int extract_line(cell_t **board, int size, int dir, int line, int *out) {
+  int len = 0;
+  switch (dir) {
+  case LINE_DIR_ROW:
+    for (int y = 0; y < size; y++) {
+      out[len++] = board[line][y];
+    }
+    break;
+  case LINE_DIR_COL:
+    for (int x = 0; x < size; x++) {
+      out[len++] = board[x][line];
+    }
+    break;
+  case LINE_DIR_DIAG: {
+    // x - y = line - (size - 1); start at the top-most cell of the diagonal.
+    int d = line - (size - 1);
+    int x = d > 0 ? d : 0;
+    int y = d > 0 ? 0 : -d;
+    while (x < size && y < size) {
+      out[len++] = board[x][y];
+      x++;
+      y++;
+    }
+    break;
+  }
+  case LINE_DIR_ANTI: {
+    // x + y = line; start at the top-most cell of the anti-diagonal.
+    int x = line < size ? 0 : line - (size - 1);
+    int y = line - x;
+    while (x < size && y >= 0) {
+      out[len++] = board[x][y];
+      x++;
+      y--;
+    }
+    break;
+  }
+  }
+  return len;
+}
+
+/**
+ * Rescores one line for both players and folds the delta into the totals.
+ */
+static void rescore_line(line_eval_t *le, cell_t **board, int size, int dir,
+                         int line) {
+  // Zero-initialized so the scorer's reads are defined even though it
+  // only ever looks at the `len` cells extract_line filled in (gcc can't
+  // prove that across the call and would warn at -O3 otherwise).
+  int cells[BITBOARD_MAX_SIZE] = {0};
+  int len = extract_line(board, size, dir, line, cells);
+  // Lines shorter than five cells can never hold a five; they still score
+  // their smaller patterns, which keeps the totals consistent with rebuild.
+  int crosses = score_line_for_player(cells, len, AI_CELL_CROSSES);
+  int naughts = score_line_for_player(cells, len, AI_CELL_NAUGHTS);
+
+  le->total[0] += crosses - le->scores[0][dir][line];
+  le->total[1] += naughts - le->scores[1][dir][line];
+  le->scores[0][dir][line] = crosses;
+  le->scores[1][dir][line] = naughts;
+}
+
+void line_eval_rebuild(line_eval_t *le, cell_t **board, int size) {
+  memset(le, 0, sizeof(*le));
+  for (int l = 0; l < size; l++) {
+    rescore_line(le, board, size, LINE_DIR_ROW, l);
+    rescore_line(le, board, size, LINE_DIR_COL, l);
+  }
+  for (int l = 0; l < 2 * size - 1; l++) {
+    rescore_line(le, board, size, LINE_DIR_DIAG, l);
+    rescore_line(le, board, size, LINE_DIR_ANTI, l);
+  }
+}
+
+void line_eval_update(line_eval_t *le, cell_t **board, int size, int x, int y) {
+  rescore_line(le, board, size, LINE_DIR_ROW, x);
+  rescore_line(le, board, size, LINE_DIR_COL, y);
+  rescore_line(le, board, size, LINE_DIR_DIAG, x - y + size - 1);
+  rescore_line(le, board, size, LINE_DIR_ANTI, x + y);
+}
@@ -0,0 +1,84 @@
+//
+//  eval_lines.h
+//  gomoku - Incrementally maintained per-line evaluation state
+//
+//  Keeps a score per (player, direction, line) so a leaf evaluation is a
+//  pair of precomputed totals instead of re-walking pattern windows around
+//  the last move. A stone placement or removal touches exactly four lines
+//  (its row, column, and two diagonals), so the make/unmake path rescoring
+//  just those lines keeps the totals exact at all times.
+//
+
+#ifndef EVAL_LINES_H
+#define EVAL_LINES_H
+
+#include "gomoku.h"
+
+#ifndef BITBOARD_MAX_SIZE
+#define BITBOARD_MAX_SIZE 19
+#endif
+
+// Rows and columns have `size` lines each; each diagonal family has
+// 2*size - 1 lines.
+#define LINE_EVAL_MAX_LINES (2 * BITBOARD_MAX_SIZE - 1)
+
+// Direction indices into line_eval_t.scores.
+#define LINE_DIR_ROW 0
+#define LINE_DIR_COL 1
+#define LINE_DIR_DIAG 2 // top-left to bottom-right ("\")
+#define LINE_DIR_ANTI 3 // bottom-left to top-right ("/")
+
+// A player total at or above this holds at least a four-level threat
+// (LINE_BROKEN_FOUR in eval_lines.c is defined from it). Used by the
+// null-move guard in game.c to refuse passing in tactical positions.
+#define LINE_EVAL_FOUR_THREAT 8000
+
+/**
+ * Per-line scores for both players plus running totals. scores[p][d][l] is
+ * the pattern score of line l in direction d for player p; total[p] is the
+ * sum over all lines. The evaluation of a position from `player`'s
+ * perspective is total[player] - total[opponent].
+ */
+typedef struct {
+  int scores[2][4][LINE_EVAL_MAX_LINES];
+  int total[2];
+} line_eval_t;
+
+/**
+ * Rescores every line from scratch. Used at game init and whenever the
+ * board was mutated outside the make/unmake path (undo, replay loading,
+ * protocol BOARD command).
+ *
+ * @param le The line-eval state
+ * @param board The authoritative board
+ * @param size Board size
+ */
+void line_eval_rebuild(line_eval_t *le, cell_t **board, int size);
+
+/**
+ * Rescores the four lines passing through (x, y) after the cell changed.
+ * Called with the board already updated; the same call handles both
+ * placement and removal since it recomputes from the current cells.
+ *
+ * @param le The line-eval state
+ * @param board The authoritative board
+ * @param size Board size
+ * @param x Row coordinate of the changed cell
+ * @param y Column coordinate of the changed cell
+ */
+void line_eval_update(line_eval_t *le, cell_t **board, int size, int x, int y);
+
+/**
+ * Leaf evaluation from `player`'s perspective: the difference of the two
+ * maintained totals. O(1).
+ *
+ * @param le The line-eval state
+ * @param player AI_CELL_CROSSES or AI_CELL_NAUGHTS
+ * @return Positive when `player` is ahead on line patterns
+ */
+static inline int line_eval_score(const line_eval_t *le, int player) {
+  int pi = (player == AI_CELL_CROSSES) ? 0 : 1;
+  return le->total[pi] - le->total[1 - pi];
+}
+
+#endif // EVAL_LINES_H
@@ -7,6 +7,7 @@
 
 #include "game.h"
 #include "ai.h"
+#include "nnue.h"
 #ifndef NO_JSON
 #include "json.h"
 #endif
@@ -17,6 +18,10 @@
 #include <string.h>
 #include <time.h>
 
+#if defined(__linux__)
+#include <sys/mman.h> // madvise(MADV_HUGEPAGE) on large TT allocations
+#endif
+
 #ifndef NO_JSON
 // Helper to create a JSON number string with exactly 3 decimal places for
 // milliseconds
@@ -76,13 +81,27 @@ static int notation_to_coord(const char *s, int board_size, int *x, int *y) {
 
 uint64_t compute_zobrist_hash(game_state_t *game);
 void invalidate_winner_cache(game_state_t *game);
-static void rebuild_optimization_caches(game_state_t *game);
+static void seed_game_rng(game_state_t *game, const cli_config_t *config);
 
 //===============================================================================
 // GAME INITIALIZATION AND CLEANUP
 //===============================================================================
 
+// Process-wide shared transposition table (see tt_set_shared).
+// Intentionally never cleared by reinit: cross-game warmth is the point,
+// and other workers may be probing it concurrently.
+static transposition_entry_t *tt_shared = NULL;
+static size_t tt_shared_size = 0;
+
 game_state_t *init_game(cli_config_t config) {
+#ifdef GOMOKU_FIXED_BOARD_SIZE
+  // Specialized builds bake the board size into the search core (see
+  // GAME_BOARD_SIZE in game.h); a state of any other size would index
+  // out of step with the folded arithmetic, so refuse to create one.
+  if (config.board_size != GOMOKU_FIXED_BOARD_SIZE) {
+    return NULL;
+  }
+#endif
   game_state_t *game = malloc(sizeof(game_state_t));
   if (!game) {
     return NULL;
@@ -104,8 +123,26 @@ game_state_t *init_game(cli_config_t config) {
   game->max_depth = config.max_depth;
   game->move_timeout = config.move_timeout;
   game->search_radius = config.search_radius;
+  game->leaf_radius =
+      (config.leaf_radius > 0 && config.leaf_radius < config.search_radius)
+          ? config.leaf_radius
+          : 0;
+  game->search_threads = (config.search_threads > 0) ? config.search_threads : 1;
+  game->parallel_root = config.parallel_root;
+  game->smp_stop = NULL;
   game->replay_mode = 0;
   game->config = config;
+  game->timeout_poll_counter = 0;
+  game->multipv_count = 0;
+  game->tt = NULL; // Allocated lazily by init_transposition_table
+  game->tt_size = 0;
+  game->tt_mask = 0;
+  game->tt_probes = 0;
+  game->tt_hits = 0;
+  game->tt_stores = 0;
+  game->search_nodes = 0;
+  game->movegen_calls = 0;
+  game->eval_calls = 0;
 
   // Initialize player types (X=CROSSES=1, O=NAUGHTS=-1)
   // Map X/O configuration to CROSSES/NAUGHTS
@@ -134,7 +171,10 @@ game_state_t *init_game(cli_config_t config) {
   game->move_start_time = 0.0;
   game->search_start_time = 0.0;
   game->search_timed_out = 0;
+  game->search_progress_depth = 0;
+  game->background_search = 0;
   game->disable_winner_cache = config.stateless_mode ? 1 : 0;
+  seed_game_rng(game, &config);
 
   // Initialize optimization caches
   init_optimization_caches(game);
@@ -144,15 +184,123 @@ game_state_t *init_game(cli_config_t config) {
 
   // Initialize killer moves
   init_killer_moves(game);
+  init_history_tables(game);
+
+  // VCT memo table: allocated (zeroed) on the first probe instead of up
+  // front — creating a game state shouldn't pay for a search table the
+  // game may never use (gomoku-httpd builds one state per request).
+  game->vct_table = NULL;
+  // Search-transient arena: backing block reserved at first search.
+  arena_init(&game->search_arena);
+  memset(game->vct_carry, 0, sizeof(game->vct_carry));
+  // Stamps and counters start from zero so the first epoch bump makes
+  // every (uninitialized) entry stale.
+  memset(game->threat_cache_stamp, 0, sizeof(game->threat_cache_stamp));
+  memset(game->line_version, 0, sizeof(game->line_version));
+  game->threat_cache_epoch = 0;
+  clear_threat_cache(game);
+
+  // Optional learned evaluator: pick up the process-wide model (if any)
+  // and seed the accumulators from the (empty or replayed) board.
+  game->nnue_model = nnue_default();
+  game->nnue_acc_valid = 0;
+  if (game->nnue_model) {
+    nnue_refresh(game, game->board);
+  }
 
   return game;
 }
 
+void reinit_game(game_state_t *game, cli_config_t config) {
+  // In-place re-init for pooled reuse (see game_pool in gomoku-httpd).
+  // Everything allocation- or size-shaped is kept from the previous use:
+  // board rows, the TT (with its Zobrist keys and symmetry permutations)
+  // and the VCT memo table. Notably we do NOT re-zero the TT or the VCT
+  // table — entries are verified against the full position hash on probe,
+  // so leftovers from an earlier game either miss or hit on a genuinely
+  // shared position. That skipped memset is most of the per-request setup
+  // cost this function exists to avoid.
+  int size = game->board_size;
+  for (int x = 0; x < size; x++) {
+    memset(game->board[x], AI_CELL_EMPTY, (size_t)size * sizeof(cell_t));
+  }
+
+  game->cursor_x = size / 2;
+  game->cursor_y = size / 2;
+  game->current_player = AI_CELL_CROSSES;
+  game->game_state = GAME_RUNNING;
+  game->max_depth = config.max_depth;
+  game->move_timeout = config.move_timeout;
+  game->search_radius = config.search_radius;
+  game->leaf_radius =
+      (config.leaf_radius > 0 && config.leaf_radius < config.search_radius)
+          ? config.leaf_radius
+          : 0;
+  game->search_threads = (config.search_threads > 0) ? config.search_threads : 1;
+  game->parallel_root = config.parallel_root;
+  game->smp_stop = NULL;
+  game->replay_mode = 0;
+  game->config = config;
+  game->timeout_poll_counter = 0;
+  game->multipv_count = 0;
+
+  game->player_type[0] = config.player_x_type;
+  game->player_type[1] = config.player_o_type;
+  game->depth_for_player[0] =
+      (config.depth_x >= 0) ? config.depth_x : config.max_depth;
+  game->depth_for_player[1] =
+      (config.depth_o >= 0) ? config.depth_o : config.max_depth;
+
+  game->move_history_count = 0;
+  game->undos_used = 0;
+  game->ai_history_count = 0;
+  memset(game->ai_status_message, 0, sizeof(game->ai_status_message));
+  game->last_ai_move_x = -1;
+  game->last_ai_move_y = -1;
+
+  game->total_human_time = 0.0;
+  game->total_ai_time = 0.0;
+  game->move_start_time = 0.0;
+  game->search_start_time = 0.0;
+  game->search_timed_out = 0;
+  game->search_progress_depth = 0;
+  game->background_search = 0;
+  game->disable_winner_cache = config.stateless_mode ? 1 : 0;
+  seed_game_rng(game, &config);
+
+  // Derived caches over the (now empty) board; recomputes bitboard,
+  // line totals, stone count, winner cache and the incremental hash.
+  rebuild_optimization_caches(game);
+
+  init_killer_moves(game);
+  init_history_tables(game);
+  init_threat_space_search(game);
+  init_aspiration_windows(game);
+
+  memset(game->vct_carry, 0, sizeof(game->vct_carry));
+  // Keep the arena's backing block; the next search resets it anyway.
+  arena_reset(&game->search_arena);
+  // One epoch bump invalidates every per-cell threat entry without
+  // touching the stamp arrays.
+  clear_threat_cache(game);
+
+  game->nnue_model = nnue_default();
+  game->nnue_acc_valid = 0;
+  if (game->nnue_model) {
+    nnue_refresh(game, game->board);
+  }
+}
+
 void cleanup_game(game_state_t *game) {
   if (game) {
     if (game->board) {
       free_board(game->board, game->board_size);
     }
+    if (game->tt != tt_shared) {
+      free(game->tt);
+    }
+    free(game->vct_table);
+    arena_destroy(&game->search_arena);
     free(game);
   }
 }
@@ -162,9 +310,11 @@ void cleanup_game(game_state_t *game) {
 //===============================================================================
 
 void check_game_state(game_state_t *game) {
-  if (has_winner(game->board, game->board_size, AI_CELL_CROSSES)) {
+  // get_cached_winner runs word-parallel on the bitboard mirror (kept in
+  // sync by update_post_move_state), so no O(n^2) has_winner scan here.
+  if (get_cached_winner(game, AI_CELL_CROSSES)) {
     game->game_state = GAME_HUMAN_WIN;
-  } else if (has_winner(game->board, game->board_size, AI_CELL_NAUGHTS)) {
+  } else if (get_cached_winner(game, AI_CELL_NAUGHTS)) {
     game->game_state = GAME_AI_WIN;
   } else {
     // Check for draw (board full)
@@ -240,6 +390,72 @@ int make_move(game_state_t *game, int x, int y, int player, double time_taken,
   return 1;
 }
 
+int bulk_load_moves(game_state_t *game, const move_history_t *moves, int count,
+                    int *bad_index) {
+  int size = game->board_size;
+
+  // Write all stones in one pass. On the first invalid entry (out of
+  // bounds, bad player, cell taken — which also catches duplicates within
+  // the list) the stones written so far are lifted again, so failure
+  // leaves the state exactly as it was: the derived caches were never
+  // touched and still describe the restored board.
+  for (int i = 0; i < count; i++) {
+    int x = moves[i].x;
+    int y = moves[i].y;
+    int player = moves[i].player;
+    if (x < 0 || x >= size || y < 0 || y >= size ||
+        (player != AI_CELL_CROSSES && player != AI_CELL_NAUGHTS) ||
+        game->board[x][y] != AI_CELL_EMPTY) {
+      for (int j = 0; j < i; j++) {
+        game->board[moves[j].x][moves[j].y] = AI_CELL_EMPTY;
+      }
+      if (bad_index) {
+        *bad_index = i;
+      }
+      return 0;
+    }
+    game->board[x][y] = player;
+  }
+
+  // Record history and per-player clocks, same bookkeeping as make_move.
+  for (int i = 0; i < count; i++) {
+    if (game->move_history_count < MAX_MOVE_HISTORY) {
+      move_history_t *slot = &game->move_history[game->move_history_count];
+      *slot = moves[i];
+      slot->is_winner = 0;
+      game->move_history_count++;
+    }
+    if (moves[i].player == AI_CELL_CROSSES) {
+      game->total_human_time += moves[i].time_taken;
+    } else {
+      game->total_ai_time += moves[i].time_taken;
+    }
+  }
+
+  // One derived-state rebuild for the whole batch instead of the per-stone
+  // incremental updates: bitboard, line totals, stone count, winner cache
+  // and zobrist hash all come from the final board.
+  rebuild_optimization_caches(game);
+  clear_threat_cache(game);
+  game->nnue_acc_valid = 0;
+  if (game->nnue_model) {
+    nnue_refresh(game, game->board);
+  }
+
+  // Single terminal check on the final position.
+  check_game_state(game);
+  if (game->game_state == GAME_HUMAN_WIN || game->game_state == GAME_AI_WIN) {
+    if (game->move_history_count > 0) {
+      game->move_history[game->move_history_count - 1].is_winner = 1;
+    }
+  }
+  if (count > 0 && game->game_state == GAME_RUNNING) {
+    game->current_player = other_player(moves[count - 1].player);
+  }
+
+  return 1;
+}
+
 int can_undo(game_state_t *game) {
   if (!game->config.enable_undo) {
     return 0;
@@ -283,12 +499,17 @@ void undo_last_moves(game_state_t *game) {
   // Track if we're undoing any AI moves (for AI history cleanup)
   int ai_moves_undone = 0;
 
-  // Remove last move(s) and update timing totals
+  // Remove last move(s) and update timing totals. Each history entry is
+  // the undo record for its move: search_unmake_move() reverses every
+  // incrementally maintained structure (board, candidate bitboard, line
+  // eval, NNUE accumulators, hash set, stone count, threat cache lines
+  // through the square, winner cache) exactly, so no rebuild is needed.
   for (int i = 0; i < moves_to_undo; i++) {
     if (game->move_history_count > 0) {
       game->move_history_count--;
       move_history_t last_move = game->move_history[game->move_history_count];
-      game->board[last_move.x][last_move.y] = AI_CELL_EMPTY;
+      search_unmake_move(game, game->board, last_move.x, last_move.y,
+                         last_move.player);
 
       // Check if this move was from an AI player
       int player_index = (last_move.player == AI_CELL_CROSSES) ? 0 : 1;
@@ -310,6 +531,25 @@ void undo_last_moves(game_state_t *game) {
     game->ai_history_count--;
   }
 
+  // The active threat list is filtered lossily on every move (survivors
+  // near a new stone are dropped), so it can't be reversed from records;
+  // regenerate both players' threat spaces against the restored board.
+  game->threat_count = 0;
+  for (int p = 0; p < 2; p++) {
+    int player = (p == 0) ? AI_CELL_CROSSES : AI_CELL_NAUGHTS;
+    move_t threats[361];
+    int n = generate_threat_space_moves(game, game->board, player, threats);
+    for (int t = 0; t < n && game->threat_count < MAX_THREATS; t++) {
+      threat_t *entry = &game->active_threats[game->threat_count++];
+      entry->x = threats[t].x;
+      entry->y = threats[t].y;
+      entry->threat_type = threats[t].priority;
+      entry->player = player;
+      entry->priority = threats[t].priority;
+      entry->is_active = 1;
+    }
+  }
+
   // Reset AI last move highlighting
   game->last_ai_move_x = -1;
   game->last_ai_move_y = -1;
@@ -327,8 +567,6 @@ void undo_last_moves(game_state_t *game) {
 
   // Reset game state to running (in case it was won)
   game->game_state = GAME_RUNNING;
-
-  rebuild_optimization_caches(game);
 }
 
 //===============================================================================
@@ -341,6 +579,33 @@ double get_current_time(void) {
   return ts.tv_sec + ts.tv_nsec / 1e9;
 }
 
+uint32_t game_rand(game_state_t *game) {
+  // xorshift64*: tiny, lock-free and plenty random for picking among
+  // moves the search already scored as equal.
+  uint64_t x = game->rng_state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  game->rng_state = x;
+  return (uint32_t)((x * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+/**
+ * Seed the move-selection RNG from the config: a fixed seed for
+ * reproducible runs (bench, arena), otherwise wall clock mixed with the
+ * state pointer so concurrent games don't share a stream.
+ */
+static void seed_game_rng(game_state_t *game, const cli_config_t *config) {
+  uint64_t seed = config->rng_seed;
+  if (seed == 0) {
+    seed = (uint64_t)time(NULL) ^ ((uint64_t)(uintptr_t)game << 16);
+  }
+  if (seed == 0) {
+    seed = 0x9E3779B97F4A7C15ULL; // xorshift state must be nonzero
+  }
+  game->rng_state = seed;
+}
+
 void start_move_timer(game_state_t *game) {
   game->move_start_time = get_current_time();
 }
@@ -350,13 +615,34 @@ double end_move_timer(game_state_t *game) {
   return end_time - game->move_start_time;
 }
 
+// Check the wall clock only every this many calls; the counter-masked
+// fast path is a couple of ALU ops versus a vDSO clock read per node.
+#define TIMEOUT_POLL_INTERVAL 4096
+
 int is_search_timed_out(game_state_t *game) {
+  // Lazy-SMP helpers treat the master's stop signal as a timeout so every
+  // existing bail-out path also terminates helper threads promptly.
+  if (game->smp_stop && *game->smp_stop) {
+    return 1;
+  }
   if (game->move_timeout <= 0) {
     return 0; // No timeout set
   }
+  // Sticky after first detection so the unwind doesn't wait out another
+  // polling interval at every level of the stack.
+  if (game->search_timed_out) {
+    return 1;
+  }
+  if ((++game->timeout_poll_counter & (TIMEOUT_POLL_INTERVAL - 1)) != 0) {
+    return 0;
+  }
 
   double elapsed = get_current_time() - game->search_start_time;
-  return elapsed >= game->move_timeout;
+  if (elapsed >= game->move_timeout) {
+    game->search_timed_out = 1;
+    return 1;
+  }
+  return 0;
 }
 
 //===============================================================================
@@ -407,6 +693,9 @@ void add_ai_history_entry(game_state_t *game, int moves_evaluated) {
 //===============================================================================
 
 void init_optimization_caches(game_state_t *game) {
+  bitboard_sync(&game->bitboard, game->board, game->board_size,
+                game->search_radius);
+  line_eval_rebuild(&game->line_eval, game->board, game->board_size);
   game->stones_on_board = 0;
   game->winner_cache_valid = 0;
   game->has_winner_cache[0] = 0;
@@ -417,15 +706,18 @@ void init_optimization_caches(game_state_t *game) {
 
   // Initialize killer moves
   init_killer_moves(game);
+  init_history_tables(game);
 
   // Initialize advanced optimizations from research papers
   init_threat_space_search(game);
   init_aspiration_windows(game);
 }
 
-static void rebuild_optimization_caches(game_state_t *game) {
+void rebuild_optimization_caches(game_state_t *game) {
   int size = game->board_size;
 
+  bitboard_sync(&game->bitboard, game->board, size, game->search_radius);
+  line_eval_rebuild(&game->line_eval, game->board, size);
   game->stones_on_board = 0;
   for (int x = 0; x < size; x++) {
     for (int y = 0; y < size; y++) {
@@ -452,8 +744,55 @@ void update_post_move_state(game_state_t *game, int x, int y) {
     int player_index = (cell == AI_CELL_CROSSES) ? 0 : 1;
     int pos = x * game->board_size + y;
     game->current_hash ^= game->zobrist_keys[player_index][pos];
+    for (int t = 0; t < 7; t++) {
+      game->sym_hashes[t] ^=
+          game->zobrist_keys[player_index][game->sym_perm[t][pos]];
+    }
+    bitboard_place(&game->bitboard, x, y, cell);
+    line_eval_update(&game->line_eval, game->board, game->board_size, x, y);
+    nnue_make(game, x, y, cell);
+    invalidate_threat_cache(game, x, y);
+    // Real (non-search) moves keep the active threat list current; search
+    // nodes regenerate their threat space locally instead (see ai.c).
+    update_threat_analysis(game, x, y, cell);
+  }
+
+  invalidate_winner_cache(game);
+}
+
+void search_make_move(game_state_t *game, cell_t **board, int x, int y,
+                      int player) {
+  board[x][y] = (cell_t)player;
+  bitboard_place(&game->bitboard, x, y, player);
+  line_eval_update(&game->line_eval, board, game->board_size, x, y);
+  nnue_make(game, x, y, player);
+  int player_index = (player == AI_CELL_CROSSES) ? 0 : 1;
+  int pos = x * game->board_size + y;
+  game->current_hash ^= game->zobrist_keys[player_index][pos];
+  for (int t = 0; t < 7; t++) {
+    game->sym_hashes[t] ^=
+        game->zobrist_keys[player_index][game->sym_perm[t][pos]];
   }
+  game->stones_on_board++;
+  invalidate_threat_cache(game, x, y);
+  invalidate_winner_cache(game);
+}
 
+void search_unmake_move(game_state_t *game, cell_t **board, int x, int y,
+                        int player) {
+  int player_index = (player == AI_CELL_CROSSES) ? 0 : 1;
+  int pos = x * game->board_size + y;
+  game->current_hash ^= game->zobrist_keys[player_index][pos];
+  for (int t = 0; t < 7; t++) {
+    game->sym_hashes[t] ^=
+        game->zobrist_keys[player_index][game->sym_perm[t][pos]];
+  }
+  game->stones_on_board--;
+  bitboard_remove(&game->bitboard, x, y, player);
+  board[x][y] = AI_CELL_EMPTY;
+  line_eval_update(&game->line_eval, board, game->board_size, x, y);
+  nnue_unmake(game, x, y, player);
+  invalidate_threat_cache(game, x, y);
   invalidate_winner_cache(game);
 }
 
@@ -461,17 +800,39 @@ void invalidate_winner_cache(game_state_t *game) {
   game->winner_cache_valid = 0;
 }
 
+void invalidate_threat_cache(game_state_t *game, int x, int y) {
+  // Bumping a line's version counter stales every cached entry on that
+  // line at once: entries carry the key they were computed under, and
+  // threat_cache_key() sums the four counters. Four increments replace
+  // the old walk that cleared up to 33 per-cell flags per make/unmake.
+  int size = game->board_size;
+  game->line_version[0][y]++;
+  game->line_version[1][x]++;
+  game->line_version[2][x - y + size - 1]++;
+  game->line_version[3][x + y]++;
+}
+
+void clear_threat_cache(game_state_t *game) {
+  // One epoch bump outdates every stored stamp (the key is monotonic in
+  // epoch and counters alike) — no 722-byte memset. init_game relies on
+  // this to push the key past the zeroed stamps of a fresh state.
+  game->threat_cache_epoch++;
+}
+
 int get_cached_winner(game_state_t *game, int player) {
+  // The bitboard mirror is kept in sync by update_post_move_state and the
+  // search make/unmake paths, so five detection runs word-parallel instead
+  // of walking the int** board cell by cell.
   if (game->disable_winner_cache) {
-    return has_winner(game->board, game->board_size, player);
+    return bitboard_has_five(&game->bitboard, player);
   }
 
   if (!game->winner_cache_valid) {
     // Compute winner status for both players
     game->has_winner_cache[0] =
-        has_winner(game->board, game->board_size, AI_CELL_CROSSES);
+        bitboard_has_five(&game->bitboard, AI_CELL_CROSSES);
     game->has_winner_cache[1] =
-        has_winner(game->board, game->board_size, AI_CELL_NAUGHTS);
+        bitboard_has_five(&game->bitboard, AI_CELL_NAUGHTS);
     game->winner_cache_valid = 1;
   }
 
@@ -486,15 +847,73 @@ int get_cached_winner(game_state_t *game, int player) {
 // TRANSPOSITION TABLE FUNCTIONS
 //===============================================================================
 
+void tt_set_shared(transposition_entry_t *table, size_t entries_per_half) {
+  tt_shared = table;
+  tt_shared_size = entries_per_half;
+}
+
 void init_transposition_table(game_state_t *game) {
-  // Initialize transposition table
-  memset(game->transposition_table, 0, sizeof(game->transposition_table));
+  if (tt_shared) {
+    // Adopt the shared segment. tt_generation is per game state, so the
+    // staleness test in store_transposition is only a heuristic across
+    // workers — it can mis-apply the replacement preference, never
+    // return wrong data (the key ^ data check still guards every probe).
+    game->tt = tt_shared;
+    game->tt_size = tt_shared_size;
+    game->tt_mask = tt_shared_size - 1;
+  }
+  // Allocate on first use: two halves (one per perspective player) of a
+  // power-of-two entry count so probes index with a mask, not a divide.
+  if (!game->tt) {
+    size_t entries = TT_DEFAULT_ENTRIES;
+    if (game->config.tt_size_mb > 0) {
+      size_t budget = (size_t)game->config.tt_size_mb * 1024 * 1024 /
+                      (2 * sizeof(transposition_entry_t));
+      entries = 1;
+      while (entries * 2 <= budget) {
+        entries *= 2;
+      }
+    }
+    // Back off on allocation failure rather than dying: a smaller table
+    // only costs hit rate.
+    while (entries >= (1 << 12)) {
+      game->tt = malloc(2 * entries * sizeof(transposition_entry_t));
+      if (game->tt) {
+        break;
+      }
+      entries /= 2;
+    }
+    if (!game->tt) {
+      game->tt_size = 0;
+      game->tt_mask = 0;
+      return; // Probes and stores no-op; the search still works.
+    }
+    game->tt_size = entries;
+    game->tt_mask = entries - 1;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // Probes hash uniformly over the table, so 2MB transparent huge
+    // pages cut TLB misses once the table outgrows a couple of them.
+    // malloc gives no alignment guarantee, so advise only the
+    // page-aligned interior; madvise is a hint and may fail freely.
+    size_t bytes = 2 * entries * sizeof(transposition_entry_t);
+    if (bytes >= 4u * 1024 * 1024) {
+      uintptr_t lo = ((uintptr_t)game->tt + 4095) & ~(uintptr_t)4095;
+      uintptr_t hi = ((uintptr_t)game->tt + bytes) & ~(uintptr_t)4095;
+      if (hi > lo) {
+        madvise((void *)lo, hi - lo, MADV_HUGEPAGE);
+      }
+    }
+#endif
+  }
+  if (game->tt != tt_shared) {
+    memset(game->tt, 0, 2 * game->tt_size * sizeof(transposition_entry_t));
+  }
+  game->tt_generation = 0;
 
-  // Initialize Zobrist keys using a linear congruential generator with fixed
-  // seed This avoids calling srand() which would overwrite the time-based seed
-  // used for game randomization (e.g., random move selection among equal-weight
-  // moves)
-  uint64_t lcg_state = 12345ULL;
+  // Initialize Zobrist keys using a linear congruential generator with a
+  // fixed seed, independent of the per-game move-selection RNG (rng_state)
+  // so hashes agree across every game regardless of --seed.
+  uint64_t lcg_state = ZOBRIST_SEED;
   for (int player = 0; player < 2; player++) {
     for (int pos = 0; pos < 361; pos++) {
       // LCG: next = (a * state + c) mod m
@@ -508,12 +927,28 @@ void init_transposition_table(game_state_t *game) {
     }
   }
 
+  // Cell permutations for the 7 nontrivial dihedral orientations, used
+  // to keep one incremental hash per orientation (see position_hash).
+  {
+    int n = game->board_size;
+    for (int x = 0; x < n; x++) {
+      for (int y = 0; y < n; y++) {
+        int tx[7] = {n - 1 - x, x, n - 1 - x, y, y, n - 1 - y, n - 1 - y};
+        int ty[7] = {y, n - 1 - y, n - 1 - y, x, n - 1 - x, x, n - 1 - x};
+        for (int t = 0; t < 7; t++) {
+          game->sym_perm[t][x * n + y] = (uint16_t)(tx[t] * n + ty[t]);
+        }
+      }
+    }
+  }
+
   // Compute initial hash
   game->current_hash = compute_zobrist_hash(game);
 }
 
 uint64_t compute_zobrist_hash(game_state_t *game) {
   uint64_t hash = 0;
+  memset(game->sym_hashes, 0, sizeof(game->sym_hashes));
 
   for (int i = 0; i < game->board_size; i++) {
     for (int j = 0; j < game->board_size; j++) {
@@ -521,6 +956,10 @@ uint64_t compute_zobrist_hash(game_state_t *game) {
         int player_index = (game->board[i][j] == AI_CELL_CROSSES) ? 0 : 1;
         int pos = i * game->board_size + j;
         hash ^= game->zobrist_keys[player_index][pos];
+        for (int t = 0; t < 7; t++) {
+          game->sym_hashes[t] ^=
+              game->zobrist_keys[player_index][game->sym_perm[t][pos]];
+        }
       }
     }
   }
@@ -528,41 +967,133 @@ uint64_t compute_zobrist_hash(game_state_t *game) {
   return hash;
 }
 
-void store_transposition(game_state_t *game, uint64_t hash, int ai_player,
+// Packing layout for transposition_entry_t.data: bits 0-31 value (int32),
+// 32-39 depth, 40-41 flag, 42-47 generation (search age mod 64),
+// 48-55 best_x + 1, 56-63 best_y + 1 (the +1 maps the -1 "no move"
+// sentinel into unsigned range).
+static uint64_t tt_pack(int value, int depth, int flag, int generation,
+                        int best_x, int best_y) {
+  return (uint64_t)(uint32_t)value | ((uint64_t)(uint8_t)depth << 32) |
+         ((uint64_t)(flag & 0x3) << 40) |
+         ((uint64_t)(generation & 0x3F) << 42) |
+         ((uint64_t)(uint8_t)(best_x + 1) << 48) |
+         ((uint64_t)(uint8_t)(best_y + 1) << 56);
+}
+
+static int tt_unpack_value(uint64_t data) { return (int)(int32_t)(data & 0xFFFFFFFFULL); }
+static int tt_unpack_depth(uint64_t data) { return (int)((data >> 32) & 0xFF); }
+static int tt_unpack_flag(uint64_t data) { return (int)((data >> 40) & 0x3); }
+static int tt_unpack_gen(uint64_t data) { return (int)((data >> 42) & 0x3F); }
+
+// Each index maps to an aligned two-slot bucket: slot 0 is depth-preferred
+// (kept while it is deep and from the current search), slot 1 is
+// always-replace. Shallow leaf entries land in slot 1 instead of evicting
+// the deep entries that make late-iteration probes worthwhile.
+static transposition_entry_t *tt_bucket(game_state_t *game, uint64_t hash,
+                                        int player) {
+  int player_index = (player == AI_CELL_CROSSES) ? 0 : 1;
+  size_t index = (size_t)(hash & game->tt_mask) & ~(size_t)1;
+  return &game->tt[(size_t)player_index * game->tt_size + index];
+}
+
+static void tt_write(transposition_entry_t *entry, uint64_t hash,
+                     uint64_t data) {
+  // Two relaxed stores; the XOR key makes any interleaving detectable.
+  __atomic_store_n(&entry->key, hash ^ data, __ATOMIC_RELAXED);
+  __atomic_store_n(&entry->data, data, __ATOMIC_RELAXED);
+}
+
+void store_transposition(game_state_t *game, uint64_t hash, int player,
                          int value, int depth, int flag, int best_x,
                          int best_y) {
-  int ai_index = (ai_player == AI_CELL_CROSSES) ? 0 : 1;
-  int index = hash % TRANSPOSITION_TABLE_SIZE;
-  transposition_entry_t *entry = &game->transposition_table[ai_index][index];
-
-  // Replace if this entry is deeper or empty
-  if (entry->hash == 0 || entry->depth <= depth) {
-    entry->hash = hash;
-    entry->ai_player = ai_player;
-    entry->value = value;
-    entry->depth = depth;
-    entry->flag = flag;
-    entry->best_move_x = best_x;
-    entry->best_move_y = best_y;
+  if (!game->tt) {
+    return;
+  }
+  game->tt_stores++;
+  transposition_entry_t *bucket = tt_bucket(game, hash, player);
+  int generation = game->tt_generation & 0x3F;
+  uint64_t data = tt_pack(value, depth, flag, generation, best_x, best_y);
+
+  // Depth-preferred slot: take it when empty, stale (an earlier search's
+  // generation), holding this same position, or when the new entry is at
+  // least as deep. The stored fields may decode from a torn entry under
+  // SMP; worst case we mis-apply the replacement preference, never return
+  // a wrong value.
+  uint64_t old_key = __atomic_load_n(&bucket[0].key, __ATOMIC_RELAXED);
+  uint64_t old_data = __atomic_load_n(&bucket[0].data, __ATOMIC_RELAXED);
+  if (old_data == 0 || tt_unpack_gen(old_data) != generation ||
+      (old_key ^ old_data) == hash || tt_unpack_depth(old_data) <= depth) {
+    tt_write(&bucket[0], hash, data);
+    return;
   }
+
+  // Otherwise the shallow entry still gets remembered somewhere.
+  tt_write(&bucket[1], hash, data);
+}
+
+int probe_transposition_move(game_state_t *game, uint64_t hash, int player,
+                             int *best_x, int *best_y) {
+  if (!game->tt) {
+    return 0;
+  }
+  transposition_entry_t *bucket = tt_bucket(game, hash, player);
+
+  for (int slot = 0; slot < 2; slot++) {
+    uint64_t key = __atomic_load_n(&bucket[slot].key, __ATOMIC_RELAXED);
+    uint64_t data = __atomic_load_n(&bucket[slot].data, __ATOMIC_RELAXED);
+    if ((key ^ data) != hash) {
+      continue;
+    }
+    // The packed move is stored +1 so zero means "no move recorded".
+    int bx = (int)((data >> 48) & 0xFF);
+    int by = (int)((data >> 56) & 0xFF);
+    if (bx > 0 && by > 0 && bx <= game->board_size && by <= game->board_size) {
+      *best_x = bx - 1;
+      *best_y = by - 1;
+      return 1;
+    }
+  }
+  return 0;
 }
 
-int probe_transposition(game_state_t *game, uint64_t hash, int ai_player,
+int probe_transposition(game_state_t *game, uint64_t hash, int player,
                         int depth, int alpha, int beta, int *value) {
-  int ai_index = (ai_player == AI_CELL_CROSSES) ? 0 : 1;
-  int index = hash % TRANSPOSITION_TABLE_SIZE;
-  transposition_entry_t *entry = &game->transposition_table[ai_index][index];
-
-  if (entry->hash == hash && entry->ai_player == ai_player &&
-      entry->depth >= depth) {
-    *value = entry->value;
-
-    if (entry->flag == TT_EXACT) {
-      return 1; // Exact value
-    } else if (entry->flag == TT_LOWER_BOUND && entry->value >= beta) {
-      return 1; // Beta cutoff
-    } else if (entry->flag == TT_UPPER_BOUND && entry->value <= alpha) {
-      return 1; // Alpha cutoff
+  if (!game->tt) {
+    return 0;
+  }
+  __atomic_fetch_add(&game->tt_probes, 1, __ATOMIC_RELAXED);
+  transposition_entry_t *bucket = tt_bucket(game, hash, player);
+
+  for (int slot = 0; slot < 2; slot++) {
+    uint64_t key = __atomic_load_n(&bucket[slot].key, __ATOMIC_RELAXED);
+    uint64_t data = __atomic_load_n(&bucket[slot].data, __ATOMIC_RELAXED);
+
+    // Integrity check: only a complete, untorn store satisfies
+    // key ^ data == hash (and an empty entry only matches hash 0, which
+    // zobrist keys make vanishingly unlikely). The perspective player is
+    // implied by the table half, so no per-entry player field is needed.
+    if ((key ^ data) != hash) {
+      if (data != 0) {
+        // Occupied by some other position: an index collision. Dead code
+        // in normal builds; profile builds use the rate to judge whether
+        // the table is undersized for the workload.
+        PROFILE_INC(game, tt_collisions);
+      }
+      continue;
+    }
+    if (tt_unpack_depth(data) < depth) {
+      continue;
+    }
+    int entry_value = tt_unpack_value(data);
+    int entry_flag = tt_unpack_flag(data);
+    *value = entry_value;
+
+    // Exact value, beta cutoff, or alpha cutoff
+    if (entry_flag == TT_EXACT ||
+        (entry_flag == TT_LOWER_BOUND && entry_value >= beta) ||
+        (entry_flag == TT_UPPER_BOUND && entry_value <= alpha)) {
+      __atomic_fetch_add(&game->tt_hits, 1, __ATOMIC_RELAXED);
+      return 1;
     }
   }
 
@@ -579,6 +1110,36 @@ void init_killer_moves(game_state_t *game) {
   }
 }
 
+void init_history_tables(game_state_t *game) {
+  memset(game->history_scores, 0, sizeof(game->history_scores));
+  memset(game->countermoves, -1, sizeof(game->countermoves));
+  game->cm_prev_x = -1;
+  game->cm_prev_y = -1;
+}
+
+// Keep history scores bounded so long games can't saturate the ordering;
+// halving preserves the relative ranking.
+#define HISTORY_SCORE_LIMIT (1 << 20)
+
+void store_history_cutoff(game_state_t *game, int player, int x, int y,
+                          int depth) {
+  int pi = (player == AI_CELL_CROSSES) ? 0 : 1;
+  int idx = x * game->board_size + y;
+  game->history_scores[pi][idx] += depth * depth;
+  if (game->history_scores[pi][idx] >= HISTORY_SCORE_LIMIT) {
+    for (int c = 0; c < 361; c++) {
+      game->history_scores[pi][c] >>= 1;
+    }
+  }
+}
+
+void store_countermove(game_state_t *game, int player, int prev_x, int prev_y,
+                       int x, int y) {
+  int pi = (player == AI_CELL_CROSSES) ? 0 : 1;
+  game->countermoves[pi][prev_x * game->board_size + prev_y] =
+      x * game->board_size + y;
+}
+
 void store_killer_move(game_state_t *game, int depth, int x, int y) {
   if (depth >= MAX_SEARCH_DEPTH)
     return;
@@ -627,38 +1188,37 @@ void init_threat_space_search(game_state_t *game) {
 }
 
 void update_threat_analysis(game_state_t *game, int x, int y, int player) {
-  // Invalidate nearby threats
+  // Keep only the opponent's surviving entries: the mover's threat space
+  // is rebuilt wholesale below, and any entry whose square was just
+  // occupied or sits in the new stone's 5-window must be re-proven.
+  int kept = 0;
   for (int i = 0; i < game->threat_count; i++) {
-    if (game->active_threats[i].is_active) {
-      int dx = abs(game->active_threats[i].x - x);
-      int dy = abs(game->active_threats[i].y - y);
-      if (dx <= 2 && dy <= 2) {
-        game->active_threats[i].is_active = 0;
-      }
+    threat_t *t = &game->active_threats[i];
+    if (!t->is_active || t->player == player) {
+      continue;
     }
-  }
-
-  // Analyze new threats created by this move
-  const int radius = 4;
-  for (int i = max(0, x - radius); i <= min(game->board_size - 1, x + radius);
-       i++) {
-    for (int j = max(0, y - radius); j <= min(game->board_size - 1, y + radius);
-         j++) {
-      if (game->board[i][j] == AI_CELL_EMPTY) {
-        // Check if this position creates a threat
-        int threat_level =
-            evaluate_threat_fast(game->board, i, j, player, game->board_size);
-        if (threat_level > 100 && game->threat_count < MAX_THREATS) {
-          game->active_threats[game->threat_count].x = i;
-          game->active_threats[game->threat_count].y = j;
-          game->active_threats[game->threat_count].threat_type = threat_level;
-          game->active_threats[game->threat_count].player = player;
-          game->active_threats[game->threat_count].priority = threat_level;
-          game->active_threats[game->threat_count].is_active = 1;
-          game->threat_count++;
-        }
-      }
+    if (game->board[t->x][t->y] != AI_CELL_EMPTY) {
+      continue;
+    }
+    if (abs(t->x - x) <= 4 && abs(t->y - y) <= 4) {
+      continue;
     }
+    game->active_threats[kept++] = *t;
+  }
+  game->threat_count = kept;
+
+  // Regenerate the mover's threat space (see generate_threat_space_moves
+  // in ai.c — the same generator that drives VCT candidates).
+  move_t threats[361];
+  int n = generate_threat_space_moves(game, game->board, player, threats);
+  for (int i = 0; i < n && game->threat_count < MAX_THREATS; i++) {
+    threat_t *t = &game->active_threats[game->threat_count++];
+    t->x = threats[i].x;
+    t->y = threats[i].y;
+    t->threat_type = threats[i].priority;
+    t->player = player;
+    t->priority = threats[i].priority;
+    t->is_active = 1;
   }
 }
 
@@ -705,31 +1265,53 @@ int should_try_null_move(game_state_t *game, int depth) {
          game->stones_on_board < (game->board_size * game->board_size) / 2;
 }
 
+// The position hash doesn't encode the side to move — stone-count parity
+// normally implies it. A passed turn breaks that invariant, so the null
+// subtree searches in a shifted hash space to keep its transposition
+// entries from aliasing regular ones at the same board position.
+#define NULL_MOVE_HASH_SHIFT 0x9E3779B97F4A7C15ULL
+
 int try_null_move_pruning(game_state_t *game, int depth, int beta,
-                          int ai_player) {
+                          int player, int last_x, int last_y) {
   if (!should_try_null_move(game, depth)) {
     return 0;
   }
 
-  // Temporarily disable null moves to avoid infinite recursion
+  // Tactical guard: passing is unsound while the opponent holds a
+  // four-level threat, since the reduced search would start from a
+  // position where the forced answer was silently skipped. Gomoku has no
+  // zugzwang otherwise (an extra stone never hurts), so this is the only
+  // soundness condition needed.
+  int opp_index = (other_player(player) == AI_CELL_CROSSES) ? 0 : 1;
+  if (game->line_eval.total[opp_index] >= LINE_EVAL_FOUR_THREAT) {
+    return 0;
+  }
+
+  // Temporarily disable null moves to avoid back-to-back passes
   game->null_move_allowed = 0;
   game->null_move_count++;
+  game->current_hash ^= NULL_MOVE_HASH_SHIFT;
+  for (int t = 0; t < 7; t++) {
+    game->sym_hashes[t] ^= NULL_MOVE_HASH_SHIFT;
+  }
 
-  // Search with reduced depth
+  // Skip our turn: the opponent moves from this same position at reduced
+  // depth with a null window around beta.
   int null_score =
-      -minimax_with_timeout(game, game->board, depth - NULL_MOVE_REDUCTION - 1,
-                            -(beta + 1), -beta, 0, ai_player, -1, -1);
+      minimax_with_timeout(game, game->board, depth - NULL_MOVE_REDUCTION - 1,
+                           beta - 1, beta, 0, player, last_x, last_y);
 
   // Restore null move settings
+  game->current_hash ^= NULL_MOVE_HASH_SHIFT;
+  for (int t = 0; t < 7; t++) {
+    game->sym_hashes[t] ^= NULL_MOVE_HASH_SHIFT;
+  }
   game->null_move_allowed = 1;
   game->null_move_count--;
 
-  // If null move fails high, we can prune
-  if (null_score >= beta) {
-    return beta; // Null move cutoff
-  }
-
-  return 0; // No pruning
+  // If even a free move for the opponent can't bring the score below
+  // beta, a real move here won't either.
+  return null_score >= beta;
 }
 
 //===============================================================================
@@ -10,7 +10,10 @@
 
 #include <stdint.h>
 #include "gomoku.h"
+#include "arena.h"
 #include "board.h"
+#include "bitboard.h"
+#include "eval_lines.h"
 #include "cli.h"
 
 // move_t is defined in ai.h
@@ -41,19 +44,77 @@ typedef struct {
 } move_history_t;
 
 /**
- * Transposition table entry for caching evaluated positions
+ * Transposition table entry for caching evaluated positions.
+ *
+ * Lock-free 16-byte format: `data` packs value, depth, flag, and the best
+ * move into one word, and `key` stores hash ^ data. A probe recomputes
+ * key ^ data and compares against the position hash — a torn write (one
+ * word from each of two racing stores) fails that check, so concurrent
+ * Lazy-SMP threads (and, later, processes over shared memory) need no
+ * mutexes. The perspective player is implied by which half of the table
+ * the entry lives in, so it is not stored.
  */
 typedef struct {
-    uint64_t hash;         // Position hash
-    int ai_player;         // Perspective this score was computed for (X or O)
-    int value;             // Evaluated value
-    int depth;             // Search depth
-    int flag;              // Exact, lower bound, or upper bound
-    int best_move_x;       // Best move coordinates
-    int best_move_y;
+    uint64_t key;          // hash ^ data (integrity check)
+    uint64_t data;         // Packed value/depth/flag/best move
 } transposition_entry_t;
 
-#define TRANSPOSITION_TABLE_SIZE 100000
+// Default transposition table size: entries per perspective half. Must be
+// a power of two so probes index with a mask instead of a divide. 2 halves
+// x 131072 entries x 16 bytes = 4 MB; override with --tt-size.
+#define TT_DEFAULT_ENTRIES (1 << 17)
+
+// Seed for the LCG that derives the Zobrist keys (init_transposition_table).
+// Every binary built from this constant hashes positions identically, which
+// is what makes persisted TT contents (snapshot.h) meaningful across runs.
+#define ZOBRIST_SEED 12345ULL
+
+/**
+ * Dedicated memo table for the VCT searcher (find_forced_win_recursive).
+ *
+ * VCT trees revisit the same position through transposed forcing
+ * sequences, and each node regenerates candidates and threat scores from
+ * scratch, so STEP 3/4 latency spikes in threat-dense middlegames. The
+ * entries are tiny depth-capped facts: result = 1 means a forced win was
+ * proven from this position (valid for any budget at least `depth`);
+ * result = 0 means no win exists within `depth` plies (valid for any
+ * budget at most `depth`). Keyed by current_hash — NOT the symmetry
+ * canonical hash — because the cached best move is played directly and a
+ * twin-orientation move would be illegal.
+ */
+typedef struct {
+    uint64_t key;          // current_hash ^ attacker tag (0 = empty slot)
+    int16_t best_x, best_y; // First move of the proven sequence (result = 1)
+    int8_t depth;          // Budget the result was established at
+    int8_t result;         // 1 = win proven, 0 = no win within depth
+} vct_entry_t;
+
+// 2^14 entries x 16 bytes = 256 KB, heap-allocated on the first VCT probe
+// (like the transposition table) so creating a game state stays cheap.
+// Single-probe, always-replace.
+#define VCT_TT_SIZE (1 << 14)
+#define VCT_TT_MASK (VCT_TT_SIZE - 1)
+
+/**
+ * Cross-turn VCT carry-over: the attacker-move sequence of the last
+ * proven forced win, one slot per player. Only two stones typically land
+ * between searches, so last turn's proof usually still holds; ai.c
+ * replays it linearly (re-running every per-node check against the
+ * current board) before paying for a fresh tree search. Replay is a full
+ * re-proof, so stale slots are safe — they just fail and fall through.
+ */
+#define VCT_CARRY_LEN 20
+
+// Hidden-layer cap for the optional NNUE evaluator (see nnue.h). The
+// accumulators are embedded in game_state_t so search clones copy them
+// with the struct; the cap bounds that footprint.
+#define NNUE_MAX_HIDDEN 128
+struct nnue_model;
+typedef struct {
+    int valid;                     // 1 = seq holds a previously proven win
+    int len;                       // Moves recorded in seq
+    int seq[VCT_CARRY_LEN][2];     // Attacker moves (blocks are recomputed)
+} vct_carry_t;
 #define TT_EXACT 0
 #define TT_LOWER_BOUND 1
 #define TT_UPPER_BOUND 2
@@ -62,6 +123,16 @@ typedef struct {
 #define ASPIRATION_WINDOW 50
 #define NULL_MOVE_REDUCTION 2
 
+// Probe/store under the canonical (minimum-over-orientations) hash while
+// the position has at most this many stones. Openings transpose across
+// the 8 dihedral symmetries constantly; past ~10 stones the chance of a
+// symmetric twin is negligible and the 7 extra compares aren't worth it.
+#define SYM_HASH_STONE_LIMIT 10
+
+// Multi-PV analysis: cap on how many ranked root lines one search reports.
+#define MULTIPV_MAX 8
+#define MULTIPV_PV_LEN 16
+
 /**
  * Threat structure for threat-space search (from Allis 1994 paper)
  */
@@ -82,14 +153,59 @@ typedef struct {
     int depth;             // Depth at which window was set
 } aspiration_window_t;
 
+/**
+ * One ranked root line from a Multi-PV search: the root move, its exact
+ * score at the last completed depth, and the principal variation
+ * reconstructed from transposition-table best moves.
+ */
+typedef struct {
+    int x, y;                  // Root move
+    int score;                 // Root score from the AI's perspective
+    int pv_x[MULTIPV_PV_LEN];  // Variation cells, starting with the root move
+    int pv_y[MULTIPV_PV_LEN];
+    int pv_len;                // Number of valid pv_x/pv_y entries
+} multipv_entry_t;
+
 // move_t is defined in ai.h
 
+//===============================================================================
+// HOT-PATH PROFILE COUNTERS (opt-in)
+//===============================================================================
+// Fine-grained search instrumentation, compiled in only under
+// -DGOMOKU_PROFILE (`make PROFILE=1`). The PROFILE_* macros below expand
+// to nothing in normal builds, so the hot path pays zero for them; in
+// profile builds find_best_ai_move resets the struct per search and
+// snapshots it into scoring_report_t at the end, where bench prints it.
+// The always-on coarse counters (search_nodes, tt_probes/hits/stores,
+// movegen_calls, eval_calls) are unaffected and stay available in both
+// build flavors.
+
+#ifdef GOMOKU_PROFILE
+#include <string.h>
+
+#define PROFILE_CUTOFF_BINS 16
+
+typedef struct {
+    // PVS nodes entered, indexed by remaining depth (clamped to the
+    // array), exposing where the tree actually spends its nodes.
+    uint64_t nodes_by_depth[MAX_SEARCH_DEPTH + 1];
+    // Beta cutoffs binned by the ordered index of the move that caused
+    // them; the last bin collects everything deeper. A healthy move
+    // ordering keeps nearly all of the mass in bin 0.
+    uint64_t cutoffs_by_move_index[PROFILE_CUTOFF_BINS];
+    uint64_t cutoffs;            // Total beta cutoffs
+    uint64_t killer_cutoffs;     // Cutoffs whose move sat in the killer table
+    uint64_t tt_collisions;      // Probes landing on another position's entry
+    uint64_t movegen_candidates; // Candidates produced across generator runs
+} profile_counters_t;
+#endif // GOMOKU_PROFILE
+
 /**
  * Structure to represent the current game state
  */
 typedef struct {
     cli_config_t config;   // Configuration
-    int **board;           // The game board
+    cell_t **board;           // The game board
     int board_size;        // Size of the board
     int cursor_x, cursor_y; // Current cursor position
     int current_player;    // Current player (AI_CELL_CROSSES or AI_CELL_NAUGHTS)
@@ -97,6 +213,7 @@ typedef struct {
     int max_depth;         // AI search depth
     double move_timeout;   // Move timeout in seconds, fractional (0 = no timeout)
     int search_radius;     // Search radius for move generation (1-5)
+    int leaf_radius;       // Tighter candidate radius near the leaves (0 = off)
     int replay_mode;       // Whether we're in replay mode (disables cursor)
 
     // Player configuration
@@ -126,20 +243,87 @@ typedef struct {
     double search_start_time;
     int search_timed_out;
 
+    // Live search progress for a UI thread polling while find_best_ai_move
+    // runs on a worker: the iterative-deepening depth currently being
+    // searched (0 outside the deepening loop). The searching thread is the
+    // only writer; readers tolerate the race (display only).
+    volatile int search_progress_depth;
+    // Set by frontends that render their own progress while the search
+    // runs on a worker thread; suppresses the engine's inline "thinking"
+    // banner and per-root dot output so the two don't interleave.
+    int background_search;
+
+    // Move-selection RNG: xorshift64* state, seeded from config.rng_seed
+    // (0 = time-based). Replaces libc rand() for tie-breaks among
+    // equal-score moves so runs are reproducible under --seed, and keeps
+    // any platform rand() locking out of the search threads.
+    uint64_t rng_state;
+
     // Optimization caches
+    bitboard_t bitboard;                       // Word-parallel mirror of board (see bitboard.h)
+    line_eval_t line_eval;                     // Incremental per-line eval state (see eval_lines.h)
     int stones_on_board;                       // Cached stone count
     int has_winner_cache[2];                   // Cache for winner detection [player1, player2]
     int winner_cache_valid;                    // Whether winner cache is valid
     int disable_winner_cache;                  // If true, bypass winner cache entirely
 
-    // Transposition table
-    transposition_entry_t transposition_table[2][TRANSPOSITION_TABLE_SIZE];
+    // Transposition table, heap-allocated by init_transposition_table as
+    // 2 * tt_size entries (one half per perspective player). Lazy-SMP
+    // clones copy the pointer and so share the master's table.
+    transposition_entry_t *tt;
+    uint64_t tt_mask;                          // tt_size - 1 (tt_size is a power of two)
+    size_t tt_size;                            // Entries per perspective half
+    uint8_t tt_generation;                     // Search age, bumped per find_best_ai_move
+    // Cumulative probe statistics, bumped with relaxed atomic adds.
+    // Lazy-SMP helper clones count into their own copies, which die with
+    // the clone, so under -T these cover the master thread only.
+    // gomoku-httpd diffs them around a search for its /metrics endpoint.
+    uint64_t tt_probes;                        // probe_transposition calls
+    uint64_t tt_hits;                          // Probes answered by a usable entry
+    // Work counters in the same cumulative style, but plain increments:
+    // the searching thread is the only writer of its own context, and the
+    // SMP clones' copies die with the clone. find_best_ai_move diffs them
+    // around each pipeline stage for the scoring report.
+    uint64_t tt_stores;                        // store_transposition calls
+    uint64_t search_nodes;                     // pvs/quiescence/VCT nodes entered
+    uint64_t movegen_calls;                    // generate_moves_optimized calls
+    uint64_t eval_calls;                       // Leaf evaluations (line totals or NNUE)
+#ifdef GOMOKU_PROFILE
+    profile_counters_t profile;                // Opt-in fine-grained counters
+#endif
+    uint32_t timeout_poll_counter;             // Nodes since the last wall-clock poll
     uint64_t zobrist_keys[2][361];            // Zobrist keys for hashing
     uint64_t current_hash;                     // Current position hash
+    uint64_t sym_hashes[7];                    // Hashes of the 7 nontrivial dihedral orientations
+    uint16_t sym_perm[7][361];                 // Cell permutations for those orientations
+    vct_entry_t *vct_table;                    // VCT memo table, VCT_TT_SIZE entries, allocated on first probe
+    arena_t search_arena;                      // Per-context bump arena for search transients, reset each move
+    int threat_cache[2][361];                  // Cached evaluate_threat_fast per player
+    uint32_t threat_cache_stamp[2][361];       // Line-version key each entry was computed under
+    uint32_t line_version[4][37];              // Per-direction line change counters (37 = 2*19-1 diagonals)
+    uint32_t threat_cache_epoch;               // Bumped by clear_threat_cache; part of every key
+    vct_carry_t vct_carry[2];                  // Last proven VCT per attacker
+
+    // Optional learned evaluator (see nnue.h). The model pointer is
+    // read-only shared state (NULL = classical eval); the accumulators
+    // are per-game and ride along in smp_clone_game's struct copy.
+    const struct nnue_model *nnue_model;
+    int32_t nnue_acc[2][NNUE_MAX_HIDDEN];      // Per-perspective accumulators
+    int nnue_acc_valid;                        // Accumulators match the board
+
+    // Parallel search coordination
+    int search_threads;                        // Total threads for the root search (1 = off)
+    int parallel_root;                         // Root-split mode instead of Lazy-SMP
+    volatile int *smp_stop;                    // Set by the master to halt helper clones
 
     // Killer moves heuristic
     int killer_moves[MAX_SEARCH_DEPTH][MAX_KILLER_MOVES][2]; // [depth][move_num][x,y]
 
+    // History and countermove heuristics (beta-cutoff driven ordering)
+    int history_scores[2][361];               // Cutoff history per player and cell
+    int countermoves[2][361];                 // Refutation cell per previous-move cell (-1 none)
+    int cm_prev_x, cm_prev_y;                 // Last-move context for countermove lookup
+
     // Threat-space search (from research papers)
     threat_t active_threats[MAX_THREATS];     // Currently active threats
     int threat_count;                         // Number of active threats
@@ -151,8 +335,69 @@ typedef struct {
     // Null-move pruning
     int null_move_allowed;                    // Whether null moves are allowed
     int null_move_count;                      // Count of consecutive null moves
+
+    // Multi-PV analysis output, filled by find_best_ai_move when
+    // config.multipv > 1: the top root moves of the last completed
+    // iteration with their scores and table-reconstructed variations.
+    multipv_entry_t multipv_results[MULTIPV_MAX];
+    int multipv_count;
 } game_state_t;
 
+// Compile-time board-size specialization. Builds that only ever play
+// one size (the Gomocup brain is hard-wired to 15) can pass
+// -DGOMOKU_FIXED_BOARD_SIZE=15: every hot-path read of the board size
+// then becomes an integer literal, so the compiler folds the
+// `x * size + y` index arithmetic and fully unrolls fixed-trip line
+// walks instead of re-loading a struct field it cannot prove constant.
+// init_game() rejects any other configured size in such builds, so the
+// constant can never disagree with the allocated board.
+#ifdef GOMOKU_FIXED_BOARD_SIZE
+#define GAME_BOARD_SIZE(game) (GOMOKU_FIXED_BOARD_SIZE)
+#else
+#define GAME_BOARD_SIZE(game) ((game)->board_size)
+#endif
+
+// Instrumentation hooks for the profile counters above. Normal builds
+// compile every one of these to ((void)0), so call sites in the search
+// stay free of #ifdef noise without costing anything.
+#ifdef GOMOKU_PROFILE
+#define PROFILE_RESET(game)                                                    \
+  memset(&(game)->profile, 0, sizeof((game)->profile))
+#define PROFILE_INC(game, field) ((void)(game)->profile.field++)
+#define PROFILE_ADD(game, field, n)                                            \
+  ((void)((game)->profile.field += (uint64_t)(n)))
+#define PROFILE_NODE_AT_DEPTH(game, depth)                                     \
+  do {                                                                         \
+    int pd_ = (depth);                                                         \
+    if (pd_ < 0)                                                               \
+      pd_ = 0;                                                                 \
+    if (pd_ > MAX_SEARCH_DEPTH)                                                \
+      pd_ = MAX_SEARCH_DEPTH;                                                  \
+    (game)->profile.nodes_by_depth[pd_]++;                                     \
+  } while (0)
+#define PROFILE_BETA_CUTOFF(game, depth, move_index, x, y)                     \
+  do {                                                                         \
+    int pb_ = (move_index);                                                    \
+    if (pb_ >= PROFILE_CUTOFF_BINS)                                            \
+      pb_ = PROFILE_CUTOFF_BINS - 1;                                           \
+    (game)->profile.cutoffs_by_move_index[pb_]++;                              \
+    (game)->profile.cutoffs++;                                                 \
+    for (int pk_ = 0; pk_ < MAX_KILLER_MOVES; pk_++) {                         \
+      if ((game)->killer_moves[depth][pk_][0] == (x) &&                        \
+          (game)->killer_moves[depth][pk_][1] == (y)) {                        \
+        (game)->profile.killer_cutoffs++;                                      \
+        break;                                                                 \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
+#else
+#define PROFILE_RESET(game) ((void)0)
+#define PROFILE_INC(game, field) ((void)0)
+#define PROFILE_ADD(game, field, n) ((void)0)
+#define PROFILE_NODE_AT_DEPTH(game, depth) ((void)0)
+#define PROFILE_BETA_CUTOFF(game, depth, move_index, x, y) ((void)0)
+#endif // GOMOKU_PROFILE
+
 //===============================================================================
 // GAME INITIALIZATION AND CLEANUP
 //===============================================================================
@@ -167,6 +412,25 @@ typedef struct {
  */
 game_state_t* init_game(cli_config_t config);
 
+/**
+ * Re-initializes an existing game state in place for a new game, keeping
+ * the expensive allocations and tables from the previous use: the board
+ * rows, the transposition table (and its Zobrist keys and symmetry
+ * permutations, which never change), and the VCT memo table. Only the
+ * board contents and per-game fields are reset. TT and VCT entries are
+ * left in place — both are verified against the full position hash on
+ * probe, so stale entries from an earlier game miss (or legitimately hit
+ * on a shared position).
+ *
+ * The caller must pass a config with the same board_size the state was
+ * created with; tt_size_mb is ignored on reuse (the table keeps the size
+ * it was first allocated at).
+ *
+ * @param game An existing game state from init_game()
+ * @param config The configuration for the new game
+ */
+void reinit_game(game_state_t *game, cli_config_t config);
+
 /**
  * Cleans up and frees game state resources.
  * 
@@ -198,6 +462,25 @@ void check_game_state(game_state_t *game);
  */
 int make_move(game_state_t *game, int x, int y, int player, double time_taken, int positions_evaluated, int own_score, int opponent_score);
 
+/**
+ * Bulk position loader: apply a whole list of moves at once. Stones are
+ * written directly to the board and the derived state (bitboard, line
+ * totals, stone count, winner cache, zobrist hash) is rebuilt ONCE for
+ * the final position, followed by a single terminal check — O(n^2 +
+ * moves) instead of the per-stone make_move pipeline's O(moves x n^2).
+ * History entries are copied verbatim (metadata included), so callers
+ * replaying recorded games keep their per-move stats.
+ *
+ * @param game The game state to load into (typically a fresh board)
+ * @param moves Moves in play order; is_winner is recomputed, not trusted
+ * @param count Number of moves
+ * @param bad_index If non-NULL, receives the index of the first invalid
+ *                  move on failure
+ * @return 1 on success; 0 on an invalid move, leaving the state unchanged
+ */
+int bulk_load_moves(game_state_t *game, const move_history_t *moves, int count,
+                    int *bad_index);
+
 /**
  * Checks if undo is possible (need at least 2 moves).
  * 
@@ -224,6 +507,17 @@ void undo_last_moves(game_state_t *game);
  */
 void init_optimization_caches(game_state_t *game);
 
+/**
+ * Rebuilds every derived cache from the board in one pass: bitboard,
+ * line totals, stone count, winner cache and the zobrist/symmetry
+ * hashes. Batch paths (bulk load, undo, reinit) use this instead of
+ * per-stone incremental updates, and the search calls it at root entry
+ * when the board was edited behind the mirrors' back.
+ *
+ * @param game The game state
+ */
+void rebuild_optimization_caches(game_state_t *game);
+
 /**
  * Refreshes per-move bookkeeping after a stone is placed: increments the
  * stone count, applies the incremental zobrist update for the placed stone,
@@ -236,6 +530,34 @@ void init_optimization_caches(game_state_t *game);
  */
 void update_post_move_state(game_state_t *game, int x, int y);
 
+/**
+ * Applies a speculative search move: writes the stone, mirrors it into the
+ * bitboard, XORs the incremental zobrist hash, bumps the stone count, and
+ * invalidates the winner cache — all the bookkeeping a search node needs,
+ * in one call. Pair every call with search_unmake_move.
+ *
+ * @param game The game state
+ * @param board The board the search is mutating (game->board in practice)
+ * @param x X coordinate of the move
+ * @param y Y coordinate of the move
+ * @param player AI_CELL_CROSSES or AI_CELL_NAUGHTS
+ */
+void search_make_move(game_state_t *game, cell_t **board, int x, int y,
+                      int player);
+
+/**
+ * Exact inverse of search_make_move: clears the stone and unwinds the
+ * bitboard, hash, stone count, and winner cache bookkeeping.
+ *
+ * @param game The game state
+ * @param board The board the search is mutating (game->board in practice)
+ * @param x X coordinate of the move
+ * @param y Y coordinate of the move
+ * @param player AI_CELL_CROSSES or AI_CELL_NAUGHTS
+ */
+void search_unmake_move(game_state_t *game, cell_t **board, int x, int y,
+                        int player);
+
 /**
  * Invalidates the winner cache when a move is made.
  * 
@@ -260,26 +582,66 @@ int get_cached_winner(game_state_t *game, int player);
 void init_transposition_table(game_state_t *game);
 
 /**
- * Computes the Zobrist hash for the current position.
- * 
+ * Installs a process-wide shared transposition table. Every game state
+ * initialized afterwards probes and stores into this one table instead
+ * of allocating its own, so one search warms probes for every other
+ * context — worker threads, and (when the memory is a MAP_SHARED
+ * segment created before fork) prefork worker processes too. Safe
+ * because entries are lock-free (key = hash ^ data) and Zobrist keys
+ * come from a fixed seed, so hashes agree across all contexts.
+ *
+ * The table must hold 2 * entries_per_half entries (entries_per_half a
+ * power of two), be zeroed, and outlive every game state using it.
+ * Pass NULL to return to per-game heap tables.
+ *
+ * @param table            The shared entry array, or NULL
+ * @param entries_per_half Entries per perspective half (power of two)
+ */
+void tt_set_shared(transposition_entry_t *table, size_t entries_per_half);
+
+/**
+ * Computes the Zobrist hash for the current position. Also refreshes the
+ * symmetry hashes (sym_hashes) as a side effect, so assigning the result
+ * to current_hash leaves the whole hash set consistent.
+ *
  * @param game The game state
  * @return The hash value
  */
 uint64_t compute_zobrist_hash(game_state_t *game);
 
+/**
+ * Hash used for transposition probes and stores: the identity hash, or
+ * the minimum over all eight dihedral orientations while the stone count
+ * is at or under SYM_HASH_STONE_LIMIT, so mirrored openings share their
+ * table entries. Any recorded best move may then be in a twin's
+ * orientation — harmless, since the move is used purely for ordering and
+ * a non-candidate cell simply gets no boost.
+ */
+static inline uint64_t position_hash(const game_state_t *game) {
+  uint64_t hash = game->current_hash;
+  if (game->stones_on_board <= SYM_HASH_STONE_LIMIT) {
+    for (int t = 0; t < 7; t++) {
+      if (game->sym_hashes[t] < hash) {
+        hash = game->sym_hashes[t];
+      }
+    }
+  }
+  return hash;
+}
+
 /**
  * Stores a position evaluation in the transposition table.
- * 
+ *
  * @param game The game state
  * @param hash Position hash
- * @param ai_player The AI player (AI_CELL_CROSSES or AI_CELL_NOUGHTS)
+ * @param player The side to move, whose perspective `value` is from
  * @param value Evaluated value
  * @param depth Search depth
  * @param flag Type of bound (exact, lower, upper)
  * @param best_x Best move x coordinate
  * @param best_y Best move y coordinate
  */
-void store_transposition(game_state_t *game, uint64_t hash, int ai_player,
+void store_transposition(game_state_t *game, uint64_t hash, int player,
                          int value, int depth, int flag, int best_x,
                          int best_y);
 
@@ -288,16 +650,30 @@ void store_transposition(game_state_t *game, uint64_t hash, int ai_player,
  *
  * @param game The game state
  * @param hash Position hash
- * @param ai_player The AI player (AI_CELL_CROSSES or AI_CELL_NOUGHTS)
+ * @param player The side to move, whose perspective the value is from
  * @param depth Search depth
  * @param alpha Alpha value
  * @param beta Beta value
  * @param value Pointer to store the cached value
  * @return 1 if found and usable, 0 otherwise
  */
-int probe_transposition(game_state_t *game, uint64_t hash, int ai_player,
+int probe_transposition(game_state_t *game, uint64_t hash, int player,
                         int depth, int alpha, int beta, int *value);
 
+/**
+ * Fetches the stored best move for a position, if any, regardless of the
+ * entry's depth or bound type. Used purely for move ordering.
+ *
+ * @param game The game state
+ * @param hash Position hash
+ * @param player The side to move
+ * @param best_x Receives the move x coordinate
+ * @param best_y Receives the move y coordinate
+ * @return 1 if a recorded move was found, 0 otherwise
+ */
+int probe_transposition_move(game_state_t *game, uint64_t hash, int player,
+                             int *best_x, int *best_y);
+
 /**
  * Initializes the killer moves table.
  * 
@@ -326,6 +702,40 @@ void store_killer_move(game_state_t *game, int depth, int x, int y);
  */
 int is_killer_move(game_state_t *game, int depth, int x, int y);
 
+/**
+ * Clears the history and countermove tables.
+ *
+ * @param game The game state
+ */
+void init_history_tables(game_state_t *game);
+
+/**
+ * Credits a move that caused a beta cutoff in the history table, weighted
+ * by depth squared so deep cutoffs dominate leaf noise.
+ *
+ * @param game The game state
+ * @param player The side to move that made the cutoff move
+ * @param x Move x coordinate
+ * @param y Move y coordinate
+ * @param depth Remaining depth at the cutoff node
+ */
+void store_history_cutoff(game_state_t *game, int player, int x, int y,
+                          int depth);
+
+/**
+ * Records (x, y) as the refutation of the previous move at (prev_x,
+ * prev_y) for `player`.
+ *
+ * @param game The game state
+ * @param player The side to move that refuted the previous move
+ * @param prev_x Previous move x coordinate
+ * @param prev_y Previous move y coordinate
+ * @param x Refutation x coordinate
+ * @param y Refutation y coordinate
+ */
+void store_countermove(game_state_t *game, int player, int prev_x, int prev_y,
+                       int x, int y);
+
 /**
  * Initializes the threat-space search system.
  * 
@@ -384,15 +794,19 @@ void update_aspiration_window(game_state_t *game, int depth, int value, int alph
 int should_try_null_move(game_state_t *game, int depth);
 
 /**
- * Performs null-move pruning search.
- * 
+ * Performs null-move pruning search: lets the opponent move twice in a
+ * row at reduced depth with a null window around beta.
+ *
  * @param game The game state
  * @param depth Current search depth
  * @param beta Beta value
- * @param ai_player AI player
- * @return Search result or 0 if no pruning
+ * @param player The side to move (the player passing its turn)
+ * @param last_x Row of the last placed stone (terminal-check context)
+ * @param last_y Column of the last placed stone
+ * @return 1 if the null search failed high (prune with beta), 0 otherwise
  */
-int try_null_move_pruning(game_state_t *game, int depth, int beta, int ai_player);
+int try_null_move_pruning(game_state_t *game, int depth, int beta,
+                          int player, int last_x, int last_y);
 
 //===============================================================================
 // TIMING FUNCTIONS
@@ -400,11 +814,22 @@ int try_null_move_pruning(game_state_t *game, int depth, int beta, int ai_player
 
 /**
  * Gets the current time in seconds.
- * 
+ *
  * @return Current time as double
  */
 double get_current_time(void);
 
+/**
+ * Advances the game's xorshift64* RNG and returns 32 random bits.
+ * Used for tie-breaks among equal-score moves; seeded from
+ * config.rng_seed at init (0 = time-based) so a fixed --seed makes
+ * move selection reproducible.
+ *
+ * @param game The game state
+ * @return Next 32-bit pseudo-random value
+ */
+uint32_t game_rand(game_state_t *game);
+
 /**
  * Starts the move timer.
  * 
@@ -428,6 +853,38 @@ double end_move_timer(game_state_t *game);
  */
 int is_search_timed_out(game_state_t *game);
 
+/**
+ * Invalidate cached threat scores on the four lines through (x, y) by
+ * bumping those lines' version counters — four increments, no cell walk.
+ * A placed or removed stone can only change threats on lines that pass
+ * through it, so everything else stays warm. Called from the search
+ * make/unmake paths and update_post_move_state.
+ */
+void invalidate_threat_cache(game_state_t *game, int x, int y);
+
+/**
+ * Current validity key for the cell (x, y): the cache epoch plus the
+ * versions of its four lines. Entries store the key they were computed
+ * under; every invalidation event strictly increases the key (counters
+ * and epoch only grow), so a stale stamp can never match short of a
+ * uint32 wrap. Line ids: row y for the x-direction, column x for the
+ * y-direction, the two diagonal indices for the rest.
+ */
+static inline uint32_t threat_cache_key(const game_state_t *game, int x,
+                                        int y) {
+  int size = game->board_size;
+  return game->threat_cache_epoch + game->line_version[0][y] +
+         game->line_version[1][x] + game->line_version[2][x - y + size - 1] +
+         game->line_version[3][x + y];
+}
+
+/**
+ * Invalidate the whole per-cell threat cache. Used after bulk board
+ * changes (undo, replay load) where per-cell invalidation isn't worth
+ * tracking.
+ */
+void clear_threat_cache(game_state_t *game);
+
 //===============================================================================
 // HISTORY MANAGEMENT
 //===============================================================================
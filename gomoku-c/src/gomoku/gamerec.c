@@ -0,0 +1,217 @@
+//
+//  gamerec.c
+//  gomoku - compact binary game-record corpus format
+//
+//  Reader and writer for the .gmr corpus layout documented in gamerec.h.
+//  The reader follows the NNUE weights loader: mmap on POSIX, a malloc'd
+//  file image on the MinGW brain build.
+//
+
+#include "gamerec.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+// No mmap on the MinGW brain build: read the file into a malloc'd
+// buffer instead. The corpus interface is identical either way.
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define GAMEREC_FILE_HEADER_SIZE 16
+#define GAMEREC_RECORD_HEADER_SIZE 8
+
+int gamerec_open(gamerec_corpus_t *corpus, const char *path) {
+  memset(corpus, 0, sizeof(*corpus));
+
+  uint8_t *base = NULL;
+  size_t size = 0;
+
+#ifdef _WIN32
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    return 0;
+  }
+  fseek(f, 0, SEEK_END);
+  long fsize = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if (fsize <= 0) {
+    fclose(f);
+    return 0;
+  }
+  base = malloc((size_t)fsize);
+  if (!base || fread(base, 1, (size_t)fsize, f) != (size_t)fsize) {
+    free(base);
+    fclose(f);
+    return 0;
+  }
+  fclose(f);
+  size = (size_t)fsize;
+#else
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return 0;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return 0;
+  }
+  size = (size_t)st.st_size;
+  base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    return 0;
+  }
+#endif
+
+  // Header: magic, version, game count, reserved.
+  uint32_t header[4];
+  if (size < GAMEREC_FILE_HEADER_SIZE) {
+    goto fail;
+  }
+  memcpy(header, base, sizeof(header));
+  if (header[0] != GAMEREC_MAGIC || header[1] != GAMEREC_VERSION) {
+    goto fail;
+  }
+
+  corpus->base = base;
+  corpus->size = size;
+  corpus->game_count = header[2];
+  return 1;
+
+fail:
+#ifdef _WIN32
+  free(base);
+#else
+  munmap(base, size);
+#endif
+  return 0;
+}
+
+void gamerec_close(gamerec_corpus_t *corpus) {
+  if (!corpus->base) {
+    return;
+  }
+#ifdef _WIN32
+  free((void *)corpus->base);
+#else
+  munmap((void *)corpus->base, corpus->size);
+#endif
+  memset(corpus, 0, sizeof(*corpus));
+}
+
+int gamerec_next(const gamerec_corpus_t *corpus, size_t *cursor,
+                 gamerec_view_t *view) {
+  if (!corpus->base) {
+    return 0;
+  }
+  size_t offset = *cursor ? *cursor : GAMEREC_FILE_HEADER_SIZE;
+  if (offset + GAMEREC_RECORD_HEADER_SIZE > corpus->size) {
+    return 0;
+  }
+
+  const uint8_t *rec = corpus->base + offset;
+  uint16_t move_count;
+  memcpy(&move_count, rec, sizeof(move_count));
+  int board_size = rec[2];
+  int result = rec[3];
+
+  // A bad record header means the rest of the file can't be trusted
+  // (record boundaries are derived, not indexed) — end the scan.
+  if (board_size < 5 || board_size > 19 || result > GAMEREC_RESULT_DRAW ||
+      move_count > MAX_MOVE_HISTORY ||
+      offset + GAMEREC_RECORD_HEADER_SIZE + (size_t)move_count * 2 >
+          corpus->size) {
+    return 0;
+  }
+
+  view->board_size = board_size;
+  view->move_count = move_count;
+  view->result = result;
+  view->depth_x = rec[4];
+  view->depth_o = rec[5];
+  view->radius = rec[6];
+  // Record headers are 8 bytes and moves 2 bytes each, so every move
+  // array sits at an even offset and the cast is alignment-safe.
+  view->moves = (const uint16_t *)(rec + GAMEREC_RECORD_HEADER_SIZE);
+
+  *cursor = offset + GAMEREC_RECORD_HEADER_SIZE + (size_t)move_count * 2;
+  return 1;
+}
+
+int gamerec_writer_open(gamerec_writer_t *writer, const char *path) {
+  memset(writer, 0, sizeof(*writer));
+  writer->file = fopen(path, "wb");
+  if (!writer->file) {
+    return 0;
+  }
+  // Placeholder header; game_count is patched by gamerec_writer_close.
+  uint32_t header[4] = {GAMEREC_MAGIC, GAMEREC_VERSION, 0, 0};
+  if (fwrite(header, sizeof(header), 1, writer->file) != 1) {
+    fclose(writer->file);
+    writer->file = NULL;
+    return 0;
+  }
+  return 1;
+}
+
+int gamerec_writer_add(gamerec_writer_t *writer, int board_size, int result,
+                       int depth_x, int depth_o, int radius,
+                       const move_history_t *moves, int move_count) {
+  if (!writer->file || board_size < 5 || board_size > 19 ||
+      result < 0 || result > GAMEREC_RESULT_DRAW || move_count < 0 ||
+      move_count > MAX_MOVE_HISTORY) {
+    return 0;
+  }
+  for (int i = 0; i < move_count; i++) {
+    if (moves[i].x < 0 || moves[i].x >= board_size || moves[i].y < 0 ||
+        moves[i].y >= board_size ||
+        (moves[i].player != AI_CELL_CROSSES &&
+         moves[i].player != AI_CELL_NAUGHTS)) {
+      return 0;
+    }
+  }
+
+  uint8_t rec[GAMEREC_RECORD_HEADER_SIZE];
+  uint16_t count16 = (uint16_t)move_count;
+  memcpy(rec, &count16, sizeof(count16));
+  rec[2] = (uint8_t)board_size;
+  rec[3] = (uint8_t)result;
+  rec[4] = (uint8_t)(depth_x > 0 ? depth_x : 0);
+  rec[5] = (uint8_t)(depth_o > 0 ? depth_o : 0);
+  rec[6] = (uint8_t)(radius > 0 ? radius : 0);
+  rec[7] = 0;
+  if (fwrite(rec, sizeof(rec), 1, writer->file) != 1) {
+    return 0;
+  }
+
+  for (int i = 0; i < move_count; i++) {
+    uint16_t packed = gamerec_pack_move(moves[i].x, moves[i].y,
+                                        moves[i].player, moves[i].is_winner);
+    if (fwrite(&packed, sizeof(packed), 1, writer->file) != 1) {
+      return 0;
+    }
+  }
+
+  writer->game_count++;
+  return 1;
+}
+
+int gamerec_writer_close(gamerec_writer_t *writer) {
+  if (!writer->file) {
+    return 0;
+  }
+  int ok = fseek(writer->file, 8, SEEK_SET) == 0 &&
+           fwrite(&writer->game_count, sizeof(uint32_t), 1, writer->file) == 1;
+  if (fclose(writer->file) != 0) {
+    ok = 0;
+  }
+  writer->file = NULL;
+  return ok;
+}
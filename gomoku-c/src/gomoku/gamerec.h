@@ -0,0 +1,172 @@
+//
+//  gamerec.h
+//  gomoku - compact binary game-record corpus format
+//
+//  The games/ corpus is stored as one json-c document per game, which
+//  the tuning harnesses re-parse on every run. A .gmr corpus instead
+//  packs many games into a single file: a 16-byte file header, then one
+//  8-byte record header plus two packed bytes per move for each game.
+//  The reader mmaps the file (read-only, like the NNUE weights loader)
+//  so a corpus scan touches no allocator and copies no move data — a
+//  game's move list is a pointer straight into the mapping.
+//
+//  File layout (all fields little-endian, every offset 2-byte aligned):
+//
+//    uint32 magic      GAMEREC_MAGIC ('GMKR')
+//    uint32 version    GAMEREC_VERSION
+//    uint32 game_count
+//    uint32 reserved   zero
+//
+//  followed by game_count records of:
+//
+//    uint16 move_count
+//    uint8  board_size
+//    uint8  result     GAMEREC_RESULT_*
+//    uint8  depth_x    0 = unrecorded
+//    uint8  depth_o    0 = unrecorded
+//    uint8  radius     0 = unrecorded
+//    uint8  flags      zero
+//    uint16 moves[move_count]   see gamerec_pack_move()
+//
+
+#ifndef GAMEREC_H
+#define GAMEREC_H
+
+#include "game.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// 'GMKR' little-endian, mirroring the NNUE/snapshot magic convention.
+#define GAMEREC_MAGIC 0x524B4D47u
+#define GAMEREC_VERSION 1
+
+// Recorded outcome, from X's point of view.
+#define GAMEREC_RESULT_UNKNOWN 0
+#define GAMEREC_RESULT_X_WIN 1
+#define GAMEREC_RESULT_O_WIN 2
+#define GAMEREC_RESULT_DRAW 3
+
+/**
+ * An open corpus file. `base` is the raw mapping (malloc'd file image on
+ * Windows, where the brain build has no mmap); views handed out by
+ * gamerec_next() point into it and are valid until gamerec_close().
+ */
+typedef struct {
+  const uint8_t *base;
+  size_t size;
+  uint32_t game_count;
+} gamerec_corpus_t;
+
+/**
+ * Zero-copy view of one game record. `moves` aliases the mapping; decode
+ * entries with the gamerec_move_*() accessors below.
+ */
+typedef struct {
+  int board_size;
+  int move_count;
+  int result;  // GAMEREC_RESULT_*
+  int depth_x; // 0 = unrecorded
+  int depth_o; // 0 = unrecorded
+  int radius;  // 0 = unrecorded
+  const uint16_t *moves;
+} gamerec_view_t;
+
+/**
+ * Packs one move into the on-disk format: x in bits 0-4, y in bits 5-9,
+ * player in bit 10 (0 = crosses, 1 = naughts), winner flag in bit 11.
+ * Five bits per coordinate cover the 19x19 maximum board.
+ */
+static inline uint16_t gamerec_pack_move(int x, int y, int player,
+                                         int is_winner) {
+  return (uint16_t)((x & 0x1F) | ((y & 0x1F) << 5) |
+                    ((player == AI_CELL_NAUGHTS) ? (1u << 10) : 0u) |
+                    (is_winner ? (1u << 11) : 0u));
+}
+
+static inline int gamerec_move_x(uint16_t move) { return move & 0x1F; }
+
+static inline int gamerec_move_y(uint16_t move) { return (move >> 5) & 0x1F; }
+
+static inline int gamerec_move_player(uint16_t move) {
+  return (move & (1u << 10)) ? AI_CELL_NAUGHTS : AI_CELL_CROSSES;
+}
+
+static inline int gamerec_move_is_winner(uint16_t move) {
+  return (move >> 11) & 1;
+}
+
+/**
+ * Maps a corpus file read-only and validates its header.
+ *
+ * @param corpus Corpus handle to fill
+ * @param path Corpus file path
+ * @return 1 on success, 0 on open/validation failure
+ */
+int gamerec_open(gamerec_corpus_t *corpus, const char *path);
+
+/**
+ * Releases the mapping. Views from gamerec_next() become invalid.
+ */
+void gamerec_close(gamerec_corpus_t *corpus);
+
+/**
+ * Iterates the corpus: with `*cursor` initialized to 0, each call fills
+ * `view` with the next record and advances the cursor. Records with
+ * malformed headers or truncated move lists end the scan early.
+ *
+ * @param corpus Open corpus
+ * @param cursor Byte-offset iteration state, start at 0
+ * @param view Filled with the next record's fields and move pointer
+ * @return 1 if a record was produced, 0 at end of corpus
+ */
+int gamerec_next(const gamerec_corpus_t *corpus, size_t *cursor,
+                 gamerec_view_t *view);
+
+/**
+ * Streaming corpus writer used by the JSON converter and the self-play
+ * harnesses. Records are appended with gamerec_writer_add(); the header's
+ * game count is patched on close.
+ */
+typedef struct {
+  FILE *file;
+  uint32_t game_count;
+} gamerec_writer_t;
+
+/**
+ * Creates (truncates) a corpus file and writes a placeholder header.
+ *
+ * @param writer Writer handle to fill
+ * @param path Destination path
+ * @return 1 on success, 0 on failure
+ */
+int gamerec_writer_open(gamerec_writer_t *writer, const char *path);
+
+/**
+ * Appends one game record. Moves outside the board or beyond the packed
+ * coordinate range are rejected rather than silently truncated.
+ *
+ * @param writer Open writer
+ * @param board_size Board dimension (5..19)
+ * @param result GAMEREC_RESULT_* outcome
+ * @param depth_x AI depth for X, 0 or -1 if unrecorded
+ * @param depth_o AI depth for O, 0 or -1 if unrecorded
+ * @param radius Search radius, 0 or -1 if unrecorded
+ * @param moves Move list to pack
+ * @param move_count Number of moves
+ * @return 1 on success, 0 on validation/write failure
+ */
+int gamerec_writer_add(gamerec_writer_t *writer, int board_size, int result,
+                       int depth_x, int depth_o, int radius,
+                       const move_history_t *moves, int move_count);
+
+/**
+ * Patches the final game count into the header and closes the file.
+ *
+ * @param writer Open writer
+ * @return 1 on success, 0 on write/close failure
+ */
+int gamerec_writer_close(gamerec_writer_t *writer);
+
+#endif // GAMEREC_H
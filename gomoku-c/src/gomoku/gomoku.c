@@ -8,6 +8,7 @@
 //
 
 #include "gomoku.h"
+#include "threat_weights.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -41,20 +42,46 @@
 #define THREAT_THREE_AND_THREE 10
 #define THREAT_THREE_AND_THREE_BROKEN 11
 
-static int threat_cost[20];
-static int threat_initialized = 0;
-static int threats[NUM_DIRECTIONS];
+// Threat valuation table. Compile-time const (rather than filled in lazily
+// by populate_threat_matrix) so the evaluator carries no mutable file-scope
+// state and stays re-entrant — a hard requirement for concurrent searches
+// in gomoku-httpd and any future multi-threaded search.
+static const int threat_cost[20] = {
+    // Single threats - base values (see threat_weights.h for the numbers
+    // and how to regenerate them with the tuning harness)
+    [THREAT_NOTHING] = 0,
+    [THREAT_FIVE] = THREAT_WEIGHT_FIVE,
+    [THREAT_STRAIGHT_FOUR] = THREAT_WEIGHT_STRAIGHT_FOUR,
+    [THREAT_FOUR] = THREAT_WEIGHT_FOUR,
+    [THREAT_FOUR_BROKEN] = THREAT_WEIGHT_FOUR_BROKEN,
+    [THREAT_THREE] = THREAT_WEIGHT_THREE,
+    [THREAT_THREE_BROKEN] = THREAT_WEIGHT_THREE_BROKEN,
+    [THREAT_TWO] = THREAT_WEIGHT_TWO,
+    [THREAT_NEAR_ENEMY] = THREAT_WEIGHT_NEAR_ENEMY,
+
+    // Combination threats - these are nearly winning positions!
+    // If you have an open three + any four, opponent can only block one
+    [THREAT_THREE_AND_FOUR] = THREAT_WEIGHT_THREE_AND_FOUR,
+    [THREAT_THREE_AND_THREE] = THREAT_WEIGHT_THREE_AND_THREE,
+    [THREAT_THREE_AND_THREE_BROKEN] = THREAT_WEIGHT_THREE_AND_THREE_BROKEN,
+};
+
+const int *threat_cost_defaults(void) { return threat_cost; }
 
 // Function declarations
 void populate_threat_matrix();
+static int calc_combination_threat_with(int one, int two,
+                                        const int *threat_costs);
 void reset_row(int *row, int size);
 int other_player(int player);
-int calc_score_at(int **board, int size, int player, int x, int y);
+int calc_score_at(cell_t **board, int size, int player, int x, int y);
 int calc_threat_in_one_dimension(int *row, int player);
 int count_squares(int value, int player, int *last_square, int *hole_count,
                   int *square_count, int *contiguous_square_count,
                   int *enemy_count);
 int calc_combination_threat(int one, int two);
+static void threats_by_row_copy(cell_t **board, int size, int player, int x,
+                                int y, int *threats);
 
 // Helper macros
 #define max(a, b) ((a) > (b) ? (a) : (b))
@@ -68,9 +95,8 @@ int calc_combination_threat(int one, int two);
  * Fast incremental evaluation focusing on positions near last move
  * Much faster than full board evaluation
  */
-static int evaluate_position_local_region(int **board, int size, int player,
+static int evaluate_position_local_region(cell_t **board, int size, int player,
                                           int last_x, int last_y) {
-  populate_threat_matrix();
 
   int total_score = 0;
   int opponent = other_player(player);
@@ -95,19 +121,17 @@ static int evaluate_position_local_region(int **board, int size, int player,
   return total_score;
 }
 
-int evaluate_position_incremental(int **board, int size, int player, int last_x,
+int evaluate_position_incremental(cell_t **board, int size, int player, int last_x,
                                   int last_y) {
-  // Keep full terminal semantics for legacy callers.
-  if (has_winner(board, size, player)) {
-    return 1000000; // Win
-  }
-  if (has_winner(board, size, other_player(player))) {
-    return -1000000; // Loss
+  // Terminal check is local: a five can only have appeared through the
+  // last stone placed, so no full-board scan is needed.
+  if (has_five_through(board, size, last_x, last_y)) {
+    return (board[last_x][last_y] == player) ? 1000000 : -1000000;
   }
   return evaluate_position_local_region(board, size, player, last_x, last_y);
 }
 
-int evaluate_position_incremental_fast(int **board, int size, int player,
+int evaluate_position_incremental_fast(cell_t **board, int size, int player,
                                        int last_x, int last_y) {
   return evaluate_position_local_region(board, size, player, last_x, last_y);
 }
@@ -115,8 +139,7 @@ int evaluate_position_incremental_fast(int **board, int size, int player,
 /**
  * Original full board evaluation function - kept for fallback
  */
-int evaluate_position(int **board, int size, int player) {
-  populate_threat_matrix();
+int evaluate_position(cell_t **board, int size, int player) {
 
   int total_score = 0;
   int opponent = other_player(player);
@@ -144,9 +167,12 @@ int evaluate_position(int **board, int size, int player) {
 }
 
 /**
- * Simple win detection - checks if player has 5 in a row anywhere on board
+ * Simple win detection - checks if player has 5 in a row anywhere on board.
+ * O(n^2) cold-validation path; hot paths use has_five_through() on the last
+ * move (a new five must pass through the stone that completed it) or the
+ * bitboard mirror in game.c.
  */
-int has_winner(int **board, int size, int player) {
+int has_winner(cell_t **board, int size, int player) {
   // Check all positions for 5 in a row
   for (int i = 0; i < size; i++) {
     for (int j = 0; j < size; j++) {
@@ -187,6 +213,50 @@ int has_winner(int **board, int size, int player) {
   return 0; // No winner
 }
 
+/**
+ * Last-move-local win detection: checks whether the stone at (x, y)
+ * completes exactly five in a row in any direction. Because a new five must
+ * pass through the stone that created it, this replaces full-board
+ * has_winner() scans everywhere the last move is known. Overline (six or
+ * more) does not win, matching has_winner() semantics.
+ */
+int has_five_through(cell_t **board, int size, int x, int y) {
+  if (x < 0 || y < 0 || x >= size || y >= size ||
+      board[x][y] == AI_CELL_EMPTY) {
+    return 0;
+  }
+  int player = board[x][y];
+
+  int directions[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+  for (int d = 0; d < 4; d++) {
+    int dx = directions[d][0];
+    int dy = directions[d][1];
+    int count = 1;
+
+    int nx = x + dx, ny = y + dy;
+    while (nx >= 0 && nx < size && ny >= 0 && ny < size &&
+           board[nx][ny] == player) {
+      count++;
+      nx += dx;
+      ny += dy;
+    }
+
+    nx = x - dx;
+    ny = y - dy;
+    while (nx >= 0 && nx < size && ny >= 0 && ny < size &&
+           board[nx][ny] == player) {
+      count++;
+      nx -= dx;
+      ny -= dy;
+    }
+
+    if (count == 5) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
 //===============================================================================
 // PATTERN ANALYSIS FUNCTIONS (CORE LOGIC FROM ORIGINAL)
 //===============================================================================
@@ -199,11 +269,117 @@ void reset_row(int *row, int size) {
   }
 }
 
+// Pattern lookup table: the 8 non-center cells of a 9-cell line, two bits
+// each (relative encoding below), index a precomputed threat class. Built
+// once at startup by populate_threat_matrix — single-threaded init, then
+// read-only, so the evaluator stays re-entrant.
+#define LINE_CELL_OWN 0
+#define LINE_CELL_ENEMY 1
+#define LINE_CELL_EMPTY 2
+#define LINE_CELL_OOB 3
+#define THREAT_LUT_SIZE (1 << (2 * SEARCH_RADIUS * 2))
+
+static uint8_t threat_lut[THREAT_LUT_SIZE];
+static int threat_lut_ready = 0;
+
+/**
+ * Builds the packed 16-bit line code for one direction by walking the
+ * board directly with the direction's (dx, dy) stride — the probed stone's
+ * cell is skipped exactly like pack_line_code skips the center. Cells past
+ * the board edge encode as LINE_CELL_OOB, matching what the row-copy path
+ * leaves at OUT_OF_BOUNDS, so both paths index the same table entries.
+ * Positions a full window away from every edge take the branch-free loop.
+ */
+static unsigned line_code_in_direction(cell_t **board, int size, int player,
+                                       int x, int y, int dx, int dy) {
+  unsigned code = 0;
+  int k;
+
+  if (x - SEARCH_RADIUS >= 0 && x + SEARCH_RADIUS < size &&
+      y - SEARCH_RADIUS >= 0 && y + SEARCH_RADIUS < size) {
+    for (k = -SEARCH_RADIUS; k <= SEARCH_RADIUS; k++) {
+      if (k == 0) {
+        continue;
+      }
+      int v = board[x + k * dx][y + k * dy];
+      unsigned state = (v == player)    ? LINE_CELL_OWN
+                       : (v == -player) ? LINE_CELL_ENEMY
+                                        : LINE_CELL_EMPTY;
+      code = (code << 2) | state;
+    }
+    return code;
+  }
+
+  for (k = -SEARCH_RADIUS; k <= SEARCH_RADIUS; k++) {
+    if (k == 0) {
+      continue;
+    }
+    int cx = x + k * dx;
+    int cy = y + k * dy;
+    unsigned state;
+    if (cx < 0 || cx >= size || cy < 0 || cy >= size) {
+      state = LINE_CELL_OOB;
+    } else {
+      int v = board[cx][cy];
+      state = (v == player)    ? LINE_CELL_OWN
+              : (v == -player) ? LINE_CELL_ENEMY
+                               : LINE_CELL_EMPTY;
+    }
+    code = (code << 2) | state;
+  }
+  return code;
+}
+
 /**
  * Calculates the threat score for placing a stone at position (x,y)
- * This is the core pattern recognition function from the original code
+ * This is the core pattern recognition function from the original code.
+ * The _with variant scores against a caller-supplied cost table — the
+ * tuning harness probes candidate weights through it; engine code uses
+ * the plain wrapper, which applies the built-in table.
+ */
+int calc_score_at_with(cell_t **board, int size, int player, int x, int y,
+                       const int *threat_costs) {
+  // Per-direction threat classes live on the stack so concurrent callers
+  // never stomp each other's results.
+  int threats[NUM_DIRECTIONS] = {0};
+  int i, j;
+  int score = 0;
+
+  if (threat_lut_ready) {
+    // Hot path: build each direction's packed line code by walking the
+    // board directly — no intermediate row[] copies. The classes come
+    // straight out of the lookup table.
+    threats[0] = threat_lut[line_code_in_direction(board, size, player, x, y,
+                                                   1, 0)];
+    threats[1] = threat_lut[line_code_in_direction(board, size, player, x, y,
+                                                   0, 1)];
+    threats[2] = threat_lut[line_code_in_direction(board, size, player, x, y,
+                                                   1, 1)];
+    threats[3] = threat_lut[line_code_in_direction(board, size, player, x, y,
+                                                   1, -1)];
+  } else {
+    threats_by_row_copy(board, size, player, x, y, threats);
+  }
+
+  // Calculate total score including combinations
+  for (i = 0; i < NUM_DIRECTIONS; i++) {
+    score += threat_costs[threats[i]];
+    for (j = i + 1; j < NUM_DIRECTIONS; j++) {
+      score += calc_combination_threat_with(threats[i], threats[j],
+                                            threat_costs);
+    }
+  }
+
+  return score;
+}
+
+/**
+ * Pre-LUT fallback: copies each direction's window into a local row[] and
+ * classifies it with the stateful walk. Only reachable before
+ * populate_threat_matrix has run (and from the table builder itself).
  */
-int calc_score_at(int **board, int size, int player, int x, int y) {
+static void threats_by_row_copy(cell_t **board, int size, int player, int x,
+                                int y, int *threats) {
   int min_x = max(x - SEARCH_RADIUS, 0);
   int max_x = min(x + SEARCH_RADIUS, size - 1);
   int min_y = max(y - SEARCH_RADIUS, 0);
@@ -212,9 +388,6 @@ int calc_score_at(int **board, int size, int player, int x, int y) {
   int row_size = SEARCH_RADIUS * 2 + 1;
   int row[SEARCH_RADIUS * 2 + 1];
   int i, index;
-  int score = 0;
-
-  memset(threats, 0, NUM_DIRECTIONS * sizeof(int));
 
   // Analyze horizontal direction
   reset_row(row, row_size);
@@ -264,23 +437,23 @@ int calc_score_at(int **board, int size, int player, int x, int y) {
     row[index] = board[i][j];
   }
   threats[3] = calc_threat_in_one_dimension(row, player);
+}
 
-  // Calculate total score including combinations
-  for (i = 0; i < NUM_DIRECTIONS; i++) {
-    score += threat_cost[threats[i]];
-    for (j = i + 1; j < NUM_DIRECTIONS; j++) {
-      score += calc_combination_threat(threats[i], threats[j]);
-    }
-  }
-
-  return score;
+int calc_score_at(cell_t **board, int size, int player, int x, int y) {
+  return calc_score_at_with(board, size, player, x, y, threat_cost);
 }
 
 /**
  * Analyzes a single line/direction for threat patterns
  * The stone of interest is assumed to be at the center of the array
  */
-int calc_threat_in_one_dimension(int *row, int player) {
+/**
+ * Scalar line classifier: the original stateful walk via count_squares.
+ * Kept as the reference implementation — it seeds the lookup table in
+ * populate_threat_matrix and serves as the fallback before the table is
+ * built.
+ */
+static int classify_line_scalar(const int *row, int player) {
   int player_square_count = 1; // Include the center stone
   int player_contiguous_square_count = 1;
   int enemy_count = 0;
@@ -342,6 +515,40 @@ int calc_threat_in_one_dimension(int *row, int player) {
   return threat;
 }
 
+/**
+ * Packs a 9-cell row into the 16-bit table index. The center cell is
+ * always the probed player's stone (calc_score_at places it), so only the
+ * 8 surrounding cells are encoded. The encoding is relative to `player`,
+ * which lets one table serve both sides.
+ */
+static unsigned pack_line_code(const int *row, int player) {
+  unsigned code = 0;
+  for (int i = 0; i <= SEARCH_RADIUS * 2; i++) {
+    if (i == SEARCH_RADIUS) {
+      continue;
+    }
+    unsigned state;
+    if (row[i] == player) {
+      state = LINE_CELL_OWN;
+    } else if (row[i] == -player) {
+      state = LINE_CELL_ENEMY;
+    } else if (row[i] == AI_CELL_EMPTY) {
+      state = LINE_CELL_EMPTY;
+    } else {
+      state = LINE_CELL_OOB;
+    }
+    code = (code << 2) | state;
+  }
+  return code;
+}
+
+int calc_threat_in_one_dimension(int *row, int player) {
+  if (threat_lut_ready) {
+    return threat_lut[pack_line_code(row, player)];
+  }
+  return classify_line_scalar(row, player);
+}
+
 int count_squares(int value, int player, int *last_square, int *hole_count,
                   int *square_count, int *contiguous_square_count,
                   int *enemy_count) {
@@ -364,7 +571,8 @@ int count_squares(int value, int player, int *last_square, int *hole_count,
   return RT_CONTINUE;
 }
 
-int calc_combination_threat(int one, int two) {
+static int calc_combination_threat_with(int one, int two,
+                                        const int *threat_costs) {
   // Ensure one <= two for simpler comparisons
   if (one > two) {
     int temp = one;
@@ -378,12 +586,12 @@ int calc_combination_threat(int one, int two) {
   if (one == THREAT_THREE &&
       (two == THREAT_FOUR || two == THREAT_STRAIGHT_FOUR ||
        two == THREAT_FOUR_BROKEN)) {
-    return threat_cost[THREAT_THREE_AND_FOUR];
+    return threat_costs[THREAT_THREE_AND_FOUR];
   }
 
   // Two open threes = winning
   if (one == THREAT_THREE && two == THREAT_THREE) {
-    return threat_cost[THREAT_THREE_AND_THREE];
+    return threat_costs[THREAT_THREE_AND_THREE];
   }
 
   // VERY STRONG COMBINATIONS
@@ -392,24 +600,24 @@ int calc_combination_threat(int one, int two) {
   if (one == THREAT_THREE_BROKEN &&
       (two == THREAT_FOUR || two == THREAT_STRAIGHT_FOUR ||
        two == THREAT_FOUR_BROKEN)) {
-    return threat_cost[THREAT_THREE_AND_THREE]; // Treat as strong as double
+    return threat_costs[THREAT_THREE_AND_THREE]; // Treat as strong as double
                                                 // three
   }
 
   // Open three + broken three = strong threat
   if (one == THREAT_THREE && two == THREAT_THREE_BROKEN) {
-    return threat_cost[THREAT_THREE_AND_THREE_BROKEN];
+    return threat_costs[THREAT_THREE_AND_THREE_BROKEN];
   }
 
   // Two broken threes with potential = moderate threat
   if (one == THREAT_THREE_BROKEN && two == THREAT_THREE_BROKEN) {
-    return threat_cost[THREAT_THREE_AND_THREE_BROKEN] / 2;
+    return threat_costs[THREAT_THREE_AND_THREE_BROKEN] / 2;
   }
 
   // Four + Four = extremely dangerous (multiple must-block threats)
   if ((one == THREAT_FOUR || one == THREAT_FOUR_BROKEN) &&
       (two == THREAT_FOUR || two == THREAT_FOUR_BROKEN)) {
-    return threat_cost[THREAT_THREE_AND_FOUR]; // Treat as winning
+    return threat_costs[THREAT_THREE_AND_FOUR]; // Treat as winning
   }
 
   // Any four + two = developing threat
@@ -426,31 +634,48 @@ int calc_combination_threat(int one, int two) {
   return 0;
 }
 
+int calc_combination_threat(int one, int two) {
+  return calc_combination_threat_with(one, two, threat_cost);
+}
+
 void populate_threat_matrix() {
-  if (threat_initialized > 0) {
+  // threat_cost is a compile-time const table; what remains to build here
+  // is the line-pattern lookup table. Exhaustively classify every encoded
+  // 8-cell neighborhood with the scalar walk once, so the hot path becomes
+  // one pack + one load. Idempotent; called from single-threaded startup.
+  if (threat_lut_ready) {
     return;
   }
 
-  threat_initialized = 1;
-
-  // Single threats - base values
-  threat_cost[THREAT_NOTHING] = 0;
-  threat_cost[THREAT_FIVE] = 100000; // Winning position
-  threat_cost[THREAT_STRAIGHT_FOUR] =
-      50000;                        // Open four = guaranteed win next turn
-  threat_cost[THREAT_FOUR] = 10000; // Closed four = MUST block or lose!
-  threat_cost[THREAT_FOUR_BROKEN] = 8000; // Four with hole = still must block
-  threat_cost[THREAT_THREE] = 1000;       // Open three = serious threat
-  threat_cost[THREAT_THREE_BROKEN] = 200; // Three with hole = developing threat
-  threat_cost[THREAT_TWO] = 50;           // Open two = potential
-  threat_cost[THREAT_NEAR_ENEMY] = 10;    // Positional value
-
-  // Combination threats - these are nearly winning positions!
-  // If you have an open three + any four, opponent can only block one
-  threat_cost[THREAT_THREE_AND_FOUR] = 45000; // Nearly as good as straight four
-  threat_cost[THREAT_THREE_AND_THREE] = 40000; // Double open three = winning
-  threat_cost[THREAT_THREE_AND_THREE_BROKEN] =
-      5000; // Weaker but still dangerous
+  int row[SEARCH_RADIUS * 2 + 1];
+  for (unsigned code = 0; code < THREAT_LUT_SIZE; code++) {
+    unsigned bits = code;
+    // Decode in reverse of pack_line_code's shift order.
+    for (int i = SEARCH_RADIUS * 2; i >= 0; i--) {
+      if (i == SEARCH_RADIUS) {
+        continue;
+      }
+      switch (bits & 3) {
+      case LINE_CELL_OWN:
+        row[i] = AI_CELL_CROSSES;
+        break;
+      case LINE_CELL_ENEMY:
+        row[i] = AI_CELL_NAUGHTS;
+        break;
+      case LINE_CELL_EMPTY:
+        row[i] = AI_CELL_EMPTY;
+        break;
+      default:
+        row[i] = OUT_OF_BOUNDS;
+        break;
+      }
+      bits >>= 2;
+    }
+    row[SEARCH_RADIUS] = AI_CELL_CROSSES;
+    threat_lut[code] = (uint8_t)classify_line_scalar(row, AI_CELL_CROSSES);
+  }
+
+  threat_lut_ready = 1;
 }
 
 //===============================================================================
@@ -460,7 +685,7 @@ void populate_threat_matrix() {
 /**
  * Example of how to use this evaluation function with minimax
  */
-int minimax_example(int **board, int size, int depth, int alpha, int beta,
+int minimax_example(cell_t **board, int size, int depth, int alpha, int beta,
                     int maximizing_player, int ai_player) {
 
   // Base case: evaluate leaf node
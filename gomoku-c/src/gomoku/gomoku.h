@@ -9,6 +9,7 @@
 #define GOMOKU_H
 
 #include <math.h>
+#include <stdint.h>
 #include "ansi.h"
 
 //===============================================================================
@@ -82,7 +83,11 @@
 // CONSTANTS AND DEFINITIONS
 //===============================================================================
 
-// Board cell values
+// Board cell values. Cells are a single signed byte: a 19x19 board fits in
+// ~361 bytes (one third of a cache line per row) instead of ~1.4KB as ints,
+// which quadruples L1 density for the candidate scans in the search.
+typedef int8_t cell_t;
+
 #define AI_CELL_EMPTY 0
 #define AI_CELL_CROSSES 1
 #define AI_CELL_NAUGHTS -1
@@ -189,7 +194,7 @@ typedef enum {
 //   depth: Maximum search depth
 //   alpha: Alpha value for alpha-beta pruning
 //   beta: Beta value for alpha-beta pruning
-int minimax_with_last_move(int **board, int depth, int alpha, int beta,
+int minimax_with_last_move(cell_t **board, int depth, int alpha, int beta,
         int maximizing_player, int ai_player, int last_x,
         int last_y);
 
@@ -211,7 +216,7 @@ void display_rules();
  * @param player The player to evaluate for (AI_CELL_CROSSES or AI_CELL_NAUGHTS)
  * @return Score where positive values favor the player, negative favor opponent
  */
-int evaluate_position(int **board, int size, int player);
+int evaluate_position(cell_t **board, int size, int player);
 
 /**
  * Fast incremental evaluation function for minimax algorithm.
@@ -224,14 +229,14 @@ int evaluate_position(int **board, int size, int player);
  * @param last_y Y coordinate of the last move
  * @return Score where positive values favor the player, negative favor opponent
  */
-int evaluate_position_incremental(int **board, int size, int player, int last_x,
+int evaluate_position_incremental(cell_t **board, int size, int player, int last_x,
         int last_y);
 
 /**
  * Incremental evaluation without terminal win/loss scans.
  * Intended for search code paths that already checked terminal status.
  */
-int evaluate_position_incremental_fast(int **board, int size, int player,
+int evaluate_position_incremental_fast(cell_t **board, int size, int player,
                                        int last_x, int last_y);
 
 /**
@@ -242,7 +247,21 @@ int evaluate_position_incremental_fast(int **board, int size, int player,
  * @param player The player to check for (AI_CELL_CROSSES or AI_CELL_NAUGHTS)
  * @return 1 if player has won, 0 otherwise
  */
-int has_winner(int **board, int size, int player);
+int has_winner(cell_t **board, int size, int player);
+
+/**
+ * Checks whether the stone at (x, y) completes exactly five in a row in any
+ * direction. A new five must pass through the stone that created it, so
+ * this is the O(1)-ish standard win check whenever the last move is known;
+ * has_winner() remains only for cold validation of arbitrary boards.
+ *
+ * @param board 2D array representing the game board
+ * @param size Size of the board
+ * @param x Row coordinate of the last stone placed
+ * @param y Column coordinate of the last stone placed
+ * @return 1 if that stone is part of an exact five, 0 otherwise
+ */
+int has_five_through(cell_t **board, int size, int x, int y);
 
 /**
  * Example minimax implementation using the evaluation function.
@@ -257,7 +276,7 @@ int has_winner(int **board, int size, int player);
  * @param ai_player The AI player (AI_CELL_CROSSES or AI_CELL_NAUGHTS)
  * @return Best evaluation score found
  */
-int minimax_example(int **board, int size, int depth, int alpha, int beta,
+int minimax_example(cell_t **board, int size, int depth, int alpha, int beta,
         int maximizing_player, int ai_player);
 
 //===============================================================================
@@ -275,7 +294,23 @@ int minimax_example(int **board, int size, int depth, int alpha, int beta,
  * @param y Column coordinate
  * @return Threat score for patterns around this position
  */
-int calc_score_at(int **board, int size, int player, int x, int y);
+int calc_score_at(cell_t **board, int size, int player, int x, int y);
+
+/**
+ * calc_score_at against a caller-supplied threat cost table instead of
+ * the built-in one. The table is indexed by the THREAT_* classes (20
+ * entries, same layout as the built-in threat_cost[]). Used by the
+ * evaluation tuning harness to probe candidate weight vectors; engine
+ * code should call calc_score_at.
+ */
+int calc_score_at_with(cell_t **board, int size, int player, int x, int y,
+                       const int *threat_costs);
+
+/**
+ * Returns the built-in threat cost table (read-only, 20 entries). The
+ * tuning harness seeds its search from these values.
+ */
+const int *threat_cost_defaults(void);
 
 /**
  * Analyzes a single line/direction for threat patterns.
@@ -310,8 +345,9 @@ int calc_combination_threat(int one, int two);
 int other_player(int player);
 
 /**
- * Initializes the threat scoring matrix.
- * Must be called before using evaluation functions.
+ * Historical init hook for the threat scoring matrix. The matrix is a
+ * compile-time const table now (keeping the evaluator re-entrant), so this
+ * is a no-op retained for call-site compatibility.
  */
 void populate_threat_matrix(void);
 
@@ -324,7 +360,7 @@ void populate_threat_matrix(void);
  */
 void reset_row(int *row, int size);
 
-int calc_score_at(int **board, int size, int player, int x, int y);
+int calc_score_at(cell_t **board, int size, int player, int x, int y);
 int calc_threat_in_one_dimension(int *row, int player);
 void populate_threat_matrix();
 
@@ -6,10 +6,15 @@
 //
 
 #include "ai.h"
+#include "board.h"
+#include "book.h"
 #include "cli.h"
 #include "game.h"
 #include "gomoku.h"
+#include "nnue.h"
+#include "snapshot.h"
 #include "ui.h"
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -43,6 +48,155 @@ static int get_player_depth(game_state_t *game, int player) {
   return game->depth_for_player[index];
 }
 
+//===============================================================================
+// BACKGROUND AI SEARCH
+//===============================================================================
+
+// find_best_ai_move arguments and completion flag for the worker thread.
+// best_x/best_y are updated by the search as each deepening iteration
+// completes, so the polling UI reads a live best-so-far from them.
+typedef struct {
+  game_state_t *game;
+  int best_x;
+  int best_y;
+  volatile int done;
+} ai_search_task_t;
+
+static void *ai_search_thread(void *arg) {
+  ai_search_task_t *task = (ai_search_task_t *)arg;
+  find_best_ai_move(task->game, &task->best_x, &task->best_y, NULL);
+  task->done = 1;
+  return NULL;
+}
+
+/**
+ * Runs find_best_ai_move on a worker thread while this (UI) thread keeps
+ * polling the keyboard and rendering a one-line progress readout: current
+ * deepening depth, nodes searched, elapsed time and the best move so far.
+ * 'm' forces move-now by raising the engine's stop flag, which harvests
+ * the best move found; 'q'/ESC quits the game the same way.
+ *
+ * Falls back to the old synchronous search if the thread can't be
+ * created.
+ *
+ * @param game The game state
+ * @param out_x Output: chosen move row
+ * @param out_y Output: chosen move column (-1 if the user quit)
+ */
+static void run_ai_move_background(game_state_t *game, int *out_x,
+                                   int *out_y) {
+  static volatile int stop_flag;
+  stop_flag = 0;
+  game->background_search = 1;
+  // is_search_timed_out checks this pointer at every node, so raising the
+  // flag unwinds the whole search stack with the current best preserved -
+  // the same mechanism the Lazy-SMP master uses to halt its helpers.
+  game->smp_stop = &stop_flag;
+
+  ai_search_task_t task = {game, -1, -1, 0};
+  pthread_t thread;
+  if (pthread_create(&thread, NULL, ai_search_thread, &task) != 0) {
+    game->smp_stop = NULL;
+    game->background_search = 0;
+    find_best_ai_move(game, out_x, out_y, NULL);
+    return;
+  }
+
+  uint64_t nodes_at_start = game->search_nodes;
+  int user_quit = 0;
+  while (!task.done) {
+    int key = get_key_timeout(100);
+    if (key == 'm' || key == 'M') {
+      stop_flag = 1; // Move now: harvest the best move found so far
+    } else if (key == 'q' || key == 'Q' || key == KEY_ESC) {
+      stop_flag = 1;
+      user_quit = 1;
+    }
+
+    // Racy reads of the worker's live counters - display only, the
+    // authoritative values are read after the join below.
+    int depth = game->search_progress_depth;
+    uint64_t nodes = game->search_nodes - nodes_at_start;
+    double elapsed = get_current_time() - game->search_start_time;
+    char best_str[8] = "...";
+    if (task.best_x >= 0) {
+      board_coord_to_notation(task.best_x, task.best_y, best_str,
+                              sizeof(best_str));
+    }
+    printf("\r  AI thinking: depth %d | %llu nodes | %.1fs | best %s | "
+           "'m' = move now   ",
+           depth, (unsigned long long)nodes, elapsed, best_str);
+    fflush(stdout);
+  }
+  pthread_join(thread, NULL);
+  printf("\r%*s\r", 78, ""); // Clear the progress line
+  fflush(stdout);
+
+  game->smp_stop = NULL;
+  game->background_search = 0;
+
+  if (user_quit) {
+    game->game_state = GAME_QUIT;
+    *out_x = -1;
+    *out_y = -1;
+    return;
+  }
+  *out_x = task.best_x;
+  *out_y = task.best_y;
+}
+
+// Keyframe snapshots for replay scrubbing: a full copy of the board
+// every REPLAY_KEYFRAME_INTERVAL moves. Seeking to move N restores the
+// nearest keyframe at or below N and bulk-applies at most one
+// interval's worth of moves - no per-move rendering, no replaying a
+// long game from move 0 to reach its end.
+#define REPLAY_KEYFRAME_INTERVAL 32
+
+/**
+ * Restores board, sidebar history and status to the position after
+ * `pos` moves of the replay, using the keyframe array built by
+ * run_replay_mode. Pure state reconstruction; the caller renders once
+ * afterwards.
+ */
+static void replay_seek(game_state_t *game, const replay_data_t *replay,
+                        const cell_t *keyframes, int pos) {
+  int n = game->board_size;
+  size_t cells = (size_t)n * n;
+  int k = pos / REPLAY_KEYFRAME_INTERVAL;
+  memcpy(game->board[0], keyframes + (size_t)k * cells,
+         cells * sizeof(cell_t));
+  for (int i = k * REPLAY_KEYFRAME_INTERVAL; i < pos; i++) {
+    game->board[replay->moves[i].x][replay->moves[i].y] =
+        (cell_t)replay->moves[i].player;
+  }
+
+  // Sidebar history mirrors the applied prefix (move_count is capped at
+  // MAX_MOVE_HISTORY by load_game_json, same as move_history).
+  memcpy(game->move_history, replay->moves,
+         (size_t)pos * sizeof(move_history_t));
+  game->move_history_count = pos;
+
+  if (pos > 0) {
+    const move_history_t *last = &replay->moves[pos - 1];
+    game->current_player = last->player;
+    game->last_ai_move_x = last->x;
+    game->last_ai_move_y = last->y;
+    game->cursor_x = last->x;
+    game->cursor_y = last->y;
+    if (last->is_winner) {
+      game->game_state = (last->player == AI_CELL_CROSSES) ? GAME_HUMAN_WIN
+                                                           : GAME_AI_WIN;
+    } else {
+      game->game_state = GAME_RUNNING;
+    }
+  } else {
+    game->current_player = AI_CELL_CROSSES;
+    game->last_ai_move_x = -1;
+    game->last_ai_move_y = -1;
+    game->game_state = GAME_RUNNING;
+  }
+}
+
 /**
  * Runs replay mode - loads and displays a previously recorded game.
  * @param config The CLI configuration with replay_file and replay_wait
@@ -86,110 +240,124 @@ static int run_replay_mode(cli_config_t *config) {
   }
   game->replay_mode = 1; // Disable cursor in replay mode
 
-  clear_screen();
-
-  // Enable raw mode for keyboard input
-  enable_raw_mode();
-
-  // Show initial empty board
-  refresh_display(game);
-
-  // Display replay info
-  printf("\n  Replaying game from: %s\n", config->replay_file);
-  printf("  Total moves: %d | Winner: %s", replay.move_count, replay.winner);
-  if (replay.depth_x > 0 || replay.depth_o > 0) {
-    printf(" | Depth: X=%d O=%d",
-           replay.depth_x > 0 ? replay.depth_x : game_config.max_depth,
-           replay.depth_o > 0 ? replay.depth_o : game_config.max_depth);
-  }
-  if (replay.radius > 0) {
-    printf(" | Radius: %d", replay.radius);
-  }
-  printf("\n");
-  if (config->replay_wait > 0) {
-    printf("  Auto-advance: %.1fs delay\n", config->replay_wait);
-  } else {
-    printf("  Press any key for next move, 'q' to quit\n");
+  // Build the keyframe snapshots: keyframe k is the board after
+  // k * REPLAY_KEYFRAME_INTERVAL moves (keyframe 0 is empty).
+  int n = game->board_size;
+  size_t cells = (size_t)n * n;
+  int keyframe_count = replay.move_count / REPLAY_KEYFRAME_INTERVAL + 1;
+  cell_t *keyframes = calloc((size_t)keyframe_count * cells, sizeof(cell_t));
+  if (!keyframes) {
+    printf("Error: Failed to allocate replay keyframes\n");
+    cleanup_game(game);
+    return 1;
   }
-
-  // Wait for initial keypress or delay
-  if (config->replay_wait > 0) {
-    usleep((useconds_t)(config->replay_wait * 1000000));
-  } else {
-    int key = get_key();
-    if (key == 'q' || key == 'Q' || key == 27) { // q or ESC
+  {
+    cell_t *scratch = calloc(cells, sizeof(cell_t)); // AI_CELL_EMPTY = 0
+    if (!scratch) {
+      printf("Error: Failed to allocate replay keyframes\n");
+      free(keyframes);
       cleanup_game(game);
-      return 0;
+      return 1;
+    }
+    for (int i = 0; i < replay.move_count; i++) {
+      scratch[replay.moves[i].x * n + replay.moves[i].y] =
+          (cell_t)replay.moves[i].player;
+      if ((i + 1) % REPLAY_KEYFRAME_INTERVAL == 0) {
+        memcpy(keyframes + (size_t)((i + 1) / REPLAY_KEYFRAME_INTERVAL) * cells,
+               scratch, cells * sizeof(cell_t));
+      }
     }
+    free(scratch);
   }
 
-  // Replay each move
-  for (int i = 0; i < replay.move_count; i++) {
-    move_history_t *move = &replay.moves[i];
-
-    // Place the stone on the board
-    game->board[move->x][move->y] = move->player;
-    game->current_player = move->player;
-    game->last_ai_move_x = move->x;
-    game->last_ai_move_y = move->y;
-    game->cursor_x = move->x;
-    game->cursor_y = move->y;
-
-    // Add to move history for display
-    if (game->move_history_count < MAX_MOVE_HISTORY) {
-      game->move_history[game->move_history_count] = *move;
-      game->move_history_count++;
-    }
+  clear_screen();
 
-    // Check for winner
-    if (move->is_winner) {
-      if (move->player == AI_CELL_CROSSES) {
-        game->game_state = GAME_HUMAN_WIN;
-      } else {
-        game->game_state = GAME_AI_WIN;
-      }
-    }
+  // Enable raw mode for keyboard input
+  enable_raw_mode();
 
-    // Refresh display
+  // Scrub loop: every iteration reconstructs the position at `pos`
+  // applied moves (keyframe + bulk apply) and renders it exactly once,
+  // so jumping 10 or 180 moves costs the same as stepping 1.
+  int pos = (config->replay_wait > 0) ? 0 : replay.move_count ? 1 : 0;
+  int quit = 0;
+  while (!quit) {
+    replay_seek(game, &replay, keyframes, pos);
     refresh_display(game);
 
-    // Show move info
-    const char *player_str = (move->player == AI_CELL_CROSSES) ? "X" : "O";
-    printf("\n  Move %d/%d: %s at [%d, %d]", i + 1, replay.move_count,
-           player_str, move->x, move->y);
-    if (move->time_taken > 0) {
-      printf(" (%.3f ms)", move->time_taken * 1000.0);
+    printf("\n  Replay: %s | move %d/%d | Winner: %s\n", config->replay_file,
+           pos, replay.move_count, replay.winner);
+    if (pos > 0) {
+      const move_history_t *move = &replay.moves[pos - 1];
+      const char *player_str = (move->player == AI_CELL_CROSSES) ? "X" : "O";
+      char coord[8];
+      board_coord_to_notation(move->x, move->y, coord, sizeof(coord));
+      printf("  Last: %s at %s", player_str, coord);
+      if (move->time_taken > 0) {
+        printf(" (%.3f ms)", move->time_taken * 1000.0);
+      }
+      if (move->is_winner) {
+        printf(" ** WINNER **");
+      }
+      printf("\n");
     }
-    if (move->is_winner) {
-      printf(" ** WINNER **");
+    printf("  →/Enter next | ← prev | ↑/↓ ±10 | 0 start | G end | q quit\n");
+    fflush(stdout);
+
+    int key;
+    if (config->replay_wait > 0 && pos < replay.move_count) {
+      // Auto-advance: wait out the delay but let a key interrupt it.
+      key = get_key_timeout((int)(config->replay_wait * 1000));
+      if (key == -1) {
+        pos++;
+        continue;
+      }
+    } else {
+      key = get_key();
+      if (key == -1) { // stdin closed (scripted run reached the end)
+        break;
+      }
     }
-    printf("\n");
 
-    // Wait for next move
-    if (i < replay.move_count - 1) { // Don't wait after last move
-      if (config->replay_wait > 0) {
-        usleep((useconds_t)(config->replay_wait * 1000000));
-      } else {
-        int key = get_key();
-        if (key == 'q' || key == 'Q' || key == 27) { // q or ESC
-          break;
-        }
-      }
+    switch (key) {
+    case KEY_RIGHT:
+    case KEY_ENTER:
+    case KEY_SPACE:
+      if (pos < replay.move_count)
+        pos++;
+      break;
+    case KEY_LEFT:
+      if (pos > 0)
+        pos--;
+      break;
+    case KEY_UP:
+      pos = (pos + 10 < replay.move_count) ? pos + 10 : replay.move_count;
+      break;
+    case KEY_DOWN:
+      pos = (pos > 10) ? pos - 10 : 0;
+      break;
+    case '0':
+      pos = 0;
+      break;
+    case 'G':
+    case 'g':
+      pos = replay.move_count;
+      break;
+    case KEY_ESC:
+    case 'q':
+    case 'Q':
+      quit = 1;
+      break;
+    default:
+      break;
     }
   }
 
-  // Final message
-  printf("\n  Replay complete. Press any key to exit.\n");
-  get_key();
-
+  free(keyframes);
   cleanup_game(game);
   return 0;
 }
 
 int main(int argc, char *argv[]) {
-  // Initialize random seed for first move randomization
-  srand(time(NULL));
-
   // Parse command line arguments
   cli_config_t config = parse_arguments(argc, argv);
 
@@ -204,6 +372,30 @@ int main(int argc, char *argv[]) {
     return 1;
   }
 
+  // Optional learned evaluator: load the weights before any game is
+  // created so init_game picks the model up.
+  static nnue_model_t nnue_model;
+  if (strlen(config.nnue_file) > 0) {
+    if (!nnue_load(&nnue_model, config.nnue_file)) {
+      printf("Error: Failed to load NNUE weights from '%s'\n",
+             config.nnue_file);
+      return 1;
+    }
+    nnue_set_default(&nnue_model);
+  }
+
+  // Optional opening book: mapped once up front, consulted by
+  // find_best_ai_move for every early-ply decision.
+  static book_t opening_book;
+  if (strlen(config.book_file) > 0) {
+    if (!book_open(&opening_book, config.book_file)) {
+      printf("Error: Failed to load opening book from '%s'\n",
+             config.book_file);
+      return 1;
+    }
+    book_set_default(&opening_book);
+  }
+
   // Check for replay mode
   if (strlen(config.replay_file) > 0) {
     return run_replay_mode(&config);
@@ -217,11 +409,28 @@ int main(int argc, char *argv[]) {
     }
   }
 
-  // Initialize game state
-  game_state_t *game = init_game(config);
-  if (!game) {
-    printf("Error: Failed to initialize game\n");
-    return 1;
+  // Initialize game state: either resume from a binary snapshot (board,
+  // history, clocks and warmed search tables come back as written) or
+  // start fresh.
+  game_state_t *game;
+  if (strlen(config.resume_file) > 0) {
+    game = snapshot_load(config.resume_file);
+    if (!game) {
+      printf("Error: Failed to resume from snapshot '%s'\n",
+             config.resume_file);
+      return 1;
+    }
+    // Keep the session-level flags from THIS invocation (output paths,
+    // headless, hints); the game itself keeps the snapshot's settings.
+    memcpy(game->config.json_file, config.json_file,
+           sizeof(game->config.json_file));
+    game->config.headless = config.headless;
+  } else {
+    game = init_game(config);
+    if (!game) {
+      printf("Error: Failed to initialize game\n");
+      return 1;
+    }
   }
 
   // Initialize threat matrix for evaluation functions
@@ -273,7 +482,13 @@ int main(int argc, char *argv[]) {
       int saved_depth = game->max_depth;
       game->max_depth = get_player_depth(game, game->current_player);
 
-      find_best_ai_move(game, &ai_x, &ai_y, NULL);
+      if (config.headless) {
+        find_best_ai_move(game, &ai_x, &ai_y, NULL);
+      } else {
+        // Interactive: search on a worker thread so the UI stays live
+        // (progress line, move-now key) instead of freezing at depth 7+.
+        run_ai_move_background(game, &ai_x, &ai_y);
+      }
 
       game->max_depth = saved_depth; // Restore
 
@@ -321,6 +536,18 @@ int main(int argc, char *argv[]) {
     get_key(); // Wait for any key press
   }
 
+  // Write a binary snapshot if requested (resumable with --resume)
+  if (strlen(config.snapshot_file) > 0) {
+    if (snapshot_save(game, config.snapshot_file)) {
+      if (!config.headless) {
+        printf("Snapshot saved to %s\n", config.snapshot_file);
+      }
+    } else {
+      fprintf(stderr, "Error: Failed to write snapshot to %s\n",
+              config.snapshot_file);
+    }
+  }
+
   // Write JSON output if requested
   if (strlen(config.json_file) > 0) {
     if (write_game_json(game, config.json_file)) {
@@ -0,0 +1,310 @@
+//
+//  mcts.c
+//  gomoku - Monte-Carlo Tree Search engine backend
+//
+//  UCT over a flat node arena. The tree reuses the minimax module's
+//  candidate generator and fast threat evaluator, so both backends agree
+//  on which moves are worth considering; they differ only in how deeply
+//  and selectively those moves are explored.
+//
+
+#include "mcts.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ai.h"
+#include "eval_lines.h"
+#include "nnue.h"
+
+// Node arena size. 2^18 nodes at ~32 bytes each is ~8 MB, allocated per
+// search and freed on return. When the arena fills, leaves simply stop
+// expanding and keep being rolled out — the search degrades, not crashes.
+#define MCTS_MAX_NODES (1 << 18)
+
+// Children kept per expansion. generate_moves_optimized can return dozens
+// of candidates; beyond the top candidates the priors are so small that
+// UCT would visit them a handful of times at most, so capping keeps the
+// arena dense with nodes that matter.
+#define MCTS_MAX_CHILDREN 32
+
+// PUCT exploration constant. Higher values spread visits across siblings;
+// this is tuned toward exploitation because the priors are already sharp.
+#define MCTS_UCT_C 1.4
+
+// Rollout horizon in plies. Long enough for a threat sequence to resolve,
+// short enough that one simulation stays cheap.
+#define MCTS_ROLLOUT_PLIES 12
+
+// Simulation cap when no per-move timeout is configured.
+#define MCTS_DEFAULT_SIMULATIONS 50000
+
+// Squash scale for converting line-eval differences into (-1, 1) values.
+// A four-level threat (LINE_EVAL_FOUR_THREAT = 8000) maps to ~0.58.
+#define MCTS_EVAL_SCALE 12000.0
+
+typedef struct {
+  int16_t x, y;          // The move that led into this node
+  int16_t num_children;  // 0 until expanded
+  int32_t first_child;   // Arena index of first child, -1 until expanded
+  int32_t visits;
+  float value_sum;       // Accumulated results, from this node's
+                         // player's perspective
+  float prior;           // Normalized policy prior from the parent's
+                         // expansion
+  int8_t player;         // Player who made (x, y)
+  int8_t terminal;       // 1 when (x, y) completed exactly five
+} mcts_node_t;
+
+typedef struct {
+  mcts_node_t *nodes;
+  int count;
+} mcts_arena_t;
+
+/**
+ * Expand a node: generate candidates for the side to move, keep the best
+ * MCTS_MAX_CHILDREN, and assign each a prior from evaluate_threat_fast
+ * for both placement and denial (a cell that completes our four or
+ * breaks theirs is prior-heavy either way).
+ *
+ * Returns the number of children created (0 on a full board or a full
+ * arena — the caller treats both as "keep this node a leaf").
+ */
+static int mcts_expand(game_state_t *game, mcts_arena_t *arena,
+                       mcts_node_t *node, int side_to_move) {
+  if (arena->count + MCTS_MAX_CHILDREN > MCTS_MAX_NODES) {
+    return 0;
+  }
+
+  move_t moves[361];
+  int move_count =
+      generate_moves_optimized(game, game->board, moves, side_to_move, 3);
+  if (move_count == 0) {
+    return 0;
+  }
+
+  qsort(moves, move_count, sizeof(move_t), compare_moves);
+  int n = min(move_count, MCTS_MAX_CHILDREN);
+
+  double priors[MCTS_MAX_CHILDREN];
+  double prior_sum = 0.0;
+  int opponent = other_player(side_to_move);
+  for (int i = 0; i < n; i++) {
+    int attack = evaluate_threat_fast(game->board, moves[i].x, moves[i].y,
+                                      side_to_move, GAME_BOARD_SIZE(game));
+    int defense = evaluate_threat_fast(game->board, moves[i].x, moves[i].y,
+                                       opponent, GAME_BOARD_SIZE(game));
+    priors[i] = 1.0 + attack + defense / 2.0;
+    prior_sum += priors[i];
+  }
+
+  node->first_child = arena->count;
+  node->num_children = (int16_t)n;
+  for (int i = 0; i < n; i++) {
+    mcts_node_t *child = &arena->nodes[arena->count++];
+    child->x = (int16_t)moves[i].x;
+    child->y = (int16_t)moves[i].y;
+    child->num_children = 0;
+    child->first_child = -1;
+    child->visits = 0;
+    child->value_sum = 0.0f;
+    child->prior = (float)(priors[i] / prior_sum);
+    child->player = (int8_t)side_to_move;
+    child->terminal = (int8_t)is_winning_move(game->board, moves[i].x,
+                                              moves[i].y, side_to_move,
+                                              GAME_BOARD_SIZE(game));
+  }
+  return n;
+}
+
+/**
+ * Threat-guided rollout from the current position with `side_to_move` to
+ * play. Plays up to MCTS_ROLLOUT_PLIES moves, mostly greedily by
+ * evaluate_threat_fast with occasional random picks among the top
+ * candidates, and scores the resulting position with the incremental
+ * line evaluator. Restores the board before returning.
+ *
+ * @return Value in [-1, 1] from `perspective`'s point of view
+ */
+static double mcts_rollout(game_state_t *game, int side_to_move,
+                           int perspective) {
+  int made_x[MCTS_ROLLOUT_PLIES], made_y[MCTS_ROLLOUT_PLIES];
+  int made_p[MCTS_ROLLOUT_PLIES];
+  int made = 0;
+  int player = side_to_move;
+  double result = 0.0;
+  int decided = 0;
+
+  while (made < MCTS_ROLLOUT_PLIES) {
+    move_t moves[361];
+    int move_count =
+        generate_moves_optimized(game, game->board, moves, player, 1);
+    if (move_count == 0) {
+      break; // Board effectively full: fall through to static eval (draw-ish)
+    }
+    qsort(moves, move_count, sizeof(move_t), compare_moves);
+
+    // Greedy on the generator's priority (threat-dominated), with a 1-in-4
+    // random pick among the top few so repeated rollouts don't all walk
+    // the same line.
+    int pick = 0;
+    int top = min(move_count, 6);
+    if (top > 1 && (game_rand(game) & 3) == 0) {
+      pick = (int)(game_rand(game) % (uint32_t)top);
+    }
+    int x = moves[pick].x;
+    int y = moves[pick].y;
+
+    if (is_winning_move(game->board, x, y, player, GAME_BOARD_SIZE(game))) {
+      result = (player == perspective) ? 1.0 : -1.0;
+      decided = 1;
+      break;
+    }
+
+    search_make_move(game, game->board, x, y, player);
+    made_x[made] = x;
+    made_y[made] = y;
+    made_p[made] = player;
+    made++;
+    player = other_player(player);
+  }
+
+  if (!decided) {
+    int eval = game->nnue_model
+                   ? nnue_evaluate(game, perspective)
+                   : line_eval_score(&game->line_eval, perspective);
+    result = tanh((double)eval / MCTS_EVAL_SCALE);
+  }
+
+  while (made > 0) {
+    made--;
+    search_unmake_move(game, game->board, made_x[made], made_y[made],
+                       made_p[made]);
+  }
+  return result;
+}
+
+/**
+ * PUCT child selection: argmax over Q + C * prior * sqrt(N_parent) /
+ * (1 + N_child). Unvisited children inherit Q = 0 (the parent's
+ * perspective is neutral about them until the prior pulls one in).
+ */
+static int mcts_select_child(const mcts_arena_t *arena,
+                             const mcts_node_t *node) {
+  double sqrt_parent = sqrt((double)max(node->visits, 1));
+  int best = node->first_child;
+  double best_score = -1e30;
+  for (int i = 0; i < node->num_children; i++) {
+    const mcts_node_t *child = &arena->nodes[node->first_child + i];
+    double q = (child->visits > 0)
+                   ? (double)child->value_sum / (double)child->visits
+                   : 0.0;
+    double u = MCTS_UCT_C * child->prior * sqrt_parent /
+               (1.0 + (double)child->visits);
+    if (q + u > best_score) {
+      best_score = q + u;
+      best = node->first_child + i;
+    }
+  }
+  return best;
+}
+
+int mcts_search(game_state_t *game, int ai_player, int *best_x, int *best_y,
+                int *best_value) {
+  mcts_arena_t arena;
+  arena.nodes = malloc((size_t)MCTS_MAX_NODES * sizeof(mcts_node_t));
+  if (!arena.nodes) {
+    return 0; // Caller keeps its pre-seeded fallback move
+  }
+  arena.count = 0;
+
+  // Root: a pseudo-node for "the opponent just moved"; its children are
+  // the AI's candidate replies.
+  mcts_node_t *root = &arena.nodes[arena.count++];
+  root->x = -1;
+  root->y = -1;
+  root->num_children = 0;
+  root->first_child = -1;
+  root->visits = 0;
+  root->value_sum = 0.0f;
+  root->prior = 1.0f;
+  root->player = (int8_t)other_player(ai_player);
+  root->terminal = 0;
+
+  if (mcts_expand(game, &arena, root, ai_player) == 0) {
+    free(arena.nodes);
+    return 0;
+  }
+
+  int sim_cap = (game->move_timeout > 0) ? INT32_MAX
+                                         : MCTS_DEFAULT_SIMULATIONS;
+  int path[MCTS_ROLLOUT_PLIES + 361];
+  int sims = 0;
+
+  while (sims < sim_cap && !is_search_timed_out(game)) {
+    // --- Selection: descend by PUCT, making moves as we go ---
+    int depth = 0;
+    int node_idx = 0;
+    int side = ai_player;
+    path[depth++] = node_idx;
+
+    while (arena.nodes[node_idx].num_children > 0) {
+      node_idx = mcts_select_child(&arena, &arena.nodes[node_idx]);
+      mcts_node_t *node = &arena.nodes[node_idx];
+      search_make_move(game, game->board, node->x, node->y, node->player);
+      path[depth++] = node_idx;
+      side = other_player(node->player);
+      if (node->terminal) {
+        break;
+      }
+    }
+
+    mcts_node_t *leaf = &arena.nodes[node_idx];
+    double value; // From the perspective of leaf->player
+
+    if (leaf->terminal) {
+      value = 1.0;
+    } else {
+      // --- Expansion: grow the leaf once it has been visited before ---
+      if (leaf->visits > 0 && depth > 1) {
+        mcts_expand(game, &arena, leaf, side);
+      }
+      // --- Simulation ---
+      value = -mcts_rollout(game, side, side);
+    }
+
+    // --- Backpropagation: unwind moves, flipping perspective per ply ---
+    for (int d = depth - 1; d >= 1; d--) {
+      mcts_node_t *node = &arena.nodes[path[d]];
+      node->visits++;
+      node->value_sum += (float)value;
+      search_unmake_move(game, game->board, node->x, node->y, node->player);
+      value = -value;
+    }
+    root->visits++;
+    sims++;
+  }
+
+  // Final pick: most-visited root child (robust against a late Q spike
+  // from a barely-visited sibling).
+  int best_idx = root->first_child;
+  for (int i = 0; i < root->num_children; i++) {
+    const mcts_node_t *child = &arena.nodes[root->first_child + i];
+    if (child->visits > arena.nodes[best_idx].visits) {
+      best_idx = root->first_child + i;
+    }
+  }
+  const mcts_node_t *chosen = &arena.nodes[best_idx];
+  *best_x = chosen->x;
+  *best_y = chosen->y;
+  if (best_value) {
+    double q = (chosen->visits > 0)
+                   ? (double)chosen->value_sum / (double)chosen->visits
+                   : 0.0;
+    *best_value = (int)(q * MCTS_EVAL_SCALE);
+  }
+
+  free(arena.nodes);
+  return sims;
+}
@@ -0,0 +1,44 @@
+//
+//  mcts.h
+//  gomoku - Monte-Carlo Tree Search engine backend
+//
+//  Alternative search backend selectable with --engine=mcts. Shares the
+//  tactical pre-search steps in find_best_ai_move() with minimax; only the
+//  deep search is replaced. MCTS scales near-linearly with the per-move
+//  time budget, which suits timeout-driven play better than fixed-depth
+//  iterative deepening in quiet, balanced middlegames.
+//
+
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "game.h"
+
+/**
+ * Run a UCT search from the current position and return the most-visited
+ * root move.
+ *
+ * Candidate generation and move priors reuse the minimax machinery:
+ * children come from generate_moves_optimized() and each child's prior is
+ * derived from evaluate_threat_fast(), so the tree is biased toward the
+ * same forcing moves minimax would order first. Playouts are short
+ * threat-guided rollouts scored with the incremental line evaluator
+ * rather than full random games.
+ *
+ * The search runs until game->move_timeout expires (via
+ * is_search_timed_out) or a fixed simulation cap when no timeout is set.
+ *
+ * @param game Current game state (board, caches, and clock already set up
+ *             by find_best_ai_move)
+ * @param ai_player The player to move (AI_CELL_CROSSES or AI_CELL_NAUGHTS)
+ * @param best_x Output: row of the selected move
+ * @param best_y Output: column of the selected move
+ * @param best_value Output: root value of the selected move scaled to the
+ *                   static-eval range (comparable to minimax scores only
+ *                   in sign and rough magnitude)
+ * @return Number of simulations completed
+ */
+int mcts_search(game_state_t *game, int ai_player, int *best_x, int *best_y,
+                int *best_value);
+
+#endif // MCTS_H
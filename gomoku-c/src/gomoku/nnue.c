@@ -0,0 +1,270 @@
+//
+//  nnue.c
+//  gomoku - optional NNUE-style incrementally-updated learned evaluator
+//
+//  Loader and inference only; training is offline. See nnue.h for the
+//  weights file layout. The accumulator math keeps both perspectives
+//  up to date so evaluation from either side is a single output-layer
+//  pass, exactly like the classical line_eval totals.
+//
+
+#include "nnue.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+// No mmap on the MinGW brain build: read the file into a malloc'd
+// buffer instead. The model interface is identical either way.
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define NNUE_MAGIC 0x4E4B4D47u // 'GMKN'
+#define NNUE_VERSION 1u
+
+// Clipped-ReLU ceiling for the hidden activations. Matches the range an
+// int8 output weight can be trained against without overflow: 127 * 127
+// * 128 hidden units fits comfortably in int32.
+#define NNUE_CLIP 127
+
+static const nnue_model_t *default_model = NULL;
+
+void nnue_set_default(const nnue_model_t *model) { default_model = model; }
+
+const nnue_model_t *nnue_default(void) { return default_model; }
+
+int nnue_load(nnue_model_t *model, const char *path) {
+  memset(model, 0, sizeof(*model));
+
+  uint8_t *base = NULL;
+  size_t size = 0;
+
+#ifdef _WIN32
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    return 0;
+  }
+  fseek(f, 0, SEEK_END);
+  long fsize = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if (fsize <= 0) {
+    fclose(f);
+    return 0;
+  }
+  base = malloc((size_t)fsize);
+  if (!base || fread(base, 1, (size_t)fsize, f) != (size_t)fsize) {
+    free(base);
+    fclose(f);
+    return 0;
+  }
+  fclose(f);
+  size = (size_t)fsize;
+#else
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return 0;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return 0;
+  }
+  size = (size_t)st.st_size;
+  base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    return 0;
+  }
+#endif
+
+  // Header: magic, version, hidden, cells.
+  if (size < 16) {
+    goto fail;
+  }
+  uint32_t header[4];
+  memcpy(header, base, sizeof(header));
+  if (header[0] != NNUE_MAGIC || header[1] != NNUE_VERSION) {
+    goto fail;
+  }
+  int hidden = (int)header[2];
+  int cells = (int)header[3];
+  if (hidden <= 0 || hidden > NNUE_MAX_HIDDEN || cells <= 0 || cells > 361) {
+    goto fail;
+  }
+
+  size_t need = 16;
+  size_t bias_off = need;
+  need += (size_t)hidden * sizeof(int16_t);
+  size_t weights_off = need;
+  need += (size_t)2 * cells * hidden * sizeof(int16_t);
+  size_t out_off = need;
+  need += (size_t)hidden * sizeof(int8_t);
+  size_t tail_off = need;
+  need += 2 * sizeof(int32_t);
+  if (size < need) {
+    goto fail;
+  }
+
+  model->hidden = hidden;
+  model->cells = cells;
+  model->input_bias = (const int16_t *)(base + bias_off);
+  model->input_weights = (const int16_t *)(base + weights_off);
+  model->output_weights = (const int8_t *)(base + out_off);
+  memcpy(&model->output_bias, base + tail_off, sizeof(int32_t));
+  memcpy(&model->output_scale, base + tail_off + sizeof(int32_t),
+         sizeof(int32_t));
+  if (model->output_scale == 0) {
+    model->output_scale = 1;
+  }
+  model->mapping = base;
+  model->mapping_size = size;
+  return 1;
+
+fail:
+#ifdef _WIN32
+  free(base);
+#else
+  munmap(base, size);
+#endif
+  return 0;
+}
+
+void nnue_unload(nnue_model_t *model) {
+  if (!model->mapping) {
+    return;
+  }
+#ifdef _WIN32
+  free(model->mapping);
+#else
+  munmap(model->mapping, model->mapping_size);
+#endif
+  memset(model, 0, sizeof(*model));
+}
+
+/**
+ * Weight row for feature (plane, cell) as seen from `perspective` (0 =
+ * crosses, 1 = naughts). The opponent's perspective sees the planes
+ * swapped, which is what lets one set of weights serve both sides.
+ */
+static inline const int16_t *feature_row(const nnue_model_t *m, int plane,
+                                         int cell, int perspective) {
+  int p = plane ^ perspective;
+  return m->input_weights + ((size_t)p * m->cells + cell) * m->hidden;
+}
+
+static inline void acc_add(int32_t *acc, const int16_t *row, int hidden) {
+  for (int h = 0; h < hidden; h++) {
+    acc[h] += row[h];
+  }
+}
+
+static inline void acc_sub(int32_t *acc, const int16_t *row, int hidden) {
+  for (int h = 0; h < hidden; h++) {
+    acc[h] -= row[h];
+  }
+}
+
+void nnue_refresh(game_state_t *game, cell_t **board) {
+  const nnue_model_t *m = game->nnue_model;
+  if (!m) {
+    return;
+  }
+  for (int side = 0; side < 2; side++) {
+    for (int h = 0; h < m->hidden; h++) {
+      game->nnue_acc[side][h] = m->input_bias[h];
+    }
+  }
+  int size = game->board_size;
+  for (int x = 0; x < size; x++) {
+    for (int y = 0; y < size; y++) {
+      int cell_value = board[x][y];
+      if (cell_value == AI_CELL_EMPTY) {
+        continue;
+      }
+      int plane = (cell_value == AI_CELL_CROSSES) ? 0 : 1;
+      int cell = x * size + y;
+      if (cell >= m->cells) {
+        continue; // Weights trained on a smaller grid: ignore the rest
+      }
+      acc_add(game->nnue_acc[0], feature_row(m, plane, cell, 0), m->hidden);
+      acc_add(game->nnue_acc[1], feature_row(m, plane, cell, 1), m->hidden);
+    }
+  }
+  game->nnue_acc_valid = 1;
+}
+
+void nnue_make(game_state_t *game, int x, int y, int player) {
+  const nnue_model_t *m = game->nnue_model;
+  if (!m || !game->nnue_acc_valid) {
+    return;
+  }
+  int plane = (player == AI_CELL_CROSSES) ? 0 : 1;
+  int cell = x * game->board_size + y;
+  if (cell >= m->cells) {
+    return;
+  }
+  acc_add(game->nnue_acc[0], feature_row(m, plane, cell, 0), m->hidden);
+  acc_add(game->nnue_acc[1], feature_row(m, plane, cell, 1), m->hidden);
+}
+
+void nnue_unmake(game_state_t *game, int x, int y, int player) {
+  const nnue_model_t *m = game->nnue_model;
+  if (!m || !game->nnue_acc_valid) {
+    return;
+  }
+  int plane = (player == AI_CELL_CROSSES) ? 0 : 1;
+  int cell = x * game->board_size + y;
+  if (cell >= m->cells) {
+    return;
+  }
+  acc_sub(game->nnue_acc[0], feature_row(m, plane, cell, 0), m->hidden);
+  acc_sub(game->nnue_acc[1], feature_row(m, plane, cell, 1), m->hidden);
+}
+
+int nnue_evaluate(const game_state_t *game, int player) {
+  const nnue_model_t *m = game->nnue_model;
+  int side = (player == AI_CELL_CROSSES) ? 0 : 1;
+  const int32_t *acc = game->nnue_acc[side];
+  int hidden = m->hidden;
+
+  // Clipped ReLU into an int16 scratch row, then the int8 output dot.
+  int16_t clipped[NNUE_MAX_HIDDEN];
+  for (int h = 0; h < hidden; h++) {
+    int32_t v = acc[h];
+    clipped[h] = (int16_t)(v < 0 ? 0 : (v > NNUE_CLIP ? NNUE_CLIP : v));
+  }
+
+  int32_t sum = m->output_bias;
+#if defined(__SSE2__)
+  __m128i vsum = _mm_setzero_si128();
+  int h = 0;
+  for (; h + 8 <= hidden; h += 8) {
+    __m128i a = _mm_loadu_si128((const __m128i *)&clipped[h]);
+    // Sign-extend 8 int8 output weights to int16.
+    __m128i wb = _mm_loadl_epi64((const __m128i *)&m->output_weights[h]);
+    __m128i w = _mm_srai_epi16(_mm_unpacklo_epi8(wb, wb), 8);
+    vsum = _mm_add_epi32(vsum, _mm_madd_epi16(a, w));
+  }
+  int32_t lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, vsum);
+  sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  for (; h < hidden; h++) {
+    sum += clipped[h] * m->output_weights[h];
+  }
+#else
+  for (int h = 0; h < hidden; h++) {
+    sum += clipped[h] * m->output_weights[h];
+  }
+#endif
+
+  return sum / m->output_scale;
+}
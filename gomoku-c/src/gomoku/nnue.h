@@ -0,0 +1,83 @@
+//
+//  nnue.h
+//  gomoku - optional NNUE-style incrementally-updated learned evaluator
+//
+//  Second evaluation backend behind the leaf eval in ai.c/mcts.c,
+//  selected per process by loading a weights file (--nnue FILE). The
+//  network is deliberately tiny: two 361-cell occupancy planes (own
+//  stones, opponent stones) feed a single hidden layer of clipped-ReLU
+//  units whose accumulator is updated on make/unmake instead of being
+//  recomputed, followed by an int8 output dot product. Training happens
+//  offline; the engine only mmaps the quantized weights and runs
+//  inference.
+//
+//  Weights file layout (little-endian, no padding):
+//      uint32  magic      'GMKN' (0x4E4B4D47)
+//      uint32  version    1
+//      uint32  hidden     hidden units H (<= NNUE_MAX_HIDDEN)
+//      uint32  cells      board cells covered (361 for 19x19; smaller
+//                         boards use the top-left sub-grid)
+//      int16   input_bias[H]
+//      int16   input_weights[2 * cells][H]   (plane-major: own plane
+//                                             rows first, then opponent)
+//      int8    output_weights[H]
+//      int32   output_bias
+//      int32   output_scale   divisor mapping the raw dot product into
+//                             the same range as line_eval_score()
+//
+
+#ifndef NNUE_H
+#define NNUE_H
+
+#include "game.h"
+
+typedef struct nnue_model {
+  int hidden;                  // H
+  int cells;                   // Covered cells (board_size^2 at most)
+  const int16_t *input_bias;   // [H]
+  const int16_t *input_weights; // [2 * cells][H], row-major
+  const int8_t *output_weights; // [H]
+  int32_t output_bias;
+  int32_t output_scale;
+  void *mapping;               // mmap base (or malloc'd buffer on Windows)
+  size_t mapping_size;
+} nnue_model_t;
+
+/**
+ * Maps a weights file and validates its header. Returns 1 on success.
+ * The model references the mapping directly; call nnue_unload to release
+ * it. Safe to share across threads and games (read-only after load).
+ */
+int nnue_load(nnue_model_t *model, const char *path);
+
+void nnue_unload(nnue_model_t *model);
+
+/**
+ * Process-wide default model used by init_game to wire new games. NULL
+ * (the initial state) leaves the classical evaluator active.
+ */
+void nnue_set_default(const nnue_model_t *model);
+const nnue_model_t *nnue_default(void);
+
+/**
+ * Rebuilds both perspective accumulators from the current board. Called
+ * on init/undo and any other non-incremental board change.
+ */
+void nnue_refresh(game_state_t *game, cell_t **board);
+
+/**
+ * Incremental accumulator update for a stone placed/removed at (x, y).
+ * Mirrors the zobrist update pattern in search_make/unmake_move: the two
+ * calls must be symmetric or the accumulator drifts.
+ */
+void nnue_make(game_state_t *game, int x, int y, int player);
+void nnue_unmake(game_state_t *game, int x, int y, int player);
+
+/**
+ * Runs the output layer on `player`'s accumulator. Comparable in sign
+ * and rough magnitude to line_eval_score() (the weights file's
+ * output_scale is responsible for the calibration).
+ */
+int nnue_evaluate(const game_state_t *game, int player);
+
+#endif // NNUE_H
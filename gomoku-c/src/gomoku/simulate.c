@@ -0,0 +1,225 @@
+//
+//  simulate.c
+//  gomoku - in-process multi-game simulation for tuning pipelines
+//
+//  Worker-pool structure mirrors src/tools/selfplay.c: a mutex-guarded
+//  next-game counter hands indices to workers, each worker owns one
+//  game state for its whole lifetime and reinit_game()s it per game.
+//  Unlike selfplay there is no tally or SPRT - results go straight into
+//  the caller's packed record array, one slot per game index, so no
+//  ordering or aggregation happens in here.
+//
+
+#include "simulate.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ai.h"
+#include "board.h"
+#include "game.h"
+#include "gomoku.h"
+
+// Work distribution state shared by the pool (read-mostly; only
+// next_game mutates, under lock).
+typedef struct {
+  pthread_mutex_t lock;
+  const sim_config_t *config;
+  const sim_opening_t *openings;
+  int opening_count;
+  sim_result_t *results;
+  int game_count;
+  int next_game;
+  int played; // Games actually completed (== claimed, barring OOM)
+} sim_pool_t;
+
+static void sim_base_config(cli_config_t *cfg, const sim_config_t *config) {
+  memset(cfg, 0, sizeof(*cfg));
+  cfg->board_size = config->board_size;
+  cfg->max_depth = config->depth;
+  cfg->skip_welcome = 1;
+  cfg->headless = 1;
+  cfg->search_radius = config->search_radius;
+  cfg->leaf_radius = config->leaf_radius;
+  cfg->move_timeout = config->move_timeout;
+  cfg->player_x_type = PLAYER_TYPE_AI;
+  cfg->player_o_type = PLAYER_TYPE_AI;
+  cfg->depth_x = -1;
+  cfg->depth_o = -1;
+}
+
+static void sim_play_game(game_state_t *game, sim_pool_t *pool, int index) {
+  const sim_config_t *config = pool->config;
+  sim_result_t *result = &pool->results[index];
+  memset(result, 0, sizeof(*result));
+  result->opening_index = -1;
+
+  cli_config_t cfg;
+  sim_base_config(&cfg, config);
+  // Per-game tie-break stream derived from the batch seed, in the same
+  // shape selfplay derives per-game seeds: reproducible no matter which
+  // worker claims the game or in what order.
+  cfg.rng_seed = config->rng_seed ^ ((uint64_t)(index + 1) << 8);
+  reinit_game(game, cfg);
+
+  if (pool->opening_count > 0) {
+    const sim_opening_t *opening = &pool->openings[index % pool->opening_count];
+    result->opening_index = index % pool->opening_count;
+    int player = AI_CELL_CROSSES;
+    for (int i = 0; i < opening->count; i++) {
+      make_move(game, opening->moves[i][0], opening->moves[i][1], player, 0.0,
+                0, 0, 0);
+      player = other_player(player);
+    }
+  }
+
+  int max_plies = (config->max_plies > 0 && config->max_plies < MAX_MOVE_HISTORY)
+                      ? config->max_plies
+                      : MAX_MOVE_HISTORY;
+  uint64_t nodes_before = game->search_nodes;
+  double start = get_current_time();
+
+  while (game->game_state == GAME_RUNNING &&
+         game->move_history_count < max_plies) {
+    int side = game->current_player;
+    int x = -1, y = -1;
+    double move_start = get_current_time();
+    find_best_ai_move(game, &x, &y, NULL);
+    if (x < 0 ||
+        !make_move(game, x, y, side, get_current_time() - move_start, 0, 0, 0)) {
+      break; // Full board race; the record stays a draw
+    }
+  }
+
+  result->seconds = (float)(get_current_time() - start);
+  result->nodes = game->search_nodes - nodes_before;
+  result->plies = (int16_t)game->move_history_count;
+  if (game->game_state == GAME_HUMAN_WIN) { // X won
+    result->winner = SIM_WINNER_X;
+  } else if (game->game_state == GAME_AI_WIN) { // O won
+    result->winner = SIM_WINNER_O;
+  } else {
+    result->winner = SIM_WINNER_DRAW;
+  }
+}
+
+static void *sim_worker(void *arg) {
+  sim_pool_t *pool = arg;
+
+  cli_config_t cfg;
+  sim_base_config(&cfg, pool->config);
+  game_state_t *game = init_game(cfg);
+  if (!game) {
+    return NULL;
+  }
+
+  for (;;) {
+    pthread_mutex_lock(&pool->lock);
+    int index = pool->next_game++;
+    pthread_mutex_unlock(&pool->lock);
+    if (index >= pool->game_count) {
+      break;
+    }
+
+    sim_play_game(game, pool, index);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->played++;
+    pthread_mutex_unlock(&pool->lock);
+  }
+
+  cleanup_game(game);
+  return NULL;
+}
+
+/**
+ * Reject any opening with a stone off the board or stacked on an
+ * earlier one before a single worker starts, so a bad opening fails the
+ * batch loudly instead of skewing its results.
+ */
+static int sim_openings_valid(const sim_config_t *config,
+                              const sim_opening_t *openings,
+                              int opening_count) {
+  for (int o = 0; o < opening_count; o++) {
+    const sim_opening_t *opening = &openings[o];
+    if (opening->count < 0 || (opening->count > 0 && !opening->moves)) {
+      return 0;
+    }
+    for (int i = 0; i < opening->count; i++) {
+      int x = opening->moves[i][0];
+      int y = opening->moves[i][1];
+      if (x < 0 || x >= config->board_size || y < 0 ||
+          y >= config->board_size) {
+        return 0;
+      }
+      for (int j = 0; j < i; j++) {
+        if (opening->moves[j][0] == x && opening->moves[j][1] == y) {
+          return 0;
+        }
+      }
+    }
+  }
+  return 1;
+}
+
+int simulate_games(const sim_config_t *config, const sim_opening_t *openings,
+                   int opening_count, sim_result_t *results, int game_count) {
+  if (!config || !results || game_count < 1 || config->board_size < 5 ||
+      config->board_size > 19 || config->depth < 1 || opening_count < 0 ||
+      (opening_count > 0 && !openings)) {
+    return -1;
+  }
+  if (!sim_openings_valid(config, openings, opening_count)) {
+    return -1;
+  }
+
+  // Idempotent; embedding callers shouldn't have to know about the
+  // threat matrix the way the binaries' main() functions do.
+  populate_threat_matrix();
+
+  int threads = config->threads;
+  if (threads < 1) {
+    threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  }
+  if (threads < 1) {
+    threads = 1;
+  }
+  if (threads > game_count) {
+    threads = game_count;
+  }
+
+  sim_pool_t pool;
+  memset(&pool, 0, sizeof(pool));
+  pthread_mutex_init(&pool.lock, NULL);
+  pool.config = config;
+  pool.openings = openings;
+  pool.opening_count = opening_count;
+  pool.results = results;
+  pool.game_count = game_count;
+
+  pthread_t *workers = calloc((size_t)threads, sizeof(pthread_t));
+  if (!workers) {
+    pthread_mutex_destroy(&pool.lock);
+    return -1;
+  }
+  int started = 0;
+  for (int t = 0; t < threads; t++) {
+    if (pthread_create(&workers[t], NULL, sim_worker, &pool) != 0) {
+      break;
+    }
+    started++;
+  }
+  if (started == 0) {
+    free(workers);
+    pthread_mutex_destroy(&pool.lock);
+    return -1;
+  }
+  for (int t = 0; t < started; t++) {
+    pthread_join(workers[t], NULL);
+  }
+  free(workers);
+  pthread_mutex_destroy(&pool.lock);
+  return pool.played;
+}
@@ -0,0 +1,91 @@
+//
+//  simulate.h
+//  gomoku - in-process multi-game simulation for tuning pipelines
+//
+//  Runs K self-play games from caller-supplied openings across a
+//  worker thread pool inside one process and returns packed per-game
+//  result records. Spawning the TUI binary per game costs ~50ms of
+//  fork/exec/init before the first search node; for the thousands of
+//  short games a tuning run needs, that overhead dominates. Here each
+//  worker allocates one game state and reinit_game()s it per game, so
+//  the marginal cost of a game is the search itself.
+//
+//  The module is part of the engine core (linked into every DAEMON_CORE
+//  consumer and exported via `make libgomoku`), so external pipelines
+//  can embed it the same way selfplay and the daemon embed the search.
+//
+
+#ifndef SIMULATE_H
+#define SIMULATE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Engine settings shared by every game of a simulation batch. Both
+ * sides play with the same strength (A/B comparisons with differing
+ * sides are selfplay's job; tuning runs want many games of one config).
+ */
+typedef struct {
+  int board_size;       // 15 or 19
+  int depth;            // Search depth for both sides
+  int search_radius;    // Candidate radius (see cli_config_t)
+  int leaf_radius;      // Leaf candidate radius (0 = same as search)
+  double move_timeout;  // Seconds per move, fractional (0 = fixed depth)
+  int max_plies;        // Abort unfinished games after this many moves
+                        // (0 = play until the board decides)
+  int threads;          // Worker threads (0 = online cores)
+  uint64_t rng_seed;    // Base tie-break seed; each game derives its own
+                        // from this and its index, so a batch replays
+                        // identically regardless of thread scheduling
+} sim_config_t;
+
+/**
+ * One opening: (x,y) stone coordinates placed alternately starting with
+ * X before the engines take over. Game i of a batch plays opening
+ * i % opening_count, so a batch cycles through the opening set evenly.
+ */
+typedef struct {
+  const int (*moves)[2]; // moves[k][0] = x, moves[k][1] = y
+  int count;
+} sim_opening_t;
+
+/** Winner values in sim_result_t (draws and ply-capped games are 0). */
+#define SIM_WINNER_DRAW 0
+#define SIM_WINNER_X 1
+#define SIM_WINNER_O (-1)
+
+/**
+ * Packed per-game result record, 24 bytes, safe to write to disk or
+ * hand across FFI boundaries as-is.
+ */
+typedef struct {
+  int32_t opening_index; // Which opening this game started from (-1 none)
+  int8_t winner;         // SIM_WINNER_X / SIM_WINNER_O / SIM_WINNER_DRAW
+  int8_t reserved;       // Zero; keeps the record layout explicit
+  int16_t plies;         // Total stones placed, openings included
+  float seconds;         // Wall-clock time spent on this game
+  uint64_t nodes;        // Search nodes across both sides
+} sim_result_t;
+
+/**
+ * Play `game_count` games under `config`, cycling through `openings`
+ * (NULL/0 starts every game from an empty board), and fill one
+ * sim_result_t per game in `results` (caller-allocated, game_count
+ * entries, indexed by game). Blocks until the batch finishes.
+ *
+ * Openings are validated up front: any stone off the board or stacked
+ * on an earlier one rejects the whole batch. Returns the number of
+ * games played, or -1 on invalid arguments.
+ */
+int simulate_games(const sim_config_t *config, const sim_opening_t *openings,
+                   int opening_count, sim_result_t *results, int game_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIMULATE_H
@@ -0,0 +1,374 @@
+//
+//  snapshot.c
+//  gomoku - versioned binary snapshot/restore of game state
+//
+
+#include "snapshot.h"
+#include "board.h"
+#include "gomoku.h"
+#include "nnue.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Fixed-size file header. The struct-size field is the layout
+ * fingerprint: any change to game_state_t (or the cell/entry types below
+ * it) changes sizeof and invalidates old snapshots, which is exactly
+ * what we want for raw-bytes persistence.
+ */
+typedef struct {
+  uint32_t magic;       // SNAPSHOT_MAGIC
+  uint32_t version;     // SNAPSHOT_VERSION
+  uint32_t state_size;  // sizeof(game_state_t) of the writing binary
+  uint32_t board_size;  // Board dimension (duplicated for pre-read checks)
+  uint64_t tt_entries;  // Per-half TT entry count (0 = no TT payload)
+  uint32_t has_vct;     // 1 = VCT memo payload follows the TT payload
+  uint32_t reserved;    // Zero; room for future flags
+} snapshot_header_t;
+
+int snapshot_save(game_state_t *game, const char *filename) {
+  if (!game || !filename || strlen(filename) == 0) {
+    return 0;
+  }
+
+  FILE *f = fopen(filename, "wb");
+  if (!f) {
+    return 0;
+  }
+
+  int size = game->board_size;
+  snapshot_header_t hdr = {
+      .magic = SNAPSHOT_MAGIC,
+      .version = SNAPSHOT_VERSION,
+      .state_size = (uint32_t)sizeof(game_state_t),
+      .board_size = (uint32_t)size,
+      .tt_entries = (uint64_t)(game->tt ? game->tt_size : 0),
+      .has_vct = game->vct_table ? 1u : 0u,
+      .reserved = 0,
+  };
+
+  // The struct is written as-is; its pointer fields are meaningless on
+  // disk and rebuilt by snapshot_load. Board rows are contiguous (see
+  // create_board), so the whole grid is one block.
+  int ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+           fwrite(game, sizeof(game_state_t), 1, f) == 1 &&
+           fwrite(&game->board[0][0], (size_t)size * size * sizeof(cell_t), 1,
+                  f) == 1;
+  if (ok && hdr.tt_entries > 0) {
+    ok = fwrite(game->tt, 2 * game->tt_size * sizeof(transposition_entry_t), 1,
+                f) == 1;
+  }
+  if (ok && hdr.has_vct) {
+    ok = fwrite(game->vct_table, VCT_TT_SIZE * sizeof(vct_entry_t), 1, f) == 1;
+  }
+
+  if (fclose(f) != 0) {
+    ok = 0;
+  }
+  if (!ok) {
+    remove(filename);
+  }
+  return ok;
+}
+
+game_state_t *snapshot_load(const char *filename) {
+  if (!filename || strlen(filename) == 0) {
+    return NULL;
+  }
+
+  FILE *f = fopen(filename, "rb");
+  if (!f) {
+    return NULL;
+  }
+
+  snapshot_header_t hdr;
+  if (fread(&hdr, sizeof(hdr), 1, f) != 1 || hdr.magic != SNAPSHOT_MAGIC ||
+      hdr.version != SNAPSHOT_VERSION ||
+      hdr.state_size != (uint32_t)sizeof(game_state_t) ||
+      hdr.board_size < 5 || hdr.board_size > 19) {
+    fclose(f);
+    return NULL;
+  }
+
+  game_state_t *game = malloc(sizeof(game_state_t));
+  if (!game || fread(game, sizeof(game_state_t), 1, f) != 1) {
+    free(game);
+    fclose(f);
+    return NULL;
+  }
+
+  // Cross-check the struct against the header and clamp anything an
+  // index later trusts; a corrupt snapshot should fail here, not in the
+  // search.
+  if (game->board_size != (int)hdr.board_size ||
+      (game->current_player != AI_CELL_CROSSES &&
+       game->current_player != AI_CELL_NAUGHTS) ||
+      game->move_history_count < 0 ||
+      game->move_history_count > MAX_MOVE_HISTORY ||
+      game->ai_history_count < 0 || game->ai_history_count > MAX_AI_HISTORY ||
+      (hdr.tt_entries > 0 && (game->tt_size != (size_t)hdr.tt_entries ||
+                              game->tt_mask != game->tt_size - 1))) {
+    free(game);
+    fclose(f);
+    return NULL;
+  }
+
+  // Rebuild every pointer field from the payload (or empty).
+  int size = game->board_size;
+  game->board = NULL;
+  game->tt = NULL;
+  game->vct_table = NULL;
+  arena_init(&game->search_arena);
+  game->smp_stop = NULL;
+
+  game->board = create_board(size);
+  if (!game->board ||
+      fread(&game->board[0][0], (size_t)size * size * sizeof(cell_t), 1, f) !=
+          1) {
+    goto fail;
+  }
+
+  if (hdr.tt_entries > 0) {
+    game->tt = malloc(2 * game->tt_size * sizeof(transposition_entry_t));
+    if (!game->tt ||
+        fread(game->tt, 2 * game->tt_size * sizeof(transposition_entry_t), 1,
+              f) != 1) {
+      goto fail;
+    }
+  } else {
+    game->tt_size = 0;
+    game->tt_mask = 0;
+  }
+
+  if (hdr.has_vct) {
+    game->vct_table = malloc(VCT_TT_SIZE * sizeof(vct_entry_t));
+    if (!game->vct_table ||
+        fread(game->vct_table, VCT_TT_SIZE * sizeof(vct_entry_t), 1, f) != 1) {
+      goto fail;
+    }
+  }
+
+  fclose(f);
+
+  // Re-bind process-local state the snapshot can't carry.
+  game->nnue_model = nnue_default();
+  game->nnue_acc_valid = 0;
+  if (game->nnue_model) {
+    nnue_refresh(game, game->board);
+  }
+  return game;
+
+fail:
+  fclose(f);
+  cleanup_game(game);
+  return NULL;
+}
+
+//===============================================================================
+// TRANSPOSITION TABLE SNAPSHOTS
+//===============================================================================
+
+/**
+ * TT snapshot file header. A stored entry is only reusable when the
+ * loading binary hashes positions and packs entries exactly like the
+ * writing one did, so everything that feeds into that — engine version,
+ * zobrist seed, entry layout, entry count — is recorded and checked.
+ */
+typedef struct {
+  uint32_t magic;           // TT_SNAPSHOT_MAGIC
+  uint32_t version;         // TT_SNAPSHOT_VERSION
+  char engine_version[12];  // GAME_VERSION string, zero-padded
+  uint32_t entry_size;      // sizeof(transposition_entry_t)
+  uint64_t zobrist_seed;    // ZOBRIST_SEED of the writing binary
+  uint64_t entries_per_half;
+} tt_snapshot_header_t;
+
+int tt_snapshot_save(const transposition_entry_t *table,
+                     size_t entries_per_half, const char *filename) {
+  if (!table || entries_per_half == 0 || !filename || !filename[0]) {
+    return 0;
+  }
+
+  // Write-then-rename: the snapshot is consumed by the next boot, so a
+  // half-written file must never be visible under the real name.
+  char tmp[520];
+  int n = snprintf(tmp, sizeof(tmp), "%s.tmp", filename);
+  if (n < 0 || (size_t)n >= sizeof(tmp)) {
+    return 0;
+  }
+  FILE *f = fopen(tmp, "wb");
+  if (!f) {
+    return 0;
+  }
+
+  tt_snapshot_header_t hdr = {
+      .magic = TT_SNAPSHOT_MAGIC,
+      .version = TT_SNAPSHOT_VERSION,
+      .engine_version = {0},
+      .entry_size = (uint32_t)sizeof(transposition_entry_t),
+      .zobrist_seed = ZOBRIST_SEED,
+      .entries_per_half = (uint64_t)entries_per_half,
+  };
+  strncpy(hdr.engine_version, GAME_VERSION, sizeof(hdr.engine_version) - 1);
+
+  int ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+           fwrite(table,
+                  2 * entries_per_half * sizeof(transposition_entry_t), 1,
+                  f) == 1;
+  if (fclose(f) != 0) {
+    ok = 0;
+  }
+  if (ok) {
+    ok = rename(tmp, filename) == 0;
+  }
+  if (!ok) {
+    remove(tmp);
+  }
+  return ok;
+}
+
+int tt_snapshot_load(transposition_entry_t *table, size_t entries_per_half,
+                     const char *filename) {
+  if (!table || entries_per_half == 0 || !filename || !filename[0]) {
+    return 0;
+  }
+
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    return 0;
+  }
+  size_t body = 2 * entries_per_half * sizeof(transposition_entry_t);
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      (size_t)st.st_size != sizeof(tt_snapshot_header_t) + body) {
+    close(fd);
+    return 0;
+  }
+
+  // Map rather than read: validation touches only the header page, and
+  // the table copy is one sequential pass the kernel can readahead.
+  void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return 0;
+  }
+#ifdef MADV_SEQUENTIAL
+  madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+
+  const tt_snapshot_header_t *hdr = (const tt_snapshot_header_t *)map;
+  char expect_version[12] = {0};
+  strncpy(expect_version, GAME_VERSION, sizeof(expect_version) - 1);
+  int ok = hdr->magic == TT_SNAPSHOT_MAGIC &&
+           hdr->version == TT_SNAPSHOT_VERSION &&
+           memcmp(hdr->engine_version, expect_version,
+                  sizeof(expect_version)) == 0 &&
+           hdr->entry_size == (uint32_t)sizeof(transposition_entry_t) &&
+           hdr->zobrist_seed == ZOBRIST_SEED &&
+           hdr->entries_per_half == (uint64_t)entries_per_half;
+  if (ok) {
+    memcpy(table, (const char *)map + sizeof(tt_snapshot_header_t), body);
+  }
+  munmap(map, (size_t)st.st_size);
+  return ok;
+}
+
+//===============================================================================
+// MEMORY-MAPPED TRANSPOSITION TABLE FILES
+//===============================================================================
+
+transposition_entry_t *tt_file_map(const char *filename,
+                                   size_t entries_per_half) {
+  if (!filename || !filename[0] || entries_per_half == 0) {
+    return NULL;
+  }
+
+  int fd = open(filename, O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    return NULL;
+  }
+
+  size_t body = 2 * entries_per_half * sizeof(transposition_entry_t);
+  size_t total = sizeof(tt_snapshot_header_t) + body;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return NULL;
+  }
+
+  // A wrong-sized file was written by a differently-configured binary (or
+  // is brand new at size 0); truncate down then up so every page reads as
+  // zero, which is a valid empty table.
+  int fresh = (size_t)st.st_size != total;
+  if (fresh &&
+      (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)total) != 0)) {
+    close(fd);
+    return NULL;
+  }
+
+  void *map = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return NULL;
+  }
+#ifdef MADV_RANDOM
+  // The live table probes hash uniformly across the file; disable
+  // readahead so a probe faults one page, not a cluster. (File-backed
+  // mappings can't get huge pages, so this is the useful hint here.)
+  madvise(map, total, MADV_RANDOM);
+#endif
+
+  tt_snapshot_header_t *hdr = (tt_snapshot_header_t *)map;
+  if (!fresh) {
+    char expect_version[12] = {0};
+    strncpy(expect_version, GAME_VERSION, sizeof(expect_version) - 1);
+    int ok = hdr->magic == TT_SNAPSHOT_MAGIC &&
+             hdr->version == TT_SNAPSHOT_VERSION &&
+             memcmp(hdr->engine_version, expect_version,
+                    sizeof(expect_version)) == 0 &&
+             hdr->entry_size == (uint32_t)sizeof(transposition_entry_t) &&
+             hdr->zobrist_seed == ZOBRIST_SEED &&
+             hdr->entries_per_half == (uint64_t)entries_per_half;
+    if (!ok) {
+      // Right size, wrong provenance (typically an engine upgrade that
+      // changed hashing): wipe in place and start cold rather than
+      // refusing the file — the caller asked for persistence, not a
+      // specific history.
+      memset(map, 0, total);
+      fresh = 1;
+    }
+  }
+  if (fresh) {
+    hdr->magic = TT_SNAPSHOT_MAGIC;
+    hdr->version = TT_SNAPSHOT_VERSION;
+    memset(hdr->engine_version, 0, sizeof(hdr->engine_version));
+    strncpy(hdr->engine_version, GAME_VERSION,
+            sizeof(hdr->engine_version) - 1);
+    hdr->entry_size = (uint32_t)sizeof(transposition_entry_t);
+    hdr->zobrist_seed = ZOBRIST_SEED;
+    hdr->entries_per_half = (uint64_t)entries_per_half;
+  }
+
+  return (transposition_entry_t *)((char *)map +
+                                   sizeof(tt_snapshot_header_t));
+}
+
+void tt_file_unmap(transposition_entry_t *table, size_t entries_per_half) {
+  if (!table || entries_per_half == 0) {
+    return;
+  }
+  char *base = (char *)table - sizeof(tt_snapshot_header_t);
+  size_t total = sizeof(tt_snapshot_header_t) +
+                 2 * entries_per_half * sizeof(transposition_entry_t);
+  // Kick off writeback without blocking shutdown; the kernel flushes any
+  // remaining dirty pages after munmap regardless.
+  msync(base, total, MS_ASYNC);
+  munmap(base, total);
+}
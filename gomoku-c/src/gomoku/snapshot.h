@@ -0,0 +1,96 @@
+//
+//  snapshot.h
+//  gomoku - versioned binary snapshot/restore of game state
+//
+//  write_game_json()/load_game_json() round-trip games through json-c
+//  text and re-execute make_move() per stone on load, which discards the
+//  warmed search state. A snapshot instead writes the game_state_t and
+//  its heap blocks (board, transposition table, VCT memo) as raw bytes,
+//  so save and restore are a handful of block reads/writes and a resumed
+//  game keeps its caches. The struct layout doubles as the format
+//  fingerprint: a snapshot written by a binary with a different
+//  game_state_t size is rejected rather than misread.
+//
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "game.h"
+
+// 'GMKS' little-endian, mirroring the NNUE weights magic convention.
+#define SNAPSHOT_MAGIC 0x534B4D47u
+#define SNAPSHOT_VERSION 1
+
+// 'GMKT' little-endian: standalone transposition-table snapshot, used to
+// warm-start a daemon's shared TT segment across restarts.
+#define TT_SNAPSHOT_MAGIC 0x544B4D47u
+#define TT_SNAPSHOT_VERSION 1
+
+/**
+ * Write a binary snapshot of `game` to `filename`.
+ *
+ * @param game The game state to snapshot
+ * @param filename Destination path
+ * @return 1 on success, 0 on failure
+ */
+int snapshot_save(game_state_t *game, const char *filename);
+
+/**
+ * Restore a game state from a snapshot written by snapshot_save. The
+ * returned state is fully independent (own board, TT and VCT memo) and
+ * is released with cleanup_game() like any other. The NNUE model pointer
+ * is re-bound to the process-wide default, not the one the snapshotting
+ * process had loaded.
+ *
+ * @param filename Snapshot path
+ * @return Restored game state, or NULL on read/validation failure
+ */
+game_state_t *snapshot_load(const char *filename);
+
+/**
+ * Write the contents of a transposition table (both perspective halves,
+ * `entries_per_half` entries each) to `filename` as a standalone
+ * snapshot. The file is written to a temp path and renamed into place so
+ * a crash mid-write can never leave a truncated snapshot for the next
+ * boot to find.
+ *
+ * @return 1 on success, 0 on failure
+ */
+int tt_snapshot_save(const transposition_entry_t *table,
+                     size_t entries_per_half, const char *filename);
+
+/**
+ * Fill `table` from a snapshot written by tt_snapshot_save. The file is
+ * rejected (returning 0, table untouched) unless its engine version,
+ * zobrist seed, entry layout and entry count all match this binary —
+ * entry counts must be identical because probe indices are hash & mask.
+ * A stale or missing snapshot therefore just means a cold start, never
+ * a corrupted table.
+ *
+ * @return 1 when the table was loaded, 0 otherwise
+ */
+int tt_snapshot_load(transposition_entry_t *table, size_t entries_per_half,
+                     const char *filename);
+
+/**
+ * Map `filename` as a live, writable transposition table (both
+ * perspective halves) backed by the file itself — every store lands on
+ * disk without an explicit save step, so the table survives process
+ * restarts as well as in-process reinits. The file is created (or wiped
+ * and resized) when missing, wrong-sized, or written by a binary with a
+ * different engine version, zobrist seed or entry layout; a validation
+ * failure therefore means a cold start, never an unusable table. Pass
+ * the result to tt_set_shared() to have init_game adopt it.
+ *
+ * @return Pointer to the mapped entry array, or NULL on I/O failure
+ */
+transposition_entry_t *tt_file_map(const char *filename,
+                                   size_t entries_per_half);
+
+/**
+ * Release a mapping returned by tt_file_map, scheduling writeback of any
+ * dirty pages. `entries_per_half` must match the mapping call.
+ */
+void tt_file_unmap(transposition_entry_t *table, size_t entries_per_half);
+
+#endif // SNAPSHOT_H
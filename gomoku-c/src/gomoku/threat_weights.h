@@ -0,0 +1,56 @@
+//
+//  threat_weights.h
+//  gomoku - threat valuation weights
+//
+//  Default values for the threat_cost[] table in gomoku.c. The defaults
+//  below are the original hand-tuned numbers; `make tune-weights` builds
+//  the Texel-style harness in src/tools/tune_eval.c, fits the weights to
+//  the games/ corpus, and writes threat_weights_tuned.h next to this
+//  file. Rebuilding with -DGOMOKU_USE_TUNED_WEIGHTS picks the fitted
+//  values up; each macro can also be overridden individually with -D for
+//  ad-hoc experiments. THREAT_WEIGHT_FIVE is the fixed anchor of the
+//  scale and is never tuned.
+//
+
+#ifndef THREAT_WEIGHTS_H
+#define THREAT_WEIGHTS_H
+
+#ifdef GOMOKU_USE_TUNED_WEIGHTS
+#include "threat_weights_tuned.h"
+#endif
+
+#ifndef THREAT_WEIGHT_FIVE
+#define THREAT_WEIGHT_FIVE 100000 // Winning position
+#endif
+#ifndef THREAT_WEIGHT_STRAIGHT_FOUR
+#define THREAT_WEIGHT_STRAIGHT_FOUR 50000 // Open four = guaranteed win
+#endif
+#ifndef THREAT_WEIGHT_FOUR
+#define THREAT_WEIGHT_FOUR 10000 // Closed four = MUST block or lose!
+#endif
+#ifndef THREAT_WEIGHT_FOUR_BROKEN
+#define THREAT_WEIGHT_FOUR_BROKEN 8000 // Four with hole = still must block
+#endif
+#ifndef THREAT_WEIGHT_THREE
+#define THREAT_WEIGHT_THREE 1000 // Open three = serious threat
+#endif
+#ifndef THREAT_WEIGHT_THREE_BROKEN
+#define THREAT_WEIGHT_THREE_BROKEN 200 // Three with hole = developing
+#endif
+#ifndef THREAT_WEIGHT_TWO
+#define THREAT_WEIGHT_TWO 50 // Open two = potential
+#endif
+#ifndef THREAT_WEIGHT_NEAR_ENEMY
+#define THREAT_WEIGHT_NEAR_ENEMY 10 // Positional value
+#endif
+#ifndef THREAT_WEIGHT_THREE_AND_FOUR
+#define THREAT_WEIGHT_THREE_AND_FOUR 45000 // Nearly as good as open four
+#endif
+#ifndef THREAT_WEIGHT_THREE_AND_THREE
+#define THREAT_WEIGHT_THREE_AND_THREE 40000 // Double open three = winning
+#endif
+#ifndef THREAT_WEIGHT_THREE_AND_THREE_BROKEN
+#define THREAT_WEIGHT_THREE_AND_THREE_BROKEN 5000 // Weaker but dangerous
+#endif
+
+#endif // THREAT_WEIGHTS_H
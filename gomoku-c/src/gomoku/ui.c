@@ -12,6 +12,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/select.h>
 #include <unistd.h>
 
 //===============================================================================
@@ -65,6 +66,19 @@ int get_key(void) {
   return -1;
 }
 
+int get_key_timeout(int timeout_ms) {
+  fd_set fds;
+  FD_ZERO(&fds);
+  FD_SET(STDIN_FILENO, &fds);
+  struct timeval tv;
+  tv.tv_sec = timeout_ms / 1000;
+  tv.tv_usec = (timeout_ms % 1000) * 1000;
+  if (select(STDIN_FILENO + 1, &fds, NULL, NULL, &tv) <= 0) {
+    return -1;
+  }
+  return get_key();
+}
+
 void handle_input(game_state_t *game) {
   int key = get_key();
 
@@ -128,7 +142,7 @@ void handle_input(game_state_t *game) {
 //   - Four in a row (open or closed on one side)
 //   - Compound: two open threes for the same player
 //   - Compound: open three + four for the same player
-static void compute_hint_map(int **board, int board_size,
+static void compute_hint_map(cell_t **board, int board_size,
                              int hint_map[MAX_BOARD_DIM][MAX_BOARD_DIM]) {
   int dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
 
@@ -245,7 +259,7 @@ static void compute_hint_map(int **board, int board_size,
 #define WIN_CELL 1
 
 // Locate the winning 5-in-a-row for the given player and mark those cells.
-static void find_winning_cells(int **board, int board_size, int player,
+static void find_winning_cells(cell_t **board, int board_size, int player,
                                int win_map[MAX_BOARD_DIM][MAX_BOARD_DIM]) {
   int dirs[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
 
@@ -300,7 +314,33 @@ static void find_winning_cells(int **board, int board_size, int player,
 // DISPLAY FUNCTIONS
 //===============================================================================
 
-void clear_screen(void) { printf("\033[2J\033[H"); }
+//===============================================================================
+// DIFFERENTIAL BOARD RENDERING
+//===============================================================================
+
+// The exact escape-sequence string last emitted for every board cell
+// (leading space + colored glyph). refresh_display diffs freshly
+// formatted cells against this and reprints only the ones that changed
+// (typically the new stone, the cursor and the last-move highlight)
+// instead of pushing the whole board's escape codes through the
+// terminal on every keystroke - tens of KB per refresh over SSH.
+#define CELL_STR_MAX 48
+
+// Screen position of cell (i, j): draw_board emits one leading newline,
+// the column-letter line, then one board row per line with a 4-column
+// row-label prefix and 2 columns per cell.
+#define CELL_SCREEN_ROW(i) ((i) + 3)
+#define CELL_SCREEN_COL(j) (2 * (j) + 5)
+
+static char drawn_cells[MAX_BOARD_DIM][MAX_BOARD_DIM][CELL_STR_MAX];
+static int drawn_board_size = 0; // 0 = cache invalid, next refresh is full
+
+void clear_screen(void) {
+  printf("\033[2J\033[H");
+  // Anything drawn over a cleared screen is gone; the next refresh must
+  // repaint everything (rules screen, replay banner, board-size change).
+  drawn_board_size = 0;
+}
 
 void press_any_key_to_continue(const char *press_what) {
   printf("\n%s%s%s%s%s\n\n", COLOR_BRIGHT_WHITE, ESCAPE_CODE_BOLD,
@@ -385,6 +425,111 @@ void draw_game_history_sidebar(game_state_t *game, int start_row) {
   }
 }
 
+// Everything draw_board needs to decide a cell's color: whose turn it
+// is, the last move, and the optional hint/win overlays. Computed once
+// per refresh, shared by the full and differential paths.
+typedef struct {
+  int is_human_turn;
+  int last_move_x, last_move_y;
+  int hint_map[MAX_BOARD_DIM][MAX_BOARD_DIM];
+  int win_map[MAX_BOARD_DIM][MAX_BOARD_DIM];
+} render_maps_t;
+
+static void compute_render_maps(game_state_t *game, render_maps_t *maps) {
+  // Cursor is only shown for human players, not in replay mode
+  int current_player_index = (game->current_player == AI_CELL_CROSSES) ? 0 : 1;
+  maps->is_human_turn =
+      !game->replay_mode &&
+      (game->player_type[current_player_index] == PLAYER_TYPE_HUMAN);
+
+  maps->last_move_x = -1;
+  maps->last_move_y = -1;
+  if (game->move_history_count > 0) {
+    maps->last_move_x = game->move_history[game->move_history_count - 1].x;
+    maps->last_move_y = game->move_history[game->move_history_count - 1].y;
+  }
+
+  memset(maps->hint_map, 0, sizeof(maps->hint_map));
+  if (game->config.hints_enabled) {
+    compute_hint_map(game->board, game->board_size, maps->hint_map);
+  }
+
+  memset(maps->win_map, 0, sizeof(maps->win_map));
+  if (game->game_state == GAME_HUMAN_WIN) {
+    find_winning_cells(game->board, game->board_size, AI_CELL_CROSSES,
+                       maps->win_map);
+  } else if (game->game_state == GAME_AI_WIN) {
+    find_winning_cells(game->board, game->board_size, AI_CELL_NAUGHTS,
+                       maps->win_map);
+  }
+}
+
+// Formats one cell - the leading space plus the colored glyph - into buf.
+// The single source of the per-cell color logic for both render paths,
+// and what gets recorded in drawn_cells for the diff.
+static void format_cell(game_state_t *game, const render_maps_t *maps, int i,
+                        int j, char *buf, size_t size) {
+  int is_cursor_here =
+      maps->is_human_turn && (i == game->cursor_x && j == game->cursor_y);
+  int is_last_move = (i == maps->last_move_x && j == maps->last_move_y);
+
+  if (game->board[i][j] == AI_CELL_EMPTY) {
+    if (is_cursor_here) {
+      // Empty cell with cursor: show yellow X or O based on current player
+      const char *glyph = (game->current_player == AI_CELL_CROSSES)
+                              ? UNICODE_CROSSES
+                              : UNICODE_NAUGHTS;
+      snprintf(buf, size, " %s%s%s", COLOR_CURSOR, glyph, COLOR_RESET);
+    } else {
+      // Empty cell without cursor: show normal grid intersection
+      snprintf(buf, size, " %s%s%s", COLOR_RESET, UNICODE_EMPTY, COLOR_RESET);
+    }
+    return;
+  }
+
+  int is_crosses = (game->board[i][j] == AI_CELL_CROSSES);
+  const char *glyph = is_crosses ? UNICODE_CROSSES : UNICODE_NAUGHTS;
+  if (is_cursor_here) {
+    snprintf(buf, size, " %s%s%s%s",
+             is_crosses ? COLOR_X_NORMAL : COLOR_O_NORMAL,
+             COLOR_BG_CURSOR_OCCUPIED, glyph, COLOR_RESET);
+  } else if (maps->win_map[i][j] == WIN_CELL) {
+    snprintf(buf, size, " %s%s%s", is_crosses ? COLOR_X_WIN : COLOR_O_WIN,
+             glyph, COLOR_RESET);
+  } else if (is_last_move) {
+    snprintf(buf, size, " %s%s%s",
+             is_crosses ? COLOR_X_LAST_MOVE : COLOR_O_LAST_MOVE, glyph,
+             COLOR_RESET);
+  } else if (maps->hint_map[i][j] == HINT_THREAT) {
+    snprintf(buf, size, " %s%s%s", is_crosses ? COLOR_X_HINT : COLOR_O_HINT,
+             glyph, COLOR_RESET);
+  } else {
+    snprintf(buf, size, " %s%s%s", is_crosses ? COLOR_X_NORMAL : COLOR_O_NORMAL,
+             glyph, COLOR_RESET);
+  }
+}
+
+// Differential repaint: reformat every cell, reposition-and-reprint only
+// those whose escape string changed since the last refresh. The sidebar
+// and status box are absolute-positioned and cheap, so they are redrawn
+// by refresh_display as usual.
+static void draw_board_diff(game_state_t *game) {
+  render_maps_t maps;
+  compute_render_maps(game, &maps);
+
+  for (int i = 0; i < game->board_size; i++) {
+    for (int j = 0; j < game->board_size; j++) {
+      char buf[CELL_STR_MAX];
+      format_cell(game, &maps, i, j, buf, sizeof(buf));
+      if (strcmp(buf, drawn_cells[i][j]) != 0) {
+        printf(ESCAPE_MOVE_CURSOR_TO, CELL_SCREEN_ROW(i), CELL_SCREEN_COL(j));
+        printf("%s", buf);
+        strcpy(drawn_cells[i][j], buf);
+      }
+    }
+  }
+}
+
 void draw_board(game_state_t *game) {
   printf("\n     ");
 
@@ -401,38 +546,8 @@ void draw_board(game_state_t *game) {
   int board_start_row =
       0; // After header (4 lines) + column numbers (1 line) + buffer (1 line)
 
-  // Determine if current player is human (cursor only shown for human players,
-  // not in replay mode)
-  int current_player_index = (game->current_player == AI_CELL_CROSSES) ? 0 : 1;
-  int is_human_turn =
-      !game->replay_mode &&
-      (game->player_type[current_player_index] == PLAYER_TYPE_HUMAN);
-
-  // Find the last move position for highlighting (from move history)
-  int last_move_x = -1, last_move_y = -1;
-  if (game->move_history_count > 0) {
-    last_move_x = game->move_history[game->move_history_count - 1].x;
-    last_move_y = game->move_history[game->move_history_count - 1].y;
-  }
-
-  // Compute hint map if hints are enabled
-  int hint_map[MAX_BOARD_DIM][MAX_BOARD_DIM];
-  memset(hint_map, 0, sizeof(hint_map));
-  if (game->config.hints_enabled) {
-    compute_hint_map(game->board, game->board_size, hint_map);
-  }
-
-  // Compute winning cells map if someone won
-  int win_map[MAX_BOARD_DIM][MAX_BOARD_DIM];
-  memset(win_map, 0, sizeof(win_map));
-  int winner_player = 0;
-  if (game->game_state == GAME_HUMAN_WIN) {
-    winner_player = AI_CELL_CROSSES;
-    find_winning_cells(game->board, game->board_size, winner_player, win_map);
-  } else if (game->game_state == GAME_AI_WIN) {
-    winner_player = AI_CELL_NAUGHTS;
-    find_winning_cells(game->board, game->board_size, winner_player, win_map);
-  }
+  render_maps_t maps;
+  compute_render_maps(game, &maps);
 
   for (int i = 0; i < game->board_size; i++) {
     printf("  ");
@@ -443,53 +558,10 @@ void draw_board(game_state_t *game) {
       printf("%s%2s%s ", COLOR_GREEN, get_coordinate_unicode(i), COLOR_RESET);
     }
     for (int j = 0; j < game->board_size; j++) {
-      // Only show cursor if it's a human player's turn
-      int is_cursor_here =
-          is_human_turn && (i == game->cursor_x && j == game->cursor_y);
-      int is_last_move = (i == last_move_x && j == last_move_y);
-
-      printf(" "); // Always add the space before the symbol
-
-      // Show appropriate symbol based on cell content
-      if (game->board[i][j] == AI_CELL_EMPTY) {
-        if (is_cursor_here) {
-          // Empty cell with cursor: show yellow X or O based on current player
-          if (game->current_player == AI_CELL_CROSSES) {
-            printf("%s%s%s", COLOR_CURSOR, UNICODE_CROSSES, COLOR_RESET);
-          } else {
-            printf("%s%s%s", COLOR_CURSOR, UNICODE_NAUGHTS, COLOR_RESET);
-          }
-        } else {
-          // Empty cell without cursor: show normal grid intersection
-          printf("%s%s%s", COLOR_RESET, UNICODE_EMPTY, COLOR_RESET);
-        }
-      } else if (game->board[i][j] == AI_CELL_CROSSES) {
-        if (is_cursor_here) {
-          printf("%s%s%s%s", COLOR_X_NORMAL, COLOR_BG_CURSOR_OCCUPIED,
-                 UNICODE_CROSSES, COLOR_RESET);
-        } else if (win_map[i][j] == WIN_CELL) {
-          printf("%s%s%s", COLOR_X_WIN, UNICODE_CROSSES, COLOR_RESET);
-        } else if (is_last_move) {
-          printf("%s%s%s", COLOR_X_LAST_MOVE, UNICODE_CROSSES, COLOR_RESET);
-        } else if (hint_map[i][j] == HINT_THREAT) {
-          printf("%s%s%s", COLOR_X_HINT, UNICODE_CROSSES, COLOR_RESET);
-        } else {
-          printf("%s%s%s", COLOR_X_NORMAL, UNICODE_CROSSES, COLOR_RESET);
-        }
-      } else { // AI_CELL_NAUGHTS
-        if (is_cursor_here) {
-          printf("%s%s%s%s", COLOR_O_NORMAL, COLOR_BG_CURSOR_OCCUPIED,
-                 UNICODE_NAUGHTS, COLOR_RESET);
-        } else if (win_map[i][j] == WIN_CELL) {
-          printf("%s%s%s", COLOR_O_WIN, UNICODE_NAUGHTS, COLOR_RESET);
-        } else if (is_last_move) {
-          printf("%s%s%s", COLOR_O_LAST_MOVE, UNICODE_NAUGHTS, COLOR_RESET);
-        } else if (hint_map[i][j] == HINT_THREAT) {
-          printf("%s%s%s", COLOR_O_HINT, UNICODE_NAUGHTS, COLOR_RESET);
-        } else {
-          printf("%s%s%s", COLOR_O_NORMAL, UNICODE_NAUGHTS, COLOR_RESET);
-        }
-      }
+      // Record what each cell looks like so the next refresh can diff
+      // against it (see draw_board_diff).
+      format_cell(game, &maps, i, j, drawn_cells[i][j], CELL_STR_MAX);
+      printf("%s", drawn_cells[i][j]);
     }
     printf("\n");
   }
@@ -899,8 +971,22 @@ void display_rules(void) {
 }
 
 void refresh_display(game_state_t *game) {
-  clear_screen();
-  draw_board(game);
+  // Full repaint only when the cell cache can't be trusted: first draw,
+  // board-size change, or anything that cleared the screen since (rules
+  // page, replay banner). Otherwise reprint just the changed cells plus
+  // the absolute-positioned sidebar and status box.
+  // Replay mode appends a move-info line below the status box on every
+  // step; the resulting scroll would shift the board off the cached
+  // screen rows, so it always repaints fully.
+  if (drawn_board_size != game->board_size || game->replay_mode) {
+    clear_screen();
+    draw_board(game);
+    draw_status(game);
+    drawn_board_size = game->board_size;
+    return;
+  }
+  draw_board_diff(game);
+  draw_game_history_sidebar(game, 2);
   draw_status(game);
 }
 
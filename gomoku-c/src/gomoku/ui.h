@@ -39,6 +39,16 @@ void disable_raw_mode(void);
  */
 int get_key(void);
 
+/**
+ * Waits up to timeout_ms for a keypress. Lets the caller interleave
+ * rendering with input, e.g. the live progress line while an AI search
+ * runs on a worker thread.
+ *
+ * @param timeout_ms Milliseconds to wait (0 = poll without blocking)
+ * @return Key code as get_key(), or -1 if no key arrived in time
+ */
+int get_key_timeout(int timeout_ms);
+
 /**
  * Handles user input and updates game state accordingly.
  * 
@@ -0,0 +1,266 @@
+//
+//  binary_api.c
+//  gomoku-httpd - compact binary move protocol for robot clients
+//
+
+#include "binary_api.h"
+#include "json_api.h"
+#include "ai.h"
+#include "game.h"
+#include "game_pool.h"
+#include "session.h"
+#include "gomoku.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//===============================================================================
+// INTERNAL HELPERS
+//===============================================================================
+
+static unsigned int read_u16(const unsigned char *p) {
+  return (unsigned int)p[0] | ((unsigned int)p[1] << 8);
+}
+
+static void write_u16(unsigned char *p, unsigned int v) {
+  p[0] = (unsigned char)(v & 0xFF);
+  p[1] = (unsigned char)((v >> 8) & 0xFF);
+}
+
+static void write_u32(unsigned char *p, unsigned long v) {
+  p[0] = (unsigned char)(v & 0xFF);
+  p[1] = (unsigned char)((v >> 8) & 0xFF);
+  p[2] = (unsigned char)((v >> 16) & 0xFF);
+  p[3] = (unsigned char)((v >> 24) & 0xFF);
+}
+
+//===============================================================================
+// CONTENT-TYPE NEGOTIATION
+//===============================================================================
+
+int binary_api_is_binary_request(const char *content_type, size_t len) {
+  static const char media_type[] = BINARY_API_CONTENT_TYPE;
+  size_t type_len = sizeof(media_type) - 1;
+
+  if (!content_type || len < type_len) {
+    return 0;
+  }
+  if (strncasecmp(content_type, media_type, type_len) != 0) {
+    return 0;
+  }
+  // The media type must end here or be followed by parameters
+  // (e.g. "application/x-gomoku-move; version=1").
+  if (len == type_len) {
+    return 1;
+  }
+  char next = content_type[type_len];
+  return next == ';' || next == ' ' || next == '\t';
+}
+
+//===============================================================================
+// GAME STATE PARSING
+//===============================================================================
+
+game_state_t *binary_api_parse_game(const unsigned char *buf, size_t len,
+                                    char *error_msg, size_t error_msg_len) {
+  if (!buf || !error_msg) {
+    if (error_msg && error_msg_len > 0) {
+      snprintf(error_msg, error_msg_len, "Invalid parameters");
+    }
+    return NULL;
+  }
+
+  error_msg[0] = '\0';
+
+  if (len < BINARY_API_REQUEST_HEADER ||
+      memcmp(buf, BINARY_API_MAGIC, 4) != 0) {
+    snprintf(error_msg, error_msg_len,
+             "Invalid binary request: bad magic or truncated header");
+    return NULL;
+  }
+
+  int board_size = buf[4];
+  if (board_size != 15 && board_size != 19) {
+    snprintf(error_msg, error_msg_len, "Invalid board size: must be 15 or 19");
+    return NULL;
+  }
+
+  // Depths and radius use the same caps as the JSON path; 0 means "use
+  // the API default" so a client can leave the tuning bytes blank.
+  int depth_x = buf[5];
+  int depth_o = buf[6];
+  if (depth_x > API_MAX_DEPTH) {
+    depth_x = API_MAX_DEPTH;
+  }
+  if (depth_o > API_MAX_DEPTH) {
+    depth_o = API_MAX_DEPTH;
+  }
+
+  int radius = buf[7];
+  if (radius == 0) {
+    radius = 3; // Matches the JSON path's fallback (and the TUI default)
+  }
+  if (radius > API_MAX_RADIUS) {
+    radius = API_MAX_RADIUS;
+  }
+
+  int timeout = (int)read_u16(buf + 8);
+  int move_count = (int)read_u16(buf + 10);
+
+  if (move_count > board_size * board_size) {
+    snprintf(error_msg, error_msg_len, "Invalid move count: %d", move_count);
+    return NULL;
+  }
+  if (len != (size_t)(BINARY_API_REQUEST_HEADER + 2 * move_count)) {
+    snprintf(error_msg, error_msg_len,
+             "Request length does not match move count");
+    return NULL;
+  }
+
+  // Binary requests are robot-vs-robot by definition: both players AI,
+  // no sessions, undo or multipv. Everything else mirrors the config
+  // json_api_parse_game builds.
+  cli_config_t config = {
+      .board_size = board_size,
+      .max_depth = API_MAX_DEPTH,
+      .move_timeout = timeout,
+      .show_help = 0,
+      .invalid_args = 0,
+      .enable_undo = 0,
+      .max_undo_allowed = 0,
+      .skip_welcome = 1,
+      .headless = 1,
+      .stateless_mode = 1,
+      .search_radius = radius,
+      .leaf_radius = 2,
+      .json_file = "",
+      .replay_file = "",
+      .replay_wait = 0,
+      .player_x_type = PLAYER_TYPE_AI,
+      .player_o_type = PLAYER_TYPE_AI,
+      .depth_x = (depth_x > 0) ? depth_x : API_MAX_DEPTH,
+      .depth_o = (depth_o > 0) ? depth_o : API_MAX_DEPTH,
+      .player_x_explicit = 1,
+      .player_o_explicit = 1,
+      .tt_size_mb = json_api_tt_size_mb(),
+      .multipv = 1,
+  };
+
+  // Moves alternate strictly starting with X; the wire format carries
+  // only coordinates, so per-move stats default to zero.
+  move_history_t parsed_moves[MAX_MOVE_HISTORY];
+  const unsigned char *p = buf + BINARY_API_REQUEST_HEADER;
+  for (int i = 0; i < move_count; i++, p += 2) {
+    int x = p[0];
+    int y = p[1];
+    if (x >= board_size || y >= board_size) {
+      snprintf(error_msg, error_msg_len, "Invalid move at position [%d, %d]",
+               x, y);
+      return NULL;
+    }
+    move_history_t *mv = &parsed_moves[i];
+    memset(mv, 0, sizeof(*mv));
+    mv->x = x;
+    mv->y = y;
+    mv->player = (i % 2 == 0) ? AI_CELL_CROSSES : AI_CELL_NAUGHTS;
+  }
+
+  game_state_t *game = game_pool_acquire(config);
+  if (!game) {
+    snprintf(error_msg, error_msg_len, "Failed to initialize game state");
+    return NULL;
+  }
+
+  // Apply the batch: one rebuild + one terminal check for the whole game
+  int bad_index = -1;
+  if (!bulk_load_moves(game, parsed_moves, move_count, &bad_index)) {
+    snprintf(error_msg, error_msg_len, "Invalid move at position [%d, %d]",
+             parsed_moves[bad_index].x, parsed_moves[bad_index].y);
+    session_release(game);
+    return NULL;
+  }
+
+  // Set current player to opposite of last move
+  if (game->move_history_count > 0) {
+    int last_player = game->move_history[game->move_history_count - 1].player;
+    game->current_player =
+        (last_player == AI_CELL_CROSSES) ? AI_CELL_NAUGHTS : AI_CELL_CROSSES;
+  }
+
+  return game;
+}
+
+//===============================================================================
+// GAME STATE SERIALIZATION
+//===============================================================================
+
+unsigned char *binary_api_serialize_game(game_state_t *game,
+                                         double elapsed_sec, size_t *out_len) {
+  if (!game || !out_len) {
+    return NULL;
+  }
+
+  int size = game->board_size;
+  size_t cells_len = ((size_t)(size * size) + 3) / 4;
+  size_t total = BINARY_API_RESPONSE_HEADER + cells_len;
+
+  unsigned char *buf = calloc(1, total);
+  if (!buf) {
+    return NULL;
+  }
+
+  memcpy(buf, BINARY_API_MAGIC, 4);
+  buf[4] = 0; // status: ok
+  buf[5] = (unsigned char)size;
+  // GAME_RUNNING/GAME_HUMAN_WIN/GAME_AI_WIN/GAME_DRAW are already
+  // 0/1/2/3, which is exactly the wire encoding.
+  buf[6] = (unsigned char)game->game_state;
+  buf[7] = 0; // reserved
+  write_u16(buf + 8, (unsigned int)game->move_history_count);
+
+  if (game->move_history_count > 0) {
+    const move_history_t *last =
+        &game->move_history[game->move_history_count - 1];
+    buf[10] = (unsigned char)last->x;
+    buf[11] = (unsigned char)last->y;
+  } else {
+    buf[10] = 0xFF;
+    buf[11] = 0xFF;
+  }
+
+  double us = elapsed_sec * 1000000.0;
+  if (us < 0) {
+    us = 0;
+  }
+  if (us > 4294967295.0) {
+    us = 4294967295.0;
+  }
+  write_u32(buf + 12, (unsigned long)us);
+
+  long evals = 0;
+  if (game->move_history_count > 0) {
+    evals = game->move_history[game->move_history_count - 1].positions_evaluated;
+    if (evals < 0) {
+      evals = 0;
+    }
+  }
+  write_u32(buf + 16, (unsigned long)evals);
+
+  // 2-bit cells, row-major, LSB-first (calloc pre-zeroed = all empty)
+  unsigned char *cells = buf + BINARY_API_RESPONSE_HEADER;
+  for (int x = 0; x < size; x++) {
+    for (int y = 0; y < size; y++) {
+      cell_t c = game->board[x][y];
+      if (c == AI_CELL_EMPTY) {
+        continue;
+      }
+      unsigned int code = (c == AI_CELL_CROSSES) ? 1 : 2;
+      int idx = x * size + y;
+      cells[idx >> 2] |= (unsigned char)(code << ((idx & 3) * 2));
+    }
+  }
+
+  *out_len = total;
+  return buf;
+}
@@ -0,0 +1,112 @@
+//
+//  binary_api.h
+//  gomoku-httpd - compact binary move protocol for robot clients
+//
+
+#ifndef NET_BINARY_API_H
+#define NET_BINARY_API_H
+
+#include "game.h"
+#include <stddef.h>
+
+//===============================================================================
+// WIRE FORMAT
+//===============================================================================
+//
+// An alternative encoding for POST /gomoku/play, negotiated by sending
+// Content-Type: application/x-gomoku-move. Robot-vs-robot clients making
+// hundreds of moves per minute spend as long in json-c's DOM as in a
+// shallow search; this format parses in a single pass and serializes the
+// board as packed 2-bit cells instead of nested JSON arrays (~111 bytes
+// for a 19x19 response vs several KB of text).
+//
+// All multi-byte fields are little-endian. Requests (12-byte header):
+//
+//   offset  size  field
+//   0       4     magic "GMK1"
+//   4       1     board_size (15 or 19)
+//   5       1     depth for X (0 = API default, capped at API_MAX_DEPTH)
+//   6       1     depth for O (0 = API default, capped at API_MAX_DEPTH)
+//   7       1     search radius (0 = default 3, capped at API_MAX_RADIUS)
+//   8       2     per-move timeout in seconds (0 = none)
+//   10      2     move_count
+//   12      2*N   moves as (x, y) byte pairs in play order, strictly
+//                 alternating and starting with X
+//
+// Both players are implicitly AI — that is the only position /gomoku/play
+// accepts anyway. Sessions, undo and multipv are JSON-only features.
+//
+// Responses (20-byte header + packed board):
+//
+//   offset  size  field
+//   0       4     magic "GMK1"
+//   4       1     status (0 = ok)
+//   5       1     board_size
+//   6       1     winner (0 = in progress, 1 = X, 2 = O, 3 = draw;
+//                 matches the GAME_* state constants)
+//   7       1     reserved (0)
+//   8       2     move_count after the engine's reply
+//   10      2     last move as (x, y), 0xFF 0xFF on an empty board
+//   12      4     engine think time in microseconds
+//   16      4     positions evaluated by the search
+//   20      ...   ceil(size*size / 4) bytes of 2-bit cells, row-major,
+//                 LSB-first within each byte (0 = empty, 1 = X, 2 = O)
+//
+// Malformed requests and server errors are still answered as JSON with a
+// non-2xx HTTP status, so clients keep one error path for both encodings.
+
+#define BINARY_API_CONTENT_TYPE "application/x-gomoku-move"
+#define BINARY_API_MAGIC "GMK1"
+#define BINARY_API_REQUEST_HEADER 12
+#define BINARY_API_RESPONSE_HEADER 20
+
+//===============================================================================
+// CONTENT-TYPE NEGOTIATION
+//===============================================================================
+
+/**
+ * Check whether a Content-Type header value selects the binary protocol.
+ * Matches the media type case-insensitively and ignores any parameters
+ * after ';'. The header value need not be null-terminated.
+ *
+ * @param content_type Header value (may be NULL)
+ * @param len Header value length
+ * @return 1 if the binary protocol was requested, 0 otherwise
+ */
+int binary_api_is_binary_request(const char *content_type, size_t len);
+
+//===============================================================================
+// GAME STATE PARSING
+//===============================================================================
+
+/**
+ * Parse a binary move request and restore game state, mirroring
+ * json_api_parse_game(): same depth/radius caps, same pooled-game
+ * checkout, same bulk position load, and current_player set to the
+ * opposite of the last move.
+ *
+ * @param buf The request body
+ * @param len Body length in bytes
+ * @param error_msg Buffer to store error message on failure
+ * @param error_msg_len Size of error message buffer
+ * @return game_state_t* on success, NULL on error (check error_msg)
+ */
+game_state_t *binary_api_parse_game(const unsigned char *buf, size_t len,
+                                    char *error_msg, size_t error_msg_len);
+
+//===============================================================================
+// GAME STATE SERIALIZATION
+//===============================================================================
+
+/**
+ * Serialize game state into the binary response format above.
+ *
+ * @param game The game state to serialize
+ * @param elapsed_sec Engine think time for the latest move in seconds
+ * @param out_len Receives the response length in bytes
+ * @return Allocated buffer (caller must free), or NULL on error
+ */
+unsigned char *binary_api_serialize_game(game_state_t *game,
+                                         double elapsed_sec, size_t *out_len);
+
+#endif // NET_BINARY_API_H
@@ -98,7 +98,19 @@ daemon_config_t daemon_parse_arguments(int argc, char *argv[]) {
       .daemonize = 0,
       .log_file = "",
       .log_level = DAEMON_LOG_INFO,
+      .async_log = 0,
       .report_scoring = 0,
+      .tt_size_mb = 0,
+      .shared_tt_mb = 0,
+      .tt_file = "",
+      .sessions = 0,
+      .deadline_ms = 0,
+      .workers = 0,
+      .ponder = 0,
+      .prefork = 0,
+      .numa_node = -1,
+      .keep_alive_idle = 0,
+      .keep_alive_max = 0,
       .show_help = 0,
       .invalid_args = 0,
   };
@@ -109,7 +121,19 @@ daemon_config_t daemon_parse_arguments(int argc, char *argv[]) {
       {"daemonize", no_argument, 0, 'd'},
       {"log-file", required_argument, 0, 'l'},
       {"log-level", required_argument, 0, 'L'},
+      {"async-log", no_argument, 0, 'A'},
       {"report-scoring", no_argument, 0, 'r'},
+      {"tt-size", required_argument, 0, 'z'},
+      {"shared-tt", required_argument, 0, 'S'},
+      {"tt-file", required_argument, 0, 't'},
+      {"sessions", required_argument, 0, 'g'},
+      {"deadline-ms", required_argument, 0, 'D'},
+      {"nnue", required_argument, 0, 'N'},
+      {"workers", required_argument, 0, 'w'},
+      {"ponder", no_argument, 0, 'p'},
+      {"prefork", required_argument, 0, 'P'},
+      {"numa-node", required_argument, 0, 'n'},
+      {"keep-alive", required_argument, 0, 'k'},
       {"help", no_argument, 0, 'h'},
       {0, 0, 0, 0}};
 
@@ -119,8 +143,8 @@ daemon_config_t daemon_parse_arguments(int argc, char *argv[]) {
   // Reset getopt
   optind = 1;
 
-  while ((c = getopt_long(argc, argv, "b:a:dl:L:rh", long_options,
-                          &option_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "b:a:dl:L:Arz:S:t:g:D:N:w:pP:n:k:h",
+                          long_options, &option_index)) != -1) {
     switch (c) {
     case 'b':
       if (!parse_bind_address(optarg, config.bind_host,
@@ -165,10 +189,141 @@ daemon_config_t daemon_parse_arguments(int argc, char *argv[]) {
       break;
     }
 
+    case 'A':
+      config.async_log = 1;
+      break;
+
     case 'r':
       config.report_scoring = 1;
       break;
 
+    case 'z': {
+      int mb = atoi(optarg);
+      if (mb < 1 || mb > 4096) {
+        fprintf(stderr, "Error: Invalid --tt-size '%s' (expected 1-4096 MB)\n",
+                optarg);
+        config.invalid_args = 1;
+      } else {
+        config.tt_size_mb = mb;
+      }
+      break;
+    }
+
+    case 'S': {
+      int mb = atoi(optarg);
+      if (mb < 1 || mb > 16384) {
+        fprintf(stderr,
+                "Error: Invalid --shared-tt '%s' (expected 1-16384 MB)\n",
+                optarg);
+        config.invalid_args = 1;
+      } else {
+        config.shared_tt_mb = mb;
+      }
+      break;
+    }
+
+    case 't':
+      strncpy(config.tt_file, optarg, sizeof(config.tt_file) - 1);
+      config.tt_file[sizeof(config.tt_file) - 1] = '\0';
+      break;
+
+    case 'g': {
+      int sessions = atoi(optarg);
+      if (sessions < 0 || sessions > 4096) {
+        fprintf(stderr,
+                "Error: Invalid --sessions '%s' (expected 0-4096)\n", optarg);
+        config.invalid_args = 1;
+      } else {
+        config.sessions = sessions;
+      }
+      break;
+    }
+
+    case 'D': {
+      int ms = atoi(optarg);
+      if (ms < 0 || ms > 600000) {
+        fprintf(stderr,
+                "Error: Invalid --deadline-ms '%s' (expected 0-600000)\n",
+                optarg);
+        config.invalid_args = 1;
+      } else {
+        config.deadline_ms = ms;
+      }
+      break;
+    }
+
+    case 'N':
+      strncpy(config.nnue_file, optarg, sizeof(config.nnue_file) - 1);
+      config.nnue_file[sizeof(config.nnue_file) - 1] = '\0';
+      break;
+
+    case 'w': {
+      int workers = atoi(optarg);
+      if (workers < 0 || workers > 32) {
+        fprintf(stderr, "Error: Invalid --workers '%s' (expected 0-32)\n",
+                optarg);
+        config.invalid_args = 1;
+      } else {
+        config.workers = workers;
+      }
+      break;
+    }
+
+    case 'p':
+      config.ponder = 1;
+      break;
+
+    case 'P': {
+      int prefork = atoi(optarg);
+      if (prefork < 0 || prefork > 32) {
+        fprintf(stderr, "Error: Invalid --prefork '%s' (expected 0-32)\n",
+                optarg);
+        config.invalid_args = 1;
+      } else {
+        config.prefork = prefork;
+      }
+      break;
+    }
+
+    case 'n': {
+      int node = atoi(optarg);
+      if (node < 0 || node > 255) {
+        fprintf(stderr, "Error: Invalid --numa-node '%s' (expected 0-255)\n",
+                optarg);
+        config.invalid_args = 1;
+      } else {
+        config.numa_node = node;
+      }
+      break;
+    }
+
+    case 'k': {
+      // "sec" or "sec:max" — idle timeout plus optional per-connection
+      // request cap.
+      char *end = NULL;
+      long sec = strtol(optarg, &end, 10);
+      long max = 0;
+      int ok = end != optarg && sec >= 1 && sec <= 3600;
+      if (ok && *end == ':') {
+        const char *second = end + 1;
+        max = strtol(second, &end, 10);
+        ok = end != second && *end == '\0' && max >= 0 && max <= 1000000;
+      } else if (ok) {
+        ok = *end == '\0';
+      }
+      if (!ok) {
+        fprintf(stderr,
+                "Error: Invalid --keep-alive '%s' (expected sec or sec:max, "
+                "sec 1-3600)\n",
+                optarg);
+        config.invalid_args = 1;
+      } else {
+        config.keep_alive_idle = (int)sec;
+        config.keep_alive_max = (int)max;
+      }
+      break;
+    }
+
     case 'h':
       config.show_help = 1;
       break;
@@ -227,8 +382,72 @@ void daemon_print_help(const char *program_name) {
   printf("  -L, --log-level <level>  Set log level (default: INFO)\n");
   printf("                           Levels: TRACE, DEBUG, INFO, WARN, ERROR, "
          "FATAL\n");
+  printf("  -A, --async-log          Queue log lines to a background flusher "
+         "thread\n");
+  printf("                           instead of writing on the request path "
+         "(full\n");
+  printf("                           queue drops lines rather than "
+         "blocking)\n");
+  printf("  -z, --tt-size MB         Transposition table size per game in "
+         "megabytes\n");
+  printf("                           (default: 4)\n");
+  printf("  -S, --shared-tt MB       One transposition table of this size "
+         "shared by\n");
+  printf("                           all workers, threaded or preforked "
+         "(default:\n");
+  printf("                           off = per-game tables; overrides "
+         "--tt-size)\n");
+  printf("  -t, --tt-file FILE       Snapshot the shared transposition table "
+         "to FILE\n");
+  printf("                           on graceful shutdown and load it back at "
+         "boot,\n");
+  printf("                           so deploys restart warm (requires "
+         "--shared-tt;\n");
+  printf("                           stale or mismatched files start "
+         "cold)\n");
+  printf("  -g, --sessions <n>       Keep warm search contexts for up to n "
+         "games,\n");
+  printf("                           keyed by the request's session_id "
+         "(default:\n");
+  printf("                           0 = stateless, every request searches "
+         "cold)\n");
+  printf("  -D, --deadline-ms <ms>   Default request deadline; queued "
+         "requests get\n");
+  printf("                           the remaining budget as their search "
+         "timeout\n");
+  printf("                           (per-request X-Deadline-Ms header "
+         "overrides)\n");
+  printf("  -N, --nnue FILE          Load NNUE weights and use the learned "
+         "evaluator\n");
+  printf("                           at search leaves (default: classical "
+         "eval)\n");
   printf("  -r, --report-scoring     Include AI scoring report in JSON "
-         "responses\n");
+         "responses by default\n");
+  printf("                           (per request: ?scoring=none|summary|full;"
+         " full adds VCT sequences)\n");
+  printf("  -w, --workers <n>        AI worker threads for concurrent "
+         "requests\n");
+  printf("                           (default: 0 = one request at a "
+         "time)\n");
+  printf("  -p, --ponder             Pre-search likely replies on idle "
+         "workers while\n");
+  printf("                           waiting for a session's next move "
+         "(requires\n");
+  printf("                           --sessions and --workers)\n");
+  printf("  -P, --prefork <n>        Fork n server processes sharing the "
+         "port via\n");
+  printf("                           SO_REUSEPORT (default: 0 = single "
+         "process)\n");
+  printf("  -n, --numa-node <node>   Bind table memory and worker threads to "
+         "one\n");
+  printf("                           NUMA node, so the shared TT stays local "
+         "to the\n");
+  printf("                           CPUs probing it (Linux only; default: "
+         "unbound)\n");
+  printf("  -k, --keep-alive <s[:n]> Keep-alive idle timeout in seconds, "
+         "with an\n");
+  printf("                           optional cap on requests served per\n");
+  printf("                           connection (default: 120, unlimited)\n");
   printf("  -h, --help               Show this help message\n\n");
 
   printf("ENDPOINTS:\n");
@@ -260,5 +479,5 @@ void daemon_print_help(const char *program_name) {
   printf("CONSTRAINTS:\n");
   printf("  Max AI depth: %d\n", 6);
   printf("  Max search radius: %d\n", 4);
-  printf("  Single-threaded (one request at a time)\n");
+  printf("  One request at a time unless --workers is set\n");
 }
@@ -39,7 +39,20 @@ typedef struct {
     int daemonize;                // Run as daemon (-d/--daemonize)
     char log_file[512];           // Log file path (-l/--log-file), empty = stdout
     daemon_log_level_t log_level; // Log level (-L/--log-level)
+    int async_log;                // Async ring-buffer logging (-A/--async-log)
     int report_scoring;           // Include scoring report in JSON (-r/--report-scoring)
+    int tt_size_mb;               // Transposition table MB per game (-z/--tt-size, 0 = default)
+    int shared_tt_mb;             // Shared TT segment MB (-S/--shared-tt, 0 = per-game tables)
+    char tt_file[512];            // Shared-TT snapshot path (-t/--tt-file, empty = none)
+    int sessions;                 // Warm per-game contexts to keep (-g/--sessions, 0 = stateless)
+    int deadline_ms;              // Default request deadline (-D/--deadline-ms, 0 = none)
+    char nnue_file[256];          // NNUE weights file (-N/--nnue, empty = classical eval)
+    int workers;                  // AI worker threads (-w/--workers, 0 = synchronous)
+    int ponder;                   // Speculative pondering on idle workers (-p/--ponder)
+    int prefork;                  // Prefork server processes (-P/--prefork, 0 = single process)
+    int numa_node;                // NUMA node to bind memory and workers to (-n/--numa-node, -1 = unbound)
+    int keep_alive_idle;          // Keep-alive idle timeout seconds (-k/--keep-alive, 0 = default 120)
+    int keep_alive_max;           // Max requests per connection (-k sec:max, 0 = unlimited)
     int show_help;                // Show help and exit
     int invalid_args;             // Invalid arguments detected
 } daemon_config_t;
@@ -0,0 +1,69 @@
+//
+//  game_pool.c
+//  gomoku-httpd - pooled, pre-initialized game-state contexts
+//
+
+#include "game_pool.h"
+
+#include <pthread.h>
+#include <stddef.h>
+
+// Enough slots for a full worker pool's worth of concurrent checkouts of
+// either supported board size (see handlers.c). Any slot can hold any
+// size; acquire scans for a size match.
+#define GAME_POOL_SLOTS 16
+
+static game_state_t *pool[GAME_POOL_SLOTS];
+
+// Worker threads acquire and release concurrently; the pool operations
+// are a handful of pointer moves, so one mutex is plenty.
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+game_state_t *game_pool_acquire(cli_config_t config) {
+  game_state_t *game = NULL;
+
+  pthread_mutex_lock(&pool_mutex);
+  for (int slot = 0; slot < GAME_POOL_SLOTS; slot++) {
+    if (pool[slot] && pool[slot]->board_size == config.board_size) {
+      game = pool[slot];
+      pool[slot] = NULL;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&pool_mutex);
+
+  if (game) {
+    reinit_game(game, config);
+    return game;
+  }
+  return init_game(config);
+}
+
+void game_pool_release(game_state_t *game) {
+  if (!game) {
+    return;
+  }
+
+  pthread_mutex_lock(&pool_mutex);
+  for (int slot = 0; slot < GAME_POOL_SLOTS; slot++) {
+    if (!pool[slot]) {
+      pool[slot] = game;
+      pthread_mutex_unlock(&pool_mutex);
+      return;
+    }
+  }
+  pthread_mutex_unlock(&pool_mutex);
+
+  cleanup_game(game);
+}
+
+void game_pool_drain(void) {
+  pthread_mutex_lock(&pool_mutex);
+  for (int slot = 0; slot < GAME_POOL_SLOTS; slot++) {
+    if (pool[slot]) {
+      cleanup_game(pool[slot]);
+      pool[slot] = NULL;
+    }
+  }
+  pthread_mutex_unlock(&pool_mutex);
+}
@@ -0,0 +1,45 @@
+//
+//  game_pool.h
+//  gomoku-httpd - pooled, pre-initialized game-state contexts
+//
+
+#ifndef NET_GAME_POOL_H
+#define NET_GAME_POOL_H
+
+#include "game.h"
+
+//===============================================================================
+// GAME STATE POOL
+//===============================================================================
+//
+// Every /gomoku/play request used to rebuild a full game_state_t from
+// scratch: struct + board allocation, transposition-table allocation and
+// zeroing, 722 Zobrist keys, symmetry permutations — then tear it all
+// down. The pool keeps initialized states and hands them out with
+// reinit_game(), so repeat requests pay only a board clear and a cache
+// rebuild instead of the full multi-millisecond setup.
+//
+// With the worker pool in handlers.c, several requests can hold checked
+// out states at once; the pool itself is mutex-protected and sized for
+// a full complement of workers per board size.
+
+/**
+ * Check out a game state for the given config. Reuses a pooled state
+ * with a matching board size when one is available, otherwise falls
+ * back to a fresh init_game(). Returns NULL on allocation failure.
+ * Thread-safe.
+ */
+game_state_t *game_pool_acquire(cli_config_t config);
+
+/**
+ * Return a game state to the pool. If every slot is occupied, the state
+ * is freed instead. Safe to call with NULL. Thread-safe.
+ */
+void game_pool_release(game_state_t *game);
+
+/**
+ * Free all pooled states. Called once at daemon shutdown.
+ */
+void game_pool_drain(void);
+
+#endif // NET_GAME_POOL_H
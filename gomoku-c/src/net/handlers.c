@@ -6,14 +6,19 @@
 #define HTTPSERVER_IMPL
 #include "handlers.h"
 #include "ai.h" // includes scoring_report_t
+#include "binary_api.h"
 #include "board.h"
 #include "game.h"
+#include "game_pool.h"
+#include "session.h"
 #include "gomoku.h"
 #include "httpserver.h"
 #include "json_api.h"
 #include "logger.h"
+#include "metrics.h"
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -41,7 +46,9 @@ static int report_scoring_enabled = 0;
 typedef struct {
   double start_time;
   char client_ip[INET_ADDRSTRLEN];
-  const char *path;
+  // Owned copy of the request path: the context travels with a job into a
+  // worker thread, so it can't point at another thread's scratch buffer.
+  char path[256];
   // W3C traceparent trace-id ("" when absent). Logged on every request line so
   // engine logs can be joined to FastAPI/Honeycomb traces by trace_id.
   char trace_id[TRACE_ID_LEN];
@@ -49,6 +56,144 @@ typedef struct {
 
 static __thread request_context_t current_request = {0};
 
+//===============================================================================
+// WORKER POOL
+//===============================================================================
+//
+// With workers enabled (-w/--workers), /gomoku/play is handled in three
+// stages: the event-loop thread parses and validates the request, a
+// worker thread runs the AI search on its own pooled game state, and the
+// event-loop thread sends the finished response. httpserver.h request
+// and response objects are only ever touched from the loop thread; the
+// worker sees nothing but the job struct and its checked-out game.
+
+#define MAX_WORKERS 32
+
+// Request-inactivity timeout (seconds) while a job is queued or
+// computing. The library default is 20s, which a deep search on a loaded
+// box could exceed; the write path restores the normal timeouts once the
+// response goes out.
+#define WORKER_REQUEST_TIMEOUT 300
+
+// Admission queue bound: jobs allowed to wait for a worker, per worker.
+// Under this the daemon queues bursts instead of telling the balancer
+// to drain (which just bounces requests between backends); at the bound
+// it rejects with 503 so retries go elsewhere immediately.
+#define QUEUE_LIMIT_PER_WORKER 4
+
+// Deadline-to-budget conversion: reserve this much of a request's
+// deadline for serialization and the response write, and never hand the
+// search less than the minimum (a legal move still beats an LB timeout).
+#define DEADLINE_RESPONSE_MARGIN_MS 25.0
+#define DEADLINE_MIN_BUDGET_MS 10.0
+
+// Upper bound on positions per /gomoku/analyze/batch request. Keeps a
+// single request from pinning the admission queue indefinitely; the
+// analytics pipeline splits larger sets into several batches.
+#define MAX_BATCH_POSITIONS 1024
+
+struct analyze_batch_s;
+
+typedef struct play_job_s {
+  struct http_request_s *request;
+  game_state_t *game;
+  request_context_t ctx; // Logging context captured at accept time
+  double deadline_at;    // Absolute deadline (get_current_time scale), 0 = none
+  int ai_player;
+  int player_index;
+  // Set for /gomoku/analyze/batch elements: the result joins the batch
+  // stream instead of becoming a standalone response.
+  struct analyze_batch_s *batch;
+  int batch_index;
+  // Set when the client negotiated the binary protocol via Content-Type
+  // (see binary_api.h); a successful compute then produces a binary
+  // body, while errors stay JSON with a non-2xx status.
+  int binary;
+  // Scoring-report detail for this response (see scoring query param)
+  json_scoring_detail_t scoring_detail;
+  // Filled by play_compute:
+  int status;
+  char *response_json;        // malloc'd body (NULL = use fallback_body)
+  size_t response_len;        // nonzero = binary body (may contain NULs)
+  const char *fallback_body;  // static fallback when serialization failed
+  struct play_job_s *next;
+} play_job_t;
+
+// One /gomoku/analyze/batch request in flight. Elements fan out across
+// the worker pool as ordinary play jobs; results are streamed back as a
+// chunked JSON array in completion order (each element carries its
+// input "index"). All fields are touched only on the event-loop thread.
+typedef struct analyze_batch_s {
+  struct http_request_s *request;
+  request_context_t ctx;
+  int total;     // elements in the request array
+  int completed; // elements whose result has been produced
+  char **ready;  // completed results awaiting a chunk write
+  int ready_n;
+  int ready_cap;
+  char *inflight;  // chunk body currently being written (freed on done)
+  int started;     // response status+headers and '[' have been sent
+  int writing;     // a chunk write is awaiting its notify_done
+  int closing;     // the final ']' chunk has been sent
+  int dispatching; // handle_analyze_batch is still fanning elements out;
+                   // the stream must not close (and free the batch) yet
+} analyze_batch_t;
+
+static pthread_t worker_threads[MAX_WORKERS];
+static int worker_count = 0;
+static int pool_running = 0;
+
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_available = PTHREAD_COND_INITIALIZER;
+static play_job_t *job_head = NULL, *job_tail = NULL;   // Awaiting a worker
+static play_job_t *done_head = NULL, *done_tail = NULL; // Awaiting drain
+static int jobs_in_flight = 0; // Accepted but not yet responded to
+static int queued_jobs = 0;    // Subset of the above still awaiting a worker
+
+// Default deadline applied when a request carries no X-Deadline-Ms
+// header (-D/--deadline-ms, 0 = none).
+static int default_deadline_ms = 0;
+
+//===============================================================================
+// SPECULATIVE PONDERING (-p/--ponder, requires -g and -w)
+//===============================================================================
+//
+// Between a session game's moves the worker pool is idle while the human
+// thinks. When enabled, answering a session request also queues a ponder
+// job: the opponent's top-K predicted replies (by the root generator's
+// move priority) are searched speculatively on idle workers, each with a
+// bounded budget, directly on the warm session context. The results need
+// no cache of their own — they land in the session's transposition table
+// keyed by position hash, so when the predicted reply actually arrives
+// the real search starts from a solved or nearly solved table.
+//
+// Ponder work is strictly lower priority than real requests: workers only
+// pick it up when the job queue is empty, and enqueueing a real job sets
+// ponder_stop, which running ponder searches observe through the engine's
+// smp_stop/timeout polling within a few thousand nodes. A ponder job
+// holds the session loan while it runs, so a request racing in for the
+// same session falls back to a cold rebuild — the prompt abort keeps that
+// window to roughly one timeout-poll interval.
+
+#define PONDER_MAX_PREDICTIONS 3
+#define PONDER_BUDGET_SECONDS 2.0
+
+typedef struct ponder_job_s {
+  char session_id[SESSION_ID_MAX];
+  int expected_moves; // history length the stored context must still have
+  int opponent;       // predicted mover (AI_CELL_*)
+  int predictions;
+  int px[PONDER_MAX_PREDICTIONS];
+  int py[PONDER_MAX_PREDICTIONS];
+  struct ponder_job_s *next;
+} ponder_job_t;
+
+static int ponder_enabled = 0;
+static ponder_job_t *ponder_head = NULL, *ponder_tail = NULL;
+// Raised (under pool_mutex) whenever a real job is waiting; checked by
+// in-flight ponder searches via game->smp_stop.
+static volatile int ponder_stop = 0;
+
 /**
  * Extract the trace-id from a W3C traceparent header.
  *
@@ -105,14 +250,44 @@ static void send_json_response(struct http_request_s *request, int status,
   // Log request completion
   double elapsed_ms =
       (get_current_time() - current_request.start_time) * 1000.0;
+  metrics_observe_request(current_request.path, status, elapsed_ms / 1000.0);
   if (current_request.trace_id[0] != '\0') {
     LOG_INFO("%s %s %d %.3fms trace_id=%s", current_request.client_ip,
-             current_request.path ? current_request.path : "/unknown", status,
-             elapsed_ms, current_request.trace_id);
+             current_request.path[0] ? current_request.path : "/unknown",
+             status, elapsed_ms, current_request.trace_id);
   } else {
     LOG_INFO("%s %s %d %.3fms", current_request.client_ip,
-             current_request.path ? current_request.path : "/unknown", status,
-             elapsed_ms);
+             current_request.path[0] ? current_request.path : "/unknown",
+             status, elapsed_ms);
+  }
+}
+
+/**
+ * Send a binary-protocol response body and log the request. Same shape
+ * as send_json_response but with an explicit length (binary bodies
+ * contain NULs) and the binary media type.
+ */
+static void send_binary_response(struct http_request_s *request, int status,
+                                 const unsigned char *body, size_t body_len) {
+  struct http_response_s *response = http_response_init();
+  http_response_status(response, status);
+  http_response_header(response, "Content-Type", BINARY_API_CONTENT_TYPE);
+  http_response_header(response, "Access-Control-Allow-Origin", "*");
+  http_response_body(response, (const char *)body, (int)body_len);
+
+  http_respond(request, response);
+
+  double elapsed_ms =
+      (get_current_time() - current_request.start_time) * 1000.0;
+  metrics_observe_request(current_request.path, status, elapsed_ms / 1000.0);
+  if (current_request.trace_id[0] != '\0') {
+    LOG_INFO("%s %s %d %.3fms trace_id=%s", current_request.client_ip,
+             current_request.path[0] ? current_request.path : "/unknown",
+             status, elapsed_ms, current_request.trace_id);
+  } else {
+    LOG_INFO("%s %s %d %.3fms", current_request.client_ip,
+             current_request.path[0] ? current_request.path : "/unknown",
+             status, elapsed_ms);
   }
 }
 
@@ -154,6 +329,46 @@ static int path_matches(struct http_request_s *request, const char *path) {
   return 0;
 }
 
+/**
+ * Scoring-report detail for a request, from the `scoring` query
+ * parameter: "none"/"0" omits the report, "summary"/"1" includes the
+ * per-evaluator entries without VCT sequences, "full"/"2" includes
+ * everything. Absent or unrecognized, the server default applies:
+ * summary when -r/--report-scoring is set, none otherwise.
+ */
+static json_scoring_detail_t
+scoring_detail_from_request(struct http_request_s *request) {
+  json_scoring_detail_t fallback =
+      report_scoring_enabled ? JSON_SCORING_SUMMARY : JSON_SCORING_NONE;
+  struct http_string_s target = http_request_target(request);
+  const char *q = memchr(target.buf, '?', (size_t)target.len);
+  if (!q) {
+    return fallback;
+  }
+  const char *end = target.buf + target.len;
+  q++;
+  while (q < end) {
+    const char *amp = memchr(q, '&', (size_t)(end - q));
+    const char *stop = amp ? amp : end;
+    if (stop - q > 8 && strncmp(q, "scoring=", 8) == 0) {
+      const char *v = q + 8;
+      size_t n = (size_t)(stop - v);
+      if ((n == 4 && strncmp(v, "none", 4) == 0) || (n == 1 && *v == '0')) {
+        return JSON_SCORING_NONE;
+      }
+      if ((n == 7 && strncmp(v, "summary", 7) == 0) || (n == 1 && *v == '1')) {
+        return JSON_SCORING_SUMMARY;
+      }
+      if ((n == 4 && strncmp(v, "full", 4) == 0) || (n == 1 && *v == '2')) {
+        return JSON_SCORING_FULL;
+      }
+      return fallback;
+    }
+    q = stop + 1;
+  }
+  return fallback;
+}
+
 //===============================================================================
 // PUBLIC FUNCTIONS - INITIALIZATION
 //===============================================================================
@@ -175,7 +390,36 @@ void handlers_init(void) {
 // PUBLIC FUNCTIONS - BUSY STATUS
 //===============================================================================
 
-int handlers_is_busy(void) { return server_busy != 0; }
+int handlers_is_busy(void) {
+  if (worker_count > 0) {
+    // Busy for routing purposes only once the admission queue is full;
+    // below that the daemon absorbs bursts itself instead of bouncing
+    // them between backends.
+    pthread_mutex_lock(&pool_mutex);
+    int busy = queued_jobs >= worker_count * QUEUE_LIMIT_PER_WORKER;
+    pthread_mutex_unlock(&pool_mutex);
+    return busy;
+  }
+  return server_busy != 0;
+}
+
+int handlers_capacity_pct(void) {
+  if (worker_count > 0) {
+    // Weight = share of the admission budget still free: one slot per
+    // worker plus the bounded queue behind them. A single long search on
+    // a multi-worker daemon costs one slot instead of marking the whole
+    // backend drained.
+    pthread_mutex_lock(&pool_mutex);
+    int slots = worker_count * (1 + QUEUE_LIMIT_PER_WORKER);
+    int active = jobs_in_flight;
+    pthread_mutex_unlock(&pool_mutex);
+    if (active >= slots) {
+      return 0;
+    }
+    return ((slots - active) * 100) / slots;
+  }
+  return server_busy ? 0 : 100;
+}
 
 void handlers_set_busy(void) { server_busy = 1; }
 
@@ -185,6 +429,287 @@ void handlers_set_report_scoring(int enabled) {
   report_scoring_enabled = enabled;
 }
 
+void handlers_set_default_deadline_ms(int ms) { default_deadline_ms = ms; }
+
+//===============================================================================
+// PUBLIC FUNCTIONS - WORKER POOL
+//===============================================================================
+
+static void play_compute(play_job_t *job);
+static void play_finish(play_job_t *job);
+static void batch_push_result(analyze_batch_t *batch, int index, int status,
+                              const char *result_json);
+static void batch_pump(analyze_batch_t *batch);
+static void batch_element_finish(play_job_t *job);
+
+static void ponder_run(ponder_job_t *pj);
+
+static void *worker_main(void *arg) {
+  (void)arg;
+  for (;;) {
+    pthread_mutex_lock(&pool_mutex);
+    while (pool_running && !job_head && !ponder_head) {
+      pthread_cond_wait(&job_available, &pool_mutex);
+    }
+    if (!pool_running) {
+      pthread_mutex_unlock(&pool_mutex);
+      return NULL;
+    }
+    if (!job_head) {
+      // No real work waiting: pick up a ponder job instead.
+      ponder_job_t *pj = ponder_head;
+      ponder_head = pj->next;
+      if (!ponder_head) {
+        ponder_tail = NULL;
+      }
+      pthread_mutex_unlock(&pool_mutex);
+      ponder_run(pj);
+      continue;
+    }
+    play_job_t *job = job_head;
+    job_head = job->next;
+    if (!job_head) {
+      job_tail = NULL;
+    }
+    queued_jobs--;
+    if (queued_jobs == 0) {
+      ponder_stop = 0; // Queue drained; ponder searches may run again
+    }
+    pthread_mutex_unlock(&pool_mutex);
+
+    play_compute(job);
+
+    pthread_mutex_lock(&pool_mutex);
+    job->next = NULL;
+    if (done_tail) {
+      done_tail->next = job;
+    } else {
+      done_head = job;
+    }
+    done_tail = job;
+    pthread_mutex_unlock(&pool_mutex);
+  }
+}
+
+int handlers_start_workers(int count) {
+  if (count <= 0) {
+    return 1; // Synchronous mode
+  }
+  if (count > MAX_WORKERS) {
+    count = MAX_WORKERS;
+  }
+  pool_running = 1;
+  for (int i = 0; i < count; i++) {
+    if (pthread_create(&worker_threads[i], NULL, worker_main, NULL) != 0) {
+      worker_count = i;
+      handlers_stop_workers();
+      return 0;
+    }
+  }
+  worker_count = count;
+  LOG_INFO("Worker pool started (%d threads)", count);
+  return 1;
+}
+
+void handlers_stop_workers(void) {
+  if (!pool_running) {
+    return;
+  }
+  pthread_mutex_lock(&pool_mutex);
+  pool_running = 0;
+  pthread_cond_broadcast(&job_available);
+  pthread_mutex_unlock(&pool_mutex);
+
+  for (int i = 0; i < worker_count; i++) {
+    pthread_join(worker_threads[i], NULL);
+  }
+  worker_count = 0;
+
+  // The daemon is shutting down: release undispatched and unflushed jobs
+  // without responding (their connections die with the process).
+  play_job_t *lists[2] = {job_head, done_head};
+  for (int l = 0; l < 2; l++) {
+    for (play_job_t *job = lists[l]; job;) {
+      play_job_t *next = job->next;
+      session_release(job->game);
+      free(job->response_json);
+      free(job);
+      job = next;
+    }
+  }
+  job_head = job_tail = done_head = done_tail = NULL;
+  jobs_in_flight = 0;
+  queued_jobs = 0;
+
+  for (ponder_job_t *pj = ponder_head; pj;) {
+    ponder_job_t *next = pj->next;
+    free(pj);
+    pj = next;
+  }
+  ponder_head = ponder_tail = NULL;
+}
+
+//===============================================================================
+// SPECULATIVE PONDERING
+//===============================================================================
+
+void handlers_set_ponder(int enabled) { ponder_enabled = enabled; }
+
+/**
+ * Build a ponder job for the session game just answered, or NULL when
+ * pondering doesn't apply (feature off, game over, opponent is not a
+ * human client, stateless request). Runs on the answering worker while
+ * it still holds the session loan; the job is enqueued by the caller
+ * AFTER session_release so the picking worker's session_take can't miss.
+ */
+static ponder_job_t *ponder_prepare(const play_job_t *job,
+                                    game_state_t *game) {
+  if (!ponder_enabled || !pool_running ||
+      game->game_state != GAME_RUNNING ||
+      game->player_type[1 - job->player_index] != PLAYER_TYPE_HUMAN) {
+    return NULL;
+  }
+  ponder_job_t *pj = calloc(1, sizeof(*pj));
+  if (!pj) {
+    return NULL;
+  }
+  if (!session_id_of(game, pj->session_id, sizeof(pj->session_id))) {
+    free(pj);
+    return NULL;
+  }
+  pj->expected_moves = game->move_history_count;
+  pj->opponent = (job->ai_player == AI_CELL_CROSSES) ? AI_CELL_NAUGHTS
+                                                     : AI_CELL_CROSSES;
+
+  // Predict the opponent's likely replies: top-K of the root generator's
+  // candidate list by move priority (the same ordering the search would
+  // explore first).
+  move_t moves[361];
+  int n = generate_moves_optimized(game, game->board, moves, pj->opponent,
+                                   game->config.max_depth);
+  for (int k = 0; k < PONDER_MAX_PREDICTIONS && k < n; k++) {
+    int best = k;
+    for (int i = k + 1; i < n; i++) {
+      if (moves[i].priority > moves[best].priority) {
+        best = i;
+      }
+    }
+    move_t tmp = moves[k];
+    moves[k] = moves[best];
+    moves[best] = tmp;
+    pj->px[k] = moves[k].x;
+    pj->py[k] = moves[k].y;
+    pj->predictions++;
+  }
+  if (pj->predictions == 0) {
+    free(pj);
+    return NULL;
+  }
+  return pj;
+}
+
+static void ponder_enqueue(ponder_job_t *pj) {
+  if (!pj) {
+    return;
+  }
+  pthread_mutex_lock(&pool_mutex);
+  if (!pool_running) {
+    pthread_mutex_unlock(&pool_mutex);
+    free(pj);
+    return;
+  }
+  pj->next = NULL;
+  if (ponder_tail) {
+    ponder_tail->next = pj;
+  } else {
+    ponder_head = pj;
+  }
+  ponder_tail = pj;
+  pthread_cond_signal(&job_available);
+  pthread_mutex_unlock(&pool_mutex);
+}
+
+/**
+ * Search the predicted replies speculatively on the warm session
+ * context. Each prediction is played, searched under a bounded budget,
+ * and unmade; everything of value persists in the context's
+ * transposition table. Aborts between (and, via ponder_stop, inside)
+ * searches as soon as real work arrives.
+ */
+static void ponder_run(ponder_job_t *pj) {
+  game_state_t *game = session_take(pj->session_id);
+  if (!game) {
+    free(pj); // Evicted, or the next real request beat us to the context
+    return;
+  }
+  // Re-loan immediately so session_release below stores it back.
+  session_loan(pj->session_id, game);
+  if (game->game_state != GAME_RUNNING ||
+      game->move_history_count != pj->expected_moves) {
+    // A real request advanced the game between scheduling and pickup
+    session_release(game);
+    free(pj);
+    return;
+  }
+
+  double saved_timeout = game->move_timeout;
+  int searched = 0;
+  game->smp_stop = &ponder_stop;
+  for (int i = 0; i < pj->predictions && !ponder_stop; i++) {
+    int x = pj->px[i], y = pj->py[i];
+    if (!make_move(game, x, y, pj->opponent, 0, 0, 0, 0)) {
+      continue;
+    }
+    if (game->game_state == GAME_RUNNING) {
+      game->move_timeout = PONDER_BUDGET_SECONDS;
+      int bx = -1, by = -1;
+      find_best_ai_move(game, &bx, &by, NULL);
+      searched++;
+    }
+    // Unmake the prediction: pop its history entry and reverse the
+    // incremental state, exactly as undo_last_moves does per move. The
+    // prediction carried no think time, so the time totals are untouched.
+    game->move_history_count--;
+    search_unmake_move(game, game->board, x, y, pj->opponent);
+    game->game_state = GAME_RUNNING;
+    game->current_player = pj->opponent;
+  }
+  game->smp_stop = NULL;
+  game->move_timeout = saved_timeout;
+  game->search_timed_out = 0;
+  LOG_DEBUG("Ponder: session %s searched %d/%d predicted replies%s",
+            pj->session_id, searched, pj->predictions,
+            ponder_stop ? " (yielded to real work)" : "");
+  session_release(game);
+  free(pj);
+}
+
+void handlers_drain_completions(void) {
+  for (;;) {
+    pthread_mutex_lock(&pool_mutex);
+    play_job_t *job = done_head;
+    if (job) {
+      done_head = job->next;
+      if (!done_head) {
+        done_tail = NULL;
+      }
+      jobs_in_flight--;
+    }
+    pthread_mutex_unlock(&pool_mutex);
+    if (!job) {
+      return;
+    }
+    play_finish(job);
+  }
+}
+
+int handlers_inflight(void) {
+  pthread_mutex_lock(&pool_mutex);
+  int count = jobs_in_flight;
+  pthread_mutex_unlock(&pool_mutex);
+  return count;
+}
+
 //===============================================================================
 // PUBLIC FUNCTIONS - REQUEST DISPATCHER
 //===============================================================================
@@ -205,13 +730,11 @@ void handle_request(struct http_request_s *request) {
   struct http_string_s target = http_request_target(request);
 
   // Store path for logging (null-terminate for safety)
-  static __thread char path_buf[256];
-  size_t path_len = (size_t)target.len < sizeof(path_buf) - 1
+  size_t path_len = (size_t)target.len < sizeof(current_request.path) - 1
                         ? (size_t)target.len
-                        : sizeof(path_buf) - 1;
-  memcpy(path_buf, target.buf, path_len);
-  path_buf[path_len] = '\0';
-  current_request.path = path_buf;
+                        : sizeof(current_request.path) - 1;
+  memcpy(current_request.path, target.buf, path_len);
+  current_request.path[path_len] = '\0';
 
   struct http_string_s req_body = http_request_body(request);
   LOG_DEBUG("Request: %.*s %.*s from %s (%d bytes)", (int)method.len,
@@ -234,9 +757,9 @@ void handle_request(struct http_request_s *request) {
         (get_current_time() - current_request.start_time) * 1000.0;
     if (current_request.trace_id[0] != '\0') {
       LOG_INFO("%s %s 204 %.3fms trace_id=%s", current_request.client_ip,
-               path_buf, elapsed_ms, current_request.trace_id);
+               current_request.path, elapsed_ms, current_request.trace_id);
     } else {
-      LOG_INFO("%s %s 204 %.3fms", current_request.client_ip, path_buf,
+      LOG_INFO("%s %s 204 %.3fms", current_request.client_ip, current_request.path,
                elapsed_ms);
     }
     return;
@@ -261,6 +784,18 @@ void handle_request(struct http_request_s *request) {
     } else {
       handle_method_not_allowed(request);
     }
+  } else if (path_matches(request, "/gomoku/analyze/batch")) {
+    if (method_matches(request, "POST")) {
+      handle_analyze_batch(request);
+    } else {
+      handle_method_not_allowed(request);
+    }
+  } else if (path_matches(request, "/metrics")) {
+    if (method_matches(request, "GET")) {
+      handle_metrics(request);
+    } else {
+      handle_method_not_allowed(request);
+    }
   } else {
     handle_not_found(request);
   }
@@ -298,7 +833,85 @@ void handle_ready(struct http_request_s *request) {
   }
 }
 
+void handle_metrics(struct http_request_s *request) {
+  // Queue gauges live behind the pool mutex in this file; sample them
+  // here and let the renderer own everything counter-shaped.
+  int queue_depth = 0;
+  int in_flight = 0;
+  if (pool_running) {
+    pthread_mutex_lock(&pool_mutex);
+    queue_depth = queued_jobs;
+    in_flight = jobs_in_flight;
+    pthread_mutex_unlock(&pool_mutex);
+  }
+
+  char *text = metrics_render(queue_depth, in_flight);
+  if (!text) {
+    handle_internal_error(request, "Failed to render metrics");
+    return;
+  }
+
+  struct http_response_s *response = http_response_init();
+  http_response_status(response, 200);
+  http_response_header(response, "Content-Type",
+                       "text/plain; version=0.0.4; charset=utf-8");
+  http_response_body(response, text, (int)strlen(text));
+  http_respond(request, response);
+  free(text); // http_respond serialized the body into its own buffer
+
+  double elapsed_ms =
+      (get_current_time() - current_request.start_time) * 1000.0;
+  metrics_observe_request(current_request.path, 200, elapsed_ms / 1000.0);
+  LOG_INFO("%s %s %d %.3fms", current_request.client_ip,
+           current_request.path[0] ? current_request.path : "/unknown", 200,
+           elapsed_ms);
+}
+
 void handle_play(struct http_request_s *request) {
+  // Bounded admission: reject right away when the queue is full so the
+  // balancer's retry lands on another backend instead of stacking here.
+  if (pool_running) {
+    pthread_mutex_lock(&pool_mutex);
+    int full = queued_jobs >= worker_count * QUEUE_LIMIT_PER_WORKER;
+    pthread_mutex_unlock(&pool_mutex);
+    if (full) {
+      LOG_WARN("Admission queue full, rejecting request");
+      char *error_json = json_api_error_response("Server queue is full");
+      if (error_json) {
+        send_json_response(request, 503, error_json);
+        free(error_json);
+      } else {
+        send_json_response(request, 503, "{\"error\":\"Server queue is full\"}");
+      }
+      return;
+    }
+  }
+
+  // Per-request deadline: X-Deadline-Ms header, else the configured
+  // default. Converted into a search budget when the job is picked up,
+  // so time spent waiting in the queue degrades depth, not reliability.
+  double deadline_ms = (double)default_deadline_ms;
+  struct http_string_s deadline_hdr =
+      http_request_header(request, "X-Deadline-Ms");
+  if (deadline_hdr.len > 0 && deadline_hdr.len < 16) {
+    char deadline_buf[16];
+    memcpy(deadline_buf, deadline_hdr.buf, (size_t)deadline_hdr.len);
+    deadline_buf[deadline_hdr.len] = '\0';
+    double v = atof(deadline_buf);
+    if (v > 0) {
+      deadline_ms = v;
+    }
+  }
+
+  // Protocol negotiation: Content-Type application/x-gomoku-move selects
+  // the compact binary encoding for robot clients (see binary_api.h).
+  // Everything downstream of parsing is shared; only the body codecs
+  // differ, and errors are JSON either way.
+  struct http_string_s content_type =
+      http_request_header(request, "Content-Type");
+  int binary =
+      binary_api_is_binary_request(content_type.buf, (size_t)content_type.len);
+
   // Get request body
   struct http_string_s body = http_request_body(request);
 
@@ -308,22 +921,29 @@ void handle_play(struct http_request_s *request) {
     return;
   }
 
-  // Create null-terminated copy of body
-  char *body_str = malloc(body.len + 1);
-  if (!body_str) {
-    handle_internal_error(request, "Memory allocation failed");
-    return;
-  }
-  memcpy(body_str, body.buf, body.len);
-  body_str[body.len] = '\0';
-
-  LOG_DEBUG("  received game state: %zu bytes", body.len);
+  LOG_DEBUG("  received game state: %zu bytes%s", body.len,
+            binary ? " (binary)" : "");
 
   // Parse game state
   char error_msg[256] = {0};
-  game_state_t *game =
-      json_api_parse_game(body_str, error_msg, sizeof(error_msg));
-  free(body_str);
+  game_state_t *game;
+  if (binary) {
+    // Binary bodies may contain NULs; the parser takes an explicit length
+    game = binary_api_parse_game((const unsigned char *)body.buf, body.len,
+                                 error_msg, sizeof(error_msg));
+  } else {
+    // Create null-terminated copy of body
+    char *body_str = malloc(body.len + 1);
+    if (!body_str) {
+      handle_internal_error(request, "Memory allocation failed");
+      return;
+    }
+    memcpy(body_str, body.buf, body.len);
+    body_str[body.len] = '\0';
+
+    game = json_api_parse_game(body_str, error_msg, sizeof(error_msg));
+    free(body_str);
+  }
 
   if (!game) {
     LOG_WARN("Failed to parse game: %s", error_msg);
@@ -334,8 +954,21 @@ void handle_play(struct http_request_s *request) {
   // Check if game already has a winner
   if (json_api_has_winner(game)) {
     LOG_DEBUG("  game already finished, returning unchanged");
+    if (binary) {
+      size_t response_len = 0;
+      unsigned char *response_buf =
+          binary_api_serialize_game(game, 0, &response_len);
+      session_release(game);
+      if (response_buf) {
+        send_binary_response(request, 200, response_buf, response_len);
+        free(response_buf);
+      } else {
+        handle_internal_error(request, "Failed to serialize game state");
+      }
+      return;
+    }
     char *response_json = json_api_serialize_game(game);
-    cleanup_game(game);
+    session_release(game);
 
     if (response_json) {
       send_json_response(request, 200, response_json);
@@ -350,13 +983,236 @@ void handle_play(struct http_request_s *request) {
   int ai_player = game->current_player;
   int player_index = (ai_player == AI_CELL_CROSSES) ? 0 : 1;
   if (game->player_type[player_index] != PLAYER_TYPE_AI) {
-    cleanup_game(game);
+    session_release(game);
     handle_bad_request(
         request,
         "Next player is human; server only accepts AI to-move positions");
     return;
   }
 
+  // Package the accepted request as a job. In synchronous mode it is
+  // computed and answered right here; with workers running it is handed
+  // off and this thread returns to the event loop.
+  play_job_t *job = calloc(1, sizeof(*job));
+  if (!job) {
+    session_release(game);
+    handle_internal_error(request, "Memory allocation failed");
+    return;
+  }
+  job->request = request;
+  job->game = game;
+  job->ctx = current_request;
+  job->deadline_at =
+      (deadline_ms > 0) ? current_request.start_time + deadline_ms / 1000.0 : 0;
+  job->ai_player = ai_player;
+  job->player_index = player_index;
+  job->binary = binary;
+  job->scoring_detail = scoring_detail_from_request(request);
+  job->status = 500;
+  job->fallback_body = "{\"error\":\"Internal server error\"}";
+
+  if (pool_running) {
+    // The library would drop an idle connection after 20s; a queued deep
+    // search can legitimately take longer, so extend the clock until the
+    // response goes out (the write path restores the normal timeouts).
+    request->timeout = WORKER_REQUEST_TIMEOUT;
+    pthread_mutex_lock(&pool_mutex);
+    jobs_in_flight++;
+    queued_jobs++;
+    ponder_stop = 1; // Real work waiting: in-flight ponder searches yield
+    if (job_tail) {
+      job_tail->next = job;
+    } else {
+      job_head = job;
+    }
+    job_tail = job;
+    pthread_cond_signal(&job_available);
+    pthread_mutex_unlock(&pool_mutex);
+    return;
+  }
+
+  play_compute(job);
+  play_finish(job);
+}
+
+void handle_analyze_batch(struct http_request_s *request) {
+  // Same bounded admission as /gomoku/play: a batch is either accepted
+  // whole or bounced to another backend.
+  if (pool_running) {
+    pthread_mutex_lock(&pool_mutex);
+    int full = queued_jobs >= worker_count * QUEUE_LIMIT_PER_WORKER;
+    pthread_mutex_unlock(&pool_mutex);
+    if (full) {
+      LOG_WARN("Admission queue full, rejecting batch request");
+      char *error_json = json_api_error_response("Server queue is full");
+      if (error_json) {
+        send_json_response(request, 503, error_json);
+        free(error_json);
+      } else {
+        send_json_response(request, 503, "{\"error\":\"Server queue is full\"}");
+      }
+      return;
+    }
+  }
+
+  struct http_string_s body = http_request_body(request);
+  if (body.len == 0) {
+    LOG_WARN("Empty request body");
+    handle_bad_request(request, "Request body is required");
+    return;
+  }
+
+  char *body_str = malloc(body.len + 1);
+  if (!body_str) {
+    handle_internal_error(request, "Memory allocation failed");
+    return;
+  }
+  memcpy(body_str, body.buf, body.len);
+  body_str[body.len] = '\0';
+
+  LOG_DEBUG("  received batch: %zu bytes", body.len);
+
+  char error_msg[256] = {0};
+  int count = 0;
+  char **items =
+      json_api_split_array(body_str, &count, error_msg, sizeof(error_msg));
+  free(body_str);
+
+  if (!items) {
+    LOG_WARN("Failed to parse batch: %s", error_msg);
+    handle_bad_request(request, error_msg);
+    return;
+  }
+  if (count > MAX_BATCH_POSITIONS) {
+    for (int i = 0; i < count; i++) {
+      free(items[i]);
+    }
+    free(items);
+    handle_bad_request(request, "Batch too large (max 1024 positions)");
+    return;
+  }
+
+  analyze_batch_t *batch = calloc(1, sizeof(*batch));
+  if (!batch) {
+    for (int i = 0; i < count; i++) {
+      free(items[i]);
+    }
+    free(items);
+    handle_internal_error(request, "Memory allocation failed");
+    return;
+  }
+  batch->request = request;
+  batch->ctx = current_request;
+  batch->total = count;
+  batch->dispatching = 1;
+  http_request_set_userdata(request, batch);
+
+  LOG_INFO("  batch of %d positions accepted", count);
+
+  // Fan the elements out. Each valid position becomes an ordinary play
+  // job; invalid ones resolve to an error result immediately. In
+  // synchronous mode (no workers) each element computes inline and the
+  // stream advances between elements.
+  int jobs_submitted = 0;
+  for (int i = 0; i < count; i++) {
+    char elem_error[256] = {0};
+    game_state_t *game =
+        json_api_parse_game(items[i], elem_error, sizeof(elem_error));
+    free(items[i]);
+
+    if (!game) {
+      char *error_json = json_api_error_response(elem_error);
+      batch_push_result(batch, i, 400, error_json);
+      free(error_json);
+      continue;
+    }
+
+    if (json_api_has_winner(game)) {
+      char *game_json = json_api_serialize_game(game);
+      session_release(game);
+      if (game_json) {
+        batch_push_result(batch, i, 200, game_json);
+        free(game_json);
+      } else {
+        batch_push_result(batch, i, 500, NULL);
+      }
+      continue;
+    }
+
+    int ai_player = game->current_player;
+    int player_index = (ai_player == AI_CELL_CROSSES) ? 0 : 1;
+    if (game->player_type[player_index] != PLAYER_TYPE_AI) {
+      session_release(game);
+      char *error_json = json_api_error_response(
+          "Next player is human; server only accepts AI to-move positions");
+      batch_push_result(batch, i, 400, error_json);
+      free(error_json);
+      continue;
+    }
+
+    play_job_t *job = calloc(1, sizeof(*job));
+    if (!job) {
+      session_release(game);
+      batch_push_result(batch, i, 500, NULL);
+      continue;
+    }
+    job->request = request;
+    job->game = game;
+    job->ctx = current_request;
+    job->ai_player = ai_player;
+    job->player_index = player_index;
+    job->scoring_detail = scoring_detail_from_request(request);
+    job->batch = batch;
+    job->batch_index = i;
+    job->status = 500;
+    job->fallback_body = "{\"error\":\"Internal server error\"}";
+
+    if (pool_running) {
+      pthread_mutex_lock(&pool_mutex);
+      jobs_in_flight++;
+      queued_jobs++;
+      ponder_stop = 1;
+      if (job_tail) {
+        job_tail->next = job;
+      } else {
+        job_head = job;
+      }
+      job_tail = job;
+      pthread_cond_signal(&job_available);
+      pthread_mutex_unlock(&pool_mutex);
+      jobs_submitted++;
+    } else {
+      play_compute(job);
+      batch_element_finish(job);
+    }
+  }
+  free(items);
+
+  // Outstanding elements can legitimately take longer than the library's
+  // per-request timeout; batch_chunk_done keeps extending it until the
+  // last one lands.
+  if (jobs_submitted > 0) {
+    request->timeout = WORKER_REQUEST_TIMEOUT;
+  }
+  batch->dispatching = 0;
+  batch_pump(batch);
+}
+
+/**
+ * Stage 2 of /gomoku/play: run the AI search and build the response
+ * body. Runs on a worker thread when the pool is enabled, otherwise
+ * inline on the event-loop thread. Touches only the job and its
+ * checked-out game state — never the HTTP request.
+ */
+static void play_compute(play_job_t *job) {
+  game_state_t *game = job->game;
+  int ai_player = job->ai_player;
+  int player_index = job->player_index;
+
+  // Adopt the job's logging context so engine log lines keep the
+  // client IP and trace-id of the request they belong to.
+  current_request = job->ctx;
+
   // Set player-specific depth for AI search (same pattern as main.c)
   int saved_depth = game->max_depth;
   game->max_depth = game->depth_for_player[player_index];
@@ -368,6 +1224,26 @@ void handle_play(struct http_request_s *request) {
   // Mark server as busy for HAProxy agent-check
   handlers_set_busy();
 
+  // A queued request already spent part of its deadline waiting; cap
+  // the search at what remains (minus the response margin) so it comes
+  // back with a shallower move instead of timing out at the balancer.
+  if (job->deadline_at > 0) {
+    double remaining = job->deadline_at - get_current_time() -
+                       DEADLINE_RESPONSE_MARGIN_MS / 1000.0;
+    if (remaining < DEADLINE_MIN_BUDGET_MS / 1000.0) {
+      remaining = DEADLINE_MIN_BUDGET_MS / 1000.0;
+    }
+    if (game->move_timeout <= 0 || remaining < game->move_timeout) {
+      game->move_timeout = remaining;
+    }
+  }
+
+  // TT counters are cumulative per pooled context; diff them around the
+  // search to get this request's contribution for /metrics. The worker
+  // owns the game here, so plain reads don't race.
+  uint64_t tt_probes_before = game->tt_probes;
+  uint64_t tt_hits_before = game->tt_hits;
+
   // Start timing
   double start_time = get_current_time();
   game->search_start_time = start_time;
@@ -412,8 +1288,10 @@ void handle_play(struct http_request_s *request) {
   // Make the move
   if (best_x < 0 || best_y < 0) {
     LOG_ERROR("  AI failed to find valid move after %.3fs", elapsed_time);
-    cleanup_game(game);
-    handle_internal_error(request, "AI failed to find a valid move");
+    LOG_ERROR("Internal error: AI failed to find a valid move");
+    session_release(game);
+    job->game = NULL;
+    job->response_json = json_api_error_response("AI failed to find a valid move");
     return;
   }
 
@@ -426,11 +1304,17 @@ void handle_play(struct http_request_s *request) {
                                        game->board_size);
   int moves_evaluated = game->last_ai_moves_evaluated;
 
+  metrics_observe_search(elapsed_time, moves_evaluated,
+                         game->tt_probes - tt_probes_before,
+                         game->tt_hits - tt_hits_before, &scoring_report);
+
   if (!make_move(game, best_x, best_y, ai_player, elapsed_time, moves_evaluated,
                  own_score, opp_score)) {
     LOG_ERROR("  failed to make move at [%d, %d]", best_x, best_y);
-    cleanup_game(game);
-    handle_internal_error(request, "Failed to apply AI move");
+    LOG_ERROR("Internal error: Failed to apply AI move");
+    session_release(game);
+    job->game = NULL;
+    job->response_json = json_api_error_response("Failed to apply AI move");
     return;
   }
 
@@ -465,36 +1349,261 @@ void handle_play(struct http_request_s *request) {
       best_x, best_y, player_depth, game->search_radius, moves_evaluated,
       elapsed_time, move_type);
 
-  // Log scoring pipeline summary (only when evaluators ran)
+  // Log scoring pipeline summary (only when evaluators ran). One line
+  // per request, carrying each stage's time plus its work breakdown
+  // (nodes, tt probes/hits/stores, movegen runs, leaf evals) and the
+  // trace id, so a blown deadline can be attributed to the stage that
+  // burned the budget straight from the log.
   if (scoring_report.entry_count > 0) {
-    char pipeline[512];
+    char pipeline[1024];
     int pos = 0;
-    for (int i = 0; i < scoring_report.entry_count && pos < 480; i++) {
+    for (int i = 0; i < scoring_report.entry_count && pos < 960; i++) {
       scoring_entry_t *e = &scoring_report.entries[i];
-      pos +=
-          snprintf(pipeline + pos, sizeof(pipeline) - (size_t)pos,
-                   "%s%s(%.2fms)", i > 0 ? " " : "", e->evaluator, e->time_ms);
+      pos += snprintf(pipeline + pos, sizeof(pipeline) - (size_t)pos,
+                      "%s%s(%.2fms n=%llu tt=%llu/%llu/%llu mg=%llu ev=%llu)",
+                      i > 0 ? " " : "", e->evaluator, e->time_ms,
+                      (unsigned long long)e->nodes,
+                      (unsigned long long)e->tt_probes,
+                      (unsigned long long)e->tt_hits,
+                      (unsigned long long)e->tt_stores,
+                      (unsigned long long)e->movegen_calls,
+                      (unsigned long long)e->eval_calls);
       if (e->decisive) {
         pos += snprintf(pipeline + pos, sizeof(pipeline) - (size_t)pos, "*");
         break; // steps after decisive didn't run
       }
     }
-    LOG_INFO("  scoring: %s", pipeline);
+    if (job->ctx.trace_id[0] != '\0') {
+      LOG_INFO("  scoring: %s trace_id=%s", pipeline, job->ctx.trace_id);
+    } else {
+      LOG_INFO("  scoring: %s", pipeline);
+    }
+  }
+
+  // Speculative pondering: prepared while we still hold the session
+  // loan, enqueued only after the release below so the picking worker
+  // finds the context in the store.
+  ponder_job_t *ponder = ponder_prepare(job, game);
+
+  // Serialize (pass scoring report if enabled); the response itself is
+  // sent by play_finish on the event-loop thread.
+  if (job->binary) {
+    size_t response_len = 0;
+    unsigned char *response_buf =
+        binary_api_serialize_game(game, elapsed_time, &response_len);
+    session_release(game);
+    job->game = NULL;
+    ponder_enqueue(ponder);
+
+    if (response_buf) {
+      LOG_INFO("Sending binary response with a move (%zu bytes) HTTP 200",
+               response_len);
+      job->status = 200;
+      job->response_json = (char *)response_buf;
+      job->response_len = response_len;
+    } else {
+      LOG_ERROR("Internal error: Failed to serialize game state");
+      job->response_json =
+          json_api_error_response("Failed to serialize game state");
+    }
+    return;
   }
 
-  // Serialize and return (pass scoring report if enabled)
   char *response_json = json_api_serialize_game_ex(
-      game, report_scoring_enabled ? &scoring_report : NULL, elapsed_time);
-  cleanup_game(game);
+      game, job->scoring_detail != JSON_SCORING_NONE ? &scoring_report : NULL,
+      job->scoring_detail, elapsed_time);
+  session_release(game);
+  job->game = NULL;
+  ponder_enqueue(ponder);
 
   if (response_json) {
     LOG_INFO("Sending JSON response with a move (%zu bytes) HTTP 200",
              strlen(response_json));
-    send_json_response(request, 200, response_json);
-    free(response_json);
+    job->status = 200;
+    job->response_json = response_json;
+  } else {
+    LOG_ERROR("Internal error: Failed to serialize game state");
+    job->response_json = json_api_error_response("Failed to serialize game state");
+  }
+}
+
+/**
+ * Stage 3 of /gomoku/play: send the finished job's response and free it.
+ * Always runs on the event-loop thread.
+ */
+static void play_finish(play_job_t *job) {
+  if (job->batch) {
+    batch_element_finish(job);
+    return;
+  }
+  current_request = job->ctx;
+  if (job->response_len > 0) {
+    send_binary_response(job->request, job->status,
+                         (const unsigned char *)job->response_json,
+                         job->response_len);
+    free(job->response_json);
+  } else if (job->response_json) {
+    send_json_response(job->request, job->status, job->response_json);
+    free(job->response_json);
   } else {
-    handle_internal_error(request, "Failed to serialize game state");
+    send_json_response(job->request, job->status, job->fallback_body);
+  }
+  free(job);
+}
+
+//===============================================================================
+// BATCH ANALYSIS (/gomoku/analyze/batch)
+//===============================================================================
+
+/**
+ * Record one element's result: wrap it as
+ * {"index":N,"status":S,"result":...} and queue it for the chunk
+ * stream. On allocation failure the element is still counted as
+ * completed so the batch can finish; it is just absent from the output.
+ */
+static void batch_push_result(analyze_batch_t *batch, int index, int status,
+                              const char *result_json) {
+  batch->completed++;
+
+  if (!result_json) {
+    result_json = "{\"error\":\"Internal server error\"}";
   }
+  size_t len = strlen(result_json) + 64;
+  char *wrapped = malloc(len);
+  if (!wrapped) {
+    LOG_ERROR("  batch element %d dropped: allocation failed", index);
+    return;
+  }
+  snprintf(wrapped, len, "{\"index\":%d,\"status\":%d,\"result\":%s}", index,
+           status, result_json);
+
+  if (batch->ready_n == batch->ready_cap) {
+    int cap = batch->ready_cap ? batch->ready_cap * 2 : 16;
+    char **grown = realloc(batch->ready, (size_t)cap * sizeof(char *));
+    if (!grown) {
+      LOG_ERROR("  batch element %d dropped: allocation failed", index);
+      free(wrapped);
+      return;
+    }
+    batch->ready = grown;
+    batch->ready_cap = cap;
+  }
+  batch->ready[batch->ready_n++] = wrapped;
+}
+
+static void batch_chunk_done(struct http_request_s *request);
+
+/**
+ * Push the next piece of the chunked response out, one chunk per call:
+ * queued element results first (prefixed with '[' or ','), then the
+ * closing ']', then the zero-length terminator. Re-entered from
+ * batch_chunk_done after each write completes; a no-op while a write is
+ * in flight or results are still being computed.
+ */
+static void batch_pump(analyze_batch_t *batch) {
+  if (batch->writing) {
+    return;
+  }
+
+  if (batch->ready_n > 0) {
+    char *result = batch->ready[0];
+    batch->ready_n--;
+    memmove(&batch->ready[0], &batch->ready[1],
+            (size_t)batch->ready_n * sizeof(char *));
+
+    size_t len = strlen(result);
+    char *chunk = malloc(len + 2);
+    if (!chunk) {
+      LOG_ERROR("  batch chunk dropped: allocation failed");
+      free(result);
+      batch_pump(batch);
+      return;
+    }
+    chunk[0] = batch->started ? ',' : '[';
+    memcpy(chunk + 1, result, len + 1);
+    free(result);
+
+    struct http_response_s *response = http_response_init();
+    if (!batch->started) {
+      http_response_status(response, 200);
+      http_response_header(response, "Content-Type", "application/json");
+      http_response_header(response, "Access-Control-Allow-Origin", "*");
+      batch->started = 1;
+    }
+    batch->inflight = chunk;
+    batch->writing = 1;
+    http_response_body(response, chunk, (int)(len + 1));
+    http_respond_chunk(batch->request, response, batch_chunk_done);
+    return;
+  }
+
+  if (batch->completed < batch->total || batch->dispatching) {
+    return; // Results still being produced, or fan-out still in progress
+  }
+
+  if (!batch->closing) {
+    batch->closing = 1;
+    struct http_response_s *response = http_response_init();
+    if (!batch->started) {
+      // Every element was dropped on allocation failure; still deliver
+      // a well-formed (empty) array.
+      http_response_status(response, 200);
+      http_response_header(response, "Content-Type", "application/json");
+      http_response_header(response, "Access-Control-Allow-Origin", "*");
+      batch->started = 1;
+    }
+    batch->writing = 1;
+    http_response_body(response, "]", 1);
+    http_respond_chunk(batch->request, response, batch_chunk_done);
+    return;
+  }
+
+  // Closing bracket flushed: terminate the stream and log the request.
+  struct http_response_s *response = http_response_init();
+  http_request_set_userdata(batch->request, NULL);
+  http_respond_chunk_end(batch->request, response);
+
+  current_request = batch->ctx;
+  double elapsed_ms = (get_current_time() - batch->ctx.start_time) * 1000.0;
+  metrics_observe_request(batch->ctx.path, 200, elapsed_ms / 1000.0);
+  if (batch->ctx.trace_id[0] != '\0') {
+    LOG_INFO("%s %s 200 %.3fms batch=%d trace_id=%s", batch->ctx.client_ip,
+             batch->ctx.path, elapsed_ms, batch->total, batch->ctx.trace_id);
+  } else {
+    LOG_INFO("%s %s 200 %.3fms batch=%d", batch->ctx.client_ip, batch->ctx.path,
+             elapsed_ms, batch->total);
+  }
+  free(batch->ready);
+  free(batch);
+}
+
+static void batch_chunk_done(struct http_request_s *request) {
+  analyze_batch_t *batch = http_request_userdata(request);
+  batch->writing = 0;
+  free(batch->inflight);
+  batch->inflight = NULL;
+  // The write path restores the library's per-request timeout after each
+  // chunk; while elements are still computing, keep the worker allowance
+  // so a slow element can't kill the connection mid-stream.
+  if (batch->completed < batch->total) {
+    request->timeout = WORKER_REQUEST_TIMEOUT;
+  }
+  batch_pump(batch);
+}
+
+/**
+ * Join a finished element job back into its batch: queue the result and
+ * advance the stream. Always runs on the event-loop thread.
+ */
+static void batch_element_finish(play_job_t *job) {
+  analyze_batch_t *batch = job->batch;
+  current_request = batch->ctx;
+  batch_push_result(batch, job->batch_index, job->status,
+                    job->response_json ? job->response_json
+                                       : job->fallback_body);
+  free(job->response_json);
+  free(job);
+  batch_pump(batch);
 }
 
 void handle_not_found(struct http_request_s *request) {
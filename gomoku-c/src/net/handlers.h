@@ -25,6 +25,62 @@ void handlers_init(void);
  */
 void handlers_set_report_scoring(int enabled);
 
+/**
+ * Set the default deadline applied to /gomoku/play requests that carry
+ * no X-Deadline-Ms header (0 = none). When a worker picks up a queued
+ * request, the remaining deadline (minus a response margin) becomes the
+ * search's move_timeout, so queue wait degrades depth rather than
+ * producing balancer timeouts. Called once at startup (-D/--deadline-ms).
+ */
+void handlers_set_default_deadline_ms(int ms);
+
+/**
+ * Enable speculative pondering: after answering a session request whose
+ * opponent is human, idle workers pre-search the most plausible replies
+ * on the warm context so the findings sit in its transposition table
+ * when the real follow-up arrives. Ponder work always yields to queued
+ * requests. Only meaningful with both -g and -w; called once at startup
+ * (-p/--ponder).
+ */
+void handlers_set_ponder(int enabled);
+
+//===============================================================================
+// WORKER POOL (concurrent /gomoku/play handling)
+//===============================================================================
+
+/**
+ * Start `count` worker threads for AI computation. With workers running,
+ * handle_play parses and validates on the event-loop thread, dispatches
+ * the search to a worker, and the completed response is flushed back on
+ * the event-loop thread via handlers_drain_completions(). With count 0
+ * (the default) the daemon keeps its classic synchronous single-flight
+ * behavior.
+ *
+ * @param count Number of workers (0 = synchronous, capped at 32)
+ * @return 1 on success, 0 on thread-creation failure
+ */
+int handlers_start_workers(int count);
+
+/**
+ * Stop the worker threads and discard any jobs that have not been
+ * dispatched. Called once at daemon shutdown, before game_pool_drain().
+ */
+void handlers_stop_workers(void);
+
+/**
+ * Send the responses of finished jobs. Must be called from the
+ * event-loop thread (httpserver.h request/response objects are not
+ * thread-safe); main.c calls it after every http_server_poll.
+ */
+void handlers_drain_completions(void);
+
+/**
+ * Number of accepted /gomoku/play requests not yet responded to
+ * (queued, computing, or awaiting drain). The main loop shortens its
+ * poll timeout while this is nonzero so completions flush promptly.
+ */
+int handlers_inflight(void);
+
 //===============================================================================
 // BUSY STATUS (for HAProxy agent-check)
 //===============================================================================
@@ -37,6 +93,14 @@ void handlers_set_report_scoring(int enabled);
  */
 int handlers_is_busy(void);
 
+/**
+ * Fraction of request capacity still free, 0-100, for HAProxy weighting.
+ * With a worker pool this is the unused share of the admission budget
+ * (running slots plus the bounded queue); in synchronous mode it is
+ * binary 100/0. 0 coincides with handlers_is_busy() reporting busy.
+ */
+int handlers_capacity_pct(void);
+
 /**
  * Mark the server as busy (starting to process a request).
  * Called internally by handle_play before AI computation.
@@ -83,6 +147,17 @@ void handle_health(struct http_request_s *request);
  */
 void handle_ready(struct http_request_s *request);
 
+/**
+ * Handle GET /metrics endpoint.
+ * Returns counters and histograms in the Prometheus text exposition
+ * format: request latency by endpoint, search time and positions,
+ * transposition probe/hit counts, per-evaluator scoring timings, and
+ * queue gauges. See metrics.h for what is recorded where.
+ *
+ * @param request The HTTP request
+ */
+void handle_metrics(struct http_request_s *request);
+
 /**
  * Handle POST /gomoku/play endpoint.
  * Receives game state JSON, makes AI move, returns updated JSON.
@@ -91,6 +166,19 @@ void handle_ready(struct http_request_s *request);
  */
 void handle_play(struct http_request_s *request);
 
+/**
+ * Handle POST /gomoku/analyze/batch endpoint.
+ * Receives a JSON array of game states, fans them out across the worker
+ * pool, and streams a chunked JSON array of results back in completion
+ * order. Each result carries the "index" of the position it answers:
+ * {"index":N,"status":200,"result":{...game...}} on success, or a 4xx/5xx
+ * status with {"error":...} as the result. In synchronous mode (no
+ * workers) positions are computed one after another on the loop thread.
+ *
+ * @param request The HTTP request
+ */
+void handle_analyze_batch(struct http_request_s *request);
+
 /**
  * Handle 404 Not Found responses.
  *
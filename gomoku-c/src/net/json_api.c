@@ -7,9 +7,12 @@
 #include "ai.h"
 #include "board.h"
 #include "game.h"
+#include "game_pool.h"
+#include "session.h"
 #include "gomoku.h"
 #include "json.h"
 #include <ctype.h>
+#include <stdarg.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -19,15 +22,16 @@
 // INTERNAL HELPERS
 //===============================================================================
 
-/**
- * Helper to create a JSON number string with exactly 3 decimal places for
- * milliseconds
- */
-static json_object *json_ms_from_seconds(double seconds) {
-  char buf[32];
-  double ms = round(seconds * 1000000.0) / 1000.0; // Round to microseconds
-  snprintf(buf, sizeof(buf), "%.3f", ms);
-  return json_object_new_double_s(atof(buf), buf);
+// Transposition table size for games built by this API, settable once at
+// startup from the --tt-size daemon flag (0 = engine default).
+static int tt_size_mb_default = 0;
+
+void json_api_set_tt_size_mb(int mb) {
+  tt_size_mb_default = mb;
+}
+
+int json_api_tt_size_mb(void) {
+  return tt_size_mb_default;
 }
 
 static int column_index_from_char(char c) {
@@ -114,10 +118,664 @@ static int parse_player_config(json_object *player_obj, player_type_t *type,
   return 1;
 }
 
+//===============================================================================
+// STREAMING REQUEST PARSER
+//===============================================================================
+//
+// A /gomoku/play request has a small fixed schema, but the json-c tokener
+// builds a DOM node per field — a full move list is ~361 objects — and for
+// opening-phase moves at low depth that parse used to cost more than the
+// search itself. The scanner below fills a play_request_t straight from the
+// body buffer with no intermediate tree. It is deliberately conservative:
+// anything it does not recognise — an escape sequence, an unexpected type
+// for a known field, a legacy [x,y] coordinate pair — makes it bail out and
+// the caller re-parses with the tokener, which also owns all error
+// reporting. The fast path never produces an error message of its own.
+
+typedef struct {
+  int board_size;
+  char session_id[SESSION_ID_MAX];
+  player_type_t player_x_type;
+  player_type_t player_o_type;
+  int depth_x;
+  int depth_o;
+  int radius;
+  int timeout;
+  int enable_undo;
+  int max_undo_allowed;
+  int multipv;
+  int move_count;
+  move_history_t moves[MAX_MOVE_HISTORY];
+} play_request_t;
+
+static void request_defaults(play_request_t *req) {
+  req->board_size = 19;
+  req->session_id[0] = '\0';
+  req->player_x_type = PLAYER_TYPE_HUMAN;
+  req->player_o_type = PLAYER_TYPE_AI;
+  req->depth_x = -1;
+  req->depth_o = -1;
+  req->radius = 3;
+  req->timeout = 0;
+  req->enable_undo = 1;
+  req->max_undo_allowed = 5;
+  req->multipv = 1;
+  req->move_count = 0;
+}
+
+static void fp_ws(const char **p) {
+  while (isspace((unsigned char)**p)) {
+    (*p)++;
+  }
+}
+
+// Copy a JSON string into out. Fails (returns 0) on escapes or overflow so
+// the caller can fall back; out always holds what was copied so far.
+static int fp_string(const char **p, char *out, size_t cap) {
+  if (**p != '"') {
+    return 0;
+  }
+  (*p)++;
+  size_t n = 0;
+  while (**p && **p != '"') {
+    if (**p == '\\' || n + 1 >= cap) {
+      return 0;
+    }
+    out[n++] = *(*p)++;
+  }
+  if (**p != '"') {
+    return 0;
+  }
+  (*p)++;
+  out[n] = '\0';
+  return 1;
+}
+
+static int fp_skip_string(const char **p) {
+  if (**p != '"') {
+    return 0;
+  }
+  (*p)++;
+  while (**p && **p != '"') {
+    if (**p == '\\' && (*p)[1]) {
+      (*p)++;
+    }
+    (*p)++;
+  }
+  if (**p != '"') {
+    return 0;
+  }
+  (*p)++;
+  return 1;
+}
+
+// Parse a JSON number. is_int is cleared when the literal has a fraction or
+// exponent, matching the tokener's int/double type split that the timeout
+// and undo_limit fields depend on.
+static int fp_number(const char **p, double *out, int *is_int) {
+  char *end = NULL;
+  double v = strtod(*p, &end);
+  if (end == *p) {
+    return 0;
+  }
+  *is_int = 1;
+  for (const char *q = *p; q < end; q++) {
+    if (*q == '.' || *q == 'e' || *q == 'E') {
+      *is_int = 0;
+      break;
+    }
+  }
+  *p = end;
+  *out = v;
+  return 1;
+}
+
+// Skip any well-formed JSON value (used for fields both parsers ignore).
+static int fp_skip_value(const char **p, int depth) {
+  if (depth > 32) {
+    return 0;
+  }
+  fp_ws(p);
+  switch (**p) {
+  case '"':
+    return fp_skip_string(p);
+  case '{':
+  case '[': {
+    char close = (**p == '{') ? '}' : ']';
+    int object = (**p == '{');
+    (*p)++;
+    fp_ws(p);
+    if (**p == close) {
+      (*p)++;
+      return 1;
+    }
+    for (;;) {
+      if (object) {
+        fp_ws(p);
+        if (!fp_skip_string(p)) {
+          return 0;
+        }
+        fp_ws(p);
+        if (**p != ':') {
+          return 0;
+        }
+        (*p)++;
+      }
+      if (!fp_skip_value(p, depth + 1)) {
+        return 0;
+      }
+      fp_ws(p);
+      if (**p == ',') {
+        (*p)++;
+        continue;
+      }
+      if (**p == close) {
+        (*p)++;
+        return 1;
+      }
+      return 0;
+    }
+  }
+  case 't':
+    if (strncmp(*p, "true", 4) != 0) {
+      return 0;
+    }
+    *p += 4;
+    return 1;
+  case 'f':
+    if (strncmp(*p, "false", 5) != 0) {
+      return 0;
+    }
+    *p += 5;
+    return 1;
+  case 'n':
+    if (strncmp(*p, "null", 4) != 0) {
+      return 0;
+    }
+    *p += 4;
+    return 1;
+  default: {
+    double v;
+    int is_int;
+    return fp_number(p, &v, &is_int);
+  }
+  }
+}
+
+// Parse {"player": "AI"|"human", "depth": N}. have_player mirrors the
+// "Missing required field: X.player" check in the DOM path — when the key
+// is absent the caller falls back so the tokener raises that error.
+static int fp_player(const char **p, player_type_t *type, int *depth,
+                     int *have_player) {
+  fp_ws(p);
+  if (**p != '{') {
+    return 0;
+  }
+  (*p)++;
+  fp_ws(p);
+  if (**p == '}') {
+    (*p)++;
+    return 1;
+  }
+  for (;;) {
+    char key[24];
+    fp_ws(p);
+    if (!fp_string(p, key, sizeof(key))) {
+      return 0;
+    }
+    fp_ws(p);
+    if (**p != ':') {
+      return 0;
+    }
+    (*p)++;
+    fp_ws(p);
+    if (strcmp(key, "player") == 0) {
+      char name[16];
+      if (!fp_string(p, name, sizeof(name))) {
+        return 0;
+      }
+      if (strcasecmp(name, "AI") == 0) {
+        *type = PLAYER_TYPE_AI;
+      } else if (strcasecmp(name, "human") == 0) {
+        *type = PLAYER_TYPE_HUMAN;
+      } else {
+        return 0; // invalid value: tokener path owns the error message
+      }
+      *have_player = 1;
+    } else if (strcmp(key, "depth") == 0) {
+      double v;
+      int is_int;
+      if (!fp_number(p, &v, &is_int)) {
+        return 0;
+      }
+      *depth = (int)v;
+    } else if (!fp_skip_value(p, 0)) {
+      return 0;
+    }
+    fp_ws(p);
+    if (**p == ',') {
+      (*p)++;
+      continue;
+    }
+    if (**p == '}') {
+      (*p)++;
+      return 1;
+    }
+    return 0;
+  }
+}
+
+// Parse one element of the moves array. Mirrors the DOM walk exactly: the
+// position is the last string value under a key starting with X or O that
+// survives notation_to_coord, per-move stats are picked up by name, and a
+// move that never resolves to a coordinate is silently dropped.
+static int fp_move(const char **p, play_request_t *req) {
+  fp_ws(p);
+  if (**p != '{') {
+    return 0;
+  }
+  (*p)++;
+  int x = -1, y = -1;
+  int player = 0;
+  double time_taken = 0;
+  int positions_evaluated = 0;
+  int own_score = 0;
+  int opponent_score = 0;
+  double queue_wait_ms = 0;
+  fp_ws(p);
+  if (**p == '}') {
+    (*p)++;
+    return 1;
+  }
+  for (;;) {
+    char key[32];
+    fp_ws(p);
+    if (!fp_string(p, key, sizeof(key))) {
+      return 0;
+    }
+    fp_ws(p);
+    if (**p != ':') {
+      return 0;
+    }
+    (*p)++;
+    fp_ws(p);
+    if (**p == '"') {
+      char coord[16];
+      if (!fp_string(p, coord, sizeof(coord))) {
+        return 0;
+      }
+      int cx, cy;
+      if (notation_to_coord(coord, req->board_size, &cx, &cy)) {
+        if (key[0] == 'X') {
+          x = cx;
+          y = cy;
+          player = AI_CELL_CROSSES;
+        } else if (key[0] == 'O') {
+          x = cx;
+          y = cy;
+          player = AI_CELL_NAUGHTS;
+        }
+      }
+      // A string value under a stats key would coerce through the DOM
+      // path; it never happens in practice, so just fall back.
+      if (strcmp(key, "time_ms") == 0 || strcmp(key, "queue_wait_ms") == 0 ||
+          strcmp(key, "moves_evaluated") == 0 ||
+          strcmp(key, "moves_searched") == 0 || strcmp(key, "score") == 0 ||
+          strcmp(key, "opponent") == 0) {
+        return 0;
+      }
+    } else if (strcmp(key, "time_ms") == 0) {
+      double v;
+      int is_int;
+      if (!fp_number(p, &v, &is_int)) {
+        return 0;
+      }
+      time_taken = v / 1000.0;
+    } else if (strcmp(key, "queue_wait_ms") == 0) {
+      double v;
+      int is_int;
+      if (!fp_number(p, &v, &is_int)) {
+        return 0;
+      }
+      queue_wait_ms = v;
+    } else if (strcmp(key, "moves_evaluated") == 0 ||
+               strcmp(key, "moves_searched") == 0) {
+      double v;
+      int is_int;
+      if (!fp_number(p, &v, &is_int)) {
+        return 0;
+      }
+      positions_evaluated = (int)v;
+    } else if (strcmp(key, "score") == 0) {
+      double v;
+      int is_int;
+      if (!fp_number(p, &v, &is_int)) {
+        return 0;
+      }
+      own_score = (int)v;
+    } else if (strcmp(key, "opponent") == 0) {
+      double v;
+      int is_int;
+      if (!fp_number(p, &v, &is_int)) {
+        return 0;
+      }
+      opponent_score = (int)v;
+    } else if (**p == '[') {
+      return 0; // legacy [x,y] coordinate pair: rare, let the tokener do it
+    } else if (!fp_skip_value(p, 0)) {
+      return 0;
+    }
+    fp_ws(p);
+    if (**p == ',') {
+      (*p)++;
+      continue;
+    }
+    if (**p == '}') {
+      (*p)++;
+      break;
+    }
+    return 0;
+  }
+  if (x >= 0 && y >= 0 && player != 0) {
+    if (req->move_count >= MAX_MOVE_HISTORY) {
+      return 0; // overflow: tokener path raises the proper error
+    }
+    move_history_t *mv = &req->moves[req->move_count++];
+    memset(mv, 0, sizeof(*mv));
+    mv->x = x;
+    mv->y = y;
+    mv->player = player;
+    mv->time_taken = time_taken;
+    mv->positions_evaluated = positions_evaluated;
+    mv->own_score = own_score;
+    mv->opponent_score = opponent_score;
+    mv->queue_wait_ms = (queue_wait_ms > 0) ? queue_wait_ms : 0;
+  }
+  return 1;
+}
+
+// Fill req from the request body without building a DOM. Returns 1 when the
+// whole request was understood; 0 means "re-parse with the tokener" and
+// carries no judgement about validity.
+static int fast_parse_request(const char *s, play_request_t *req) {
+  request_defaults(req);
+  const char *p = s;
+  int have_x = 0, have_o = 0;
+  int have_x_player = 0, have_o_player = 0;
+  fp_ws(&p);
+  if (*p != '{') {
+    return 0;
+  }
+  p++;
+  fp_ws(&p);
+  if (*p == '}') {
+    return 0; // empty request: missing X/O, let the tokener report it
+  }
+  for (;;) {
+    char key[32];
+    fp_ws(&p);
+    if (!fp_string(&p, key, sizeof(key))) {
+      return 0;
+    }
+    fp_ws(&p);
+    if (*p != ':') {
+      return 0;
+    }
+    p++;
+    fp_ws(&p);
+    if (strcmp(key, "board_size") == 0) {
+      double v;
+      int is_int;
+      if (!fp_number(&p, &v, &is_int) || !is_int) {
+        return 0;
+      }
+      req->board_size = (int)v;
+      if (req->board_size != 15 && req->board_size != 19) {
+        return 0; // invalid size: tokener path owns the error message
+      }
+    } else if (strcmp(key, "session_id") == 0) {
+      if (*p == '"') {
+        if (!fp_string(&p, req->session_id, sizeof(req->session_id))) {
+          return 0;
+        }
+      } else if (!fp_skip_value(&p, 0)) {
+        return 0;
+      }
+    } else if (strcmp(key, "X") == 0) {
+      if (!fp_player(&p, &req->player_x_type, &req->depth_x, &have_x_player)) {
+        return 0;
+      }
+      have_x = 1;
+    } else if (strcmp(key, "O") == 0) {
+      if (!fp_player(&p, &req->player_o_type, &req->depth_o, &have_o_player)) {
+        return 0;
+      }
+      have_o = 1;
+    } else if (strcmp(key, "radius") == 0) {
+      double v;
+      int is_int;
+      if (!fp_number(&p, &v, &is_int)) {
+        return 0;
+      }
+      req->radius = (int)v;
+    } else if (strcmp(key, "timeout") == 0) {
+      double v;
+      int is_int;
+      if (*p == '"') {
+        // "none" (or any string) leaves timeout at 0, as the DOM path does
+        if (!fp_skip_string(&p)) {
+          return 0;
+        }
+      } else if (fp_number(&p, &v, &is_int)) {
+        if (is_int) {
+          req->timeout = (int)v;
+        }
+      } else {
+        return 0;
+      }
+    } else if (strcmp(key, "undo") == 0) {
+      if (strncmp(p, "true", 4) == 0) {
+        req->enable_undo = 1;
+        p += 4;
+      } else if (strncmp(p, "false", 5) == 0) {
+        req->enable_undo = 0;
+        p += 5;
+      } else if (!fp_skip_value(&p, 0)) {
+        return 0;
+      }
+    } else if (strcmp(key, "undo_limit") == 0) {
+      double v;
+      int is_int;
+      if (!fp_number(&p, &v, &is_int)) {
+        return 0;
+      }
+      if (is_int && (int)v >= 0) {
+        req->max_undo_allowed = (int)v;
+      }
+    } else if (strcmp(key, "multipv") == 0) {
+      double v;
+      int is_int;
+      if (!fp_number(&p, &v, &is_int)) {
+        return 0;
+      }
+      if (is_int) {
+        req->multipv = (int)v;
+        if (req->multipv < 1) {
+          req->multipv = 1;
+        }
+        if (req->multipv > MULTIPV_MAX) {
+          req->multipv = MULTIPV_MAX;
+        }
+      }
+    } else if (strcmp(key, "moves") == 0) {
+      if (*p != '[') {
+        return 0;
+      }
+      p++;
+      fp_ws(&p);
+      if (*p == ']') {
+        p++;
+      } else {
+        for (;;) {
+          if (!fp_move(&p, req)) {
+            return 0;
+          }
+          fp_ws(&p);
+          if (*p == ',') {
+            p++;
+            continue;
+          }
+          if (*p == ']') {
+            p++;
+            break;
+          }
+          return 0;
+        }
+      }
+    } else if (!fp_skip_value(&p, 0)) {
+      return 0;
+    }
+    fp_ws(&p);
+    if (*p == ',') {
+      p++;
+      continue;
+    }
+    if (*p == '}') {
+      break;
+    }
+    return 0;
+  }
+  return have_x && have_o && have_x_player && have_o_player;
+}
+
 //===============================================================================
 // PUBLIC FUNCTIONS - PARSING
 //===============================================================================
 
+// Check out a game context and load the request into it. Shared tail of
+// both the streaming and the DOM parser; error messages here are the ones
+// the DOM path has always produced.
+static game_state_t *build_game_from_request(play_request_t *req,
+                                             char *error_msg,
+                                             size_t error_msg_len) {
+  if (req->radius > API_MAX_RADIUS) {
+    req->radius = API_MAX_RADIUS;
+  }
+  if (req->radius < 1) {
+    req->radius = 1;
+  }
+  if (req->depth_x > API_MAX_DEPTH) {
+    req->depth_x = API_MAX_DEPTH;
+  }
+  if (req->depth_o > API_MAX_DEPTH) {
+    req->depth_o = API_MAX_DEPTH;
+  }
+
+  cli_config_t config = {
+      .board_size = req->board_size,
+      .max_depth = API_MAX_DEPTH,
+      .move_timeout = req->timeout,
+      .show_help = 0,
+      .invalid_args = 0,
+      .enable_undo = req->enable_undo,
+      .max_undo_allowed = req->max_undo_allowed,
+      .skip_welcome = 1,
+      .headless = 1, // Daemon mode - no stdout output
+      .stateless_mode = 1,
+      .search_radius = req->radius,
+      .leaf_radius = 2,
+      .json_file = "",
+      .replay_file = "",
+      .replay_wait = 0,
+      .player_x_type = req->player_x_type,
+      .player_o_type = req->player_o_type,
+      .depth_x = (req->depth_x > 0) ? req->depth_x : API_MAX_DEPTH,
+      .depth_o = (req->depth_o > 0) ? req->depth_o : API_MAX_DEPTH,
+      .player_x_explicit = 1,
+      .player_o_explicit = 1,
+      .tt_size_mb = tt_size_mb_default,
+      .multipv = req->multipv,
+  };
+
+  // Check out a context: the warm one stored under the session id when
+  // its history is a prefix of the incoming list, else a pooled one.
+  game_state_t *game = NULL;
+  int replay_from = -1;
+  if (req->session_id[0]) {
+    game = session_take(req->session_id);
+    if (game) {
+      int prefix = game->board_size == req->board_size &&
+                   game->config.search_radius == req->radius &&
+                   game->game_state == GAME_RUNNING &&
+                   game->move_history_count <= req->move_count;
+      for (int i = 0; prefix && i < game->move_history_count; i++) {
+        if (game->move_history[i].x != req->moves[i].x ||
+            game->move_history[i].y != req->moves[i].y ||
+            game->move_history[i].player != req->moves[i].player) {
+          prefix = 0;
+        }
+      }
+      if (prefix) {
+        replay_from = game->move_history_count;
+        // Per-request knobs (depth, timeout, multipv...) may change
+        // between moves; board_size and search_radius were just checked
+        // equal, so the derived caches stay valid under the new config.
+        game->config = config;
+      } else {
+        // Undo, a restart, or a different game reusing the id: rebuild.
+        reinit_game(game, config);
+      }
+    }
+  }
+  if (!game) {
+    game = game_pool_acquire(config);
+  }
+  if (!game) {
+    snprintf(error_msg, error_msg_len, "Failed to initialize game state");
+    return NULL;
+  }
+  if (req->session_id[0]) {
+    session_loan(req->session_id, game);
+  }
+
+  if (replay_from >= 0) {
+    // Warm path: replay only the new moves through make_move, keeping
+    // the transposition table, killer/history tables and cross-turn VCT
+    // carry-over the previous request populated.
+    for (int i = replay_from; i < req->move_count; i++) {
+      const move_history_t *mv = &req->moves[i];
+      if (!make_move(game, mv->x, mv->y, mv->player, mv->time_taken,
+                     mv->positions_evaluated, mv->own_score,
+                     mv->opponent_score)) {
+        snprintf(error_msg, error_msg_len, "Invalid move at position [%d, %d]",
+                 mv->x, mv->y);
+        session_release(game);
+        return NULL;
+      }
+      game->move_history[game->move_history_count - 1].queue_wait_ms =
+          mv->queue_wait_ms;
+    }
+  } else {
+    // Apply the batch: one rebuild + one terminal check for the whole game
+    int bad_index = -1;
+    if (!bulk_load_moves(game, req->moves, req->move_count, &bad_index)) {
+      snprintf(error_msg, error_msg_len, "Invalid move at position [%d, %d]",
+               req->moves[bad_index].x, req->moves[bad_index].y);
+      session_release(game);
+      return NULL;
+    }
+  }
+
+  // Set current player to opposite of last move
+  if (game->move_history_count > 0) {
+    int last_player = game->move_history[game->move_history_count - 1].player;
+    game->current_player =
+        (last_player == AI_CELL_CROSSES) ? AI_CELL_NAUGHTS : AI_CELL_CROSSES;
+  }
+
+  return game;
+}
+
 game_state_t *json_api_parse_game(const char *json_str, char *error_msg,
                                   size_t error_msg_len) {
   if (!json_str || !error_msg) {
@@ -129,19 +787,27 @@ game_state_t *json_api_parse_game(const char *json_str, char *error_msg,
 
   error_msg[0] = '\0';
 
+  // Fast path: fill the request straight from the body buffer. A zero
+  // return means "didn't understand it", not "invalid" — the tokener
+  // below re-parses and produces all error messages.
+  play_request_t req;
+  if (fast_parse_request(json_str, &req)) {
+    return build_game_from_request(&req, error_msg, error_msg_len);
+  }
+
   // Parse JSON string
   json_object *root = json_tokener_parse(json_str);
   if (!root) {
     snprintf(error_msg, error_msg_len, "Invalid JSON syntax");
     return NULL;
   }
+  request_defaults(&req);
 
   // Parse board size (optional, defaults to 19)
   json_object *board_obj;
-  int board_size = 19;
   if (json_object_object_get_ex(root, "board_size", &board_obj)) {
-    board_size = json_object_get_int(board_obj);
-    if (board_size != 15 && board_size != 19) {
+    req.board_size = json_object_get_int(board_obj);
+    if (req.board_size != 15 && req.board_size != 19) {
       snprintf(error_msg, error_msg_len,
                "Invalid board size: must be 15 or 19");
       json_object_put(root);
@@ -149,12 +815,19 @@ game_state_t *json_api_parse_game(const char *json_str, char *error_msg,
     }
   }
 
-  // Parse player configurations (required)
-  player_type_t player_x_type = PLAYER_TYPE_HUMAN;
-  player_type_t player_o_type = PLAYER_TYPE_AI;
-  int depth_x = -1;
-  int depth_o = -1;
+  // Parse session id (optional): opaque client key for the warm-context
+  // store. Ignored unless the daemon runs with -g/--sessions.
+  json_object *session_obj;
+  if (json_object_object_get_ex(root, "session_id", &session_obj) &&
+      json_object_is_type(session_obj, json_type_string)) {
+    const char *sid = json_object_get_string(session_obj);
+    if (sid && sid[0] && strlen(sid) < SESSION_ID_MAX) {
+      strncpy(req.session_id, sid, SESSION_ID_MAX - 1);
+      req.session_id[SESSION_ID_MAX - 1] = '\0';
+    }
+  }
 
+  // Parse player configurations (required)
   json_object *x_obj, *o_obj;
   if (!json_object_object_get_ex(root, "X", &x_obj)) {
     snprintf(error_msg, error_msg_len, "Missing required field: X");
@@ -179,61 +852,43 @@ game_state_t *json_api_parse_game(const char *json_str, char *error_msg,
     return NULL;
   }
 
-  if (!parse_player_config(x_obj, &player_x_type, &depth_x, error_msg,
+  if (!parse_player_config(x_obj, &req.player_x_type, &req.depth_x, error_msg,
                            error_msg_len)) {
     json_object_put(root);
     return NULL;
   }
-  if (!parse_player_config(o_obj, &player_o_type, &depth_o, error_msg,
+  if (!parse_player_config(o_obj, &req.player_o_type, &req.depth_o, error_msg,
                            error_msg_len)) {
     json_object_put(root);
     return NULL;
   }
 
-  // Parse radius (cap to API_MAX_RADIUS).
+  // Parse radius (capped to API_MAX_RADIUS by the builder).
   // Fallback matches the TUI CLI default in cli.c so a missing `radius`
   // field doesn't silently weaken the AI relative to the command-line
   // binary. "Radius" means "candidate moves within N empty cells of ANY
   // non-empty cell on the board" (not just the last move) — see
   // generate_moves_optimized in ai.c.
-  int radius = 3;
   json_object *radius_obj;
   if (json_object_object_get_ex(root, "radius", &radius_obj)) {
-    radius = json_object_get_int(radius_obj);
-    if (radius > API_MAX_RADIUS) {
-      radius = API_MAX_RADIUS;
-    }
-    if (radius < 1) {
-      radius = 1;
-    }
-  }
-
-  // Cap depths to API_MAX_DEPTH
-  if (depth_x > API_MAX_DEPTH) {
-    depth_x = API_MAX_DEPTH;
-  }
-  if (depth_o > API_MAX_DEPTH) {
-    depth_o = API_MAX_DEPTH;
+    req.radius = json_object_get_int(radius_obj);
   }
 
   // Parse timeout
-  int timeout = 0;
   json_object *timeout_obj;
   if (json_object_object_get_ex(root, "timeout", &timeout_obj)) {
     if (json_object_is_type(timeout_obj, json_type_int)) {
-      timeout = json_object_get_int(timeout_obj);
+      req.timeout = json_object_get_int(timeout_obj);
     }
     // "none" string results in timeout = 0
   }
 
   // Parse undo (optional): enable/disable undo; total undo moves per game
   // (default 5)
-  int enable_undo = 1;
-  int max_undo_allowed = 5;
   json_object *undo_obj;
   if (json_object_object_get_ex(root, "undo", &undo_obj)) {
     if (json_object_is_type(undo_obj, json_type_boolean)) {
-      enable_undo = json_object_get_boolean(undo_obj) ? 1 : 0;
+      req.enable_undo = json_object_get_boolean(undo_obj) ? 1 : 0;
     }
   }
   json_object *undo_limit_obj;
@@ -241,43 +896,27 @@ game_state_t *json_api_parse_game(const char *json_str, char *error_msg,
       json_object_is_type(undo_limit_obj, json_type_int)) {
     int n = json_object_get_int(undo_limit_obj);
     if (n >= 0) {
-      max_undo_allowed = n;
+      req.max_undo_allowed = n;
     }
   }
 
-  // Create cli_config for game initialization
-  cli_config_t config = {
-      .board_size = board_size,
-      .max_depth = API_MAX_DEPTH,
-      .move_timeout = timeout,
-      .show_help = 0,
-      .invalid_args = 0,
-      .enable_undo = enable_undo,
-      .max_undo_allowed = max_undo_allowed,
-      .skip_welcome = 1,
-      .headless = 1, // Daemon mode - no stdout output
-      .stateless_mode = 1,
-      .search_radius = radius,
-      .json_file = "",
-      .replay_file = "",
-      .replay_wait = 0,
-      .player_x_type = player_x_type,
-      .player_o_type = player_o_type,
-      .depth_x = (depth_x > 0) ? depth_x : API_MAX_DEPTH,
-      .depth_o = (depth_o > 0) ? depth_o : API_MAX_DEPTH,
-      .player_x_explicit = 1,
-      .player_o_explicit = 1,
-  };
-
-  // Initialize game state
-  game_state_t *game = init_game(config);
-  if (!game) {
-    snprintf(error_msg, error_msg_len, "Failed to initialize game state");
-    json_object_put(root);
-    return NULL;
+  // Parse multipv (optional): analysis mode returning the top-K root
+  // lines instead of just playing the single best move (default 1)
+  json_object *multipv_obj;
+  if (json_object_object_get_ex(root, "multipv", &multipv_obj) &&
+      json_object_is_type(multipv_obj, json_type_int)) {
+    req.multipv = json_object_get_int(multipv_obj);
+    if (req.multipv < 1) {
+      req.multipv = 1;
+    }
+    if (req.multipv > MULTIPV_MAX) {
+      req.multipv = MULTIPV_MAX;
+    }
   }
 
-  // Parse and replay moves
+  // Parse the move list into the request batch — session reuse in the
+  // builder needs to compare it against a stored history before any
+  // context is chosen.
   json_object *moves_obj;
   if (json_object_object_get_ex(root, "moves", &moves_obj)) {
     int num_moves = json_object_array_length(moves_obj);
@@ -300,7 +939,7 @@ game_state_t *json_api_parse_game(const char *json_str, char *error_msg,
         // Check for position value (preferred string notation, legacy array)
         if (json_object_is_type(val, json_type_string)) {
           const char *coord = json_object_get_string(val);
-          if (!notation_to_coord(coord, board_size, &x, &y)) {
+          if (!notation_to_coord(coord, req.board_size, &x, &y)) {
             continue;
           }
           if (key[0] == 'X') {
@@ -332,104 +971,368 @@ game_state_t *json_api_parse_game(const char *json_str, char *error_msg,
         }
       }
 
-      // Validate and make move
+      // Collect the move (a board can hold at most 361 stones, so a
+      // list that overflows the batch is invalid by construction)
       if (x >= 0 && y >= 0 && player != 0) {
-        if (!make_move(game, x, y, player, time_taken, positions_evaluated,
-                       own_score, opponent_score)) {
+        if (req.move_count >= MAX_MOVE_HISTORY) {
           snprintf(error_msg, error_msg_len,
                    "Invalid move at position [%d, %d]", x, y);
-          cleanup_game(game);
           json_object_put(root);
           return NULL;
         }
-        // Preserve queue_wait_ms from client
-        if (queue_wait_ms > 0 && game->move_history_count > 0) {
-          game->move_history[game->move_history_count - 1].queue_wait_ms =
-              queue_wait_ms;
-        }
+        move_history_t *mv = &req.moves[req.move_count++];
+        memset(mv, 0, sizeof(*mv));
+        mv->x = x;
+        mv->y = y;
+        mv->player = player;
+        mv->time_taken = time_taken;
+        mv->positions_evaluated = positions_evaluated;
+        mv->own_score = own_score;
+        mv->opponent_score = opponent_score;
+        mv->queue_wait_ms = (queue_wait_ms > 0) ? queue_wait_ms : 0;
       }
     }
   }
 
-  // Check game state after replaying moves
-  check_game_state(game);
+  json_object_put(root);
+  return build_game_from_request(&req, error_msg, error_msg_len);
+}
 
-  // Set current player to opposite of last move
-  if (game->move_history_count > 0) {
-    int last_player = game->move_history[game->move_history_count - 1].player;
-    game->current_player =
-        (last_player == AI_CELL_CROSSES) ? AI_CELL_NAUGHTS : AI_CELL_CROSSES;
+char **json_api_split_array(const char *json_str, int *out_count,
+                            char *error_msg, size_t error_msg_len) {
+  *out_count = 0;
+
+  json_object *root = json_tokener_parse(json_str);
+  if (!root) {
+    snprintf(error_msg, error_msg_len, "Invalid JSON syntax");
+    return NULL;
+  }
+
+  if (!json_object_is_type(root, json_type_array)) {
+    snprintf(error_msg, error_msg_len, "Batch request must be a JSON array");
+    json_object_put(root);
+    return NULL;
+  }
+
+  int count = (int)json_object_array_length(root);
+  if (count == 0) {
+    snprintf(error_msg, error_msg_len, "Batch array is empty");
+    json_object_put(root);
+    return NULL;
+  }
+
+  char **items = calloc((size_t)count, sizeof(char *));
+  if (!items) {
+    snprintf(error_msg, error_msg_len, "Memory allocation failed");
+    json_object_put(root);
+    return NULL;
+  }
+
+  for (int i = 0; i < count; i++) {
+    json_object *elem = json_object_array_get_idx(root, i);
+    const char *elem_str =
+        json_object_to_json_string_ext(elem, JSON_C_TO_STRING_PLAIN);
+    items[i] = strdup(elem_str ? elem_str : "null");
+    if (!items[i]) {
+      for (int j = 0; j < i; j++) {
+        free(items[j]);
+      }
+      free(items);
+      snprintf(error_msg, error_msg_len, "Memory allocation failed");
+      json_object_put(root);
+      return NULL;
+    }
   }
 
   json_object_put(root);
-  return game;
+  *out_count = count;
+  return items;
 }
 
 //===============================================================================
 // PUBLIC FUNCTIONS - SERIALIZATION
 //===============================================================================
 
+//===============================================================================
+// APPEND-STYLE JSON WRITER
+//===============================================================================
+//
+// Responses have a fixed shape, so serialization doesn't need a json-c
+// DOM: these helpers append directly into a per-thread scratch buffer
+// that is reused across requests (it grows to the largest response the
+// thread has produced and stays there). The only allocation left per
+// response is the exact-size copy handed to the caller — the response
+// outlives this thread's next request once it's queued for the event
+// loop, so the scratch itself can't be handed out.
+//
+// The output mirrors json-c's JSON_C_TO_STRING_PRETTY formatting (two
+// spaces per depth, no space after ':') so response bodies look the
+// same as they did when the DOM built them.
+
+typedef struct {
+  char *buf;
+  size_t len;
+  size_t cap;
+  int oom; // A failed grow poisons the writer; checked once at the end
+} json_writer_t;
+
+static __thread json_writer_t t_writer;
+
+static int jw_reserve(json_writer_t *w, size_t need) {
+  if (w->oom) {
+    return 0;
+  }
+  if (w->len + need + 1 <= w->cap) {
+    return 1;
+  }
+  size_t cap = w->cap ? w->cap : 4096;
+  while (cap < w->len + need + 1) {
+    cap *= 2;
+  }
+  char *grown = realloc(w->buf, cap);
+  if (!grown) {
+    w->oom = 1;
+    return 0;
+  }
+  w->buf = grown;
+  w->cap = cap;
+  return 1;
+}
+
+static void jw_putc(json_writer_t *w, char c) {
+  if (jw_reserve(w, 1)) {
+    w->buf[w->len++] = c;
+  }
+}
+
+static void jw_puts(json_writer_t *w, const char *s) {
+  size_t n = strlen(s);
+  if (jw_reserve(w, n)) {
+    memcpy(w->buf + w->len, s, n);
+    w->len += n;
+  }
+}
+
+static void jw_printf(json_writer_t *w, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void jw_printf(json_writer_t *w, const char *fmt, ...) {
+  va_list args, retry;
+  va_start(args, fmt);
+  va_copy(retry, args);
+  int n = vsnprintf(NULL, 0, fmt, args);
+  if (n > 0 && jw_reserve(w, (size_t)n)) {
+    vsnprintf(w->buf + w->len, (size_t)n + 1, fmt, retry);
+    w->len += (size_t)n;
+  }
+  va_end(retry);
+  va_end(args);
+}
+
+// Quoted, escaped JSON string. Board rows, coordinates and evaluator
+// names never need escaping, but error messages echo client input.
+static void jw_string(json_writer_t *w, const char *s) {
+  jw_putc(w, '"');
+  for (; *s; s++) {
+    unsigned char c = (unsigned char)*s;
+    switch (c) {
+    case '"':
+      jw_puts(w, "\\\"");
+      break;
+    case '\\':
+      jw_puts(w, "\\\\");
+      break;
+    case '\b':
+      jw_puts(w, "\\b");
+      break;
+    case '\f':
+      jw_puts(w, "\\f");
+      break;
+    case '\n':
+      jw_puts(w, "\\n");
+      break;
+    case '\r':
+      jw_puts(w, "\\r");
+      break;
+    case '\t':
+      jw_puts(w, "\\t");
+      break;
+    default:
+      if (c < 0x20) {
+        jw_printf(w, "\\u%04x", c);
+      } else {
+        jw_putc(w, (char)c);
+      }
+    }
+  }
+  jw_putc(w, '"');
+}
+
+static void jw_indent(json_writer_t *w, int depth) {
+  jw_putc(w, '\n');
+  for (int i = 0; i < depth * 2; i++) {
+    jw_putc(w, ' ');
+  }
+}
+
+// Comma/indent bookkeeping for one "key": prefix inside an object
+static void jw_key(json_writer_t *w, int depth, int *first, const char *key) {
+  if (!*first) {
+    jw_putc(w, ',');
+  }
+  *first = 0;
+  jw_indent(w, depth);
+  jw_string(w, key);
+  jw_putc(w, ':');
+}
+
+// Millisecond value with exactly 3 decimals (round to microseconds
+// first so e.g. 0.0009999s prints as 1.000, not 0.999)
+static void jw_ms_from_seconds(json_writer_t *w, double seconds) {
+  jw_printf(w, "%.3f", round(seconds * 1000000.0) / 1000.0);
+}
+
+// Reset the thread's scratch writer for a new response
+static json_writer_t *jw_acquire(void) {
+  t_writer.len = 0;
+  t_writer.oom = 0;
+  return &t_writer;
+}
+
+// Exact-size copy for the caller; NULL if any append failed to grow
+static char *jw_finish(json_writer_t *w) {
+  if (w->oom || !w->buf) {
+    return NULL;
+  }
+  char *result = malloc(w->len + 1);
+  if (!result) {
+    return NULL;
+  }
+  memcpy(result, w->buf, w->len);
+  result[w->len] = '\0';
+  return result;
+}
+
 char *json_api_serialize_game(game_state_t *game) {
-  return json_api_serialize_game_ex(game, NULL, 0);
+  return json_api_serialize_game_ex(game, NULL, JSON_SCORING_NONE, 0);
 }
 
 char *json_api_serialize_game_ex(game_state_t *game,
                                  const scoring_report_t *report,
+                                 json_scoring_detail_t detail,
                                  double total_time_sec) {
+  if (detail == JSON_SCORING_NONE) {
+    report = NULL;
+  }
   if (!game) {
     return NULL;
   }
 
-  json_object *root = json_object_new_object();
-  if (!root) {
-    return NULL;
-  }
+  json_writer_t *w = jw_acquire();
+  int root_first = 1;
+  char coord[8];
+
+  jw_putc(w, '{');
 
   // Player X configuration
-  json_object *player_x = json_object_new_object();
-  json_object_object_add(
-      player_x, "player",
-      json_object_new_string(game->player_type[0] == PLAYER_TYPE_HUMAN ? "human"
-                                                                       : "AI"));
+  jw_key(w, 1, &root_first, "X");
+  jw_putc(w, '{');
+  jw_indent(w, 2);
+  jw_puts(w, "\"player\":");
+  jw_string(w, game->player_type[0] == PLAYER_TYPE_HUMAN ? "human" : "AI");
   if (game->player_type[0] == PLAYER_TYPE_AI) {
-    json_object_object_add(player_x, "depth",
-                           json_object_new_int(game->depth_for_player[0]));
+    jw_putc(w, ',');
+    jw_indent(w, 2);
+    jw_printf(w, "\"depth\":%d", game->depth_for_player[0]);
   }
-  json_object_object_add(player_x, "time_ms",
-                         json_ms_from_seconds(game->total_human_time));
-  json_object_object_add(root, "X", player_x);
+  jw_putc(w, ',');
+  jw_indent(w, 2);
+  jw_puts(w, "\"time_ms\":");
+  jw_ms_from_seconds(w, game->total_human_time);
+  jw_indent(w, 1);
+  jw_putc(w, '}');
 
   // Player O configuration
-  json_object *player_o = json_object_new_object();
-  json_object_object_add(
-      player_o, "player",
-      json_object_new_string(game->player_type[1] == PLAYER_TYPE_HUMAN ? "human"
-                                                                       : "AI"));
+  jw_key(w, 1, &root_first, "O");
+  jw_putc(w, '{');
+  jw_indent(w, 2);
+  jw_puts(w, "\"player\":");
+  jw_string(w, game->player_type[1] == PLAYER_TYPE_HUMAN ? "human" : "AI");
   if (game->player_type[1] == PLAYER_TYPE_AI) {
-    json_object_object_add(player_o, "depth",
-                           json_object_new_int(game->depth_for_player[1]));
+    jw_putc(w, ',');
+    jw_indent(w, 2);
+    jw_printf(w, "\"depth\":%d", game->depth_for_player[1]);
   }
-  json_object_object_add(player_o, "time_ms",
-                         json_ms_from_seconds(game->total_ai_time));
-  json_object_object_add(root, "O", player_o);
+  jw_putc(w, ',');
+  jw_indent(w, 2);
+  jw_puts(w, "\"time_ms\":");
+  jw_ms_from_seconds(w, game->total_ai_time);
+  jw_indent(w, 1);
+  jw_putc(w, '}');
 
   // Game parameters
-  json_object_object_add(root, "board_size",
-                         json_object_new_int(game->board_size));
-  json_object_object_add(root, "radius",
-                         json_object_new_int(game->search_radius));
+  jw_key(w, 1, &root_first, "board_size");
+  jw_printf(w, "%d", game->board_size);
+  jw_key(w, 1, &root_first, "radius");
+  jw_printf(w, "%d", game->search_radius);
 
+  jw_key(w, 1, &root_first, "timeout");
   if (game->move_timeout > 0) {
-    json_object_object_add(root, "timeout",
-                           json_object_new_int(game->move_timeout));
+    jw_printf(w, "%d", (int)game->move_timeout);
   } else {
-    json_object_object_add(root, "timeout", json_object_new_string("none"));
+    jw_puts(w, "\"none\"");
   }
 
-  json_object_object_add(
-      root, "undo", json_object_new_boolean(game->config.enable_undo ? 1 : 0));
-  json_object_object_add(root, "undo_limit",
-                         json_object_new_int(game->config.max_undo_allowed));
+  jw_key(w, 1, &root_first, "undo");
+  jw_puts(w, game->config.enable_undo ? "true" : "false");
+  jw_key(w, 1, &root_first, "undo_limit");
+  jw_printf(w, "%d", game->config.max_undo_allowed);
+
+  // Multi-PV analysis lines from the last AI search (only present when
+  // the request asked for multipv > 1 and a search actually ran)
+  if (game->multipv_count > 0) {
+    jw_key(w, 1, &root_first, "multipv");
+    jw_putc(w, '[');
+    for (int i = 0; i < game->multipv_count; i++) {
+      const multipv_entry_t *entry = &game->multipv_results[i];
+      if (i > 0) {
+        jw_putc(w, ',');
+      }
+      jw_indent(w, 2);
+      jw_putc(w, '{');
+      int line_first = 1;
+      if (coord_to_notation(entry->x, entry->y, game->board_size, coord,
+                            sizeof(coord))) {
+        jw_key(w, 3, &line_first, "move");
+        jw_string(w, coord);
+      }
+      jw_key(w, 3, &line_first, "score");
+      jw_printf(w, "%d", entry->score);
+      jw_key(w, 3, &line_first, "pv");
+      if (entry->pv_len > 0) {
+        jw_putc(w, '[');
+        int pv_emitted = 0;
+        for (int p = 0; p < entry->pv_len; p++) {
+          if (coord_to_notation(entry->pv_x[p], entry->pv_y[p],
+                                game->board_size, coord, sizeof(coord))) {
+            if (pv_emitted++) {
+              jw_putc(w, ',');
+            }
+            jw_indent(w, 4);
+            jw_string(w, coord);
+          }
+        }
+        jw_indent(w, 3);
+        jw_putc(w, ']');
+      } else {
+        jw_puts(w, "[]");
+      }
+      jw_indent(w, 2);
+      jw_putc(w, '}');
+    }
+    jw_indent(w, 1);
+    jw_putc(w, ']');
+  }
 
   // Winner
   const char *winner_str = "none";
@@ -440,46 +1343,56 @@ char *json_api_serialize_game_ex(game_state_t *game,
   } else if (game->game_state == GAME_DRAW) {
     winner_str = "draw";
   }
-  json_object_object_add(root, "winner", json_object_new_string(winner_str));
+  jw_key(w, 1, &root_first, "winner");
+  jw_string(w, winner_str);
 
-  // Board state as array of row strings
-  json_object *board_array = json_object_new_array();
-  const char *x_symbol = "X"; // Use ASCII for API
-  const char *o_symbol = "O";
+  // Board state as array of row strings ("X . O . ..."), built on the
+  // stack — rows are at most 2*19 characters
+  jw_key(w, 1, &root_first, "board_state");
+  jw_putc(w, '[');
   int board_size = game->board_size;
-
   for (int row = 0; row < board_size; row++) {
-    // Allocate buffer for row string (symbols + spaces)
-    size_t row_len = (size_t)(board_size * 2);
-    char *row_str = malloc(row_len + 1);
-    if (row_str) {
-      int idx = 0;
-      for (int col = 0; col < board_size; col++) {
-        int cell = game->board[row][col];
-        if (cell == AI_CELL_CROSSES) {
-          row_str[idx++] = x_symbol[0];
-        } else if (cell == AI_CELL_NAUGHTS) {
-          row_str[idx++] = o_symbol[0];
-        } else {
-          row_str[idx++] = '.';
-        }
-        if (col < board_size - 1) {
-          row_str[idx++] = ' ';
-        }
+    char row_str[2 * 19];
+    int idx = 0;
+    for (int col = 0; col < board_size; col++) {
+      int cell = game->board[row][col];
+      if (cell == AI_CELL_CROSSES) {
+        row_str[idx++] = 'X';
+      } else if (cell == AI_CELL_NAUGHTS) {
+        row_str[idx++] = 'O';
+      } else {
+        row_str[idx++] = '.';
+      }
+      if (col < board_size - 1) {
+        row_str[idx++] = ' ';
       }
-      row_str[idx] = '\0';
-      json_object_array_add(board_array, json_object_new_string(row_str));
-      free(row_str);
     }
+    row_str[idx] = '\0';
+    if (row > 0) {
+      jw_putc(w, ',');
+    }
+    jw_indent(w, 2);
+    jw_string(w, row_str);
   }
-  json_object_object_add(root, "board_state", board_array);
+  jw_indent(w, 1);
+  jw_putc(w, ']');
 
   // Moves array
-  json_object *moves_array = json_object_new_array();
+  jw_key(w, 1, &root_first, "moves");
+  if (game->move_history_count > 0) {
+    jw_putc(w, '[');
+  } else {
+    jw_puts(w, "[]");
+  }
 
   for (int i = 0; i < game->move_history_count; i++) {
     move_history_t *move = &game->move_history[i];
-    json_object *move_obj = json_object_new_object();
+    if (i > 0) {
+      jw_putc(w, ',');
+    }
+    jw_indent(w, 2);
+    jw_putc(w, '{');
+    int move_first = 1;
 
     // Player identifier
     const char *username;
@@ -493,128 +1406,142 @@ char *json_api_serialize_game_ex(game_state_t *game,
     }
 
     // Position in compact board notation (e.g., "H7")
-    char coord[8];
     if (coord_to_notation(move->x, move->y, game->board_size, coord,
                           sizeof(coord))) {
-      json_object_object_add(move_obj, username, json_object_new_string(coord));
+      jw_key(w, 3, &move_first, username);
+      jw_string(w, coord);
     }
 
     // AI-specific fields
     if (is_ai && move->positions_evaluated > 0) {
-      json_object_object_add(move_obj, "moves_evaluated",
-                             json_object_new_int(move->positions_evaluated));
+      jw_key(w, 3, &move_first, "moves_evaluated");
+      jw_printf(w, "%d", move->positions_evaluated);
     }
     if (is_ai && move->own_score != 0) {
-      json_object_object_add(move_obj, "score",
-                             json_object_new_int(move->own_score));
+      jw_key(w, 3, &move_first, "score");
+      jw_printf(w, "%d", move->own_score);
     }
     if (is_ai && move->opponent_score != 0) {
-      json_object_object_add(move_obj, "opponent",
-                             json_object_new_int(move->opponent_score));
+      jw_key(w, 3, &move_first, "opponent");
+      jw_printf(w, "%d", move->opponent_score);
     }
 
     // Time taken
-    json_object_object_add(move_obj, "time_ms",
-                           json_ms_from_seconds(move->time_taken));
+    jw_key(w, 3, &move_first, "time_ms");
+    jw_ms_from_seconds(w, move->time_taken);
 
     // Queue wait time (preserved from client)
     if (move->queue_wait_ms > 0) {
-      char qbuf[32];
-      snprintf(qbuf, sizeof(qbuf), "%.3f", move->queue_wait_ms);
-      json_object_object_add(move_obj, "queue_wait_ms",
-                             json_object_new_double_s(atof(qbuf), qbuf));
+      jw_key(w, 3, &move_first, "queue_wait_ms");
+      jw_printf(w, "%.3f", move->queue_wait_ms);
     }
 
     // Winner flag
     if (move->is_winner) {
-      json_object_object_add(move_obj, "winner", json_object_new_boolean(1));
+      jw_key(w, 3, &move_first, "winner");
+      jw_puts(w, "true");
     }
 
     // Add scoring report to the LAST move (the one just computed)
     if (report && i == game->move_history_count - 1 && is_ai) {
-      json_object_object_add(move_obj, "offensive_max_score",
-                             json_object_new_int(report->offensive_max_score));
-      json_object_object_add(move_obj, "defensive_max_score",
-                             json_object_new_int(report->defensive_max_score));
+      jw_key(w, 3, &move_first, "offensive_max_score");
+      jw_printf(w, "%d", report->offensive_max_score);
+      jw_key(w, 3, &move_first, "defensive_max_score");
+      jw_printf(w, "%d", report->defensive_max_score);
 
       // Add total thinking time
       if (total_time_sec > 0) {
-        json_object_object_add(move_obj, "think_time_ms",
-                               json_ms_from_seconds(total_time_sec));
+        jw_key(w, 3, &move_first, "think_time_ms");
+        jw_ms_from_seconds(w, total_time_sec);
       }
 
       // Add scoring entries array
-      json_object *scoring_arr = json_object_new_array();
+      jw_key(w, 3, &move_first, "scoring");
+      if (report->entry_count > 0) {
+        jw_putc(w, '[');
+      } else {
+        jw_puts(w, "[]");
+      }
       for (int s = 0; s < report->entry_count; s++) {
         const scoring_entry_t *se = &report->entries[s];
-        json_object *se_obj = json_object_new_object();
-
-        json_object_object_add(se_obj, "player",
-                               json_object_new_string(se->is_current_player
-                                                          ? "current"
-                                                          : "opponent"));
-        json_object_object_add(se_obj, "evaluator",
-                               json_object_new_string(se->evaluator));
-        json_object_object_add(se_obj, "evaluated_moves",
-                               json_object_new_int(se->evaluated_moves));
-        json_object_object_add(se_obj, "score", json_object_new_int(se->score));
+        if (s > 0) {
+          jw_putc(w, ',');
+        }
+        jw_indent(w, 4);
+        jw_putc(w, '{');
+        int se_first = 1;
+
+        jw_key(w, 5, &se_first, "player");
+        jw_string(w, se->is_current_player ? "current" : "opponent");
+        jw_key(w, 5, &se_first, "evaluator");
+        jw_string(w, se->evaluator);
+        jw_key(w, 5, &se_first, "evaluated_moves");
+        jw_printf(w, "%d", se->evaluated_moves);
+        jw_key(w, 5, &se_first, "score");
+        jw_printf(w, "%d", se->score);
 
         // Time for this evaluator
-        {
-          char tbuf[32];
-          snprintf(tbuf, sizeof(tbuf), "%.3f", se->time_ms);
-          json_object_object_add(se_obj, "time_ms",
-                                 json_object_new_double_s(atof(tbuf), tbuf));
-        }
+        jw_key(w, 5, &se_first, "time_ms");
+        jw_printf(w, "%.3f", se->time_ms);
 
         // Boolean flags
         if (se->have_win) {
-          json_object_object_add(se_obj, "have_win",
-                                 json_object_new_boolean(1));
+          jw_key(w, 5, &se_first, "have_win");
+          jw_puts(w, "true");
         }
         if (se->have_vct) {
-          json_object_object_add(se_obj, "have_vct",
-                                 json_object_new_boolean(1));
-          // VCT sequence
-          if (se->vct_length > 0) {
-            json_object *vct_arr = json_object_new_array();
+          jw_key(w, 5, &se_first, "have_vct");
+          jw_puts(w, "true");
+          // VCT sequence (only at full detail — up to 20 coordinate
+          // pairs per entry that only debugging clients look at)
+          if (detail == JSON_SCORING_FULL && se->vct_length > 0) {
+            jw_key(w, 5, &se_first, "vct_sequence");
+            jw_putc(w, '[');
             for (int v = 0; v < se->vct_length; v++) {
-              json_object *coord = json_object_new_array();
-              json_object_array_add(
-                  coord, json_object_new_int(se->vct_sequence[v][0]));
-              json_object_array_add(
-                  coord, json_object_new_int(se->vct_sequence[v][1]));
-              json_object_array_add(vct_arr, coord);
+              if (v > 0) {
+                jw_putc(w, ',');
+              }
+              jw_indent(w, 6);
+              jw_putc(w, '[');
+              jw_indent(w, 7);
+              jw_printf(w, "%d", se->vct_sequence[v][0]);
+              jw_putc(w, ',');
+              jw_indent(w, 7);
+              jw_printf(w, "%d", se->vct_sequence[v][1]);
+              jw_indent(w, 6);
+              jw_putc(w, ']');
             }
-            json_object_object_add(se_obj, "vct_sequence", vct_arr);
+            jw_indent(w, 5);
+            jw_putc(w, ']');
           }
         }
         if (se->decisive) {
-          json_object_object_add(se_obj, "decisive",
-                                 json_object_new_boolean(1));
+          jw_key(w, 5, &se_first, "decisive");
+          jw_puts(w, "true");
         }
 
-        json_object_array_add(scoring_arr, se_obj);
+        jw_indent(w, 4);
+        jw_putc(w, '}');
+      }
+      if (report->entry_count > 0) {
+        jw_indent(w, 3);
+        jw_putc(w, ']');
       }
-      json_object_object_add(move_obj, "scoring", scoring_arr);
     }
 
-    json_object_array_add(moves_array, move_obj);
+    jw_indent(w, 2);
+    jw_putc(w, '}');
   }
 
-  json_object_object_add(root, "moves", moves_array);
-
-  // Convert to string
-  const char *json_str =
-      json_object_to_json_string_ext(root, JSON_C_TO_STRING_PRETTY);
-
-  char *result = NULL;
-  if (json_str) {
-    result = strdup(json_str);
+  if (game->move_history_count > 0) {
+    jw_indent(w, 1);
+    jw_putc(w, ']');
   }
 
-  json_object_put(root);
-  return result;
+  jw_indent(w, 0);
+  jw_putc(w, '}');
+
+  return jw_finish(w);
 }
 
 //===============================================================================
@@ -622,25 +1549,13 @@ char *json_api_serialize_game_ex(game_state_t *game,
 //===============================================================================
 
 char *json_api_error_response(const char *error_message) {
-  json_object *root = json_object_new_object();
-  if (!root) {
-    return NULL;
-  }
-
-  json_object_object_add(
-      root, "error",
-      json_object_new_string(error_message ? error_message : "Unknown error"));
-
-  const char *json_str =
-      json_object_to_json_string_ext(root, JSON_C_TO_STRING_PLAIN);
-
-  char *result = NULL;
-  if (json_str) {
-    result = strdup(json_str);
-  }
-
-  json_object_put(root);
-  return result;
+  // Fixed shape, so the append writer handles it; messages may echo
+  // client input, which jw_string escapes.
+  json_writer_t *w = jw_acquire();
+  jw_puts(w, "{\"error\":");
+  jw_string(w, error_message ? error_message : "Unknown error");
+  jw_putc(w, '}');
+  return jw_finish(w);
 }
 
 char *json_api_health_response(time_t start_time) {
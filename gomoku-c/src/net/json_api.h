@@ -35,6 +35,21 @@
 game_state_t *json_api_parse_game(const char *json_str, char *error_msg,
                                   size_t error_msg_len);
 
+/**
+ * Split a JSON array into its elements, re-serialized one string per
+ * element, so each can be fed to json_api_parse_game() independently.
+ * Used by the batch analysis endpoint.
+ *
+ * @param json_str The JSON string to parse (must be a non-empty array)
+ * @param out_count Receives the number of elements on success
+ * @param error_msg Buffer to store error message on failure
+ * @param error_msg_len Size of error message buffer
+ * @return Allocated array of allocated strings (caller frees each element
+ *         and the array), or NULL on error (check error_msg)
+ */
+char **json_api_split_array(const char *json_str, int *out_count,
+                            char *error_msg, size_t error_msg_len);
+
 //===============================================================================
 // GAME STATE SERIALIZATION
 //===============================================================================
@@ -48,18 +63,35 @@ game_state_t *json_api_parse_game(const char *json_str, char *error_msg,
  */
 char *json_api_serialize_game(game_state_t *game);
 
+/**
+ * How much of the scoring report a response carries. Negotiated per
+ * request via the `scoring` query parameter; summary keeps the
+ * per-evaluator entries but drops the VCT sequences (up to 20 coordinate
+ * pairs per entry), which only debugging clients look at.
+ */
+typedef enum {
+  JSON_SCORING_NONE = 0,    // omit the report entirely
+  JSON_SCORING_SUMMARY = 1, // entries without vct_sequence detail
+  JSON_SCORING_FULL = 2,    // entries including vct_sequence
+} json_scoring_detail_t;
+
 /**
  * Extended serialization with scoring report for the latest AI move.
- * When report is non-NULL, adds scoring, offensive_max_score, defensive_max_score
- * to the last move in the moves array.
+ * When report is non-NULL and detail is not JSON_SCORING_NONE, adds
+ * scoring, offensive_max_score, defensive_max_score to the last move in
+ * the moves array; vct_sequence arrays are emitted only at
+ * JSON_SCORING_FULL.
  *
  * @param game The game state to serialize
  * @param report Scoring report for the latest move (NULL to omit)
+ * @param detail How much of the report to emit
  * @param total_time_ms Total thinking time in seconds for the latest move
  * @return Allocated JSON string (caller must free), or NULL on error
  */
-char *json_api_serialize_game_ex(game_state_t *game, const scoring_report_t *report,
-                                  double total_time_sec);
+char *json_api_serialize_game_ex(game_state_t *game,
+                                 const scoring_report_t *report,
+                                 json_scoring_detail_t detail,
+                                 double total_time_sec);
 
 //===============================================================================
 // RESPONSE HELPERS
@@ -114,4 +146,17 @@ int json_api_has_winner(game_state_t *game);
  */
 void json_api_format_uptime(long seconds, char *buffer, size_t buffer_len);
 
+/**
+ * Sets the transposition table size (in MB) used for games created by this
+ * API. Called once at startup from the --tt-size daemon flag; 0 keeps the
+ * engine default.
+ */
+void json_api_set_tt_size_mb(int mb);
+
+/**
+ * Transposition table size (in MB) set by json_api_set_tt_size_mb().
+ * Shared with the binary API so both protocols build identical configs.
+ */
+int json_api_tt_size_mb(void);
+
 #endif // NET_JSON_API_H
@@ -0,0 +1,678 @@
+//
+//  load_gen.c
+//  gomoku-httpd - concurrent load-generation mode for gomoku-http-client
+//
+//  Replays mid-game positions from recorded games (games/*.json) against
+//  POST /gomoku/play from N concurrent worker connections, either
+//  closed-loop (each worker fires as fast as the daemon answers) or
+//  paced to a target request rate, and reports throughput, error counts
+//  and latency percentiles (p50/p95/p99/p99.9) over a measured window
+//  that excludes a configurable warmup.
+//
+//  The bodies are real request payloads: each corpus game contributes
+//  its move list truncated at the quarter points, so the daemon replays
+//  a genuine position and runs a genuine search — unlike generic HTTP
+//  load tools, which can't construct valid game payloads and end up
+//  benchmarking the error path.
+//
+
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "load_gen.h"
+#include "test_client_utils.h"
+
+#define LOAD_MAX_GAME_MOVES 400
+#define LOAD_MAX_STATUS_CODES 32
+
+static double load_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+//===============================================================================
+// CORPUS
+//===============================================================================
+
+typedef struct {
+  char *body;    // Full request payload, ready to POST
+  size_t length; // strlen(body), cached for Content-Length
+} load_body_t;
+
+typedef struct {
+  load_body_t *bodies;
+  int count;
+} load_corpus_t;
+
+/** Read a whole file into a malloc'd NUL-terminated buffer, or NULL. */
+static char *load_read_file(const char *path) {
+  FILE *fp = fopen(path, "r");
+  if (!fp) {
+    return NULL;
+  }
+  fseek(fp, 0, SEEK_END);
+  long size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  if (size <= 0 || size > 16 * 1024 * 1024) {
+    fclose(fp);
+    return NULL;
+  }
+  char *buf = malloc((size_t)size + 1);
+  if (!buf) {
+    fclose(fp);
+    return NULL;
+  }
+  size_t got = fread(buf, 1, (size_t)size, fp);
+  fclose(fp);
+  buf[got] = '\0';
+  return buf;
+}
+
+/**
+ * Extract the move sequence from a recorded game JSON: for each element
+ * of the "moves" array, the first quoted value under a key starting with
+ * X or O (e.g. {"X (human)":"J8", ...} or {"O":"K9"}). Board notation is
+ * passed through verbatim — the daemon validates it against board_size.
+ * Returns the number of moves extracted.
+ */
+static int load_parse_moves(const char *json, char (*cells)[8], char *players,
+                            int max_moves) {
+  const char *p = strstr(json, "\"moves\"");
+  if (!p) {
+    return 0;
+  }
+  p = strchr(p, '[');
+  if (!p) {
+    return 0;
+  }
+  p++;
+
+  int count = 0;
+  while (count < max_moves) {
+    // Next move object, or end of the array.
+    while (*p && *p != '{' && *p != ']') {
+      p++;
+    }
+    if (*p != '{') {
+      break;
+    }
+    p++;
+
+    int found = 0;
+    int depth = 1;
+    while (*p && depth > 0) {
+      if (*p == '{') {
+        depth++;
+        p++;
+      } else if (*p == '}') {
+        depth--;
+        p++;
+      } else if (*p == '"') {
+        // "key" : value — take a quoted value under an X/O key.
+        char key[32];
+        p++;
+        size_t k = 0;
+        while (*p && *p != '"' && k + 1 < sizeof(key)) {
+          key[k++] = *p++;
+        }
+        key[k] = '\0';
+        while (*p && *p != '"') {
+          p++;
+        }
+        if (*p) {
+          p++;
+        }
+        while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') {
+          p++;
+        }
+        if (*p != ':') {
+          continue;
+        }
+        p++;
+        while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') {
+          p++;
+        }
+        if (*p == '"') {
+          char value[8];
+          p++;
+          size_t v = 0;
+          while (*p && *p != '"' && v + 1 < sizeof(value)) {
+            value[v++] = *p++;
+          }
+          value[v] = '\0';
+          while (*p && *p != '"') {
+            p++;
+          }
+          if (*p) {
+            p++;
+          }
+          if (!found && (key[0] == 'X' || key[0] == 'O') && value[0] >= 'A' &&
+              value[0] <= 'T' && value[1] >= '1' && value[1] <= '9') {
+            snprintf(cells[count], sizeof(cells[count]), "%s", value);
+            players[count] = key[0];
+            found = 1;
+          }
+        }
+      } else {
+        p++;
+      }
+    }
+    if (found) {
+      count++;
+    }
+  }
+  return count;
+}
+
+/** Build one request body replaying the first `prefix` recorded moves. */
+static load_body_t load_build_body(const load_config_t *cfg, int board_size,
+                                   char (*cells)[8], const char *players,
+                                   int prefix) {
+  load_body_t body = {NULL, 0};
+  size_t cap = 256 + (size_t)prefix * 16;
+  char *buf = malloc(cap);
+  if (!buf) {
+    return body;
+  }
+
+  size_t len = (size_t)snprintf(
+      buf, cap,
+      "{\"X\":{\"player\":\"AI\",\"depth\":%d},"
+      "\"O\":{\"player\":\"AI\",\"depth\":%d},"
+      "\"board_size\":%d,\"radius\":%d,\"timeout\":\"none\",\"moves\":[",
+      cfg->depth, cfg->depth, board_size, cfg->radius);
+  for (int i = 0; i < prefix; i++) {
+    len += (size_t)snprintf(buf + len, cap - len, "%s{\"%c\":\"%s\"}",
+                            (i > 0) ? "," : "", players[i], cells[i]);
+  }
+  len += (size_t)snprintf(buf + len, cap - len, "]}");
+
+  body.body = buf;
+  body.length = len;
+  return body;
+}
+
+/**
+ * Scan corpus_dir for *.json recorded games and build request bodies
+ * from each game's move list truncated at the quarter points (so the
+ * daemon sees early-, mid- and late-game searches). Full games are
+ * never replayed whole: the final recorded move usually completes a
+ * five, and a finished position answers without searching.
+ */
+static int load_corpus_build(const load_config_t *cfg, load_corpus_t *corpus) {
+  corpus->bodies = NULL;
+  corpus->count = 0;
+
+  DIR *dir = opendir(cfg->corpus_dir);
+  if (!dir) {
+    fprintf(stderr, "Error: cannot open corpus directory '%s': %s\n",
+            cfg->corpus_dir, strerror(errno));
+    return -1;
+  }
+
+  int capacity = 0;
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != NULL) {
+    size_t name_len = strlen(entry->d_name);
+    if (name_len < 6 || strcmp(entry->d_name + name_len - 5, ".json") != 0) {
+      continue;
+    }
+
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s", cfg->corpus_dir, entry->d_name);
+    char *json = load_read_file(path);
+    if (!json) {
+      continue;
+    }
+
+    int board_size = 19;
+    const char *bs = strstr(json, "\"board_size\"");
+    if (bs) {
+      const char *colon = strchr(bs, ':');
+      if (colon) {
+        int v = atoi(colon + 1);
+        if (v == 15 || v == 19) {
+          board_size = v;
+        }
+      }
+    }
+
+    static char cells[LOAD_MAX_GAME_MOVES][8];
+    static char players[LOAD_MAX_GAME_MOVES];
+    int moves = load_parse_moves(json, cells, players, LOAD_MAX_GAME_MOVES);
+    free(json);
+    if (moves < 6) {
+      continue; // Too short to yield an interesting prefix
+    }
+
+    // Quarter-point prefixes, deduplicated and strictly shorter than the
+    // full game (see the function comment above).
+    int prefixes[3] = {moves / 4, moves / 2, (3 * moves) / 4};
+    int last = 0;
+    for (int i = 0; i < 3; i++) {
+      int prefix = prefixes[i];
+      if (prefix < 4 || prefix >= moves || prefix == last) {
+        continue;
+      }
+      last = prefix;
+
+      if (corpus->count == capacity) {
+        capacity = capacity ? capacity * 2 : 64;
+        load_body_t *grown =
+            realloc(corpus->bodies, (size_t)capacity * sizeof(load_body_t));
+        if (!grown) {
+          break;
+        }
+        corpus->bodies = grown;
+      }
+      load_body_t body =
+          load_build_body(cfg, board_size, cells, players, prefix);
+      if (body.body) {
+        corpus->bodies[corpus->count++] = body;
+      }
+    }
+  }
+  closedir(dir);
+
+  if (corpus->count == 0) {
+    fprintf(stderr,
+            "Error: no usable positions in '%s' (need recorded games with "
+            "6+ moves; see the -j flag of this client)\n",
+            cfg->corpus_dir);
+    return -1;
+  }
+  return 0;
+}
+
+static void load_corpus_free(load_corpus_t *corpus) {
+  for (int i = 0; i < corpus->count; i++) {
+    free(corpus->bodies[i].body);
+  }
+  free(corpus->bodies);
+}
+
+//===============================================================================
+// SHARED RUN STATE
+//===============================================================================
+
+typedef struct {
+  const load_config_t *cfg;
+  const load_corpus_t *corpus;
+  struct sockaddr_in addr; // Resolved once up front: gethostbyname's
+                           // static buffer is not safe to share between
+                           // the worker threads
+  double start;       // Run start (warmup begins here)
+  double measure_from; // start + warmup
+  double deadline;    // measure_from + duration
+
+  // Open-loop pacing: ticket n is released at start + n / rate.
+  uint64_t ticket;
+
+  pthread_mutex_t lock; // Guards everything below
+  uint64_t ok;          // 2xx responses inside the measured window
+  uint64_t conn_errors; // Connect/send/read failures (window-wide)
+  uint64_t reconnects;  // Stale keep-alive sockets replaced
+  struct {
+    int status;
+    uint64_t count;
+  } statuses[LOAD_MAX_STATUS_CODES]; // Non-2xx responses by code
+  int status_count;
+  uint32_t *samples_us; // Latencies inside the measured window
+  size_t sample_count;
+  size_t sample_cap;
+} load_state_t;
+
+static void load_record_status(load_state_t *state, int status) {
+  for (int i = 0; i < state->status_count; i++) {
+    if (state->statuses[i].status == status) {
+      state->statuses[i].count++;
+      return;
+    }
+  }
+  if (state->status_count < LOAD_MAX_STATUS_CODES) {
+    state->statuses[state->status_count].status = status;
+    state->statuses[state->status_count].count = 1;
+    state->status_count++;
+  }
+}
+
+static void load_record_sample(load_state_t *state, double seconds) {
+  if (state->sample_count == state->sample_cap) {
+    size_t cap = state->sample_cap ? state->sample_cap * 2 : 4096;
+    uint32_t *grown = realloc(state->samples_us, cap * sizeof(uint32_t));
+    if (!grown) {
+      return; // Drop the sample rather than the run
+    }
+    state->samples_us = grown;
+    state->sample_cap = cap;
+  }
+  double us = seconds * 1e6;
+  state->samples_us[state->sample_count++] =
+      (us > (double)UINT32_MAX) ? UINT32_MAX : (uint32_t)us;
+}
+
+//===============================================================================
+// WORKER
+//===============================================================================
+
+typedef struct {
+  load_state_t *state;
+  uint64_t rng; // Per-worker xorshift for corpus selection
+  int sock;     // Persistent keep-alive connection (-1 = closed)
+} load_worker_t;
+
+static uint64_t load_rand(uint64_t *state) {
+  uint64_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *state = x;
+  return x;
+}
+
+static int load_connect(const struct sockaddr_in *addr) {
+  int sock = socket(AF_INET, SOCK_STREAM, 0);
+  if (sock < 0) {
+    return -1;
+  }
+  if (connect(sock, (const struct sockaddr *)addr, sizeof(*addr)) < 0) {
+    close(sock);
+    return -1;
+  }
+  return sock;
+}
+
+/**
+ * Issue one request on the worker's persistent connection, reconnecting
+ * once if the pooled socket went stale between requests. Returns the
+ * HTTP status (0 on transport failure) and sets *reconnected.
+ */
+static int load_post(load_worker_t *worker, const load_body_t *body,
+                     int *reconnected) {
+  const load_config_t *cfg = worker->state->cfg;
+  *reconnected = 0;
+
+  for (int attempt = 0; attempt < 2; attempt++) {
+    int reused = (worker->sock >= 0);
+    if (!reused) {
+      worker->sock = load_connect(&worker->state->addr);
+      if (worker->sock < 0) {
+        return 0;
+      }
+    }
+
+    char header[256];
+    int header_len = snprintf(header, sizeof(header),
+                              "POST /gomoku/play HTTP/1.1\r\n"
+                              "Host: %s:%d\r\n"
+                              "Content-Type: application/json\r\n"
+                              "Content-Length: %zu\r\n"
+                              "Connection: keep-alive\r\n"
+                              "\r\n",
+                              cfg->host, cfg->port, body->length);
+    if (send(worker->sock, header, (size_t)header_len, 0) < 0 ||
+        send(worker->sock, body->body, body->length, 0) < 0) {
+      close(worker->sock);
+      worker->sock = -1;
+      if (reused) {
+        *reconnected = 1;
+        continue;
+      }
+      return 0;
+    }
+
+    int status = 0;
+    int keep_alive = 0;
+    size_t response_len = 0;
+    char *response = test_client_read_http_response_ex(
+        worker->sock, &status, &response_len, 0, &keep_alive, NULL, NULL);
+    if (!response) {
+      close(worker->sock);
+      worker->sock = -1;
+      if (reused) {
+        *reconnected = 1;
+        continue;
+      }
+      return 0;
+    }
+    free(response);
+
+    if (!keep_alive) {
+      close(worker->sock);
+      worker->sock = -1;
+    }
+    return status;
+  }
+  return 0;
+}
+
+static void *load_worker_fn(void *arg) {
+  load_worker_t *worker = (load_worker_t *)arg;
+  load_state_t *state = worker->state;
+  const load_config_t *cfg = state->cfg;
+
+  for (;;) {
+    double now = load_now();
+    if (now >= state->deadline) {
+      break;
+    }
+
+    if (cfg->rate > 0) {
+      // Open loop: take the next ticket on the global schedule and wait
+      // for its release time, so the offered rate is independent of how
+      // fast the daemon answers (the whole point of tail-latency runs).
+      uint64_t ticket = __atomic_fetch_add(&state->ticket, 1, __ATOMIC_RELAXED);
+      double release = state->start + (double)ticket / cfg->rate;
+      if (release >= state->deadline) {
+        break;
+      }
+      double wait = release - load_now();
+      if (wait > 0) {
+        usleep((useconds_t)(wait * 1e6));
+      }
+    }
+
+    const load_body_t *body =
+        &state->corpus->bodies[load_rand(&worker->rng) %
+                               (uint64_t)state->corpus->count];
+
+    double sent = load_now();
+    int reconnected = 0;
+    int status = load_post(worker, body, &reconnected);
+    double elapsed = load_now() - sent;
+
+    int measured = (sent >= state->measure_from);
+    pthread_mutex_lock(&state->lock);
+    if (reconnected) {
+      state->reconnects++;
+    }
+    int transport_failed = (status == 0);
+    if (transport_failed) {
+      state->conn_errors++;
+    } else if (measured) {
+      if (status >= 200 && status < 300) {
+        state->ok++;
+        load_record_sample(state, elapsed);
+      } else {
+        load_record_status(state, status);
+      }
+    }
+    pthread_mutex_unlock(&state->lock);
+
+    // A refused connection answers in microseconds; without a pause the
+    // loop melts the CPU counting failures against a dead daemon.
+    if (transport_failed) {
+      usleep(100000);
+    }
+  }
+
+  if (worker->sock >= 0) {
+    close(worker->sock);
+    worker->sock = -1;
+  }
+  return NULL;
+}
+
+//===============================================================================
+// REPORT
+//===============================================================================
+
+static int load_compare_u32(const void *a, const void *b) {
+  uint32_t va = *(const uint32_t *)a;
+  uint32_t vb = *(const uint32_t *)b;
+  return (va > vb) - (va < vb);
+}
+
+static double load_percentile_ms(const uint32_t *sorted, size_t n, double q) {
+  size_t index = (size_t)(q * (double)(n - 1) + 0.5);
+  if (index >= n) {
+    index = n - 1;
+  }
+  return (double)sorted[index] / 1000.0;
+}
+
+//===============================================================================
+// ENTRY POINT
+//===============================================================================
+
+int load_gen_run(const load_config_t *cfg) {
+  load_corpus_t corpus;
+  if (load_corpus_build(cfg, &corpus) != 0) {
+    return 1;
+  }
+
+  load_state_t state;
+  memset(&state, 0, sizeof(state));
+  state.cfg = cfg;
+  state.corpus = &corpus;
+  pthread_mutex_init(&state.lock, NULL);
+
+  struct hostent *server = gethostbyname(cfg->host);
+  if (!server) {
+    fprintf(stderr, "Error: cannot resolve host '%s'\n", cfg->host);
+    load_corpus_free(&corpus);
+    return 1;
+  }
+  state.addr.sin_family = AF_INET;
+  state.addr.sin_port = htons((uint16_t)cfg->port);
+  memcpy(&state.addr.sin_addr.s_addr, server->h_addr,
+         (size_t)server->h_length);
+
+  if (!cfg->quiet) {
+    printf("Load test: %d connection(s) against %s:%d /gomoku/play\n",
+           cfg->connections, cfg->host, cfg->port);
+    printf("Corpus: %d position(s) from %s (depth %d, radius %d)\n",
+           corpus.count, cfg->corpus_dir, cfg->depth, cfg->radius);
+    if (cfg->rate > 0) {
+      printf("Mode: open loop at %.1f req/s", cfg->rate);
+    } else {
+      printf("Mode: closed loop");
+    }
+    printf(", %.0fs warmup + %.0fs measured\n\n", cfg->warmup_sec,
+           cfg->duration_sec);
+  }
+
+  state.start = load_now();
+  state.measure_from = state.start + cfg->warmup_sec;
+  state.deadline = state.measure_from + cfg->duration_sec;
+
+  load_worker_t *workers =
+      calloc((size_t)cfg->connections, sizeof(load_worker_t));
+  pthread_t *threads = calloc((size_t)cfg->connections, sizeof(pthread_t));
+  if (!workers || !threads) {
+    free(workers);
+    free(threads);
+    load_corpus_free(&corpus);
+    return 1;
+  }
+  for (int i = 0; i < cfg->connections; i++) {
+    workers[i].state = &state;
+    workers[i].rng = 0x9E3779B97F4A7C15ULL ^ ((uint64_t)(i + 1) << 17);
+    workers[i].sock = -1;
+    pthread_create(&threads[i], NULL, load_worker_fn, &workers[i]);
+  }
+
+  if (!cfg->quiet) {
+    // One-line progress ticker; the workers own stderr for hard errors.
+    while (load_now() < state.deadline) {
+      pthread_mutex_lock(&state.lock);
+      uint64_t ok = state.ok;
+      pthread_mutex_unlock(&state.lock);
+      double now = load_now();
+      printf("\r  %s %5.1fs  %llu ok",
+             (now < state.measure_from) ? "warmup   " : "measuring",
+             now - state.start, (unsigned long long)ok);
+      fflush(stdout);
+      usleep(1000000);
+    }
+  }
+
+  for (int i = 0; i < cfg->connections; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  if (!cfg->quiet) {
+    printf("\r\033[K");
+  }
+
+  uint64_t http_errors = 0;
+  for (int i = 0; i < state.status_count; i++) {
+    http_errors += state.statuses[i].count;
+  }
+
+  printf("Requests: %llu ok, %llu http error(s), %llu transport error(s), "
+         "%llu reconnect(s)\n",
+         (unsigned long long)state.ok, (unsigned long long)http_errors,
+         (unsigned long long)state.conn_errors,
+         (unsigned long long)state.reconnects);
+  if (state.status_count > 0) {
+    printf("Errors by status:");
+    for (int i = 0; i < state.status_count; i++) {
+      printf(" %d=%llu", state.statuses[i].status,
+             (unsigned long long)state.statuses[i].count);
+    }
+    printf("\n");
+  }
+
+  int failed = (state.sample_count == 0);
+  if (failed) {
+    printf("No successful responses in the measured window.\n");
+  } else {
+    qsort(state.samples_us, state.sample_count, sizeof(uint32_t),
+          load_compare_u32);
+
+    double sum_us = 0;
+    for (size_t i = 0; i < state.sample_count; i++) {
+      sum_us += (double)state.samples_us[i];
+    }
+    printf("Throughput: %.1f req/s over %.0fs\n",
+           (double)state.sample_count / cfg->duration_sec, cfg->duration_sec);
+    printf("Latency: min %.1fms  p50 %.1fms  p95 %.1fms  p99 %.1fms  "
+           "p99.9 %.1fms  max %.1fms  mean %.1fms\n",
+           (double)state.samples_us[0] / 1000.0,
+           load_percentile_ms(state.samples_us, state.sample_count, 0.50),
+           load_percentile_ms(state.samples_us, state.sample_count, 0.95),
+           load_percentile_ms(state.samples_us, state.sample_count, 0.99),
+           load_percentile_ms(state.samples_us, state.sample_count, 0.999),
+           (double)state.samples_us[state.sample_count - 1] / 1000.0,
+           sum_us / (double)state.sample_count / 1000.0);
+  }
+
+  free(state.samples_us);
+  free(workers);
+  free(threads);
+  pthread_mutex_destroy(&state.lock);
+  load_corpus_free(&corpus);
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,38 @@
+#ifndef NET_LOAD_GEN_H
+#define NET_LOAD_GEN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Configuration for the concurrent load-generation mode of
+ * gomoku-http-client (see load_gen.c). Filled from CLI flags by
+ * test_client.c's main().
+ */
+typedef struct {
+  const char *host;       // Daemon host
+  int port;               // Daemon port
+  const char *corpus_dir; // Directory scanned for games/*.json bodies
+  int connections;        // Concurrent worker connections
+  double rate;            // Target req/s across all workers (0 = closed loop)
+  double warmup_sec;      // Seconds excluded from the measured window
+  double duration_sec;    // Measured seconds after warmup
+  int depth;              // AI depth sent in each request body
+  int radius;             // Search radius sent in each request body
+  int quiet;              // Suppress the per-second progress line
+} load_config_t;
+
+/**
+ * Run the load test: replay corpus positions against POST /gomoku/play
+ * from `connections` concurrent workers and print a latency/error
+ * report (p50/p95/p99/p99.9). Returns 0 on success, 1 on setup failure
+ * or when every request errored.
+ */
+int load_gen_run(const load_config_t *cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NET_LOAD_GEN_H
@@ -19,6 +19,10 @@ enum {
 
   kMaxFileNameLen = 255,          /* without null character */
   kDefaultMaxFileSize = 1048576L, /* 1 MB */
+
+  /* Asynchronous mode */
+  kAsyncRingSize = 1024, /* slots; must be a power of two */
+  kAsyncMsgLen = 512,    /* bytes per formatted line, longer lines truncate */
 };
 
 /* Console logger */
@@ -37,6 +41,27 @@ static struct {
   unsigned long long flushedTime;
 } s_flog;
 
+#if !defined(_WIN32) && !defined(_WIN64)
+/* Asynchronous logger: producers format complete lines into a lock-free
+ * MPSC ring; a dedicated flusher thread feeds them through the sinks.
+ * When the ring is full the line is dropped and counted instead of
+ * blocking the request path. */
+typedef struct {
+  volatile int ready; /* released by the producer once text is complete */
+  char text[kAsyncMsgLen];
+} AsyncSlot;
+
+static struct {
+  AsyncSlot ring[kAsyncRingSize];
+  volatile unsigned long long head; /* next slot to claim (producers, CAS) */
+  volatile unsigned long long tail; /* next slot to drain (flusher only) */
+  volatile unsigned long long dropped;
+  unsigned long long reportedDropped; /* flusher-local */
+  pthread_t thread;
+  volatile int running;
+} s_alog;
+#endif /* !defined(_WIN32) && !defined(_WIN64) */
+
 static volatile int s_logger;
 static volatile LogLevel s_logLevel = LogLevel_INFO;
 static volatile long s_flushInterval = 0; /* msec, 0 is auto flush off */
@@ -287,6 +312,146 @@ static int rotateLogFiles(void) {
   return 1;
 }
 
+#if !defined(_WIN32) && !defined(_WIN64)
+/* Write one pre-formatted line to every configured sink. Called only
+ * from the flusher thread, under the logger mutex (the mutex still
+ * guards against a concurrent re-init of the sinks). */
+static void writeFormattedLine(const char *text) {
+  int size;
+
+  if (hasFlag(s_logger, kConsoleLogger)) {
+    fprintf(s_clog.output, "%s\n", text);
+  }
+  if (hasFlag(s_logger, kFileLogger)) {
+    if (rotateLogFiles()) {
+      if ((size = fprintf(s_flog.output, "%s\n", text)) > 0) {
+        s_flog.currentFileSize += size;
+      }
+    }
+  }
+}
+
+static void *asyncFlusher(void *arg) {
+  (void)arg;
+  /* Keep draining after shutdown is requested until the ring is empty */
+  while (s_alog.running ||
+         s_alog.tail != __atomic_load_n(&s_alog.head, __ATOMIC_ACQUIRE)) {
+    int drained = 0;
+    unsigned long long dropped;
+
+    while (s_alog.tail != __atomic_load_n(&s_alog.head, __ATOMIC_ACQUIRE)) {
+      AsyncSlot *slot = &s_alog.ring[s_alog.tail & (kAsyncRingSize - 1)];
+      if (!__atomic_load_n(&slot->ready, __ATOMIC_ACQUIRE)) {
+        break; /* producer claimed the slot but is still formatting */
+      }
+      lock();
+      writeFormattedLine(slot->text);
+      unlock();
+      __atomic_store_n(&slot->ready, 0, __ATOMIC_RELAXED);
+      /* Release makes the cleared ready flag visible before a producer
+       * can re-claim the slot via the advanced tail */
+      __atomic_store_n(&s_alog.tail, s_alog.tail + 1, __ATOMIC_RELEASE);
+      drained++;
+    }
+
+    dropped = __atomic_load_n(&s_alog.dropped, __ATOMIC_RELAXED);
+    if (dropped != s_alog.reportedDropped) {
+      char line[kAsyncMsgLen];
+      snprintf(line, sizeof(line),
+               "W logger: dropped %llu message(s): async ring full",
+               dropped - s_alog.reportedDropped);
+      s_alog.reportedDropped = dropped;
+      lock();
+      writeFormattedLine(line);
+      unlock();
+    }
+
+    if (drained > 0) {
+      /* One flush per drained batch: disk latency is paid here, off the
+       * request path, and amortized across the batch */
+      lock();
+      if (hasFlag(s_logger, kConsoleLogger)) {
+        fflush(s_clog.output);
+      }
+      if (hasFlag(s_logger, kFileLogger)) {
+        fflush(s_flog.output);
+      }
+      unlock();
+    } else if (s_alog.running) {
+      usleep(2000);
+    }
+  }
+  return NULL;
+}
+
+/* Claim a slot, format the complete line into it, publish it. Never
+ * blocks: a full ring drops the line and bumps the counter. */
+static void asyncEnqueue(char levelc, const char *timestamp, long pid,
+                         const char *file, int line, const char *fmt,
+                         va_list arg) {
+  unsigned long long head, tail;
+  AsyncSlot *slot;
+  int size;
+
+  for (;;) {
+    head = __atomic_load_n(&s_alog.head, __ATOMIC_RELAXED);
+    tail = __atomic_load_n(&s_alog.tail, __ATOMIC_ACQUIRE);
+    if (head - tail >= kAsyncRingSize) {
+      __atomic_fetch_add(&s_alog.dropped, 1, __ATOMIC_RELAXED);
+      return;
+    }
+    if (__atomic_compare_exchange_n(&s_alog.head, &head, head + 1, 1,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+      break;
+    }
+  }
+
+  /* The flusher cleared ready before advancing tail past this slot, so
+   * the slot is exclusively ours until the release store below */
+  slot = &s_alog.ring[head & (kAsyncRingSize - 1)];
+  size = snprintf(slot->text, kAsyncMsgLen, "%c %s [%ld] %s:%d: ", levelc,
+                  timestamp, pid, file, line);
+  if (size < 0 || size >= kAsyncMsgLen) {
+    size = kAsyncMsgLen - 1;
+  }
+  vsnprintf(slot->text + size, (size_t)(kAsyncMsgLen - size), fmt, arg);
+  __atomic_store_n(&slot->ready, 1, __ATOMIC_RELEASE);
+}
+
+int logger_initAsync(void) {
+  if (s_alog.running) {
+    return 1;
+  }
+  s_alog.head = 0;
+  s_alog.tail = 0;
+  s_alog.dropped = 0;
+  s_alog.reportedDropped = 0;
+  s_alog.running = 1;
+  if (pthread_create(&s_alog.thread, NULL, asyncFlusher, NULL) != 0) {
+    s_alog.running = 0;
+    fprintf(stderr, "ERROR: logger: Failed to start async flusher\n");
+    return 0;
+  }
+  return 1;
+}
+
+void logger_exitAsync(void) {
+  if (!s_alog.running) {
+    return;
+  }
+  s_alog.running = 0; /* flusher drains the ring before exiting */
+  pthread_join(s_alog.thread, NULL);
+}
+
+unsigned long long logger_asyncDropped(void) {
+  return __atomic_load_n(&s_alog.dropped, __ATOMIC_RELAXED);
+}
+#else
+int logger_initAsync(void) { return 0; }
+void logger_exitAsync(void) {}
+unsigned long long logger_asyncDropped(void) { return 0; }
+#endif /* !defined(_WIN32) && !defined(_WIN64) */
+
 static long vflog(FILE *fp, char levelc, const char *timestamp, long pid,
                   const char *file, int line, const char *fmt, va_list arg,
                   unsigned long long currentTime,
@@ -335,6 +500,16 @@ void logger_log(LogLevel level, const char *file, int line, const char *fmt,
   levelc = getLevelChar(level);
   getTimestamp(&now, timestamp, sizeof(timestamp));
   pid = getCurrentProcessID();
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (s_alog.running) {
+    /* Async mode: hand the formatted line to the flusher thread and
+     * return without touching the sinks (or their mutex) */
+    va_start(carg, fmt);
+    asyncEnqueue(levelc, timestamp, pid, file, line, fmt, carg);
+    va_end(carg);
+    return;
+  }
+#endif /* !defined(_WIN32) && !defined(_WIN64) */
   lock();
   if (hasFlag(s_logger, kConsoleLogger)) {
     va_start(carg, fmt);
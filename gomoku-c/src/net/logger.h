@@ -96,6 +96,30 @@ void logger_autoFlush(long interval);
  */
 void logger_flush(void);
 
+/**
+ * Switch logging to asynchronous mode. Log calls format the line into a
+ * lock-free MPSC ring buffer and return immediately; a dedicated flusher
+ * thread writes to the configured sinks, so disk stalls never sit on the
+ * calling thread. When the ring is full, lines are dropped and counted
+ * (see logger_asyncDropped()) instead of blocking. Lines longer than the
+ * slot size (512 bytes) are truncated.
+ * Call after the console/file logger is initialized. No-op on Windows.
+ *
+ * @return Non-zero value upon success or 0 on error
+ */
+int logger_initAsync(void);
+
+/**
+ * Stop asynchronous mode: drains the ring through the sinks, then joins
+ * the flusher thread. Subsequent log calls are synchronous again.
+ */
+void logger_exitAsync(void);
+
+/**
+ * Number of log lines dropped because the async ring was full.
+ */
+unsigned long long logger_asyncDropped(void);
+
 /**
  * Log a message.
  * Make sure to call one of the following initialize functions before starting logging.
@@ -3,10 +3,21 @@
 //  gomoku-httpd - HTTP server entry point
 //
 
+#if defined(__linux__)
+#define _GNU_SOURCE // sched_setaffinity / CPU_SET for --numa-node binding
+#include <sched.h>
+#endif
+
 #include "cli.h"
+#include "cpu_features.h"
+#include "nnue.h"
+#include "game_pool.h"
+#include "session.h"
 #include "handlers.h"
 #include "httpserver.h"
+#include "json_api.h"
 #include "logger.h"
+#include "snapshot.h"
 #include <arpa/inet.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -16,8 +27,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
 #include <unistd.h>
 
 //===============================================================================
@@ -25,6 +38,8 @@
 //===============================================================================
 
 static volatile sig_atomic_t running = 1;
+static volatile sig_atomic_t shutdown_signal = 0;
+static volatile sig_atomic_t sighup_received = 0;
 
 // Agent thread state
 static pthread_t agent_thread_id;
@@ -80,20 +95,187 @@ static int check_port_available(const char *host, int port) {
   return -1; // Other error
 }
 
+//===============================================================================
+// NUMA NODE BINDING
+//===============================================================================
+
+#if defined(__linux__)
+/**
+ * Pin this process to the CPUs of one NUMA node by parsing the kernel's
+ * cpulist for that node (e.g. "0-15,32-47"). Every thread and prefork
+ * child spawned afterwards inherits the mask, and with the kernel's
+ * first-touch policy any memory those workers fault in — including the
+ * shared TT segment mapped below — lands on the same node. That keeps
+ * the table's probe latency local on dual-socket boxes without pulling
+ * in a libnuma dependency. Returns 0 on success, -1 if the node doesn't
+ * exist or the affinity call fails.
+ */
+static int bind_to_numa_node(int node) {
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+           node);
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    return -1;
+  }
+  char list[512];
+  if (!fgets(list, sizeof(list), f)) {
+    fclose(f);
+    return -1;
+  }
+  fclose(f);
+
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  int count = 0;
+  for (char *token = strtok(list, ","); token; token = strtok(NULL, ",")) {
+    int lo, hi;
+    if (sscanf(token, "%d-%d", &lo, &hi) == 2) {
+      // Range entry
+    } else if (sscanf(token, "%d", &lo) == 1) {
+      hi = lo;
+    } else {
+      continue;
+    }
+    for (int cpu = lo; cpu >= 0 && cpu <= hi && cpu < CPU_SETSIZE; cpu++) {
+      CPU_SET(cpu, &cpus);
+      count++;
+    }
+  }
+  if (count == 0 || sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+    return -1;
+  }
+  return 0;
+}
+#endif // __linux__
+
+//===============================================================================
+// PREFORK SUPERVISOR
+//===============================================================================
+
+// Child pids in prefork mode (parent only). Index of this process among
+// the workers, or -1 in the parent / single-process mode.
+static pid_t prefork_pids[32];
+static int prefork_index = -1;
+
+/**
+ * Fork worker `index`. Returns the child pid in the parent, 0 in the
+ * child (after recording its index), -1 on fork failure.
+ */
+static pid_t prefork_spawn(int index) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    prefork_index = index;
+  }
+  return pid;
+}
+
+/**
+ * Fork `count` workers and supervise them: restart any that die until a
+ * shutdown signal arrives, then terminate and reap the survivors.
+ *
+ * The listening socket is created per-child by httpserver.h, which sets
+ * SO_REUSEPORT, so the kernel load-balances accepted connections across
+ * the workers — no per-worker ports or proxy backends needed.
+ *
+ * Returns 0 in a worker child (the caller continues with normal server
+ * startup), 1 in the parent once all children have been reaped, -1 on
+ * fork failure.
+ */
+static int prefork_supervise(int count) {
+  for (int i = 0; i < count; i++) {
+    pid_t pid = prefork_spawn(i);
+    if (pid < 0) {
+      LOG_FATAL("Failed to fork worker %d: %s", i, strerror(errno));
+      for (int j = 0; j < i; j++) {
+        kill(prefork_pids[j], SIGTERM);
+      }
+      for (int j = 0; j < i; j++) {
+        waitpid(prefork_pids[j], NULL, 0);
+      }
+      return -1;
+    }
+    if (pid == 0) {
+      return 0;
+    }
+    prefork_pids[i] = pid;
+  }
+
+  LOG_INFO("Prefork supervisor: %d workers started (pid %d)", count,
+           (int)getpid());
+
+  while (running) {
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (errno == EINTR) {
+        continue; // Interrupted by signal; re-check running
+      }
+      break;
+    }
+    if (!running) {
+      break;
+    }
+
+    for (int i = 0; i < count; i++) {
+      if (prefork_pids[i] == pid) {
+        if (WIFSIGNALED(status)) {
+          LOG_ERROR("Worker %d (pid %d) killed by signal %d, restarting", i,
+                    (int)pid, WTERMSIG(status));
+        } else {
+          LOG_ERROR("Worker %d (pid %d) exited with status %d, restarting", i,
+                    (int)pid, WEXITSTATUS(status));
+        }
+        // Brief pause so a worker that dies at startup (bad config, port
+        // conflict) doesn't turn the supervisor into a fork bomb.
+        sleep(1);
+        pid_t new_pid = prefork_spawn(i);
+        if (new_pid == 0) {
+          return 0;
+        }
+        if (new_pid < 0) {
+          LOG_ERROR("Failed to restart worker %d: %s", i, strerror(errno));
+          prefork_pids[i] = -1;
+        } else {
+          prefork_pids[i] = new_pid;
+        }
+        break;
+      }
+    }
+  }
+
+  LOG_INFO("Prefork supervisor shutting down workers");
+  for (int i = 0; i < count; i++) {
+    if (prefork_pids[i] > 0) {
+      kill(prefork_pids[i], SIGTERM);
+    }
+  }
+  for (int i = 0; i < count; i++) {
+    if (prefork_pids[i] > 0) {
+      waitpid(prefork_pids[i], NULL, 0);
+    }
+  }
+  return 1;
+}
+
 //===============================================================================
 // HAPROXY AGENT-CHECK THREAD
 //===============================================================================
 
 /**
  * Agent-check thread function.
- * Listens on a TCP port and responds with "ready\n" or "drain\n" based on
- * whether the main thread is currently processing a request.
+ * Listens on a TCP port and answers each connection with the daemon's
+ * free capacity per the HAProxy agent protocol:
  *
- * HAProxy agent-check protocol:
- * - "ready" : Server is idle, can accept new requests
- * - "drain" : Server is busy, don't send new requests
+ * - "up N%" : available; HAProxy scales the backend weight by N
+ * - "drain" : no capacity left, don't send new requests
  * - "down"  : Server is broken (we don't use this)
- * - "up"    : Server is available (we use "ready" instead for clarity)
+ *
+ * With a worker pool N is the unused share of the admission budget
+ * (free workers plus queue headroom), so one long search on a
+ * multi-worker daemon sheds a single slot of weight instead of
+ * binary-excluding the whole backend. In synchronous mode this
+ * degenerates to "up 100%"/"drain".
  */
 static void *agent_thread_func(void *arg) {
   (void)arg; // Unused
@@ -140,13 +322,14 @@ static void *agent_thread_func(void *arg) {
     }
 
     // Determine status and respond
-    const char *status;
-    if (handlers_is_busy()) {
-      status = "drain\n";
-      LOG_DEBUG("Agent-check: responding 'drain' (busy)");
+    char status[32];
+    int pct = handlers_capacity_pct();
+    if (pct <= 0) {
+      snprintf(status, sizeof(status), "drain\n");
+      LOG_DEBUG("Agent-check: responding 'drain' (no capacity)");
     } else {
-      status = "ready\n";
-      LOG_DEBUG("Agent-check: responding 'ready' (idle)");
+      snprintf(status, sizeof(status), "up %d%%\n", pct);
+      LOG_DEBUG("Agent-check: responding 'up %d%%'", pct);
     }
 
     // Send response (best effort, don't retry on partial write)
@@ -252,12 +435,16 @@ static void stop_agent_thread(void) {
 // SIGNAL HANDLERS
 //===============================================================================
 
+// Logging from a signal handler is not async-signal-safe (the logger takes
+// a mutex and stdio may call malloc); a SIGTERM landing mid-allocation used
+// to corrupt the heap and crash in free() during shutdown. The handler only
+// records what happened; the event loop logs it.
 static void signal_handler(int signum) {
   if (signum == SIGTERM || signum == SIGINT) {
-    LOG_INFO("Received signal %d, shutting down...", signum);
+    shutdown_signal = signum;
     running = 0;
   } else if (signum == SIGHUP) {
-    LOG_INFO("Received SIGHUP, reopening log file...");
+    sighup_received = 1;
     // Log file reopen would be handled here if needed
   }
 }
@@ -385,10 +572,21 @@ static int setup_logging(const daemon_config_t *config) {
     logger_initConsoleLogger(stderr);
   }
 
+  // With -A, hand lines to a flusher thread so disk stalls and stderr
+  // contention stay off the request path (the flusher batches fflushes,
+  // so the auto-flush interval above only matters for sync mode)
+  if (config->async_log && !logger_initAsync()) {
+    fprintf(stderr, "Error: Cannot start async logger\n");
+    return -1;
+  }
+
   return 0;
 }
 
-static void cleanup_logging(void) { logger_exitFileLogger(); }
+static void cleanup_logging(void) {
+  logger_exitAsync(); // Drains the ring; no-op unless -A
+  logger_exitFileLogger();
+}
 
 //===============================================================================
 // MAIN
@@ -426,26 +624,8 @@ int main(int argc, char *argv[]) {
   // Setup signal handlers
   setup_signal_handlers();
 
-  // Initialize handlers (threat matrix, etc.)
-  handlers_init();
-
-  // Set scoring report flag
-  if (config.report_scoring) {
-    handlers_set_report_scoring(1);
-    LOG_INFO("Scoring reports enabled in JSON responses");
-  }
-
-  // Start HAProxy agent-check thread if configured
-  if (config.agent_port > 0) {
-    if (start_agent_thread(config.bind_host, config.agent_port) < 0) {
-      fprintf(stderr, "Error: Failed to start agent-check thread on port %d\n",
-              config.agent_port);
-      cleanup_logging();
-      return 1;
-    }
-  }
-
-  // Check if port is available before trying to bind
+  // Check if port is available before trying to bind. In prefork mode
+  // this runs once, before any worker holds the port via SO_REUSEPORT.
   int port_check = check_port_available(config.bind_host, config.bind_port);
   if (port_check == 0) {
     LOG_FATAL("Port %d is already in use. Another process may be listening on "
@@ -465,6 +645,189 @@ int main(int argc, char *argv[]) {
     return 1;
   }
 
+  // NUMA binding (-n/--numa-node): pin to one node's CPUs before the
+  // table mappings and worker spawns below, so first-touch places their
+  // pages node-local. Failure is a warning, not fatal — an unbound
+  // daemon is slower on a two-socket box, not wrong.
+  if (config.numa_node >= 0) {
+#if defined(__linux__)
+    if (bind_to_numa_node(config.numa_node) == 0) {
+      LOG_INFO("Bound table memory and workers to NUMA node %d",
+               config.numa_node);
+    } else {
+      LOG_WARN("Failed to bind to NUMA node %d (node missing or affinity "
+               "denied); running unbound",
+               config.numa_node);
+    }
+#else
+    LOG_WARN("--numa-node ignored: NUMA binding is Linux-only");
+#endif
+  }
+
+  // Shared transposition table (-S/--shared-tt): one anonymous
+  // MAP_SHARED segment adopted by every game state, so any worker's
+  // search warms probes for the rest. Mapped before the prefork fork so
+  // the children inherit the same physical pages.
+  transposition_entry_t *shared_tt_segment = NULL;
+  size_t shared_tt_entries = 0;
+  if (config.shared_tt_mb > 0) {
+    size_t budget = (size_t)config.shared_tt_mb * 1024 * 1024 /
+                    (2 * sizeof(transposition_entry_t));
+    size_t entries = 1;
+    while (entries * 2 <= budget) {
+      entries *= 2;
+    }
+    size_t bytes = 2 * entries * sizeof(transposition_entry_t);
+    void *segment = MAP_FAILED;
+    int hugetlb = 0;
+#ifdef MAP_HUGETLB
+    // Probes hash uniformly over the whole segment, so with 4K pages a
+    // multi-GB table blows the TLB on every lookup. Ask for explicit 2MB
+    // huge pages first; this fails cleanly when the hugepage pool is
+    // empty or the size isn't a multiple of 2MB, and we fall back to
+    // normal pages plus a THP hint.
+    if (bytes % (2u * 1024 * 1024) == 0) {
+      segment = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      hugetlb = segment != MAP_FAILED;
+    }
+#endif
+    if (segment == MAP_FAILED) {
+      segment = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+      if (segment != MAP_FAILED) {
+        madvise(segment, bytes, MADV_HUGEPAGE);
+      }
+#endif
+    }
+    if (segment == MAP_FAILED) {
+      LOG_FATAL("Failed to map %zu MB shared transposition table: %s",
+                bytes / (1024 * 1024), strerror(errno));
+      fprintf(stderr,
+              "Error: Failed to map %zu MB shared transposition table: %s\n",
+              bytes / (1024 * 1024), strerror(errno));
+      cleanup_logging();
+      return 1;
+    }
+    tt_set_shared((transposition_entry_t *)segment, entries);
+    shared_tt_segment = (transposition_entry_t *)segment;
+    shared_tt_entries = entries;
+    LOG_INFO("Shared transposition table: %zu MB (%zu entries per half, "
+             "%s pages)",
+             bytes / (1024 * 1024), entries, hugetlb ? "2MB huge" : "normal");
+
+    // Warm start (-t/--tt-file): refill the segment from the previous
+    // run's shutdown snapshot, so the first requests after a deploy
+    // probe a populated table. Loaded before the prefork fork below —
+    // the children inherit the warmed pages.
+    if (config.tt_file[0]) {
+      if (tt_snapshot_load(shared_tt_segment, shared_tt_entries,
+                           config.tt_file)) {
+        LOG_INFO("Warm-started shared TT from %s", config.tt_file);
+      } else {
+        LOG_INFO("No usable TT snapshot at %s, starting cold",
+                 config.tt_file);
+      }
+    }
+  } else if (config.tt_file[0]) {
+    LOG_WARN("--tt-file ignored: requires --shared-tt");
+  }
+
+  // Prefork multi-process mode (-P/--prefork): fork the workers before
+  // any server state exists. Only worker children fall through to the
+  // normal startup below; the parent supervises and restarts them.
+  if (config.prefork > 0) {
+    int rc = prefork_supervise(config.prefork);
+    if (rc < 0) {
+      cleanup_logging();
+      return 1;
+    }
+    if (rc > 0) {
+      // The workers shared this process's MAP_SHARED segment, so their
+      // accumulated table is still mapped here after they exit.
+      if (shared_tt_segment && config.tt_file[0]) {
+        if (tt_snapshot_save(shared_tt_segment, shared_tt_entries,
+                             config.tt_file)) {
+          LOG_INFO("Saved shared TT snapshot to %s", config.tt_file);
+        } else {
+          LOG_WARN("Failed to save TT snapshot to %s", config.tt_file);
+        }
+      }
+      LOG_INFO("Prefork supervisor exiting");
+      cleanup_logging();
+      return 0;
+    }
+    LOG_INFO("Prefork worker %d starting (pid %d)", prefork_index,
+             (int)getpid());
+    // Give each worker its own agent-check port so HAProxy can track
+    // per-process availability.
+    if (config.agent_port > 0) {
+      config.agent_port += prefork_index;
+    }
+  }
+
+  // Initialize handlers (threat matrix, etc.)
+  handlers_init();
+
+  // Size the per-game warm-context store (-g/--sessions)
+  if (config.sessions > 0) {
+    if (!session_init(config.sessions)) {
+      LOG_FATAL("Failed to allocate session store for %d games",
+                config.sessions);
+      fprintf(stderr, "Error: Failed to allocate session store for %d games\n",
+              config.sessions);
+      cleanup_logging();
+      return 1;
+    }
+    LOG_INFO("Session store enabled (%d warm contexts, %ds TTL)",
+             config.sessions, SESSION_TTL_SECONDS);
+  }
+
+  // Set scoring report flag
+  if (config.report_scoring) {
+    handlers_set_report_scoring(1);
+    LOG_INFO("Scoring reports enabled in JSON responses");
+  }
+
+  // Default request deadline for /gomoku/play (-D/--deadline-ms)
+  if (config.deadline_ms > 0) {
+    handlers_set_default_deadline_ms(config.deadline_ms);
+    LOG_INFO("Default request deadline: %d ms", config.deadline_ms);
+  }
+
+  // Start AI worker threads if requested (-w/--workers)
+  if (config.workers > 0) {
+    if (!handlers_start_workers(config.workers)) {
+      LOG_FATAL("Failed to start %d worker threads", config.workers);
+      fprintf(stderr, "Error: Failed to start %d worker threads\n",
+              config.workers);
+      cleanup_logging();
+      return 1;
+    }
+  }
+
+  // Speculative pondering rides on idle workers over warm contexts, so
+  // it needs both the session store and the worker pool.
+  if (config.ponder) {
+    if (config.sessions > 0 && config.workers > 0) {
+      handlers_set_ponder(1);
+      LOG_INFO("Speculative pondering enabled");
+    } else {
+      LOG_WARN("--ponder ignored: requires both --sessions and --workers");
+    }
+  }
+
+  // Start HAProxy agent-check thread if configured
+  if (config.agent_port > 0) {
+    if (start_agent_thread(config.bind_host, config.agent_port) < 0) {
+      fprintf(stderr, "Error: Failed to start agent-check thread on port %d\n",
+              config.agent_port);
+      cleanup_logging();
+      return 1;
+    }
+  }
+
   // Create HTTP server
   struct http_server_s *server =
       http_server_init(config.bind_port, handle_request);
@@ -474,7 +837,36 @@ int main(int argc, char *argv[]) {
     return 1;
   }
 
+  if (config.keep_alive_idle > 0) {
+    http_server_set_keep_alive(server, config.keep_alive_idle,
+                               config.keep_alive_max);
+    if (config.keep_alive_max > 0) {
+      LOG_INFO("Keep-alive: %ds idle timeout, %d requests per connection",
+               config.keep_alive_idle, config.keep_alive_max);
+    } else {
+      LOG_INFO("Keep-alive: %ds idle timeout, unlimited requests per "
+               "connection",
+               config.keep_alive_idle);
+    }
+  }
+
   LOG_INFO("gomoku-httpd v%s starting", DAEMON_VERSION);
+  LOG_INFO("CPU SIMD features: %s", cpu_simd_features());
+
+  // Optional learned evaluator, shared read-only by every game.
+  static nnue_model_t nnue_model;
+  if (strlen(config.nnue_file) > 0) {
+    if (!nnue_load(&nnue_model, config.nnue_file)) {
+      LOG_FATAL("Failed to load NNUE weights from %s", config.nnue_file);
+      fprintf(stderr, "Error: Failed to load NNUE weights from '%s'\n",
+              config.nnue_file);
+      cleanup_logging();
+      return 1;
+    }
+    nnue_set_default(&nnue_model);
+    LOG_INFO("NNUE evaluator enabled (%d hidden units, weights: %s)",
+             nnue_model.hidden, config.nnue_file);
+  }
 
   // Start listening using polling mode for graceful shutdown support
   int result;
@@ -517,18 +909,51 @@ int main(int argc, char *argv[]) {
 
   LOG_INFO("Listening on %s:%d", config.bind_host, config.bind_port);
 
-  // Event loop with graceful shutdown support
+  // Event loop with graceful shutdown support. Worker-completed responses
+  // must be sent from this thread, so poll with a short timeout while any
+  // job is in flight and flush completions after every wakeup.
   while (running) {
-    int poll_result = http_server_poll(server);
+    int poll_result =
+        http_server_poll_timeout(server, handlers_inflight() > 0 ? 1 : 100);
+    handlers_drain_completions();
+    if (sighup_received) {
+      sighup_received = 0;
+      LOG_INFO("Received SIGHUP, reopening log file...");
+    }
     if (poll_result < 0) {
       // Error or shutdown
       break;
     }
   }
 
+  if (shutdown_signal) {
+    LOG_INFO("Received signal %d, shutting down...", (int)shutdown_signal);
+  }
+
+  // Stop worker threads before tearing down the game pool
+  handlers_stop_workers();
+
+  // Persist the shared TT for the next boot's warm start. Workers are
+  // stopped, so nothing writes the segment while it streams out. In
+  // prefork mode the supervisor saves instead, after all workers exit.
+  if (shared_tt_segment && config.tt_file[0] && config.prefork == 0) {
+    if (tt_snapshot_save(shared_tt_segment, shared_tt_entries,
+                         config.tt_file)) {
+      LOG_INFO("Saved shared TT snapshot to %s", config.tt_file);
+    } else {
+      LOG_WARN("Failed to save TT snapshot to %s", config.tt_file);
+    }
+  }
+
+  // Free warm session contexts
+  session_drain();
+
   // Stop agent thread if running
   stop_agent_thread();
 
+  // Free pooled game-state contexts
+  game_pool_drain();
+
   LOG_INFO("Server stopped");
   cleanup_logging();
 
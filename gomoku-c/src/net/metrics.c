@@ -0,0 +1,333 @@
+//
+//  metrics.c
+//  gomoku-httpd - Prometheus-style counters for the /metrics endpoint
+//
+
+#include "metrics.h"
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//===============================================================================
+// COUNTER STORAGE
+//===============================================================================
+
+#define METRIC_ADD(var, n) __atomic_fetch_add(&(var), (n), __ATOMIC_RELAXED)
+#define METRIC_READ(var) __atomic_load_n(&(var), __ATOMIC_RELAXED)
+
+// Latency histogram bucket upper bounds in microseconds (rendered as
+// seconds). Spans sub-millisecond health checks up to deep searches.
+static const uint64_t bucket_bounds_us[] = {
+    1000,    2500,    5000,    10000,   25000,    50000,   100000,
+    250000,  500000,  1000000, 2500000, 5000000, 10000000,
+};
+#define BUCKET_COUNT ((int)(sizeof(bucket_bounds_us) / sizeof(bucket_bounds_us[0])))
+
+// Endpoint labels are a fixed set so scrape cardinality stays bounded no
+// matter what paths clients probe; everything unrecognized is "other".
+static const char *const endpoint_names[] = {
+    "/health", "/ready", "/gomoku/play", "/gomoku/analyze/batch",
+    "/metrics", "other",
+};
+#define ENDPOINT_COUNT ((int)(sizeof(endpoint_names) / sizeof(endpoint_names[0])))
+
+typedef struct {
+  uint64_t buckets[BUCKET_COUNT]; // Per-bucket (non-cumulative) counts
+  uint64_t overflow;              // Observations above the last bound
+  uint64_t sum_us;
+  uint64_t count;
+  uint64_t by_class[6]; // Responses by status class (index status/100)
+} endpoint_stats_t;
+
+static endpoint_stats_t endpoints[ENDPOINT_COUNT];
+
+// Search statistics
+static uint64_t searches_total = 0;
+static uint64_t search_us_total = 0;
+static uint64_t search_positions_total = 0;
+static uint64_t tt_probes_total = 0;
+static uint64_t tt_hits_total = 0;
+
+// Per-evaluator statistics. The engine emits a small fixed set of names
+// ("have_win", "block_threat", "have_vct", "minimax", ...); slots are
+// claimed once by CAS on the name pointer, after which only the counters
+// move. The name strings are compile-time literals in ai.c, so keeping
+// the pointer is safe.
+#define MAX_EVALUATOR_SLOTS 16
+
+typedef struct {
+  const char *name; // NULL = free slot
+  uint64_t runs;
+  uint64_t us_total;
+  uint64_t decisive;
+} evaluator_stats_t;
+
+static evaluator_stats_t evaluators[MAX_EVALUATOR_SLOTS];
+
+//===============================================================================
+// HOT-PATH RECORDING
+//===============================================================================
+
+static endpoint_stats_t *endpoint_for_path(const char *path) {
+  if (path) {
+    for (int i = 0; i < ENDPOINT_COUNT - 1; i++) {
+      if (strcmp(path, endpoint_names[i]) == 0) {
+        return &endpoints[i];
+      }
+    }
+  }
+  return &endpoints[ENDPOINT_COUNT - 1]; // "other"
+}
+
+void metrics_observe_request(const char *path, int status, double seconds) {
+  endpoint_stats_t *ep = endpoint_for_path(path);
+  uint64_t us = (uint64_t)(seconds * 1000000.0);
+
+  int b = 0;
+  while (b < BUCKET_COUNT && us > bucket_bounds_us[b]) {
+    b++;
+  }
+  if (b < BUCKET_COUNT) {
+    METRIC_ADD(ep->buckets[b], 1);
+  } else {
+    METRIC_ADD(ep->overflow, 1);
+  }
+  METRIC_ADD(ep->sum_us, us);
+  METRIC_ADD(ep->count, 1);
+
+  int cls = status / 100;
+  if (cls < 1 || cls > 5) {
+    cls = 0;
+  }
+  METRIC_ADD(ep->by_class[cls], 1);
+}
+
+static evaluator_stats_t *evaluator_slot(const char *name) {
+  for (int i = 0; i < MAX_EVALUATOR_SLOTS; i++) {
+    const char *have = __atomic_load_n(&evaluators[i].name, __ATOMIC_ACQUIRE);
+    if (have == NULL) {
+      const char *expected = NULL;
+      if (__atomic_compare_exchange_n(&evaluators[i].name, &expected, name, 0,
+                                      __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return &evaluators[i];
+      }
+      have = expected; // Someone else claimed it; check for a name match
+    }
+    if (strcmp(have, name) == 0) {
+      return &evaluators[i];
+    }
+  }
+  return NULL; // Table full: drop the observation
+}
+
+void metrics_observe_search(double seconds, long positions,
+                            unsigned long long tt_probes,
+                            unsigned long long tt_hits,
+                            const scoring_report_t *report) {
+  METRIC_ADD(searches_total, 1);
+  METRIC_ADD(search_us_total, (uint64_t)(seconds * 1000000.0));
+  if (positions > 0) {
+    METRIC_ADD(search_positions_total, (uint64_t)positions);
+  }
+  METRIC_ADD(tt_probes_total, tt_probes);
+  METRIC_ADD(tt_hits_total, tt_hits);
+
+  if (!report) {
+    return;
+  }
+  for (int i = 0; i < report->entry_count; i++) {
+    const scoring_entry_t *e = &report->entries[i];
+    evaluator_stats_t *slot = evaluator_slot(e->evaluator);
+    if (!slot) {
+      continue;
+    }
+    METRIC_ADD(slot->runs, 1);
+    METRIC_ADD(slot->us_total, (uint64_t)(e->time_ms * 1000.0));
+    if (e->decisive) {
+      METRIC_ADD(slot->decisive, 1);
+    }
+  }
+}
+
+//===============================================================================
+// EXPOSITION
+//===============================================================================
+
+// Render buffer: the label sets are bounded (6 endpoints x 14 histogram
+// lines plus a few dozen scalar lines), so a fixed allocation with
+// snprintf bounds checking is plenty.
+#define RENDER_BUF_SIZE 65536
+
+static int render_append(char *buf, int pos, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+static int render_append(char *buf, int pos, const char *fmt, ...) {
+  if (pos < 0 || pos >= RENDER_BUF_SIZE) {
+    return -1;
+  }
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(buf + pos, (size_t)(RENDER_BUF_SIZE - pos), fmt, args);
+  va_end(args);
+  if (n < 0 || n >= RENDER_BUF_SIZE - pos) {
+    return -1; // Truncated: fail the render rather than emit a cut line
+  }
+  return pos + n;
+}
+
+char *metrics_render(int queue_depth, int in_flight) {
+  char *buf = malloc(RENDER_BUF_SIZE);
+  if (!buf) {
+    return NULL;
+  }
+  int pos = 0;
+
+  // Request counts by endpoint and status class
+  pos = render_append(buf, pos,
+                      "# HELP gomoku_httpd_requests_total HTTP responses "
+                      "sent, by endpoint and status class.\n"
+                      "# TYPE gomoku_httpd_requests_total counter\n");
+  for (int i = 0; i < ENDPOINT_COUNT; i++) {
+    for (int cls = 1; cls <= 5; cls++) {
+      uint64_t n = METRIC_READ(endpoints[i].by_class[cls]);
+      if (n == 0) {
+        continue;
+      }
+      pos = render_append(
+          buf, pos, "gomoku_httpd_requests_total{endpoint=\"%s\",code=\"%dxx\"} %llu\n",
+          endpoint_names[i], cls, (unsigned long long)n);
+    }
+  }
+
+  // Request latency histograms
+  pos = render_append(
+      buf, pos,
+      "# HELP gomoku_httpd_request_duration_seconds HTTP request latency "
+      "from accept to response write.\n"
+      "# TYPE gomoku_httpd_request_duration_seconds histogram\n");
+  for (int i = 0; i < ENDPOINT_COUNT; i++) {
+    uint64_t count = METRIC_READ(endpoints[i].count);
+    if (count == 0) {
+      continue;
+    }
+    uint64_t cumulative = 0;
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+      cumulative += METRIC_READ(endpoints[i].buckets[b]);
+      pos = render_append(buf, pos,
+                          "gomoku_httpd_request_duration_seconds_bucket{"
+                          "endpoint=\"%s\",le=\"%g\"} %llu\n",
+                          endpoint_names[i],
+                          (double)bucket_bounds_us[b] / 1000000.0,
+                          (unsigned long long)cumulative);
+    }
+    cumulative += METRIC_READ(endpoints[i].overflow);
+    pos = render_append(buf, pos,
+                        "gomoku_httpd_request_duration_seconds_bucket{"
+                        "endpoint=\"%s\",le=\"+Inf\"} %llu\n",
+                        endpoint_names[i], (unsigned long long)cumulative);
+    pos = render_append(
+        buf, pos,
+        "gomoku_httpd_request_duration_seconds_sum{endpoint=\"%s\"} %.6f\n",
+        endpoint_names[i],
+        (double)METRIC_READ(endpoints[i].sum_us) / 1000000.0);
+    pos = render_append(
+        buf, pos,
+        "gomoku_httpd_request_duration_seconds_count{endpoint=\"%s\"} %llu\n",
+        endpoint_names[i], (unsigned long long)count);
+  }
+
+  // Search statistics: positions/sec and TT hit rate fall out of rate()
+  // over these counters. Search time is also the server's busy time (it
+  // brackets exactly the handlers_set_busy/handlers_set_ready window).
+  pos = render_append(
+      buf, pos,
+      "# HELP gomoku_httpd_searches_total AI searches completed.\n"
+      "# TYPE gomoku_httpd_searches_total counter\n"
+      "gomoku_httpd_searches_total %llu\n"
+      "# HELP gomoku_httpd_search_seconds_total Wall-clock time spent in "
+      "AI search (equals busy time).\n"
+      "# TYPE gomoku_httpd_search_seconds_total counter\n"
+      "gomoku_httpd_search_seconds_total %.6f\n"
+      "# HELP gomoku_httpd_search_positions_total Positions evaluated "
+      "across all searches.\n"
+      "# TYPE gomoku_httpd_search_positions_total counter\n"
+      "gomoku_httpd_search_positions_total %llu\n"
+      "# HELP gomoku_httpd_tt_probes_total Transposition table probes.\n"
+      "# TYPE gomoku_httpd_tt_probes_total counter\n"
+      "gomoku_httpd_tt_probes_total %llu\n"
+      "# HELP gomoku_httpd_tt_hits_total Transposition probes answered by "
+      "a usable entry.\n"
+      "# TYPE gomoku_httpd_tt_hits_total counter\n"
+      "gomoku_httpd_tt_hits_total %llu\n",
+      (unsigned long long)METRIC_READ(searches_total),
+      (double)METRIC_READ(search_us_total) / 1000000.0,
+      (unsigned long long)METRIC_READ(search_positions_total),
+      (unsigned long long)METRIC_READ(tt_probes_total),
+      (unsigned long long)METRIC_READ(tt_hits_total));
+
+  // Per-evaluator timings from the scoring pipeline (VCT, minimax, ...)
+  pos = render_append(
+      buf, pos,
+      "# HELP gomoku_httpd_evaluator_runs_total Scoring pipeline steps "
+      "executed, by evaluator.\n"
+      "# TYPE gomoku_httpd_evaluator_runs_total counter\n");
+  for (int i = 0; i < MAX_EVALUATOR_SLOTS; i++) {
+    const char *name = __atomic_load_n(&evaluators[i].name, __ATOMIC_ACQUIRE);
+    if (!name) {
+      continue;
+    }
+    pos = render_append(
+        buf, pos, "gomoku_httpd_evaluator_runs_total{evaluator=\"%s\"} %llu\n",
+        name, (unsigned long long)METRIC_READ(evaluators[i].runs));
+  }
+  pos = render_append(
+      buf, pos,
+      "# HELP gomoku_httpd_evaluator_seconds_total Wall-clock time per "
+      "evaluator.\n"
+      "# TYPE gomoku_httpd_evaluator_seconds_total counter\n");
+  for (int i = 0; i < MAX_EVALUATOR_SLOTS; i++) {
+    const char *name = __atomic_load_n(&evaluators[i].name, __ATOMIC_ACQUIRE);
+    if (!name) {
+      continue;
+    }
+    pos = render_append(
+        buf, pos,
+        "gomoku_httpd_evaluator_seconds_total{evaluator=\"%s\"} %.6f\n", name,
+        (double)METRIC_READ(evaluators[i].us_total) / 1000000.0);
+  }
+  pos = render_append(
+      buf, pos,
+      "# HELP gomoku_httpd_evaluator_decisive_total Moves decided by each "
+      "evaluator.\n"
+      "# TYPE gomoku_httpd_evaluator_decisive_total counter\n");
+  for (int i = 0; i < MAX_EVALUATOR_SLOTS; i++) {
+    const char *name = __atomic_load_n(&evaluators[i].name, __ATOMIC_ACQUIRE);
+    if (!name) {
+      continue;
+    }
+    pos = render_append(
+        buf, pos,
+        "gomoku_httpd_evaluator_decisive_total{evaluator=\"%s\"} %llu\n", name,
+        (unsigned long long)METRIC_READ(evaluators[i].decisive));
+  }
+
+  // Queue gauges, sampled by the caller
+  pos = render_append(
+      buf, pos,
+      "# HELP gomoku_httpd_queue_depth Play jobs waiting for a worker.\n"
+      "# TYPE gomoku_httpd_queue_depth gauge\n"
+      "gomoku_httpd_queue_depth %d\n"
+      "# HELP gomoku_httpd_requests_in_flight Accepted play requests not "
+      "yet responded to.\n"
+      "# TYPE gomoku_httpd_requests_in_flight gauge\n"
+      "gomoku_httpd_requests_in_flight %d\n",
+      queue_depth, in_flight);
+
+  if (pos < 0) {
+    free(buf);
+    return NULL;
+  }
+  return buf;
+}
@@ -0,0 +1,62 @@
+//
+//  metrics.h
+//  gomoku-httpd - Prometheus-style counters for the /metrics endpoint
+//
+
+#ifndef NET_METRICS_H
+#define NET_METRICS_H
+
+#include "ai.h" // scoring_report_t
+
+//===============================================================================
+// HOT-PATH RECORDING
+//===============================================================================
+//
+// All counters are plain uint64 statics bumped with relaxed atomic adds
+// (the same __atomic_* discipline the engine's shared TT uses), so the
+// worker threads and the event loop record without locks. The /metrics
+// endpoint renders a consistent-enough snapshot by reading the same way;
+// monitoring doesn't need cross-counter atomicity.
+
+/**
+ * Record one completed HTTP request. Called wherever a response is sent,
+ * after the latency is known.
+ *
+ * @param path Request path (mapped to a bounded endpoint label set)
+ * @param status HTTP status code sent
+ * @param seconds Wall-clock request latency
+ */
+void metrics_observe_request(const char *path, int status, double seconds);
+
+/**
+ * Record one AI search: think time (which is exactly the window the
+ * server reports itself busy), positions searched, the TT probe/hit
+ * delta for the search, and per-evaluator timings from the scoring
+ * report (NULL or empty for the center/adjacent opening shortcuts).
+ *
+ * @param seconds Search wall-clock time
+ * @param positions Positions evaluated by the search
+ * @param tt_probes Transposition probes issued during the search
+ * @param tt_hits Probes answered by a usable entry
+ * @param report Scoring pipeline report for the move (may be NULL)
+ */
+void metrics_observe_search(double seconds, long positions,
+                            unsigned long long tt_probes,
+                            unsigned long long tt_hits,
+                            const scoring_report_t *report);
+
+//===============================================================================
+// EXPOSITION
+//===============================================================================
+
+/**
+ * Render all metrics in the Prometheus text exposition format.
+ * Queue gauges are sampled by the caller (handlers.c owns that state).
+ *
+ * @param queue_depth Jobs waiting for a worker
+ * @param in_flight Accepted play requests not yet responded to
+ * @return Allocated text body (caller must free), or NULL on error
+ */
+char *metrics_render(int queue_depth, int in_flight);
+
+#endif // NET_METRICS_H
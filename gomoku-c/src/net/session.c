@@ -0,0 +1,220 @@
+//
+//  session.c
+//  gomoku-httpd - per-game warm search-context cache
+//
+
+#include "session.h"
+#include "game_pool.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//===============================================================================
+// STORE STATE
+//===============================================================================
+
+typedef struct {
+  char id[SESSION_ID_MAX]; // Empty string = free slot
+  game_state_t *game;
+  time_t last_used;
+} session_slot_t;
+
+// Checked-out contexts waiting to be stored again. One malloc'd record
+// per in-flight request with a session id; the list is as short as the
+// worker count, so a linked list is plenty.
+typedef struct session_loan_s {
+  char id[SESSION_ID_MAX];
+  game_state_t *game;
+  struct session_loan_s *next;
+} session_loan_t;
+
+static session_slot_t *slots = NULL;
+static int slot_count = 0;
+static session_loan_t *loans = NULL;
+
+// Requests for different games hit the store concurrently from worker
+// threads; every operation is a short scan, so one mutex is plenty.
+static pthread_mutex_t session_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+//===============================================================================
+// INTERNAL HELPERS
+//===============================================================================
+
+/**
+ * Release every slot whose idle time exceeded the TTL back to the game
+ * pool. Called with session_mutex held; the game releases happen after
+ * unlocking via the out list the caller drains.
+ */
+static int collect_expired(time_t now, game_state_t **out, int out_cap) {
+  int n = 0;
+  for (int i = 0; i < slot_count && n < out_cap; i++) {
+    if (slots[i].id[0] && now - slots[i].last_used > SESSION_TTL_SECONDS) {
+      out[n++] = slots[i].game;
+      slots[i].id[0] = '\0';
+      slots[i].game = NULL;
+    }
+  }
+  return n;
+}
+
+//===============================================================================
+// PUBLIC FUNCTIONS
+//===============================================================================
+
+int session_init(int capacity) {
+  if (capacity <= 0) {
+    return 1; // Store disabled; take misses and release forwards
+  }
+  slots = calloc((size_t)capacity, sizeof(session_slot_t));
+  if (!slots) {
+    return 0;
+  }
+  slot_count = capacity;
+  return 1;
+}
+
+game_state_t *session_take(const char *id) {
+  if (!slots || !id || !id[0] || strlen(id) >= SESSION_ID_MAX) {
+    return NULL;
+  }
+
+  game_state_t *expired[8];
+  int expired_count;
+  game_state_t *game = NULL;
+  time_t now = time(NULL);
+
+  pthread_mutex_lock(&session_mutex);
+  expired_count = collect_expired(now, expired, 8);
+  for (int i = 0; i < slot_count; i++) {
+    if (slots[i].id[0] && strcmp(slots[i].id, id) == 0) {
+      game = slots[i].game;
+      slots[i].id[0] = '\0';
+      slots[i].game = NULL;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&session_mutex);
+
+  for (int i = 0; i < expired_count; i++) {
+    game_pool_release(expired[i]);
+  }
+  return game;
+}
+
+void session_loan(const char *id, game_state_t *game) {
+  if (!slots || !id || !id[0] || strlen(id) >= SESSION_ID_MAX || !game) {
+    return;
+  }
+  session_loan_t *loan = malloc(sizeof(session_loan_t));
+  if (!loan) {
+    return; // The game just goes back to the pool on release
+  }
+  strncpy(loan->id, id, SESSION_ID_MAX - 1);
+  loan->id[SESSION_ID_MAX - 1] = '\0';
+  loan->game = game;
+
+  pthread_mutex_lock(&session_mutex);
+  loan->next = loans;
+  loans = loan;
+  pthread_mutex_unlock(&session_mutex);
+}
+
+int session_id_of(const game_state_t *game, char *out, size_t cap) {
+  if (!game || !out || cap == 0) {
+    return 0;
+  }
+  int found = 0;
+  pthread_mutex_lock(&session_mutex);
+  for (session_loan_t *loan = loans; loan; loan = loan->next) {
+    if (loan->game == game) {
+      strncpy(out, loan->id, cap - 1);
+      out[cap - 1] = '\0';
+      found = 1;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&session_mutex);
+  return found;
+}
+
+void session_release(game_state_t *game) {
+  if (!game) {
+    return;
+  }
+
+  char id[SESSION_ID_MAX] = "";
+  game_state_t *evicted = NULL;
+
+  pthread_mutex_lock(&session_mutex);
+  session_loan_t **link = &loans;
+  while (*link) {
+    if ((*link)->game == game) {
+      session_loan_t *loan = *link;
+      *link = loan->next;
+      // loan->id came from the bounded, padded copy in session_loan, so
+      // the full-buffer memcpy always carries a terminator with it.
+      memcpy(id, loan->id, SESSION_ID_MAX);
+      free(loan);
+      break;
+    }
+    link = &(*link)->next;
+  }
+
+  if (id[0]) {
+    // Prefer a free slot, or a stale entry for the same id (two
+    // in-flight requests raced on one game — replace, don't duplicate).
+    // Otherwise evict the least recently used entry.
+    int target = -1;
+    for (int i = 0; i < slot_count; i++) {
+      if (!slots[i].id[0] || strcmp(slots[i].id, id) == 0) {
+        target = i;
+        break;
+      }
+    }
+    if (target < 0) {
+      target = 0;
+      for (int i = 1; i < slot_count; i++) {
+        if (slots[i].last_used < slots[target].last_used) {
+          target = i;
+        }
+      }
+    }
+    evicted = slots[target].game; // NULL for a free slot
+    strncpy(slots[target].id, id, SESSION_ID_MAX - 1);
+    slots[target].id[SESSION_ID_MAX - 1] = '\0';
+    slots[target].game = game;
+    slots[target].last_used = time(NULL);
+    game = NULL;
+  }
+  pthread_mutex_unlock(&session_mutex);
+
+  if (evicted) {
+    game_pool_release(evicted);
+  }
+  if (game) {
+    game_pool_release(game);
+  }
+}
+
+void session_drain(void) {
+  pthread_mutex_lock(&session_mutex);
+  for (int i = 0; i < slot_count; i++) {
+    if (slots[i].game) {
+      cleanup_game(slots[i].game);
+    }
+  }
+  free(slots);
+  slots = NULL;
+  slot_count = 0;
+  while (loans) {
+    session_loan_t *loan = loans;
+    loans = loan->next;
+    if (loan->game) {
+      cleanup_game(loan->game);
+    }
+    free(loan);
+  }
+  pthread_mutex_unlock(&session_mutex);
+}
@@ -0,0 +1,82 @@
+//
+//  session.h
+//  gomoku-httpd - per-game warm search-context cache
+//
+
+#ifndef NET_SESSION_H
+#define NET_SESSION_H
+
+#include "game.h"
+
+//===============================================================================
+// SESSION STORE
+//===============================================================================
+//
+// The /gomoku/play API is stateless: every request rebuilds the board
+// from JSON and searches cold, discarding the transposition table,
+// killer/history tables, and cross-turn VCT carry-over that the SAME
+// game's previous move just populated. When the client supplies a
+// `session_id` string and the store is enabled (-g/--sessions), the
+// daemon keeps the finished request's game_state_t keyed by that id.
+// The next request for the id whose move list extends the stored
+// history replays only the new moves onto the warm context instead of
+// rebuilding, so mid-game searches start with a hot TT and a reusable
+// forced-win proof.
+//
+// Eviction is LRU when the store is full plus a TTL on idle entries, so
+// abandoned games drift back into the game pool on their own. Ids are
+// opaque client strings up to SESSION_ID_MAX - 1 bytes; longer ids are
+// treated as absent (a cold request), never truncated — truncation
+// could alias two games.
+
+#define SESSION_ID_MAX 64
+
+// Idle entries older than this are released back to the game pool the
+// next time the store is touched.
+#define SESSION_TTL_SECONDS 900
+
+/**
+ * Size the store for up to `capacity` concurrent games. 0 disables the
+ * store entirely (every session_take misses, session_release forwards
+ * to game_pool_release). Called once at startup, before any workers.
+ *
+ * @return 1 on success, 0 on allocation failure
+ */
+int session_init(int capacity);
+
+/**
+ * Check out the warm context stored under `id`, or NULL on miss (id
+ * unknown, expired, store disabled). The caller owns the returned game
+ * until it passes it to session_release(). Thread-safe.
+ */
+game_state_t *session_take(const char *id);
+
+/**
+ * Record that `game` should be stored under `id` when it is released.
+ * Called by the parser for every request that carries a session id,
+ * whether the context came from the store or the pool. Thread-safe.
+ */
+void session_loan(const char *id, game_state_t *game);
+
+/**
+ * Give a context back. Loaned games are stored under their session id
+ * (evicting the LRU entry if the store is full); everything else is
+ * forwarded to game_pool_release(). Safe to call with NULL.
+ * Thread-safe.
+ */
+void session_release(game_state_t *game);
+
+/**
+ * Look up the session id a loaned-out context will be stored under.
+ * Copies the id into `out` and returns 1, or returns 0 when the game
+ * carries no loan (stateless request, store disabled). Thread-safe.
+ */
+int session_id_of(const game_state_t *game, char *out, size_t cap);
+
+/**
+ * Free all stored contexts and loan records. Called once at daemon
+ * shutdown, after the workers have stopped and before game_pool_drain().
+ */
+void session_drain(void);
+
+#endif // NET_SESSION_H
@@ -10,6 +10,7 @@
 #include <getopt.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -18,6 +19,7 @@
 #include <time.h>
 #include <unistd.h>
 
+#include "load_gen.h"
 #include "test_client_utils.h"
 
 #define DEFAULT_HOST "127.0.0.1"
@@ -107,31 +109,34 @@ static void timer_tick_fn(void *ctx);
 // HTTP CLIENT
 //===============================================================================
 
-/**
- * Send HTTP POST request and receive response.
- * Calls tick_cb(tick_ctx) approximately every second while waiting for data.
- * Returns response body (caller must free) or NULL on error.
- * If http_status is non-NULL, the HTTP status code is stored there.
- */
-static char *http_post(const char *host, int port, const char *path,
-                       const char *body, int *http_status,
-                       void (*tick_cb)(void *), void *tick_ctx) {
-  // Create socket
+// Persistent keep-alive connections, one per distinct server port (the
+// client talks to at most two daemons in -p X:O mode). --no-keep-alive
+// restores the original one-connection-per-request behavior.
+#define KA_MAX_CONNS 2
+
+typedef struct {
+  int sock;
+  int port;
+} ka_conn_t;
+
+static ka_conn_t ka_conns[KA_MAX_CONNS] = {{-1, 0}, {-1, 0}};
+static int keep_alive_enabled = 1;
+
+/** Connect a fresh TCP socket to host:port, or return -1. */
+static int http_connect(const char *host, int port) {
   int sock = socket(AF_INET, SOCK_STREAM, 0);
   if (sock < 0) {
     fprintf(stderr, "Error: Failed to create socket: %s\n", strerror(errno));
-    return NULL;
+    return -1;
   }
 
-  // Resolve host
   struct hostent *server = gethostbyname(host);
   if (!server) {
     fprintf(stderr, "Error: Failed to resolve host '%s'\n", host);
     close(sock);
-    return NULL;
+    return -1;
   }
 
-  // Connect
   struct sockaddr_in addr;
   memset(&addr, 0, sizeof(addr));
   addr.sin_family = AF_INET;
@@ -142,41 +147,115 @@ static char *http_post(const char *host, int port, const char *path,
     fprintf(stderr, "Error: Failed to connect to %s:%d: %s\n", host, port,
             strerror(errno));
     close(sock);
-    return NULL;
+    return -1;
   }
+  return sock;
+}
 
-  // Build HTTP request
-  size_t body_len = strlen(body);
-  char *request = malloc(body_len + 512);
-  if (!request) {
-    close(sock);
-    return NULL;
+/**
+ * Take a pooled keep-alive socket for this port, or connect a new one.
+ * *reused is set to 1 when the socket carried a previous request.
+ */
+static int ka_take(const char *host, int port, int *reused) {
+  *reused = 0;
+  if (keep_alive_enabled) {
+    for (int i = 0; i < KA_MAX_CONNS; i++) {
+      if (ka_conns[i].sock >= 0 && ka_conns[i].port == port) {
+        int sock = ka_conns[i].sock;
+        ka_conns[i].sock = -1;
+        *reused = 1;
+        return sock;
+      }
+    }
   }
+  return http_connect(host, port);
+}
 
-  int req_len = snprintf(request, body_len + 512,
-                         "POST %s HTTP/1.1\r\n"
-                         "Host: %s:%d\r\n"
-                         "Content-Type: application/json\r\n"
-                         "Content-Length: %zu\r\n"
-                         "Connection: close\r\n"
-                         "\r\n"
-                         "%s",
-                         path, host, port, body_len, body);
-
-  // Send request
-  if (send(sock, request, (size_t)req_len, 0) < 0) {
-    fprintf(stderr, "Error: Failed to send request: %s\n", strerror(errno));
-    free(request);
-    close(sock);
-    return NULL;
+/** Return a still-usable socket to the pool (closes on overflow). */
+static void ka_put(int sock, int port) {
+  for (int i = 0; i < KA_MAX_CONNS; i++) {
+    if (ka_conns[i].sock < 0) {
+      ka_conns[i].sock = sock;
+      ka_conns[i].port = port;
+      return;
+    }
   }
-  free(request);
+  close(sock);
+}
 
-  // Read full response using Content-Length (no fixed 64K limit)
+/**
+ * Send HTTP POST request and receive response, reusing a kept-alive
+ * connection to the same port when possible. A stale pooled socket (the
+ * server timed it out between moves) is detected by the failed send/read
+ * and retried once on a fresh connection.
+ * Calls tick_cb(tick_ctx) approximately every second while waiting for data.
+ * Returns response body (caller must free) or NULL on error.
+ * If http_status is non-NULL, the HTTP status code is stored there.
+ */
+static char *http_post(const char *host, int port, const char *path,
+                       const char *body, int *http_status,
+                       void (*tick_cb)(void *), void *tick_ctx) {
+  char *response_body = NULL;
   size_t response_len = 0;
-  char *response_body = test_client_read_http_response(
-      sock, http_status, &response_len, 0, tick_cb, tick_ctx);
-  close(sock);
+  int server_keep_alive = 0;
+
+  for (int attempt = 0; attempt < 2; attempt++) {
+    int reused = 0;
+    int sock = ka_take(host, port, &reused);
+    if (sock < 0)
+      return NULL;
+
+    // Build HTTP request
+    size_t body_len = strlen(body);
+    char *request = malloc(body_len + 512);
+    if (!request) {
+      close(sock);
+      return NULL;
+    }
+
+    int req_len = snprintf(request, body_len + 512,
+                           "POST %s HTTP/1.1\r\n"
+                           "Host: %s:%d\r\n"
+                           "Content-Type: application/json\r\n"
+                           "Content-Length: %zu\r\n"
+                           "Connection: %s\r\n"
+                           "\r\n"
+                           "%s",
+                           path, host, port, body_len,
+                           keep_alive_enabled ? "keep-alive" : "close", body);
+
+    // Send request
+    if (send(sock, request, (size_t)req_len, 0) < 0) {
+      free(request);
+      close(sock);
+      if (reused)
+        continue; // stale pooled connection; retry on a fresh one
+      fprintf(stderr, "Error: Failed to send request: %s\n", strerror(errno));
+      return NULL;
+    }
+    free(request);
+
+    // Read full response using Content-Length (no fixed 64K limit)
+    response_len = 0;
+    server_keep_alive = 0;
+    response_body = test_client_read_http_response_ex(
+        sock, http_status, &response_len, 0, &server_keep_alive, tick_cb,
+        tick_ctx);
+
+    if (!response_body) {
+      close(sock);
+      if (reused)
+        continue;
+      fprintf(stderr, "Error: Invalid HTTP response\n");
+      return NULL;
+    }
+
+    if (keep_alive_enabled && server_keep_alive)
+      ka_put(sock, port);
+    else
+      close(sock);
+    break;
+  }
 
   if (!response_body) {
     fprintf(stderr, "Error: Invalid HTTP response\n");
@@ -596,6 +675,8 @@ static void print_usage(const char *program) {
   printf("                        daemons (X plays X, O plays O).\n");
   printf("                        Default: %d\n", DEFAULT_PORT);
   printf("      --reverse         Swap the two -p ports: M plays X, N plays O\n");
+  printf("      --no-keep-alive   Open a new TCP connection per request\n");
+  printf("                        (default: reuse keep-alive connections)\n");
   printf("  -X, --x-name <name>   Display name for X in the timing table\n");
   printf("  -O, --o-name <name>   Display name for O in the timing table\n");
   printf(
@@ -607,6 +688,18 @@ static void print_usage(const char *program) {
   printf("  -q, --quiet           No terminal output (for batch/tournament)\n");
   printf("  -v, --verbose         Show game state after each move\n");
   printf("  --help                Show this help message\n\n");
+  printf("LOAD MODE (skips game play; hammers POST /gomoku/play):\n");
+  printf("  -L, --load <n>        Run a load test with n concurrent\n");
+  printf("                        connections, replaying positions from\n");
+  printf("                        recorded games as request bodies\n");
+  printf("      --rate <r>        Target req/s across all connections\n");
+  printf("                        (default: closed loop - as fast as the\n");
+  printf("                        daemon answers)\n");
+  printf("      --warmup <s>      Seconds excluded from the report (default: 5)\n");
+  printf("      --duration <s>    Measured seconds after warmup (default: 30)\n");
+  printf("      --corpus <dir>    Directory of recorded *.json games\n");
+  printf("                        (default: games). -d and -r set the depth\n");
+  printf("                        and radius sent in each request body.\n\n");
   printf("EXAMPLES:\n");
   printf("  %s -p 10000 -d 2:3 -r 3 -b 15 -t 300 -q -j game.json\n", program);
   printf("  # Two daemons; X is served by 9514, O by 9515:\n");
@@ -615,6 +708,10 @@ static void print_usage(const char *program) {
   printf("  %s -p 9514:9515 --reverse -d 3 -r 3\n", program);
   printf("  # Two daemons named in the timing table:\n");
   printf("  %s -p 9514:9515 -X rust -O c99\n", program);
+  printf("  # 8-connection closed-loop load test, depth 2:\n");
+  printf("  %s -p 10000 -L 8 -d 2 --duration 60\n", program);
+  printf("  # Open loop at 20 req/s against the same daemon:\n");
+  printf("  %s -p 10000 -L 8 --rate 20\n", program);
 }
 
 static int parse_depth_arg(const char *optarg, int *depth_x, int *depth_o) {
@@ -672,13 +769,29 @@ int main(int argc, char *argv[]) {
   const char *x_name = NULL;
   const char *o_name = NULL;
 
+  // Load-mode settings (-L enables; see load_gen.h for the semantics)
+  int load_connections = 0;
+  double load_rate = 0.0;
+  double load_warmup = 5.0;
+  double load_duration = 30.0;
+  const char *load_corpus = "games";
+
   // Long-only flags get sentinel values >0xFF (outside the ASCII range)
   // so the getopt_long switch can distinguish them from short flags.
-  enum { OPT_REVERSE = 0x100 };
+  enum {
+    OPT_REVERSE = 0x100,
+    OPT_NO_KEEPALIVE = 0x101,
+    OPT_RATE = 0x102,
+    OPT_WARMUP = 0x103,
+    OPT_DURATION = 0x104,
+    OPT_CORPUS = 0x105,
+  };
 
   static struct option long_options[] = {{"host", required_argument, 0, 'h'},
                                          {"port", required_argument, 0, 'p'},
                                          {"reverse", no_argument, 0, OPT_REVERSE},
+                                         {"no-keep-alive", no_argument, 0,
+                                          OPT_NO_KEEPALIVE},
                                          {"x-name", required_argument, 0, 'X'},
                                          {"o-name", required_argument, 0, 'O'},
                                          {"depth", required_argument, 0, 'd'},
@@ -688,11 +801,20 @@ int main(int argc, char *argv[]) {
                                          {"json", required_argument, 0, 'j'},
                                          {"quiet", no_argument, 0, 'q'},
                                          {"verbose", no_argument, 0, 'v'},
+                                         {"load", required_argument, 0, 'L'},
+                                         {"rate", required_argument, 0,
+                                          OPT_RATE},
+                                         {"warmup", required_argument, 0,
+                                          OPT_WARMUP},
+                                         {"duration", required_argument, 0,
+                                          OPT_DURATION},
+                                         {"corpus", required_argument, 0,
+                                          OPT_CORPUS},
                                          {"help", no_argument, 0, '?'},
                                          {0, 0, 0, 0}};
 
   int c;
-  while ((c = getopt_long(argc, argv, "h:p:X:O:d:r:b:t:j:qv", long_options,
+  while ((c = getopt_long(argc, argv, "h:p:X:O:d:r:b:t:j:L:qv", long_options,
                           NULL)) != -1) {
     switch (c) {
     case 'h':
@@ -709,6 +831,9 @@ int main(int argc, char *argv[]) {
     case OPT_REVERSE:
       reverse_ports = 1;
       break;
+    case OPT_NO_KEEPALIVE:
+      keep_alive_enabled = 0;
+      break;
     case 'X':
       x_name = optarg;
       break;
@@ -745,6 +870,37 @@ int main(int argc, char *argv[]) {
     case 'j':
       json_file = optarg;
       break;
+    case 'L':
+      load_connections = atoi(optarg);
+      if (load_connections < 1 || load_connections > 256) {
+        fprintf(stderr, "Error: -L expects 1-256 connections\n");
+        return 1;
+      }
+      break;
+    case OPT_RATE:
+      load_rate = atof(optarg);
+      if (load_rate <= 0) {
+        fprintf(stderr, "Error: --rate must be positive\n");
+        return 1;
+      }
+      break;
+    case OPT_WARMUP:
+      load_warmup = atof(optarg);
+      if (load_warmup < 0) {
+        fprintf(stderr, "Error: --warmup must be non-negative\n");
+        return 1;
+      }
+      break;
+    case OPT_DURATION:
+      load_duration = atof(optarg);
+      if (load_duration <= 0) {
+        fprintf(stderr, "Error: --duration must be positive\n");
+        return 1;
+      }
+      break;
+    case OPT_CORPUS:
+      load_corpus = optarg;
+      break;
     case 'q':
       quiet = 1;
       break;
@@ -766,6 +922,28 @@ int main(int argc, char *argv[]) {
     port_o = tmp;
   }
 
+  // Writing into a kept-alive socket the server already closed raises
+  // SIGPIPE; treat it as a send() error and reconnect instead.
+  signal(SIGPIPE, SIG_IGN);
+
+  // Load mode replaces game play entirely: workers replay corpus
+  // positions against port_x and print the latency report.
+  if (load_connections > 0) {
+    load_config_t load_cfg = {
+        .host = host,
+        .port = port_x,
+        .corpus_dir = load_corpus,
+        .connections = load_connections,
+        .rate = load_rate,
+        .warmup_sec = load_warmup,
+        .duration_sec = load_duration,
+        .depth = depth_x,
+        .radius = radius,
+        .quiet = quiet,
+    };
+    return load_gen_run(&load_cfg);
+  }
+
   // Disable output buffering for real-time display
   setvbuf(stdout, NULL, _IONBF, 0);
 
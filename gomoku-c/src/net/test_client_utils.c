@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <sys/select.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -182,9 +183,9 @@ char *test_client_create_initial_game_state_ex(int board_size, int depth_x,
 static long parse_content_length(const char *headers, size_t headers_len) {
   const char *end = headers + headers_len;
   const char *q = strstr(headers, "Content-Length:");
-  if (!q || q + 14 > end)
+  if (!q || q + 15 > end)
     return -1;
-  q += 14;
+  q += 15;
   while (q < end && (*q == ' ' || *q == '\t'))
     q++;
   if (q >= end || !isdigit((unsigned char)*q))
@@ -196,9 +197,45 @@ static long parse_content_length(const char *headers, size_t headers_len) {
   return val;
 }
 
+/**
+ * Decide whether the server will keep the connection open after this
+ * response: an explicit "Connection: close" (or HTTP/1.0 without
+ * "keep-alive") means the socket must not be reused.
+ */
+static int headers_keep_alive(const char *headers) {
+  int http10 = strncmp(headers, "HTTP/1.0", 8) == 0;
+  const char *p = headers;
+  while ((p = strstr(p, "\r\n")) != NULL) {
+    p += 2;
+    if (p[0] == '\r' && p[1] == '\n')
+      break; // end of headers; don't scan into the body
+    if (strncasecmp(p, "Connection:", 11) == 0) {
+      p += 11;
+      while (*p == ' ' || *p == '\t')
+        p++;
+      if (strncasecmp(p, "close", 5) == 0)
+        return 0;
+      if (strncasecmp(p, "keep-alive", 10) == 0)
+        return 1;
+    }
+  }
+  return !http10;
+}
+
 char *test_client_read_http_response(int sock, int *out_status,
                                      size_t *out_body_len, size_t max_body_size,
                                      void (*tick_cb)(void *), void *tick_ctx) {
+  return test_client_read_http_response_ex(sock, out_status, out_body_len,
+                                           max_body_size, NULL, tick_cb,
+                                           tick_ctx);
+}
+
+char *test_client_read_http_response_ex(int sock, int *out_status,
+                                        size_t *out_body_len,
+                                        size_t max_body_size,
+                                        int *out_keep_alive,
+                                        void (*tick_cb)(void *),
+                                        void *tick_ctx) {
   if (max_body_size == 0)
     max_body_size = HTTP_DEFAULT_MAX_BODY_SIZE;
 
@@ -252,6 +289,9 @@ char *test_client_read_http_response(int sock, int *out_status,
 
   long content_length = parse_content_length(header_buf, header_len);
 
+  if (out_keep_alive)
+    *out_keep_alive = headers_keep_alive(header_buf);
+
   /* Body may have started in the same read as headers; don't discard it */
   const char *body_start = strstr(header_buf, "\r\n\r\n");
   if (body_start)
@@ -305,6 +345,10 @@ char *test_client_read_http_response(int sock, int *out_status,
     }
     body[body_len] = '\0';
   } else {
+    // Without Content-Length the body is delimited by EOF, so the
+    // connection can't be reused regardless of the headers.
+    if (out_keep_alive)
+      *out_keep_alive = 0;
     body_cap = HTTP_FALLBACK_BODY_SIZE + 1;
     body = malloc(body_cap);
     if (!body) {
@@ -42,6 +42,19 @@ char *test_client_read_http_response(int sock, int *out_status,
                                      size_t *out_body_len, size_t max_body_size,
                                      void (*tick_cb)(void *), void *tick_ctx);
 
+/**
+ * Same as test_client_read_http_response, but also reports whether the
+ * server will keep the connection open (Connection header / HTTP version
+ * semantics; always 0 when the body is EOF-delimited). out_keep_alive may
+ * be NULL.
+ */
+char *test_client_read_http_response_ex(int sock, int *out_status,
+                                        size_t *out_body_len,
+                                        size_t max_body_size,
+                                        int *out_keep_alive,
+                                        void (*tick_cb)(void *),
+                                        void *tick_ctx);
+
 /**
  * Return 1 if the string looks like complete JSON (ends with '}').
  * Used to detect truncated responses.
@@ -0,0 +1,241 @@
+//
+//  bench.c
+//  gomoku - fixed-position search benchmark
+//
+//  Runs find_best_ai_move over a small set of hand-picked positions -
+//  opening, tactical, quiet middlegame and a VCT-dense attack - at a
+//  fixed depth with no timeout, and reports time-to-depth, nodes
+//  searched, nodes/sec, transposition-table hit rate and the per-stage
+//  breakdown from scoring_report_t. The run is deterministic (fixed
+//  rng_seed, fixed depth, fresh state per position), so the node
+//  count in the final one-line summary
+//
+//      Bench: <nodes> nodes <nps> nps
+//
+//  is identical across runs on the same binary, in the style of chess
+//  engines' `bench` command: compare the node count before and after a
+//  search change to catch behaviour regressions, and the nps figure to
+//  catch speed regressions.
+//
+//  Build and run with `make bench`.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ai.h"
+#include "board.h"
+#include "game.h"
+#include "gomoku.h"
+
+#define BENCH_BOARD_SIZE 15
+#define BENCH_DEPTH 6
+
+// One stone of a benchmark position; the list is terminated by x < 0.
+typedef struct {
+  int x;
+  int y;
+  int player;
+} bench_stone_t;
+
+// A benchmark position: a name, the fixed search depth for it, and the
+// stones on the board in the order they were played (X first). Depth is
+// per position because tree sizes differ by orders of magnitude - the
+// quiet position at depth 6 alone would dwarf the rest of the suite.
+typedef struct {
+  const char *name;
+  int depth;
+  bench_stone_t stones[40];
+} bench_position_t;
+
+// clang-format off
+static const bench_position_t positions[] = {
+    // A few stones around the center: exercises the opening-heavy paths
+    // (wide candidate sets, little tactical pruning).
+    {"opening", BENCH_DEPTH,
+     {{7, 7, AI_CELL_CROSSES}, {7, 8, AI_CELL_NAUGHTS},
+      {8, 8, AI_CELL_CROSSES}, {6, 6, AI_CELL_NAUGHTS},
+      {-1, -1, 0}}},
+
+    // X's crossing pairs admit a winning compound combination: the
+    // offensive VCT probe proves it and short-circuits the pipeline.
+    // Covers the attacker's threat-space path rather than minimax.
+    {"tactical", BENCH_DEPTH,
+     {{7, 7, AI_CELL_CROSSES}, {6, 6, AI_CELL_NAUGHTS},
+      {7, 8, AI_CELL_CROSSES}, {6, 8, AI_CELL_NAUGHTS},
+      {9, 6, AI_CELL_CROSSES}, {8, 8, AI_CELL_NAUGHTS},
+      {8, 5, AI_CELL_CROSSES}, {9, 9, AI_CELL_NAUGHTS},
+      {10, 9, AI_CELL_CROSSES}, {10, 6, AI_CELL_NAUGHTS},
+      {-1, -1, 0}}},
+
+    // Scattered development with no three stones of either color close
+    // to a shared line: the search sees a broad, quiet tree - worst
+    // case for pruning, best case for the TT.
+    {"quiet-middlegame", 4,
+     {{7, 7, AI_CELL_CROSSES}, {5, 5, AI_CELL_NAUGHTS},
+      {9, 9, AI_CELL_CROSSES}, {3, 3, AI_CELL_NAUGHTS},
+      {5, 9, AI_CELL_CROSSES}, {11, 11, AI_CELL_NAUGHTS},
+      {11, 5, AI_CELL_CROSSES}, {9, 3, AI_CELL_NAUGHTS},
+      {7, 3, AI_CELL_CROSSES}, {3, 11, AI_CELL_NAUGHTS},
+      {3, 7, AI_CELL_CROSSES}, {11, 9, AI_CELL_NAUGHTS},
+      {12, 10, AI_CELL_CROSSES}, {2, 6, AI_CELL_NAUGHTS},
+      {-1, -1, 0}}},
+
+    // The defender's stress test: O (to move next turn) owns two
+    // separated closed threes, X has only scattered stones. X's own VCT
+    // probe comes up empty, the opponent VCT check proves O's threat,
+    // and the refutation scan re-runs a forced-win search behind every
+    // candidate block - the most threat-space work a single decision
+    // can do in this engine.
+    {"vct-dense", BENCH_DEPTH,
+     {{6, 5, AI_CELL_CROSSES}, {6, 6, AI_CELL_NAUGHTS},
+      {9, 10, AI_CELL_CROSSES}, {6, 7, AI_CELL_NAUGHTS},
+      {3, 4, AI_CELL_CROSSES}, {6, 8, AI_CELL_NAUGHTS},
+      {12, 3, AI_CELL_CROSSES}, {10, 10, AI_CELL_NAUGHTS},
+      {4, 12, AI_CELL_CROSSES}, {11, 10, AI_CELL_NAUGHTS},
+      {2, 2, AI_CELL_CROSSES}, {12, 10, AI_CELL_NAUGHTS},
+      {13, 13, AI_CELL_CROSSES}, {8, 8, AI_CELL_NAUGHTS},
+      {1, 8, AI_CELL_CROSSES}, {9, 7, AI_CELL_NAUGHTS},
+      {-1, -1, 0}}},
+};
+// clang-format on
+
+#define BENCH_POSITION_COUNT ((int)(sizeof(positions) / sizeof(positions[0])))
+
+static game_state_t *make_bench_game(int depth) {
+  cli_config_t cfg;
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.board_size = BENCH_BOARD_SIZE;
+  cfg.max_depth = depth;
+  cfg.skip_welcome = 1;
+  cfg.headless = 1;
+  cfg.search_radius = 3;
+  cfg.leaf_radius = 2;
+  cfg.player_x_type = PLAYER_TYPE_AI;
+  cfg.player_o_type = PLAYER_TYPE_AI;
+  cfg.depth_x = -1;
+  cfg.depth_o = -1;
+  cfg.rng_seed = 12345; // Fixed tie-break stream, see main()
+  return init_game(cfg);
+}
+
+int main(void) {
+  populate_threat_matrix();
+
+  uint64_t total_nodes = 0;
+  double total_time = 0.0;
+
+  printf("%-18s %5s %6s %9s %12s %8s %7s\n", "position", "move", "depth",
+         "time(s)", "nodes", "knps", "tt-hit");
+
+  for (int p = 0; p < BENCH_POSITION_COUNT; p++) {
+    const bench_position_t *pos = &positions[p];
+
+    // Fresh state (with a fixed rng_seed) per position: tie-break
+    // selection in the root loop draws from the game RNG, and a warm TT
+    // from the previous position would make the numbers order-dependent.
+    game_state_t *game = make_bench_game(pos->depth);
+    if (!game) {
+      fprintf(stderr, "bench: failed to allocate game state\n");
+      return 1;
+    }
+
+    move_history_t loaded[40];
+    memset(loaded, 0, sizeof(loaded));
+    int stone_count = 0;
+    while (pos->stones[stone_count].x >= 0) {
+      loaded[stone_count].x = pos->stones[stone_count].x;
+      loaded[stone_count].y = pos->stones[stone_count].y;
+      loaded[stone_count].player = pos->stones[stone_count].player;
+      stone_count++;
+    }
+    if (!bulk_load_moves(game, loaded, stone_count, NULL)) {
+      fprintf(stderr, "bench: bad stone list in position '%s'\n", pos->name);
+      cleanup_game(game);
+      return 1;
+    }
+
+    uint64_t nodes_before = game->search_nodes;
+    uint64_t probes_before = game->tt_probes;
+    uint64_t hits_before = game->tt_hits;
+
+    scoring_report_t report;
+    int bx = -1, by = -1;
+    double start = get_current_time();
+    find_best_ai_move(game, &bx, &by, &report);
+    double elapsed = get_current_time() - start;
+
+    uint64_t nodes = game->search_nodes - nodes_before;
+    uint64_t probes = game->tt_probes - probes_before;
+    uint64_t hits = game->tt_hits - hits_before;
+
+    char move_str[8] = "?";
+    if (bx >= 0) {
+      board_coord_to_notation(bx, by, move_str, sizeof(move_str));
+    }
+    printf("%-18s %5s %6d %9.3f %12llu %8.0f %6.1f%%\n", pos->name, move_str,
+           game->search_progress_depth, elapsed, (unsigned long long)nodes,
+           elapsed > 0 ? (double)nodes / elapsed / 1000.0 : 0.0,
+           probes > 0 ? 100.0 * (double)hits / (double)probes : 0.0);
+
+    // Per-evaluator breakdown from the scoring report: which pipeline
+    // stage burned the time and the nodes for this decision.
+    for (int e = 0; e < report.entry_count; e++) {
+      const scoring_entry_t *entry = &report.entries[e];
+      printf("    %-16s %8.1fms %10llu nodes %8llu evals%s\n",
+             entry->evaluator, entry->time_ms,
+             (unsigned long long)entry->nodes,
+             (unsigned long long)entry->eval_calls,
+             entry->decisive ? "  [decisive]" : "");
+      if (entry->vct_length > 0) {
+        printf("      sequence:");
+        for (int v = 0; v < entry->vct_length; v++) {
+          char seq_str[8];
+          board_coord_to_notation(entry->vct_sequence[v][0],
+                                  entry->vct_sequence[v][1], seq_str,
+                                  sizeof(seq_str));
+          printf(" %s", seq_str);
+        }
+        printf("\n");
+      }
+    }
+
+#ifdef GOMOKU_PROFILE
+    // Hot-path counter breakdown (PROFILE=1 builds only): where the
+    // nodes went, how early the ordering cuts, and table health.
+    {
+      const profile_counters_t *prof = &report.profile;
+      printf("    nodes by depth  :");
+      for (int d = MAX_SEARCH_DEPTH; d >= 0; d--) {
+        if (prof->nodes_by_depth[d] > 0) {
+          printf(" d%d:%llu", d, (unsigned long long)prof->nodes_by_depth[d]);
+        }
+      }
+      printf("\n    cutoffs by move :");
+      for (int b = 0; b < PROFILE_CUTOFF_BINS; b++) {
+        if (prof->cutoffs_by_move_index[b] > 0) {
+          printf(" %d%s:%llu", b, (b == PROFILE_CUTOFF_BINS - 1) ? "+" : "",
+                 (unsigned long long)prof->cutoffs_by_move_index[b]);
+        }
+      }
+      printf("\n    cutoffs %llu (%.1f%% killer)  tt collisions %llu  "
+             "movegen candidates %llu\n",
+             (unsigned long long)prof->cutoffs,
+             prof->cutoffs > 0
+                 ? 100.0 * (double)prof->killer_cutoffs / (double)prof->cutoffs
+                 : 0.0,
+             (unsigned long long)prof->tt_collisions,
+             (unsigned long long)prof->movegen_candidates);
+    }
+#endif
+
+    total_nodes += nodes;
+    total_time += elapsed;
+    cleanup_game(game);
+  }
+
+  printf("\nBench: %llu nodes %.0f nps\n", (unsigned long long)total_nodes,
+         total_time > 0 ? (double)total_nodes / total_time : 0.0);
+  return 0;
+}
@@ -0,0 +1,298 @@
+//
+//  gmr2book.c
+//  gomoku - .gmr corpus to binary opening book compiler
+//
+//  Mines game records into the book layout documented in book.h
+//  (one book per board size; -s selects which games to mine): every
+//  position in the first BOOK_MAX_PLIES plies of a decided game
+//  contributes the move that was played from it, keyed by the
+//  symmetry-canonical zobrist hash and stored in the orientation that
+//  minimised it. Weights count occurrences, with the eventual winner's
+//  moves counted double and the loser's skipped, so when the corpus
+//  disagrees the table keeps the move that won most.
+//
+//  Hashing goes through a real game_state_t and search_make_move, so
+//  the keys are byte-identical to what find_best_ai_move probes with —
+//  there is no reimplementation of the zobrist machinery to drift.
+//
+//  Build with `make gmr2book`; `make build-book` runs the whole
+//  games/*.json -> corpus -> book pipeline.
+//
+//  Usage: gmr2book [-s board_size] [-m min_weight] -o book.gmkb corpus.gmr...
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "book.h"
+#include "game.h"
+#include "gamerec.h"
+
+// One mined (position, move) sample, already in the canonical frame.
+typedef struct {
+  uint64_t key;
+  uint8_t x;
+  uint8_t y;
+  uint32_t weight;
+} sample_t;
+
+static sample_t *samples = NULL;
+static size_t sample_count = 0;
+static size_t sample_cap = 0;
+
+static void add_sample(uint64_t key, int x, int y, uint32_t weight) {
+  if (sample_count == sample_cap) {
+    sample_cap = sample_cap ? sample_cap * 2 : 4096;
+    samples = realloc(samples, sample_cap * sizeof(*samples));
+    if (!samples) {
+      fprintf(stderr, "gmr2book: out of memory\n");
+      exit(1);
+    }
+  }
+  samples[sample_count++] =
+      (sample_t){key, (uint8_t)x, (uint8_t)y, weight};
+}
+
+static int sample_cmp(const void *pa, const void *pb) {
+  const sample_t *a = pa, *b = pb;
+  if (a->key != b->key) {
+    return a->key < b->key ? -1 : 1;
+  }
+  if (a->x != b->x) {
+    return a->x < b->x ? -1 : 1;
+  }
+  if (a->y != b->y) {
+    return a->y < b->y ? -1 : 1;
+  }
+  return 0;
+}
+
+// Minimal headless config, mirroring the Gomocup brain's
+// make_brain_config: the game state is only a zobrist/symmetry tracker
+// here, never searched.
+static game_state_t *make_tracking_game(int board_size) {
+  cli_config_t cfg;
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.board_size = board_size;
+  cfg.max_depth = 1;
+  cfg.skip_welcome = 1;
+  cfg.headless = 1;
+  cfg.search_radius = 3;
+  cfg.leaf_radius = 2;
+  cfg.player_x_type = PLAYER_TYPE_AI;
+  cfg.player_o_type = PLAYER_TYPE_AI;
+  cfg.depth_x = -1;
+  cfg.depth_o = -1;
+  return init_game(cfg);
+}
+
+static int mine_corpus(const char *path, int board_size, int *games) {
+  gamerec_corpus_t corpus;
+  if (!gamerec_open(&corpus, path)) {
+    fprintf(stderr, "gmr2book: skipping %s (failed to open corpus)\n", path);
+    return 0;
+  }
+
+  int mined = 0;
+  size_t cursor = 0;
+  gamerec_view_t view;
+  while (gamerec_next(&corpus, &cursor, &view)) {
+    if (view.board_size != board_size) {
+      fprintf(stderr,
+              "gmr2book: skipping a %dx%d game (book is %dx%d)\n",
+              view.board_size, view.board_size, board_size, board_size);
+      continue;
+    }
+    if (view.result != GAMEREC_RESULT_X_WIN &&
+        view.result != GAMEREC_RESULT_O_WIN &&
+        view.result != GAMEREC_RESULT_DRAW) {
+      continue;  // No recorded outcome - nothing to weight by
+    }
+
+    game_state_t *game = make_tracking_game(board_size);
+    if (!game) {
+      fprintf(stderr, "gmr2book: failed to allocate game state\n");
+      break;
+    }
+
+    int plies = view.move_count < BOOK_MAX_PLIES ? view.move_count
+                                                 : BOOK_MAX_PLIES;
+    for (int i = 0; i < plies; i++) {
+      uint16_t m = view.moves[i];
+      int x = gamerec_move_x(m);
+      int y = gamerec_move_y(m);
+      int player = gamerec_move_player(m);
+      if (x >= board_size || y >= board_size ||
+          game->board[x][y] != AI_CELL_EMPTY) {
+        break;  // Malformed record tail - keep what replayed cleanly
+      }
+
+      uint32_t weight = 1;
+      if (view.result == GAMEREC_RESULT_X_WIN) {
+        weight = (player == AI_CELL_CROSSES) ? 2 : 0;
+      } else if (view.result == GAMEREC_RESULT_O_WIN) {
+        weight = (player == AI_CELL_NAUGHTS) ? 2 : 0;
+      }
+
+      if (weight > 0) {
+        int transform = BOOK_TRANSFORM_IDENTITY;
+        uint64_t key = book_canonical_hash(game, &transform);
+        int cx, cy;
+        book_transform_xy(transform, board_size, x, y, &cx, &cy);
+        if (key != 0) {  // key 0 = empty board = empty-slot sentinel
+          add_sample(key, cx, cy, weight);
+          mined++;
+        }
+      }
+
+      search_make_move(game, game->board, x, y, player);
+    }
+
+    cleanup_game(game);
+    (*games)++;
+  }
+  gamerec_close(&corpus);
+  return mined;
+}
+
+static int write_book(const char *path, int board_size,
+                      unsigned min_weight) {
+  qsort(samples, sample_count, sizeof(*samples), sample_cmp);
+
+  // Merge duplicate (key, move) runs, then keep the heaviest move per
+  // key. The array is sorted, so both collapses are single passes.
+  size_t out = 0;
+  for (size_t i = 0; i < sample_count;) {
+    size_t j = i;
+    uint32_t w = 0;
+    while (j < sample_count && sample_cmp(&samples[i], &samples[j]) == 0) {
+      w += samples[j].weight;
+      j++;
+    }
+    samples[out] = samples[i];
+    samples[out].weight = w;
+    out++;
+    i = j;
+  }
+  size_t best = 0;
+  for (size_t i = 0; i < out;) {
+    size_t j = i, top = i;
+    while (j < out && samples[j].key == samples[i].key) {
+      if (samples[j].weight > samples[top].weight) {
+        top = j;
+      }
+      j++;
+    }
+    if (samples[top].weight >= min_weight) {
+      samples[best++] = samples[top];
+    }
+    i = j;
+  }
+
+  if (best == 0) {
+    fprintf(stderr, "gmr2book: no positions survived mining\n");
+    return 0;
+  }
+
+  // Size the open-addressed table at <= 50% load so probe chains stay
+  // short; entry counts are powers of two for mask indexing.
+  uint32_t entry_count = 1;
+  while (entry_count < 2 * best) {
+    entry_count <<= 1;
+  }
+  book_entry_t *table = calloc(entry_count, sizeof(*table));
+  if (!table) {
+    fprintf(stderr, "gmr2book: out of memory\n");
+    return 0;
+  }
+  uint32_t mask = entry_count - 1;
+  for (size_t i = 0; i < best; i++) {
+    uint32_t idx = (uint32_t)samples[i].key & mask;
+    while (table[idx].key != 0) {
+      idx = (idx + 1) & mask;
+    }
+    table[idx].key = samples[i].key;
+    table[idx].x = samples[i].x;
+    table[idx].y = samples[i].y;
+    table[idx].weight =
+        samples[i].weight > 0xFFFF ? 0xFFFF : (uint16_t)samples[i].weight;
+  }
+
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    fprintf(stderr, "gmr2book: cannot open %s for writing\n", path);
+    free(table);
+    return 0;
+  }
+  uint32_t magic = BOOK_MAGIC, version = BOOK_VERSION;
+  uint64_t seed = ZOBRIST_SEED;
+  uint16_t size16 = (uint16_t)board_size, plies16 = BOOK_MAX_PLIES;
+  int ok = fwrite(&magic, 4, 1, f) == 1 && fwrite(&version, 4, 1, f) == 1 &&
+           fwrite(&seed, 8, 1, f) == 1 && fwrite(&size16, 2, 1, f) == 1 &&
+           fwrite(&plies16, 2, 1, f) == 1 &&
+           fwrite(&entry_count, 4, 1, f) == 1 &&
+           fwrite(table, sizeof(*table), entry_count, f) == entry_count;
+  if (fclose(f) != 0) {
+    ok = 0;
+  }
+  free(table);
+  if (!ok) {
+    fprintf(stderr, "gmr2book: write failed for %s\n", path);
+    remove(path);
+    return 0;
+  }
+
+  printf("gmr2book: %zu positions -> %s (%u slots, %.0f%% load)\n", best,
+         path, entry_count, 100.0 * best / entry_count);
+  return 1;
+}
+
+int main(int argc, char **argv) {
+  const char *out_path = NULL;
+  unsigned min_weight = 1;
+  int board_size = DEFAULT_BOARD_SIZE;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "o:m:s:h")) != -1) {
+    switch (opt) {
+    case 'o':
+      out_path = optarg;
+      break;
+    case 'm':
+      min_weight = (unsigned)atoi(optarg);
+      break;
+    case 's':
+      board_size = atoi(optarg);
+      break;
+    default:
+      fprintf(stderr,
+              "Usage: %s [-s board_size] [-m min_weight] -o book.gmkb "
+              "corpus.gmr...\n",
+              argv[0]);
+      return opt == 'h' ? 0 : 1;
+    }
+  }
+
+  if (!out_path || optind >= argc || board_size < 5 || board_size > 19) {
+    fprintf(stderr,
+            "Usage: %s [-s board_size] [-m min_weight] -o book.gmkb "
+            "corpus.gmr...\n",
+            argv[0]);
+    return 1;
+  }
+
+  populate_threat_matrix();
+
+  int games = 0, mined = 0;
+  for (int i = optind; i < argc; i++) {
+    mined += mine_corpus(argv[i], board_size, &games);
+  }
+  printf("gmr2book: mined %d positions from %d games (%dx%d, <= %d plies)\n",
+         mined, games, board_size, board_size, BOOK_MAX_PLIES);
+
+  int ok = write_book(out_path, board_size, min_weight);
+  free(samples);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+//
+//  json2gmr.c
+//  gomoku - JSON game record to .gmr corpus converter
+//
+//  Packs any number of write_game_json() records into one binary corpus
+//  file (see gamerec.h for the layout). The tuning and book-building
+//  harnesses then mmap the corpus instead of re-parsing every JSON file
+//  on every run.
+//
+//  Build with `make json2gmr`.
+//
+//  Usage: json2gmr -o corpus.gmr game.json...
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "game.h"
+#include "gamerec.h"
+
+static int result_from_winner(const char *winner) {
+  if (winner[0] == 'X') {
+    return GAMEREC_RESULT_X_WIN;
+  }
+  if (winner[0] == 'O') {
+    return GAMEREC_RESULT_O_WIN;
+  }
+  if (strcmp(winner, "draw") == 0) {
+    return GAMEREC_RESULT_DRAW;
+  }
+  return GAMEREC_RESULT_UNKNOWN;
+}
+
+int main(int argc, char **argv) {
+  const char *out_path = NULL;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "o:h")) != -1) {
+    switch (opt) {
+    case 'o':
+      out_path = optarg;
+      break;
+    default:
+      fprintf(stderr, "Usage: %s -o corpus.gmr game.json...\n", argv[0]);
+      return 1;
+    }
+  }
+  if (!out_path || optind >= argc) {
+    fprintf(stderr, "Usage: %s -o corpus.gmr game.json...\n", argv[0]);
+    return 1;
+  }
+
+  gamerec_writer_t writer;
+  if (!gamerec_writer_open(&writer, out_path)) {
+    perror(out_path);
+    return 1;
+  }
+
+  int converted = 0;
+  int skipped = 0;
+  for (int i = optind; i < argc; i++) {
+    replay_data_t data;
+    if (!load_game_json(argv[i], &data)) {
+      fprintf(stderr, "json2gmr: skipping %s (failed to load)\n", argv[i]);
+      skipped++;
+      continue;
+    }
+    // Trim at the first unparseable move, matching what the replay
+    // harnesses do with a malformed record tail: keep the clean prefix.
+    for (int m = 0; m < data.move_count; m++) {
+      if (data.moves[m].x < 0 || data.moves[m].x >= data.board_size ||
+          data.moves[m].y < 0 || data.moves[m].y >= data.board_size ||
+          (data.moves[m].player != AI_CELL_CROSSES &&
+           data.moves[m].player != AI_CELL_NAUGHTS)) {
+        fprintf(stderr, "json2gmr: %s truncated at move %d (malformed)\n",
+                argv[i], m);
+        data.move_count = m;
+        break;
+      }
+    }
+    if (!gamerec_writer_add(&writer, data.board_size,
+                            result_from_winner(data.winner), data.depth_x,
+                            data.depth_o, data.radius, data.moves,
+                            data.move_count)) {
+      fprintf(stderr, "json2gmr: skipping %s (invalid record)\n", argv[i]);
+      skipped++;
+      continue;
+    }
+    converted++;
+  }
+
+  if (!gamerec_writer_close(&writer)) {
+    fprintf(stderr, "json2gmr: failed to finalize %s\n", out_path);
+    return 1;
+  }
+
+  printf("wrote %s: %d games (%d skipped)\n", out_path, converted, skipped);
+  return converted > 0 ? 0 : 1;
+}
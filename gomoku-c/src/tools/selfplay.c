@@ -0,0 +1,409 @@
+//
+//  selfplay.c
+//  gomoku - parallel self-play arena for engine-strength comparisons
+//
+//  Plays two engine configurations against each other in-process, K
+//  games across a pool of worker threads, and reports the score with
+//  an Elo estimate, likelihood of superiority, and an SPRT verdict so
+//  a change can be accepted or rejected after the minimum number of
+//  games. Replaces the per-move process spawning of the scripts in
+//  tests/evals/{bash,python,ruby} for plain A/B strength runs.
+//
+//  Games come in color-alternating pairs: each pair shares one random
+//  opening (derived deterministically from the pair index) and swaps
+//  which configuration plays X, so opening and first-move advantages
+//  cancel out of the comparison.
+//
+//  Named selfplay rather than arena to stay clear of the search's
+//  bump-allocator module of that name (src/gomoku/arena.h).
+//
+//  Build with `make selfplay`. Example: compare depth 6 against depth 4
+//  with a tighter radius over up to 400 games on all cores:
+//
+//      bin/selfplay -g 400 -d 6 -D 4 -r 4 -R 3
+//
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ai.h"
+#include "board.h"
+#include "game.h"
+#include "gomoku.h"
+
+// One side of the match: the subset of cli_config_t knobs that change
+// engine strength. Depth is applied through depth_for_player; the
+// others are global on game_state_t and get swapped in before each
+// move, the same way the interactive loop swaps max_depth for -d N,M.
+typedef struct {
+  int depth;
+  int search_radius;
+  int leaf_radius;
+  double move_timeout; // Seconds, fractional (0 = fixed depth only)
+} engine_config_t;
+
+// Match setup shared by all workers (read-only after option parsing).
+typedef struct {
+  engine_config_t config_a;
+  engine_config_t config_b;
+  int board_size;
+  int max_games;
+  int opening_plies;
+  double elo0; // SPRT H0: A is at most this much stronger
+  double elo1; // SPRT H1: A is at least this much stronger
+} match_t;
+
+// Tally and coordination state, guarded by `lock`.
+typedef struct {
+  pthread_mutex_t lock;
+  const match_t *match;
+  int next_game; // Next unclaimed game index
+  int wins;      // Games won by configuration A
+  int draws;
+  int losses;
+  int finished;
+  int stop; // SPRT reached a verdict; workers stop claiming games
+} tally_t;
+
+#define SPRT_ALPHA 0.05
+#define SPRT_BETA 0.05
+
+static double elo_to_score(double elo) {
+  return 1.0 / (1.0 + pow(10.0, -elo / 400.0));
+}
+
+/**
+ * Generalized SPRT log-likelihood ratio over per-game scores (1, 1/2,
+ * 0), using the normal approximation on the sample mean and variance.
+ * Positive values favor H1 (A stronger by >= elo1), negative favor H0.
+ */
+static double sprt_llr(int wins, int draws, int losses, double elo0,
+                       double elo1) {
+  int n = wins + draws + losses;
+  if (n < 2) {
+    return 0.0;
+  }
+  double xbar = (wins + 0.5 * draws) / n;
+  double x2bar = (wins + 0.25 * draws) / n;
+  double var = x2bar - xbar * xbar;
+  if (var <= 0.0) {
+    return 0.0;
+  }
+  double s0 = elo_to_score(elo0);
+  double s1 = elo_to_score(elo1);
+  return (s1 - s0) * (2.0 * xbar - s0 - s1) * n / (2.0 * var);
+}
+
+/**
+ * Deterministic per-pair random stream (xorshift64), so both games of a
+ * color-swapped pair replay the identical opening no matter which
+ * worker picks them up or in what order.
+ */
+static uint64_t pair_rand(uint64_t *state) {
+  uint64_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *state = x;
+  return x;
+}
+
+/**
+ * Seed a game with `plies` random stones in the center quarter of the
+ * board, alternating colors from X. Keeps openings varied enough that
+ * paired games don't all collapse into one deterministic line.
+ */
+static void play_random_opening(game_state_t *game, int pair_index,
+                                int plies) {
+  uint64_t rng = 0x9E3779B97F4A7C15ULL ^ ((uint64_t)(pair_index + 1) << 1);
+  int size = game->board_size;
+  int span = size / 2;
+  int base = (size - span) / 2;
+  int player = AI_CELL_CROSSES;
+  for (int i = 0; i < plies; i++) {
+    int x, y;
+    do {
+      x = base + (int)(pair_rand(&rng) % (uint64_t)span);
+      y = base + (int)(pair_rand(&rng) % (uint64_t)span);
+    } while (game->board[x][y] != AI_CELL_EMPTY);
+    make_move(game, x, y, player, 0.0, 0, 0, 0);
+    player = other_player(player);
+  }
+}
+
+/**
+ * Apply one side's strength knobs to the game state before its move,
+ * mirroring how the interactive loop swaps max_depth per player.
+ */
+static void apply_engine_config(game_state_t *game,
+                                const engine_config_t *config) {
+  game->max_depth = config->depth;
+  game->search_radius = config->search_radius;
+  game->leaf_radius = config->leaf_radius;
+  game->move_timeout = config->move_timeout;
+}
+
+/**
+ * Play game `index` to completion on the worker's game state.
+ *
+ * @return A's per-game score doubled (2 = win, 1 = draw, 0 = loss)
+ */
+static int play_one_game(game_state_t *game, const match_t *match,
+                         int index) {
+  int a_plays_x = (index % 2 == 0);
+
+  cli_config_t cfg;
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.board_size = match->board_size;
+  cfg.max_depth = match->config_a.depth;
+  cfg.skip_welcome = 1;
+  cfg.headless = 1;
+  cfg.search_radius = match->config_a.search_radius;
+  cfg.leaf_radius = match->config_a.leaf_radius;
+  cfg.player_x_type = PLAYER_TYPE_AI;
+  cfg.player_o_type = PLAYER_TYPE_AI;
+  cfg.depth_x = -1;
+  cfg.depth_o = -1;
+  // Deterministic per-game tie-break stream so a match is reproducible
+  // regardless of how games land on worker threads.
+  cfg.rng_seed = 0xA5F3D729B1C86E04ULL ^ ((uint64_t)(index + 1) << 8);
+  reinit_game(game, cfg);
+
+  play_random_opening(game, index / 2, match->opening_plies);
+
+  while (game->game_state == GAME_RUNNING &&
+         game->move_history_count < MAX_MOVE_HISTORY) {
+    int side = game->current_player;
+    const engine_config_t *config =
+        ((side == AI_CELL_CROSSES) == a_plays_x) ? &match->config_a
+                                                 : &match->config_b;
+    apply_engine_config(game, config);
+
+    int x = -1, y = -1;
+    double start = get_current_time();
+    find_best_ai_move(game, &x, &y, NULL);
+    if (x < 0 ||
+        !make_move(game, x, y, side, get_current_time() - start, 0, 0, 0)) {
+      // No legal move found (full board race); score it as a draw.
+      return 1;
+    }
+  }
+
+  if (game->game_state == GAME_HUMAN_WIN) { // X won
+    return a_plays_x ? 2 : 0;
+  }
+  if (game->game_state == GAME_AI_WIN) { // O won
+    return a_plays_x ? 0 : 2;
+  }
+  return 1;
+}
+
+static void *selfplay_worker(void *arg) {
+  tally_t *tally = arg;
+  const match_t *match = tally->match;
+
+  cli_config_t cfg;
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.board_size = match->board_size;
+  cfg.max_depth = match->config_a.depth;
+  cfg.skip_welcome = 1;
+  cfg.headless = 1;
+  cfg.search_radius = match->config_a.search_radius;
+  cfg.leaf_radius = match->config_a.leaf_radius;
+  cfg.player_x_type = PLAYER_TYPE_AI;
+  cfg.player_o_type = PLAYER_TYPE_AI;
+  cfg.depth_x = -1;
+  cfg.depth_o = -1;
+  game_state_t *game = init_game(cfg);
+  if (!game) {
+    return NULL;
+  }
+
+  for (;;) {
+    pthread_mutex_lock(&tally->lock);
+    int index = (tally->stop) ? match->max_games : tally->next_game++;
+    pthread_mutex_unlock(&tally->lock);
+    if (index >= match->max_games) {
+      break;
+    }
+
+    int score2 = play_one_game(game, match, index);
+
+    pthread_mutex_lock(&tally->lock);
+    if (score2 == 2) {
+      tally->wins++;
+    } else if (score2 == 1) {
+      tally->draws++;
+    } else {
+      tally->losses++;
+    }
+    tally->finished++;
+    double llr = sprt_llr(tally->wins, tally->draws, tally->losses,
+                          match->elo0, match->elo1);
+    double lower = log(SPRT_BETA / (1.0 - SPRT_ALPHA));
+    double upper = log((1.0 - SPRT_BETA) / SPRT_ALPHA);
+    if (llr <= lower || llr >= upper) {
+      tally->stop = 1;
+    }
+    printf("[%3d/%d] %c  A: +%d =%d -%d  llr %.2f\n", tally->finished,
+           match->max_games,
+           (score2 == 2) ? 'W' : (score2 == 1) ? 'D' : 'L', tally->wins,
+           tally->draws, tally->losses, llr);
+    fflush(stdout);
+    pthread_mutex_unlock(&tally->lock);
+  }
+
+  cleanup_game(game);
+  return NULL;
+}
+
+static void print_config(const char *label, const engine_config_t *config) {
+  printf("  %s: depth %d, radius %d, leaf radius %d", label, config->depth,
+         config->search_radius, config->leaf_radius);
+  if (config->move_timeout > 0) {
+    printf(", timeout %.2fs", config->move_timeout);
+  }
+  printf("\n");
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  -g N    games to play at most (default 100)\n"
+          "  -b N    board size (default %d)\n"
+          "  -j N    worker threads (default: online cores)\n"
+          "  -p N    random opening plies per game pair (default 4)\n"
+          "  -d N    config A search depth (default 4)\n"
+          "  -D N    config B search depth (default 4)\n"
+          "  -r N    config A search radius (default 4)\n"
+          "  -R N    config B search radius (default 4)\n"
+          "  -l N    config A leaf radius (default 2)\n"
+          "  -L N    config B leaf radius (default 2)\n"
+          "  -t SEC  config A move timeout, fractional (default 0 = none)\n"
+          "  -T SEC  config B move timeout, fractional (default 0 = none)\n"
+          "  -s ELO  SPRT H0 elo bound (default 0)\n"
+          "  -S ELO  SPRT H1 elo bound (default 10)\n",
+          prog, DEFAULT_BOARD_SIZE);
+}
+
+int main(int argc, char *argv[]) {
+  match_t match;
+  memset(&match, 0, sizeof(match));
+  match.config_a = (engine_config_t){4, 4, 2, 0.0};
+  match.config_b = (engine_config_t){4, 4, 2, 0.0};
+  match.board_size = DEFAULT_BOARD_SIZE;
+  match.max_games = 100;
+  match.opening_plies = 4;
+  match.elo0 = 0.0;
+  match.elo1 = 10.0;
+
+  int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (threads < 1) {
+    threads = 1;
+  }
+
+  int opt;
+  while ((opt = getopt(argc, argv, "g:b:j:p:d:D:r:R:l:L:t:T:s:S:h")) != -1) {
+    switch (opt) {
+    case 'g': match.max_games = atoi(optarg); break;
+    case 'b': match.board_size = atoi(optarg); break;
+    case 'j': threads = atoi(optarg); break;
+    case 'p': match.opening_plies = atoi(optarg); break;
+    case 'd': match.config_a.depth = atoi(optarg); break;
+    case 'D': match.config_b.depth = atoi(optarg); break;
+    case 'r': match.config_a.search_radius = atoi(optarg); break;
+    case 'R': match.config_b.search_radius = atoi(optarg); break;
+    case 'l': match.config_a.leaf_radius = atoi(optarg); break;
+    case 'L': match.config_b.leaf_radius = atoi(optarg); break;
+    case 't': match.config_a.move_timeout = atof(optarg); break;
+    case 'T': match.config_b.move_timeout = atof(optarg); break;
+    case 's': match.elo0 = atof(optarg); break;
+    case 'S': match.elo1 = atof(optarg); break;
+    case 'h':
+    default:
+      usage(argv[0]);
+      return (opt == 'h') ? 0 : 1;
+    }
+  }
+
+  if (match.max_games < 2 || match.board_size < 5 ||
+      match.board_size > 19 || threads < 1 || match.opening_plies < 0) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  populate_threat_matrix();
+
+  printf("Self-play match: %d games max, board %dx%d, %d worker(s), "
+         "%d opening plies\n",
+         match.max_games, match.board_size, match.board_size, threads,
+         match.opening_plies);
+  print_config("A", &match.config_a);
+  print_config("B", &match.config_b);
+  printf("  SPRT: elo0 %.1f, elo1 %.1f, alpha %.2f, beta %.2f\n\n",
+         match.elo0, match.elo1, SPRT_ALPHA, SPRT_BETA);
+
+  tally_t tally;
+  memset(&tally, 0, sizeof(tally));
+  pthread_mutex_init(&tally.lock, NULL);
+  tally.match = &match;
+
+  pthread_t *workers = calloc((size_t)threads, sizeof(pthread_t));
+  int started = 0;
+  for (int t = 0; t < threads; t++) {
+    if (pthread_create(&workers[t], NULL, selfplay_worker, &tally) != 0) {
+      break;
+    }
+    started++;
+  }
+  if (started == 0) {
+    fprintf(stderr, "selfplay: failed to start any worker\n");
+    free(workers);
+    return 1;
+  }
+  for (int t = 0; t < started; t++) {
+    pthread_join(workers[t], NULL);
+  }
+  free(workers);
+  pthread_mutex_destroy(&tally.lock);
+
+  int n = tally.finished;
+  double xbar = (n > 0) ? (tally.wins + 0.5 * tally.draws) / n : 0.5;
+  double x2bar = (n > 0) ? (tally.wins + 0.25 * tally.draws) / n : 0.25;
+  double var = x2bar - xbar * xbar;
+  double stderr_score = (n > 1 && var > 0) ? sqrt(var / n) : 0.0;
+
+  printf("\nResult after %d game(s): A +%d =%d -%d  (score %.1f%%)\n", n,
+         tally.wins, tally.draws, tally.losses, 100.0 * xbar);
+  if (xbar > 0.0 && xbar < 1.0) {
+    double elo = -400.0 * log10(1.0 / xbar - 1.0);
+    printf("Elo: %+.1f", elo);
+    if (stderr_score > 0.0) {
+      double lo = xbar - 1.96 * stderr_score;
+      double hi = xbar + 1.96 * stderr_score;
+      if (lo > 0.0 && hi < 1.0) {
+        printf(" [%+.1f, %+.1f]", -400.0 * log10(1.0 / lo - 1.0),
+               -400.0 * log10(1.0 / hi - 1.0));
+      }
+    }
+    printf("\n");
+  }
+  if (stderr_score > 0.0) {
+    printf("LOS: %.1f%%\n",
+           50.0 * (1.0 + erf((xbar - 0.5) / (stderr_score * sqrt(2.0)))));
+  }
+
+  double llr = sprt_llr(tally.wins, tally.draws, tally.losses, match.elo0,
+                        match.elo1);
+  double lower = log(SPRT_BETA / (1.0 - SPRT_ALPHA));
+  double upper = log((1.0 - SPRT_BETA) / SPRT_ALPHA);
+  printf("SPRT: llr %.2f [%.2f, %.2f] -> %s\n", llr, lower, upper,
+         (llr >= upper)   ? "H1 accepted (A is stronger)"
+         : (llr <= lower) ? "H0 accepted (no meaningful gain)"
+                          : "inconclusive, play more games");
+  return 0;
+}
@@ -0,0 +1,383 @@
+//
+//  tune_eval.c
+//  gomoku - Texel-style evaluation weight tuning harness
+//
+//  Replays the games/ corpus, extracts threat-class feature vectors from
+//  every middlegame position, and fits the threat_cost[] weights (see
+//  threat_weights.h) to the recorded outcomes by minimizing the mean
+//  squared error between a logistic prediction of "X wins" and the
+//  actual result. The evaluation is linear in the weights, so each
+//  position is probed once with one-hot cost tables and the search
+//  itself runs on cached dot products.
+//
+//  Build with `make tune-eval`; `make tune-weights` runs it over the
+//  corpus and writes src/gomoku/threat_weights_tuned.h, which a
+//  -DGOMOKU_USE_TUNED_WEIGHTS rebuild picks up.
+//
+//  Usage: tune-eval [-o tuned_header.h] [-k scale] games/*.json
+//
+//  Arguments ending in .gmr are treated as binary corpora (see
+//  gamerec.h) and scanned through the mmap reader — one corpus file can
+//  carry the whole archive without a json-c parse per game.
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "board.h"
+#include "game.h"
+#include "gamerec.h"
+#include "gomoku.h"
+
+// Threat class indices into the cost table. These mirror the THREAT_*
+// defines private to gomoku.c — the table layout is part of the
+// calc_score_at_with() contract (see gomoku.h).
+#define IDX_NOTHING 0
+#define IDX_FIVE 1
+#define IDX_STRAIGHT_FOUR 2
+#define IDX_FOUR 3
+#define IDX_THREE 4
+#define IDX_FOUR_BROKEN 5
+#define IDX_THREE_BROKEN 6
+#define IDX_TWO 7
+#define IDX_NEAR_ENEMY 8
+#define IDX_THREE_AND_FOUR 9
+#define IDX_THREE_AND_THREE 10
+#define IDX_THREE_AND_THREE_BROKEN 11
+
+#define NUM_WEIGHTS 12
+#define COST_TABLE_SIZE 20
+
+// Skip the opening: the first few plies are decided by convention, not by
+// threat patterns, and only add noise to the fit.
+#define MIN_PLY 8
+
+// Indices actually optimized. THREAT_NOTHING is structurally zero and
+// THREAT_FIVE anchors the scale (a detected five is a win; its weight
+// defines what "1.0 probability" means), so both stay fixed.
+static const int tunable[] = {
+    IDX_STRAIGHT_FOUR, IDX_FOUR,           IDX_THREE,
+    IDX_FOUR_BROKEN,   IDX_THREE_BROKEN,   IDX_TWO,
+    IDX_NEAR_ENEMY,    IDX_THREE_AND_FOUR, IDX_THREE_AND_THREE,
+    IDX_THREE_AND_THREE_BROKEN,
+};
+#define NUM_TUNABLE ((int)(sizeof(tunable) / sizeof(tunable[0])))
+
+static const char *weight_macro[NUM_WEIGHTS] = {
+    NULL,
+    "THREAT_WEIGHT_FIVE",
+    "THREAT_WEIGHT_STRAIGHT_FOUR",
+    "THREAT_WEIGHT_FOUR",
+    "THREAT_WEIGHT_THREE",
+    "THREAT_WEIGHT_FOUR_BROKEN",
+    "THREAT_WEIGHT_THREE_BROKEN",
+    "THREAT_WEIGHT_TWO",
+    "THREAT_WEIGHT_NEAR_ENEMY",
+    "THREAT_WEIGHT_THREE_AND_FOUR",
+    "THREAT_WEIGHT_THREE_AND_THREE",
+    "THREAT_WEIGHT_THREE_AND_THREE_BROKEN",
+};
+
+typedef struct {
+  double features[NUM_WEIGHTS]; // Signed class counts (X minus O)
+  double constant;              // Weight-independent eval part
+  double outcome;               // 1.0 X won, 0.5 draw, 0.0 O won
+} sample_t;
+
+static sample_t *samples = NULL;
+static int sample_count = 0;
+static int sample_capacity = 0;
+
+static sample_t *new_sample(void) {
+  if (sample_count == sample_capacity) {
+    sample_capacity = sample_capacity ? sample_capacity * 2 : 4096;
+    samples = realloc(samples, (size_t)sample_capacity * sizeof(sample_t));
+    if (!samples) {
+      fprintf(stderr, "tune-eval: out of memory\n");
+      exit(1);
+    }
+  }
+  return &samples[sample_count++];
+}
+
+/**
+ * Extract the feature vector of the current position: for every stone,
+ * probe calc_score_at_with once per weight with a one-hot cost table.
+ * The probe value is 2 so the THREAT_THREE_AND_THREE_BROKEN / 2 integer
+ * division inside the combination scoring stays exact (2 / 2 = 1,
+ * recorded as a half count).
+ */
+static void extract_features(cell_t **board, int size, double outcome) {
+  sample_t *s = new_sample();
+  memset(s, 0, sizeof(*s));
+  s->outcome = outcome;
+
+  int zero_costs[COST_TABLE_SIZE] = {0};
+  int probe_costs[COST_TABLE_SIZE] = {0};
+
+  for (int x = 0; x < size; x++) {
+    for (int y = 0; y < size; y++) {
+      int cell = board[x][y];
+      if (cell == AI_CELL_EMPTY) {
+        continue;
+      }
+      double sign = (cell == AI_CELL_CROSSES) ? 1.0 : -1.0;
+      int base = calc_score_at_with(board, size, cell, x, y, zero_costs);
+      s->constant += sign * base;
+      for (int j = 1; j < NUM_WEIGHTS; j++) {
+        probe_costs[j] = 2;
+        int probed = calc_score_at_with(board, size, cell, x, y, probe_costs);
+        probe_costs[j] = 0;
+        s->features[j] += sign * (probed - base) / 2.0;
+      }
+    }
+  }
+}
+
+static double predict(const sample_t *s, const double *weights, double scale) {
+  double eval = s->constant;
+  for (int j = 1; j < NUM_WEIGHTS; j++) {
+    eval += weights[j] * s->features[j];
+  }
+  return 1.0 / (1.0 + exp(-eval / scale));
+}
+
+static double mean_squared_error(const double *weights, double scale) {
+  double sum = 0.0;
+  for (int i = 0; i < sample_count; i++) {
+    double err = predict(&samples[i], weights, scale) - samples[i].outcome;
+    sum += err * err;
+  }
+  return sum / sample_count;
+}
+
+static int replay_file(const char *path) {
+  replay_data_t data;
+  if (!load_game_json(path, &data)) {
+    fprintf(stderr, "tune-eval: skipping %s (failed to load)\n", path);
+    return 0;
+  }
+
+  double outcome;
+  if (data.winner[0] == 'X') {
+    outcome = 1.0;
+  } else if (data.winner[0] == 'O') {
+    outcome = 0.0;
+  } else if (strcmp(data.winner, "draw") == 0) {
+    outcome = 0.5;
+  } else {
+    fprintf(stderr, "tune-eval: skipping %s (no recorded outcome)\n", path);
+    return 0;
+  }
+
+  cell_t **board = create_board(data.board_size);
+  int positions = 0;
+  for (int i = 0; i < data.move_count; i++) {
+    const move_history_t *m = &data.moves[i];
+    if (m->x < 0 || m->x >= data.board_size || m->y < 0 ||
+        m->y >= data.board_size || m->player == 0) {
+      break; // Malformed record tail - keep what replayed cleanly
+    }
+    board[m->x][m->y] = (cell_t)m->player;
+    if (i + 1 >= MIN_PLY) {
+      extract_features(board, data.board_size, outcome);
+      positions++;
+    }
+  }
+  free_board(board, data.board_size);
+  return positions;
+}
+
+static int replay_corpus(const char *path, int *games) {
+  gamerec_corpus_t corpus;
+  if (!gamerec_open(&corpus, path)) {
+    fprintf(stderr, "tune-eval: skipping %s (failed to open corpus)\n", path);
+    return 0;
+  }
+
+  int positions = 0;
+  size_t cursor = 0;
+  gamerec_view_t view;
+  while (gamerec_next(&corpus, &cursor, &view)) {
+    double outcome;
+    if (view.result == GAMEREC_RESULT_X_WIN) {
+      outcome = 1.0;
+    } else if (view.result == GAMEREC_RESULT_O_WIN) {
+      outcome = 0.0;
+    } else if (view.result == GAMEREC_RESULT_DRAW) {
+      outcome = 0.5;
+    } else {
+      continue; // No recorded outcome - nothing to fit against
+    }
+
+    cell_t **board = create_board(view.board_size);
+    for (int i = 0; i < view.move_count; i++) {
+      uint16_t m = view.moves[i];
+      int x = gamerec_move_x(m);
+      int y = gamerec_move_y(m);
+      if (x >= view.board_size || y >= view.board_size) {
+        break; // Malformed record tail - keep what replayed cleanly
+      }
+      board[x][y] = (cell_t)gamerec_move_player(m);
+      if (i + 1 >= MIN_PLY) {
+        extract_features(board, view.board_size, outcome);
+        positions++;
+      }
+    }
+    free_board(board, view.board_size);
+    (*games)++;
+  }
+  gamerec_close(&corpus);
+  return positions;
+}
+
+/**
+ * Coordinate descent with multiplicative steps: repeatedly nudge each
+ * weight up/down by `step` while the error improves, shrinking the step
+ * each time a full pass makes no progress.
+ */
+static void optimize(double *weights, double scale) {
+  double err = mean_squared_error(weights, scale);
+  printf("initial error: %.6f\n", err);
+
+  double steps[] = {1.30, 1.12, 1.04};
+  for (size_t si = 0; si < sizeof(steps) / sizeof(steps[0]); si++) {
+    double step = steps[si];
+    int improved = 1;
+    while (improved) {
+      improved = 0;
+      for (int t = 0; t < NUM_TUNABLE; t++) {
+        int j = tunable[t];
+        double saved = weights[j];
+        double candidates[2] = {saved * step, saved / step};
+        for (int c = 0; c < 2; c++) {
+          double w = candidates[c];
+          if (w < 1.0) {
+            w = 1.0;
+          }
+          weights[j] = w;
+          double e = mean_squared_error(weights, scale);
+          if (e < err) {
+            err = e;
+            saved = w;
+            improved = 1;
+          }
+        }
+        weights[j] = saved;
+      }
+    }
+    printf("error after step %.2f pass: %.6f\n", step, err);
+  }
+}
+
+static void emit_header(FILE *out, const double *weights) {
+  fprintf(out, "//\n");
+  fprintf(out, "//  threat_weights_tuned.h\n");
+  fprintf(out, "//  gomoku - GENERATED by tune-eval; do not edit\n");
+  fprintf(out, "//\n");
+  fprintf(out, "//  Fitted to the games/ corpus (%d positions). Included\n",
+          sample_count);
+  fprintf(out, "//  via threat_weights.h when GOMOKU_USE_TUNED_WEIGHTS is\n");
+  fprintf(out, "//  defined.\n");
+  fprintf(out, "//\n\n");
+  fprintf(out, "#ifndef THREAT_WEIGHTS_TUNED_H\n");
+  fprintf(out, "#define THREAT_WEIGHTS_TUNED_H\n\n");
+  for (int j = 1; j < NUM_WEIGHTS; j++) {
+    fprintf(out, "#define %s %d\n", weight_macro[j],
+            (int)(weights[j] + 0.5));
+  }
+  fprintf(out, "\n#endif // THREAT_WEIGHTS_TUNED_H\n");
+}
+
+int main(int argc, char **argv) {
+  const char *out_path = NULL;
+  double scale = 0.0; // 0 = fit from data
+  int opt;
+
+  while ((opt = getopt(argc, argv, "o:k:h")) != -1) {
+    switch (opt) {
+    case 'o':
+      out_path = optarg;
+      break;
+    case 'k':
+      scale = atof(optarg);
+      break;
+    default:
+      fprintf(stderr,
+              "Usage: %s [-o tuned_header.h] [-k scale] game.json...\n",
+              argv[0]);
+      return 1;
+    }
+  }
+  if (optind >= argc) {
+    fprintf(stderr, "tune-eval: no game records given\n");
+    return 1;
+  }
+
+  populate_threat_matrix();
+
+  int games = 0;
+  for (int i = optind; i < argc; i++) {
+    size_t len = strlen(argv[i]);
+    if (len > 4 && strcmp(argv[i] + len - 4, ".gmr") == 0) {
+      replay_corpus(argv[i], &games);
+    } else if (replay_file(argv[i]) > 0) {
+      games++;
+    }
+  }
+  printf("loaded %d games, %d positions\n", games, sample_count);
+  if (sample_count == 0) {
+    fprintf(stderr, "tune-eval: nothing to tune\n");
+    return 1;
+  }
+
+  double weights[NUM_WEIGHTS];
+  const int *defaults = threat_cost_defaults();
+  for (int j = 0; j < NUM_WEIGHTS; j++) {
+    weights[j] = defaults[j];
+  }
+
+  // Fit the logistic scale on the default weights first: without this the
+  // error surface rewards shrinking every weight toward zero instead of
+  // reshaping their ratios.
+  if (scale <= 0.0) {
+    double best_err = 1e30;
+    for (double k = 250.0; k <= 512000.0; k *= 2.0) {
+      double e = mean_squared_error(weights, k);
+      if (e < best_err) {
+        best_err = e;
+        scale = k;
+      }
+    }
+    printf("fitted logistic scale: %.0f\n", scale);
+  }
+
+  optimize(weights, scale);
+
+  printf("\ntuned weights (default -> fitted):\n");
+  for (int t = 0; t < NUM_TUNABLE; t++) {
+    int j = tunable[t];
+    printf("  %-36s %7d -> %7d\n", weight_macro[j], defaults[j],
+           (int)(weights[j] + 0.5));
+  }
+
+  if (out_path) {
+    FILE *out = fopen(out_path, "w");
+    if (!out) {
+      perror(out_path);
+      return 1;
+    }
+    emit_header(out, weights);
+    fclose(out);
+    printf("\nwrote %s\n", out_path);
+  } else {
+    printf("\n");
+    emit_header(stdout, weights);
+  }
+
+  free(samples);
+  return 0;
+}
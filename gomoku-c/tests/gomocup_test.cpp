@@ -130,6 +130,21 @@ TEST(GomocupProtocolTest, ParseBoardRow) {
   EXPECT_EQ(protocol_parse_board_row("7,7", &x, &y, &field), 0);
 }
 
+TEST(GomocupProtocolTest, ParseSwap2Row) {
+  int x = -1, y = -1;
+  EXPECT_EQ(protocol_parse_swap2_row("7,7\r\n", &x, &y), 1);
+  EXPECT_EQ(x, 7);
+  EXPECT_EQ(y, 7);
+
+  EXPECT_EQ(protocol_parse_swap2_row(" 11 , 10 ", &x, &y), 1);
+  EXPECT_EQ(x, 11);
+  EXPECT_EQ(y, 10);
+
+  EXPECT_EQ(protocol_parse_swap2_row("DONE", &x, &y), 0);
+  EXPECT_EQ(protocol_parse_swap2_row("", &x, &y), 0);
+  EXPECT_EQ(protocol_parse_swap2_row("7", &x, &y), 0);
+}
+
 TEST(GomocupProtocolTest, ParseInfoKnown) {
   parsed_command_t cmd;
   protocol_parse_line("INFO timeout_turn 5000", &cmd);
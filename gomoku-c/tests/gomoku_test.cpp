@@ -6,14 +6,16 @@
 extern "C" {
 #include "ai.h"
 #include "board.h"
+#include "book.h"
 #include "cli.h"
 #include "game.h"
 #include "gomoku.h"
+#include "simulate.h"
 }
 
 class GomokuTest : public testing::Test {
 protected:
-  int **board;
+  cell_t **board;
   game_state_t *game;
   const int BOARD_SIZE = 19;
 
@@ -307,7 +309,7 @@ TEST_F(GomokuTest, MinimaxWithWin) {
 // Ensure minimax works correctly on boards smaller than 19x19
 TEST_F(GomokuTest, MinimaxDifferentBoardSize) {
   const int SMALL_SIZE = 15;
-  int **small_board = create_board(SMALL_SIZE);
+  cell_t **small_board = create_board(SMALL_SIZE);
   ASSERT_NE(small_board, nullptr);
 
   small_board[7][7] = AI_CELL_CROSSES;
@@ -475,7 +477,7 @@ static void find_best_move_for_player(game_state_t *game, int player,
 }
 
 // Helper: Count how many winning moves opponent has
-static int count_opponent_winning_moves(int **board, int board_size,
+static int count_opponent_winning_moves(cell_t **board, int board_size,
                                         int opponent) {
   int count = 0;
   for (int i = 0; i < board_size; i++) {
@@ -1232,6 +1234,249 @@ TEST_F(GomokuTest, OverlineIsNotAWin) {
   game->board[9][4] = AI_CELL_EMPTY;
 }
 
+// Opening-book coordinate transforms: applying a transform and then its
+// inverse must land back on the original square, for every square. This is
+// what lets book entries stored in the canonical orientation be mapped back
+// into the live game's frame (see book_probe).
+TEST_F(GomokuTest, BookTransformRoundTrip) {
+  for (int t = 0; t < 7; t++) {
+    int inv = book_inverse_transform(t);
+    for (int x = 0; x < BOARD_SIZE; x++) {
+      for (int y = 0; y < BOARD_SIZE; y++) {
+        int cx, cy, rx, ry;
+        book_transform_xy(t, BOARD_SIZE, x, y, &cx, &cy);
+        book_transform_xy(inv, BOARD_SIZE, cx, cy, &rx, &ry);
+        ASSERT_EQ(rx, x) << "transform " << t << " at " << x << "," << y;
+        ASSERT_EQ(ry, y) << "transform " << t << " at " << x << "," << y;
+      }
+    }
+  }
+}
+
+// The canonical hash must agree between a position and any of its symmetric
+// images: mirroring the stones changes current_hash but not the minimum over
+// the eight orientations, so both sides of the mirror probe the same book
+// slot.
+TEST_F(GomokuTest, BookCanonicalHashMatchesMirror) {
+  search_make_move(game, game->board, 9, 9, AI_CELL_CROSSES);
+  search_make_move(game, game->board, 10, 11, AI_CELL_NAUGHTS);
+  search_make_move(game, game->board, 8, 10, AI_CELL_CROSSES);
+  int t1 = BOOK_TRANSFORM_IDENTITY;
+  uint64_t key1 = book_canonical_hash(game, &t1);
+  EXPECT_NE(key1, 0u);
+
+  cli_config_t config = game->config;
+  game_state_t *mirror = init_game(config);
+  ASSERT_NE(mirror, nullptr);
+  // Same stones mirrored left-right (y -> size-1-y).
+  search_make_move(mirror, mirror->board, 9, BOARD_SIZE - 1 - 9,
+                   AI_CELL_CROSSES);
+  search_make_move(mirror, mirror->board, 10, BOARD_SIZE - 1 - 11,
+                   AI_CELL_NAUGHTS);
+  search_make_move(mirror, mirror->board, 8, BOARD_SIZE - 1 - 10,
+                   AI_CELL_CROSSES);
+  int t2 = BOOK_TRANSFORM_IDENTITY;
+  uint64_t key2 = book_canonical_hash(mirror, &t2);
+  EXPECT_EQ(key1, key2);
+  cleanup_game(mirror);
+}
+
+//===============================================================================
+// PERFORMANCE REGRESSION GUARDS
+//===============================================================================
+//
+// Budgets are expressed as a ratio to a reference loop timed on the same
+// machine in the same run, so they hold across CI hardware generations.
+// Each bound sits 2-3x above the ratio measured at calibration time:
+// loose enough to absorb scheduler noise, tight enough that a 2-3x
+// slowdown in the guarded path fails the suite.
+
+// Fixed-work reference loop (~50ms of xorshift steps at calibration).
+// volatile keeps the optimizer from collapsing it regardless of -O level.
+static double perf_reference_seconds() {
+  volatile uint64_t acc = 0x12345678ULL;
+  double start = get_current_time();
+  for (int i = 0; i < 20000000; i++) {
+    acc ^= acc << 13;
+    acc ^= acc >> 7;
+    acc ^= acc << 17;
+  }
+  double elapsed = get_current_time() - start;
+  (void)acc;
+  return elapsed;
+}
+
+// evaluate_threat_fast is the innermost hot function of the whole engine;
+// 50 sweeps of a 20-stone board for both players must stay under a
+// quarter of the reference loop (measured ratio ~0.07).
+TEST_F(GomokuTest, PerfGuardThreatEvalThroughput) {
+  const int stones[20][3] = {
+      {9, 9, AI_CELL_CROSSES},   {9, 10, AI_CELL_NAUGHTS},
+      {10, 10, AI_CELL_CROSSES}, {8, 8, AI_CELL_NAUGHTS},
+      {10, 8, AI_CELL_CROSSES},  {8, 10, AI_CELL_NAUGHTS},
+      {11, 11, AI_CELL_CROSSES}, {7, 7, AI_CELL_NAUGHTS},
+      {11, 7, AI_CELL_CROSSES},  {7, 11, AI_CELL_NAUGHTS},
+      {12, 9, AI_CELL_CROSSES},  {6, 9, AI_CELL_NAUGHTS},
+      {9, 12, AI_CELL_CROSSES},  {9, 6, AI_CELL_NAUGHTS},
+      {12, 12, AI_CELL_CROSSES}, {6, 6, AI_CELL_NAUGHTS},
+      {13, 9, AI_CELL_CROSSES},  {5, 9, AI_CELL_NAUGHTS},
+      {9, 13, AI_CELL_CROSSES},  {9, 5, AI_CELL_NAUGHTS}};
+  for (int i = 0; i < 20; i++) {
+    board[stones[i][0]][stones[i][1]] = stones[i][2];
+  }
+
+  double reference = perf_reference_seconds();
+  volatile long sink = 0;
+  double start = get_current_time();
+  for (int rep = 0; rep < 50; rep++) {
+    for (int x = 0; x < BOARD_SIZE; x++) {
+      for (int y = 0; y < BOARD_SIZE; y++) {
+        if (board[x][y] != AI_CELL_EMPTY) {
+          continue;
+        }
+        sink += evaluate_threat_fast(board, x, y, AI_CELL_CROSSES, BOARD_SIZE);
+        sink += evaluate_threat_fast(board, x, y, AI_CELL_NAUGHTS, BOARD_SIZE);
+      }
+    }
+  }
+  double elapsed = get_current_time() - start;
+  (void)sink;
+
+  EXPECT_LT(elapsed, 0.25 * reference)
+      << "threat eval sweep took " << elapsed << "s vs reference "
+      << reference << "s";
+}
+
+// A depth-5 search of the four-stone reference opening on 15x15 runs the
+// full iterative-deepening pipeline; it must stay under 35x the reference
+// loop (measured ratio ~12-15).
+TEST_F(GomokuTest, PerfGuardDepthFiveSearchBudget) {
+  cli_config_t config = game->config;
+  config.board_size = 15;
+  config.max_depth = 5;
+  config.search_radius = 3;
+  config.leaf_radius = 2;
+  config.player_x_type = PLAYER_TYPE_AI;
+  config.player_o_type = PLAYER_TYPE_AI;
+  config.headless = 1;
+  game_state_t *search_game = init_game(config);
+  ASSERT_NE(search_game, nullptr);
+
+  move_history_t opening[4];
+  memset(opening, 0, sizeof(opening));
+  const int cells[4][3] = {{7, 7, AI_CELL_CROSSES},
+                           {7, 8, AI_CELL_NAUGHTS},
+                           {8, 8, AI_CELL_CROSSES},
+                           {6, 6, AI_CELL_NAUGHTS}};
+  for (int i = 0; i < 4; i++) {
+    opening[i].x = cells[i][0];
+    opening[i].y = cells[i][1];
+    opening[i].player = cells[i][2];
+  }
+  ASSERT_TRUE(bulk_load_moves(search_game, opening, 4, nullptr));
+
+  double reference = perf_reference_seconds();
+  int x = -1, y = -1;
+  double start = get_current_time();
+  find_best_ai_move(search_game, &x, &y, nullptr);
+  double elapsed = get_current_time() - start;
+
+  EXPECT_GE(x, 0);
+  EXPECT_LT(elapsed, 35.0 * reference)
+      << "depth-5 search took " << elapsed << "s vs reference " << reference
+      << "s";
+  cleanup_game(search_game);
+}
+
+// Loading a 100-stone position rebuilds every derived cache; 50 rounds of
+// reinit + bulk load must stay under a tenth of the reference loop
+// (measured ratio ~0.03, about 30 microseconds per load).
+TEST_F(GomokuTest, PerfGuardHundredStoneLoadBudget) {
+  move_history_t stones[100];
+  memset(stones, 0, sizeof(stones));
+  int n = 0;
+  // 2x2 color blocks in a checkerboard: no run ever exceeds two, so the
+  // load can't terminate the game partway through.
+  for (int x = 0; x < BOARD_SIZE && n < 100; x++) {
+    for (int y = 0; y < BOARD_SIZE && n < 100; y++) {
+      stones[n].x = x;
+      stones[n].y = y;
+      stones[n].player =
+          (((x / 2) + (y / 2)) % 2) ? AI_CELL_CROSSES : AI_CELL_NAUGHTS;
+      n++;
+    }
+  }
+
+  cli_config_t config = game->config;
+  double reference = perf_reference_seconds();
+  double start = get_current_time();
+  for (int rep = 0; rep < 50; rep++) {
+    reinit_game(game, config);
+    ASSERT_TRUE(bulk_load_moves(game, stones, 100, nullptr));
+  }
+  double elapsed = get_current_time() - start;
+
+  EXPECT_LT(elapsed, 0.10 * reference)
+      << "100-stone loads took " << elapsed << "s vs reference " << reference
+      << "s";
+}
+
+//===============================================================================
+// IN-PROCESS MULTI-GAME SIMULATION (simulate.h)
+//===============================================================================
+
+// A small batch across two workers: every record is filled in, games
+// cycle through the opening set, and the same seed replays the same
+// winners regardless of how games land on threads.
+TEST_F(GomokuTest, SimulateGamesFillsRecordsReproducibly) {
+  static const int cross_opening[4][2] = {{7, 7}, {7, 8}, {8, 8}, {6, 6}};
+  static const int corner_opening[4][2] = {{3, 3}, {3, 4}, {11, 11}, {11, 12}};
+  sim_opening_t openings[2] = {{cross_opening, 4}, {corner_opening, 4}};
+
+  sim_config_t config;
+  memset(&config, 0, sizeof(config));
+  config.board_size = 15;
+  config.depth = 1;
+  config.search_radius = 2;
+  config.leaf_radius = 0;
+  config.max_plies = 60;
+  config.threads = 2;
+  config.rng_seed = 777;
+
+  sim_result_t first[4], second[4];
+  ASSERT_EQ(simulate_games(&config, openings, 2, first, 4), 4);
+  ASSERT_EQ(simulate_games(&config, openings, 2, second, 4), 4);
+
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(first[i].opening_index, i % 2);
+    EXPECT_GE(first[i].plies, 5); // Opening plus at least one searched move
+    EXPECT_TRUE(first[i].winner == SIM_WINNER_X ||
+                first[i].winner == SIM_WINNER_O ||
+                first[i].winner == SIM_WINNER_DRAW);
+    EXPECT_GT(first[i].nodes, 0u);
+    EXPECT_EQ(first[i].winner, second[i].winner);
+    EXPECT_EQ(first[i].plies, second[i].plies);
+  }
+}
+
+// Invalid input is rejected before any game runs: an opening stone off
+// the board fails the whole batch.
+TEST_F(GomokuTest, SimulateGamesRejectsBadOpening) {
+  static const int off_board[1][2] = {{15, 7}};
+  sim_opening_t opening = {off_board, 1};
+
+  sim_config_t config;
+  memset(&config, 0, sizeof(config));
+  config.board_size = 15;
+  config.depth = 1;
+  config.search_radius = 2;
+  config.threads = 1;
+
+  sim_result_t result;
+  EXPECT_EQ(simulate_games(&config, &opening, 1, &result, 1), -1);
+  EXPECT_EQ(simulate_games(nullptr, nullptr, 0, &result, 1), -1);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,279 @@
+//
+//  perft.c
+//  gomoku - move-generation validator and microbenchmark
+//
+//  Walks the generate_moves_optimized() tree to a fixed depth from a
+//  small set of fixture positions, counting every generated candidate
+//  and folding the candidate cell sets into an order-independent
+//  signature. The recorded signatures below are the oracle: a rewrite
+//  of the generator (incremental candidate sets, bitboards) must
+//  reproduce them bit for bit, and the generations/sec line is the
+//  speed baseline it has to beat.
+//
+//  `make test-perft` runs the walk in check mode and fails on any
+//  signature mismatch. After an INTENTIONAL movegen change, run
+//  `bin/perft -u` and paste the emitted table over perft_expected[].
+//
+//  The walk expands the top PERFT_BEAM moves per node in generator
+//  order, so the signature also pins the head of the move ordering -
+//  a reordering that search behavior would feel shows up here too.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ai.h"
+#include "board.h"
+#include "game.h"
+#include "gomoku.h"
+
+#define PERFT_BOARD_SIZE 15
+#define PERFT_DEPTH 3
+#define PERFT_BEAM 8
+
+// One stone of a fixture position; the list is terminated by x < 0.
+typedef struct {
+  int x;
+  int y;
+  int player;
+} perft_stone_t;
+
+typedef struct {
+  const char *name;
+  perft_stone_t stones[24];
+} perft_fixture_t;
+
+// clang-format off
+static const perft_fixture_t fixtures[] = {
+    // Sparse opening: the radius scan sees few stones and wide space.
+    {"opening",
+     {{7, 7, AI_CELL_CROSSES}, {7, 8, AI_CELL_NAUGHTS},
+      {8, 8, AI_CELL_CROSSES}, {6, 6, AI_CELL_NAUGHTS},
+      {-1, -1, 0}}},
+
+    // Scattered middlegame: many disjoint stone neighborhoods.
+    {"midgame",
+     {{7, 7, AI_CELL_CROSSES}, {5, 5, AI_CELL_NAUGHTS},
+      {9, 9, AI_CELL_CROSSES}, {3, 3, AI_CELL_NAUGHTS},
+      {5, 9, AI_CELL_CROSSES}, {11, 11, AI_CELL_NAUGHTS},
+      {11, 5, AI_CELL_CROSSES}, {9, 3, AI_CELL_NAUGHTS},
+      {7, 3, AI_CELL_CROSSES}, {3, 11, AI_CELL_NAUGHTS},
+      {3, 7, AI_CELL_CROSSES}, {11, 9, AI_CELL_NAUGHTS},
+      {-1, -1, 0}}},
+
+    // Contact fight: overlapping neighborhoods and live threats, the
+    // case where candidate pruning and ordering matter most.
+    {"contact",
+     {{7, 7, AI_CELL_CROSSES}, {6, 6, AI_CELL_NAUGHTS},
+      {7, 8, AI_CELL_CROSSES}, {6, 8, AI_CELL_NAUGHTS},
+      {9, 6, AI_CELL_CROSSES}, {8, 8, AI_CELL_NAUGHTS},
+      {8, 5, AI_CELL_CROSSES}, {9, 9, AI_CELL_NAUGHTS},
+      {10, 9, AI_CELL_CROSSES}, {10, 6, AI_CELL_NAUGHTS},
+      {-1, -1, 0}}},
+};
+// clang-format on
+
+#define PERFT_FIXTURE_COUNT ((int)(sizeof(fixtures) / sizeof(fixtures[0])))
+
+// Reference results for the default walk (depth 3, beam 8, 15x15).
+// Regenerate with `bin/perft -u` after an intentional movegen change.
+typedef struct {
+  const char *name;
+  uint64_t candidates;
+  uint64_t signature;
+} perft_expected_t;
+
+static const perft_expected_t perft_expected[] = {
+    {"opening", 4658ULL, 0x8A02AD7EEC1BB60CULL},
+    {"midgame", 11193ULL, 0xD5FD014987800E85ULL},
+    {"contact", 6358ULL, 0x955F1FA7647F5CF5ULL},
+};
+
+/**
+ * SplitMix64 finalizer: one cell (plus its rank position for the
+ * expanded beam head) hashes to a well-mixed word, and the per-node
+ * set folds with XOR so candidate order inside a node doesn't matter.
+ */
+static uint64_t mix64(uint64_t v) {
+  v += 0x9E3779B97F4A7C15ULL;
+  v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  v = (v ^ (v >> 27)) * 0x94D049BB133111EBULL;
+  return v ^ (v >> 31);
+}
+
+typedef struct {
+  uint64_t nodes;      // generate_moves_optimized() calls
+  uint64_t candidates; // Candidates produced across all nodes
+  uint64_t signature;  // Folded candidate-set hash
+} perft_result_t;
+
+static void perft_walk(game_state_t *game, int player, int depth, int beam,
+                       perft_result_t *result) {
+  move_t moves[361];
+  int count = generate_moves_optimized(game, game->board, moves, player, depth);
+
+  result->nodes++;
+  result->candidates += (uint64_t)count;
+
+  // Order-independent fold of the candidate cell set, then an ordered
+  // fold of the beam head: the set proves completeness, the head pins
+  // the part of the ordering the search actually consumes.
+  uint64_t set_hash = 0;
+  for (int i = 0; i < count; i++) {
+    set_hash ^= mix64((uint64_t)(moves[i].x * PERFT_BOARD_SIZE + moves[i].y));
+  }
+  int expand = (count < beam) ? count : beam;
+  for (int i = 0; i < expand; i++) {
+    set_hash ^= mix64(((uint64_t)(i + 1) << 32) |
+                      (uint64_t)(moves[i].x * PERFT_BOARD_SIZE + moves[i].y));
+  }
+  result->signature ^= mix64(set_hash + result->nodes);
+
+  if (depth <= 1) {
+    return;
+  }
+  for (int i = 0; i < expand; i++) {
+    search_make_move(game, game->board, moves[i].x, moves[i].y, player);
+    perft_walk(game, other_player(player), depth - 1, beam, result);
+    search_unmake_move(game, game->board, moves[i].x, moves[i].y, player);
+  }
+}
+
+static game_state_t *make_perft_game(const perft_fixture_t *fixture,
+                                     int depth) {
+  cli_config_t cfg;
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.board_size = PERFT_BOARD_SIZE;
+  cfg.max_depth = depth;
+  cfg.skip_welcome = 1;
+  cfg.headless = 1;
+  cfg.search_radius = 3;
+  cfg.leaf_radius = 2;
+  cfg.player_x_type = PLAYER_TYPE_AI;
+  cfg.player_o_type = PLAYER_TYPE_AI;
+  cfg.depth_x = -1;
+  cfg.depth_o = -1;
+  game_state_t *game = init_game(cfg);
+  if (!game) {
+    return NULL;
+  }
+
+  move_history_t loaded[24];
+  memset(loaded, 0, sizeof(loaded));
+  int count = 0;
+  while (fixture->stones[count].x >= 0) {
+    loaded[count].x = fixture->stones[count].x;
+    loaded[count].y = fixture->stones[count].y;
+    loaded[count].player = fixture->stones[count].player;
+    count++;
+  }
+  if (!bulk_load_moves(game, loaded, count, NULL)) {
+    cleanup_game(game);
+    return NULL;
+  }
+  return game;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [-d depth] [-w beam] [-u]\n"
+          "  -d N  walk depth (default %d)\n"
+          "  -w N  moves expanded per node (default %d)\n"
+          "  -u    print an updated perft_expected[] table and exit 0\n"
+          "Check mode (exit 1 on signature mismatch) applies only at the\n"
+          "default depth and beam the reference table was recorded at.\n",
+          prog, PERFT_DEPTH, PERFT_BEAM);
+}
+
+int main(int argc, char *argv[]) {
+  int depth = PERFT_DEPTH;
+  int beam = PERFT_BEAM;
+  int update = 0;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "d:w:uh")) != -1) {
+    switch (opt) {
+    case 'd': depth = atoi(optarg); break;
+    case 'w': beam = atoi(optarg); break;
+    case 'u': update = 1; break;
+    case 'h':
+    default:
+      usage(argv[0]);
+      return (opt == 'h') ? 0 : 1;
+    }
+  }
+  if (depth < 1 || beam < 1 || beam > 361) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  populate_threat_matrix();
+
+  int check = (!update && depth == PERFT_DEPTH && beam == PERFT_BEAM);
+  int failed = 0;
+  uint64_t total_nodes = 0;
+  double total_time = 0.0;
+
+  if (update) {
+    printf("static const perft_expected_t perft_expected[] = {\n");
+  } else {
+    printf("%-10s %6s %10s %12s  %-18s %10s\n", "fixture", "depth", "nodes",
+           "candidates", "signature", "gens/sec");
+  }
+
+  for (int f = 0; f < PERFT_FIXTURE_COUNT; f++) {
+    game_state_t *game = make_perft_game(&fixtures[f], depth);
+    if (!game) {
+      fprintf(stderr, "perft: failed to load fixture '%s'\n",
+              fixtures[f].name);
+      return 1;
+    }
+
+    perft_result_t result;
+    memset(&result, 0, sizeof(result));
+    double start = get_current_time();
+    perft_walk(game, game->current_player, depth, beam, &result);
+    double elapsed = get_current_time() - start;
+    cleanup_game(game);
+
+    total_nodes += result.nodes;
+    total_time += elapsed;
+
+    if (update) {
+      printf("    {\"%s\", %lluULL, 0x%016llXULL},\n", fixtures[f].name,
+             (unsigned long long)result.candidates,
+             (unsigned long long)result.signature);
+      continue;
+    }
+
+    printf("%-10s %6d %10llu %12llu  0x%016llX %10.0f\n", fixtures[f].name,
+           depth, (unsigned long long)result.nodes,
+           (unsigned long long)result.candidates,
+           (unsigned long long)result.signature,
+           elapsed > 0 ? (double)result.nodes / elapsed : 0.0);
+
+    if (check) {
+      const perft_expected_t *expected = &perft_expected[f];
+      if (result.candidates != expected->candidates ||
+          result.signature != expected->signature) {
+        printf("  MISMATCH: expected %llu candidates, 0x%016llX\n",
+               (unsigned long long)expected->candidates,
+               (unsigned long long)expected->signature);
+        failed = 1;
+      }
+    }
+  }
+
+  if (update) {
+    printf("};\n");
+    return 0;
+  }
+
+  printf("\nPerft: %llu generations %.0f gens/sec -> %s\n",
+         (unsigned long long)total_nodes,
+         total_time > 0 ? (double)total_nodes / total_time : 0.0,
+         check ? (failed ? "FAILED" : "OK") : "not checked");
+  return failed;
+}
@@ -0,0 +1,242 @@
+//
+//  tactical.c
+//  gomoku - tactical suite runner with best-move and time gates
+//
+//  Reads the EPD-like suite in tests/fixtures/tactical.epd - board
+//  stones, side to move, acceptable best moves and a millisecond
+//  budget per position - and runs each position through
+//  find_best_ai_move(). A position fails on a move outside the bm
+//  list or on budget overrun, so one artifact gates both strength
+//  (known forced wins and forced blocks keep being found) and speed
+//  (they keep being found in time).
+//
+//  Build and run with `make test-tactical`; pass a different suite
+//  file as argv[1].
+//
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ai.h"
+#include "board.h"
+#include "game.h"
+#include "gomoku.h"
+
+#define SUITE_DEFAULT "tests/fixtures/tactical.epd"
+#define MAX_STONES 64
+#define MAX_BEST 8
+#define SUITE_DEPTH 6
+
+typedef struct {
+  char id[64];
+  int size;
+  move_history_t stones[MAX_STONES];
+  int stone_count;
+  int side_to_move;
+  char best[MAX_BEST][8];
+  int best_count;
+  int budget_ms;
+} suite_position_t;
+
+static char *trim(char *s) {
+  while (isspace((unsigned char)*s)) {
+    s++;
+  }
+  char *end = s + strlen(s);
+  while (end > s && isspace((unsigned char)end[-1])) {
+    *--end = '\0';
+  }
+  return s;
+}
+
+/**
+ * Parse one suite line into `pos`. Returns 1 on success, 0 on a
+ * malformed line (reported by the caller with its line number).
+ */
+static int parse_position(char *line, suite_position_t *pos) {
+  memset(pos, 0, sizeof(*pos));
+  pos->size = DEFAULT_BOARD_SIZE;
+  pos->side_to_move = AI_CELL_CROSSES;
+
+  char *saveptr = NULL;
+  for (char *field = strtok_r(line, ";", &saveptr); field;
+       field = strtok_r(NULL, ";", &saveptr)) {
+    field = trim(field);
+    if (*field == '\0') {
+      continue;
+    }
+
+    char *inner = NULL;
+    char *key = strtok_r(field, " \t", &inner);
+    if (!key) {
+      return 0;
+    }
+
+    if (strcmp(key, "id") == 0) {
+      char *value = strtok_r(NULL, " \t", &inner);
+      if (!value) {
+        return 0;
+      }
+      snprintf(pos->id, sizeof(pos->id), "%s", value);
+    } else if (strcmp(key, "size") == 0) {
+      char *value = strtok_r(NULL, " \t", &inner);
+      if (!value) {
+        return 0;
+      }
+      pos->size = atoi(value);
+    } else if (strcmp(key, "stm") == 0) {
+      char *value = strtok_r(NULL, " \t", &inner);
+      if (!value || (*value != 'X' && *value != 'O')) {
+        return 0;
+      }
+      pos->side_to_move =
+          (*value == 'X') ? AI_CELL_CROSSES : AI_CELL_NAUGHTS;
+    } else if (strcmp(key, "ms") == 0) {
+      char *value = strtok_r(NULL, " \t", &inner);
+      if (!value) {
+        return 0;
+      }
+      pos->budget_ms = atoi(value);
+    } else if (strcmp(key, "X") == 0 || strcmp(key, "O") == 0) {
+      int player = (*key == 'X') ? AI_CELL_CROSSES : AI_CELL_NAUGHTS;
+      for (char *cell = strtok_r(NULL, " \t", &inner); cell;
+           cell = strtok_r(NULL, " \t", &inner)) {
+        int x, y;
+        if (pos->stone_count >= MAX_STONES ||
+            !notation_to_board_coord(cell, &x, &y)) {
+          return 0;
+        }
+        pos->stones[pos->stone_count].x = x;
+        pos->stones[pos->stone_count].y = y;
+        pos->stones[pos->stone_count].player = player;
+        pos->stone_count++;
+      }
+    } else if (strcmp(key, "bm") == 0) {
+      for (char *cell = strtok_r(NULL, " \t", &inner); cell;
+           cell = strtok_r(NULL, " \t", &inner)) {
+        int x, y;
+        if (pos->best_count >= MAX_BEST ||
+            !notation_to_board_coord(cell, &x, &y)) {
+          return 0;
+        }
+        snprintf(pos->best[pos->best_count], sizeof(pos->best[0]), "%s",
+                 cell);
+        pos->best_count++;
+      }
+    } else {
+      return 0;
+    }
+  }
+
+  return pos->id[0] != '\0' && pos->stone_count > 0 && pos->best_count > 0 &&
+         pos->budget_ms > 0 && pos->size >= 5 && pos->size <= 19;
+}
+
+/**
+ * Run one suite position. Returns 1 on pass.
+ */
+static int run_position(const suite_position_t *pos) {
+  cli_config_t cfg;
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.board_size = pos->size;
+  cfg.max_depth = SUITE_DEPTH;
+  cfg.skip_welcome = 1;
+  cfg.headless = 1;
+  cfg.search_radius = 3;
+  cfg.leaf_radius = 2;
+  cfg.player_x_type = PLAYER_TYPE_AI;
+  cfg.player_o_type = PLAYER_TYPE_AI;
+  cfg.depth_x = -1;
+  cfg.depth_o = -1;
+  game_state_t *game = init_game(cfg);
+  if (!game) {
+    fprintf(stderr, "tactical: failed to allocate game state\n");
+    return 0;
+  }
+
+  int ok = 0;
+  if (!bulk_load_moves(game, pos->stones, pos->stone_count, NULL)) {
+    printf("ERROR %-20s bad stone list\n", pos->id);
+  } else {
+    game->current_player = pos->side_to_move;
+    game->move_timeout = pos->budget_ms / 1000.0;
+
+    int x = -1, y = -1;
+    double start = get_current_time();
+    find_best_ai_move(game, &x, &y, NULL);
+    double elapsed_ms = (get_current_time() - start) * 1000.0;
+
+    char move_str[8] = "?";
+    if (x >= 0) {
+      board_coord_to_notation(x, y, move_str, sizeof(move_str));
+    }
+    int move_ok = 0;
+    for (int i = 0; i < pos->best_count; i++) {
+      if (strcmp(move_str, pos->best[i]) == 0) {
+        move_ok = 1;
+        break;
+      }
+    }
+    int time_ok = (elapsed_ms <= (double)pos->budget_ms);
+    ok = move_ok && time_ok;
+
+    printf("%s %-20s %-4s %7.1fms / %4dms",
+           ok ? "PASS" : "FAIL", pos->id, move_str, elapsed_ms,
+           pos->budget_ms);
+    if (!move_ok) {
+      printf("  (expected");
+      for (int i = 0; i < pos->best_count; i++) {
+        printf(" %s", pos->best[i]);
+      }
+      printf(")");
+    } else if (!time_ok) {
+      printf("  (over budget)");
+    }
+    printf("\n");
+  }
+
+  cleanup_game(game);
+  return ok;
+}
+
+int main(int argc, char *argv[]) {
+  const char *path = (argc > 1) ? argv[1] : SUITE_DEFAULT;
+  FILE *fp = fopen(path, "r");
+  if (!fp) {
+    fprintf(stderr, "tactical: cannot open suite file %s\n", path);
+    return 1;
+  }
+
+  populate_threat_matrix();
+
+  char line[512];
+  int line_no = 0;
+  int total = 0;
+  int passed = 0;
+  int malformed = 0;
+
+  while (fgets(line, sizeof(line), fp)) {
+    line_no++;
+    char *text = trim(line);
+    if (*text == '\0' || *text == '#') {
+      continue;
+    }
+
+    suite_position_t pos;
+    if (!parse_position(text, &pos)) {
+      fprintf(stderr, "tactical: malformed line %d in %s\n", line_no, path);
+      malformed++;
+      continue;
+    }
+
+    total++;
+    passed += run_position(&pos);
+  }
+  fclose(fp);
+
+  printf("\nTactical suite: %d/%d passed%s\n", passed, total,
+         malformed ? " (malformed lines skipped!)" : "");
+  return (passed == total && malformed == 0 && total > 0) ? 0 : 1;
+}